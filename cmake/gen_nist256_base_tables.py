@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+# gen_nist256_base_tables.py - Emit the NIST P-256 generator tables as static const data
+# Usage: gen_nist256_base_tables.py <output.c> [miracl_c_dir]
+#
+# Writes, in MIRACL's internal representation (BIG_256_56 limbs, Montgomery form,
+# affine points with Z = 1, excess 1):
+#   nist256_base_rows[i][j]             = (j + 1) * 16^i * G   for the signed-window comb
+#   nist256_generator_odd_multiples[i]  = (2i + 1) * G         for the ECDSA width-8 NAF
+#
+# If MIRACL's generated sources are given, the curve constants and the Montgomery
+# radix are cross-checked against rom_field_NIST256.c and rom_curve_NIST256.c.
+
+import os
+import re
+import sys
+
+# Curve (SEC 2 / FIPS 186-4 P-256)
+P = 0xFFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF
+N = 0xFFFFFFFF00000000FFFFFFFFFFFFFFFFBCE6FAADA7179E84F3B9CAC2FC632551
+A = P - 3
+B = 0x5AC635D8AA3A93E7B3EBBD55769886BC651D06B0CC53B0F63BCE3C3E27D2604B
+GX = 0x6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296
+GY = 0x4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5
+
+# MIRACL BIG_256_56 layout and the tables' shape; the C side re-checks all of them
+BASEBITS = 56
+NLEN = 5
+SIGNED_WINDOWS = 65
+WINDOW_ENTRIES = 8
+ODD_MULTIPLES = 64
+
+# Montgomery radix of MIRACL's NOT_SPECIAL moduli
+R = pow(2, BASEBITS * NLEN, P)
+
+
+def add(p1, p2):
+    if p1 is None:
+        return p2
+    if p2 is None:
+        return p1
+    x1, y1 = p1
+    x2, y2 = p2
+    if x1 == x2:
+        if (y1 + y2) % P == 0:
+            return None
+        slope = (3 * x1 * x1 + A) * pow(2 * y1, -1, P) % P
+    else:
+        slope = (y2 - y1) * pow(x2 - x1, -1, P) % P
+    x3 = (slope * slope - x1 - x2) % P
+    return x3, (slope * (x1 - x3) - y1) % P
+
+
+def on_curve(point):
+    x, y = point
+    return (y * y - (x * x * x + A * x + B)) % P == 0
+
+
+def limbs(value):
+    mask = (1 << BASEBITS) - 1
+    return [(value >> (BASEBITS * i)) & mask for i in range(NLEN)]
+
+
+def from_limbs(values):
+    return sum(v << (BASEBITS * i) for i, v in enumerate(values))
+
+
+def fp(value):
+    # Fully reduced Montgomery residue, so an excess of 1 is exact
+    words = ", ".join("0x%X" % w for w in limbs(value * R % P))
+    return "{ { %s }, 1 }" % words
+
+
+def ecp(point):
+    return "{ %s, %s, %s }" % (fp(point[0]), fp(point[1]), fp(1))
+
+
+def read_rom(path):
+    constants = {}
+    with open(path) as f:
+        for name, body in re.findall(r"BIG_256_56\s+(\w+)_NIST256\s*=\s*\{([^}]*)\}", f.read()):
+            constants[name] = from_limbs([int(w.strip().rstrip("Ll"), 0) for w in body.split(",") if w.strip()])
+    return constants
+
+
+def check_miracl(miracl_dir):
+    field_rom = os.path.join(miracl_dir, "rom_field_NIST256.c")
+    curve_rom = os.path.join(miracl_dir, "rom_curve_NIST256.c")
+    if not (os.path.exists(field_rom) and os.path.exists(curve_rom)):
+        print("gen_nist256_base_tables: MIRACL ROM sources not found in %s, skipping cross-check" % miracl_dir)
+        return
+
+    rom = read_rom(field_rom)
+    rom.update(read_rom(curve_rom))
+    expected = {"Modulus": P, "R2modp": R * R % P, "CURVE_Order": N, "CURVE_B": B, "CURVE_Gx": GX, "CURVE_Gy": GY}
+    for name, value in expected.items():
+        if name in rom and rom[name] != value:
+            sys.exit("gen_nist256_base_tables: %s_NIST256 in MIRACL's ROM does not match; the table layout is out of date" % name)
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        sys.exit("usage: gen_nist256_base_tables.py <output.c> [miracl_c_dir]")
+    if len(sys.argv) == 3:
+        check_miracl(sys.argv[2])
+
+    generator = (GX, GY)
+    assert on_curve(generator)
+
+    rows = []
+    base = generator
+    for _ in range(SIGNED_WINDOWS):
+        row = [base]
+        for _ in range(1, WINDOW_ENTRIES):
+            row.append(add(row[-1], base))
+        rows.append(row)
+        for _ in range(4):
+            base = add(base, base)
+
+    twice = add(generator, generator)
+    odd = [generator]
+    for _ in range(1, ODD_MULTIPLES):
+        odd.append(add(odd[-1], twice))
+
+    assert all(p is not None and on_curve(p) for row in rows for p in row)
+    assert all(on_curve(p) for p in odd)
+
+    out = []
+    out.append("// Generated by cmake/gen_nist256_base_tables.py - do not edit")
+    out.append("#include \"nist256_base_tables.h\"")
+    out.append("")
+    out.append("#if BASEBITS_256_56 != %d || NLEN_256_56 != %d || MODTYPE_NIST256 != NOT_SPECIAL" % (BASEBITS, NLEN))
+    out.append("#error \"nist256_base_tables.c was generated for 56-bit limbs and Montgomery form\"")
+    out.append("#endif")
+    out.append("#if NIST256_SIGNED_WINDOWS != %d || NIST256_WINDOW_ENTRIES != %d || NIST256_GENERATOR_ODD_MULTIPLES != %d" % (SIGNED_WINDOWS, WINDOW_ENTRIES, ODD_MULTIPLES))
+    out.append("#error \"nist256_base_tables.c does not match the table dimensions\"")
+    out.append("#endif")
+    out.append("")
+    out.append("const ECP_NIST256 nist256_base_rows[NIST256_SIGNED_WINDOWS][NIST256_WINDOW_ENTRIES] = {")
+    for row in rows:
+        out.append("    {")
+        for point in row:
+            out.append("        %s," % ecp(point))
+        out.append("    },")
+    out.append("};")
+    out.append("")
+    out.append("const ECP_NIST256 nist256_generator_odd_multiples[NIST256_GENERATOR_ODD_MULTIPLES] = {")
+    for point in odd:
+        out.append("    %s," % ecp(point))
+    out.append("};")
+    out.append("")
+
+    output = sys.argv[1]
+    os.makedirs(os.path.dirname(os.path.abspath(output)), exist_ok=True)
+    with open(output, "w") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
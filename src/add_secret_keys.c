@@ -4,11 +4,109 @@
 #include "add_secret_keys.h"
 #include "big_256_56.h"
 #include "core.h"
+#include "secure_memory.h"
+#include <stdint.h>
 #include <string.h>
 
 // External ROM constants
 extern const BIG_256_56 CURVE_Order_NIST256;
 
+// Curve order n and 2^256 - n as little-endian 32-bit words
+static const uint32_t nist256_n_words[8] = { 0xFC632551, 0xF3B9CAC2, 0xA7179E84, 0xBCE6FAAD, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0xFFFFFFFF };
+static const uint32_t nist256_n_complement[8] = { 0x039CDAAF, 0x0C46353D, 0x58E8617B, 0x43190552, 0x00000000, 0x00000000, 0xFFFFFFFF, 0x00000000 };
+
+static void scalar_from_bytes(const unsigned char* bytes, uint32_t w[8])
+{
+    for (int i = 0; i < 8; i++)
+    {
+        const unsigned char* p = bytes + 4 * (7 - i);
+        w[i] = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+    }
+}
+
+static void scalar_to_bytes(const uint32_t w[8], unsigned char* bytes)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        unsigned char* p = bytes + 4 * (7 - i);
+        p[0] = (unsigned char)(w[i] >> 24);
+        p[1] = (unsigned char)(w[i] >> 16);
+        p[2] = (unsigned char)(w[i] >> 8);
+        p[3] = (unsigned char)w[i];
+    }
+}
+
+// Computes r = a - n and returns 1 if that borrowed (a < n); r may alias a
+static uint32_t scalar_sub_n(const uint32_t a[8], uint32_t r[8])
+{
+    int64_t borrow = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        borrow += (int64_t)a[i] - nist256_n_words[i];
+        r[i] = (uint32_t)borrow;
+        borrow >>= 32;
+    }
+    return (uint32_t)(borrow != 0);
+}
+
+// Returns 1 if 0 < w < n, without branching on the key value
+static int scalar_is_valid(const uint32_t w[8])
+{
+    uint32_t scratch[8];
+    uint32_t any = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        any |= w[i];
+    }
+    const uint32_t below_n = scalar_sub_n(w, scratch);
+    cvc_secure_zero(scratch, sizeof(scratch));
+    return (int)(below_n & (uint32_t)(any != 0));
+}
+
+// Replace r by r - n when r >= n; r must be below 2n
+static void scalar_conditional_sub_n(uint32_t r[8])
+{
+    uint32_t difference[8];
+    const uint32_t keep_r = (uint32_t)0 - scalar_sub_n(r, difference);
+    for (int i = 0; i < 8; i++)
+    {
+        r[i] = (r[i] & keep_r) | (difference[i] & ~keep_r);
+    }
+    cvc_secure_zero(difference, sizeof(difference));
+}
+
+/*
+ * Reduce a lazily accumulated sum modulo n. Each of the eight 64-bit columns holds a
+ * sum of 32-bit words (fewer than 2^31 terms), so the total is below 2^287. The part
+ * above 2^256 is folded back with 2^256 = 2^256 - n (mod n), a value below 2^224;
+ * two folds always leave a value below 2^256 < 2n, which one conditional
+ * subtraction brings into [0, n).
+ */
+static void scalar_reduce_columns(const uint64_t columns[8], uint32_t r[8])
+{
+    uint64_t carry = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        carry += columns[i];
+        r[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+
+    for (int fold = 0; fold < 2; fold++)
+    {
+        const uint64_t high = carry;
+        carry = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            carry += (uint64_t)r[i] + high * nist256_n_complement[i];
+            r[i] = (uint32_t)carry;
+            carry >>= 32;
+        }
+    }
+
+    scalar_conditional_sub_n(r);
+}
+
 int cvc_add_nist256_secret_keys(const unsigned char* key1_bytes, int key1_len, const unsigned char* key2_bytes, int key2_len, nist256_key_material_t* result_key_material)
 {
     // Basic parameter validation
@@ -62,4 +160,171 @@ int cvc_add_nist256_secret_keys(const unsigned char* key1_bytes, int key1_len, c
     }
 
     return CVC_ADD_SECRET_KEYS_SUCCESS;
-}
\ No newline at end of file
+}
+
+int cvc_sum_nist256_secret_keys(const unsigned char* const* keys, int key_count, nist256_key_material_t* result_key_material)
+{
+    // Basic parameter validation
+    if (!keys || key_count <= 0 || !result_key_material)
+    {
+        return CVC_ADD_SECRET_KEYS_ERROR_INVALID_PARAMS;
+    }
+
+    // Clear the output structure
+    memset(result_key_material, 0, sizeof(nist256_key_material_t));
+
+    // Validate every share and accumulate column-wise; carries are resolved once at the end
+    uint64_t columns[8] = { 0 };
+    uint32_t share[8];
+    int all_valid = 1;
+    for (int k = 0; k < key_count; k++)
+    {
+        if (!keys[k])
+        {
+            cvc_secure_zero(columns, sizeof(columns));
+            return CVC_ADD_SECRET_KEYS_ERROR_INVALID_PARAMS;
+        }
+
+        scalar_from_bytes(keys[k], share);
+        all_valid &= scalar_is_valid(share);
+        for (int i = 0; i < 8; i++)
+        {
+            columns[i] += share[i];
+        }
+    }
+    cvc_secure_zero(share, sizeof(share));
+
+    if (!all_valid)
+    {
+        cvc_secure_zero(columns, sizeof(columns));
+        return CVC_ADD_SECRET_KEYS_ERROR_INVALID_SHARE;
+    }
+
+    uint32_t sum_words[8];
+    scalar_reduce_columns(columns, sum_words);
+    cvc_secure_zero(columns, sizeof(columns));
+
+    unsigned char sum_bytes[MODBYTES_256_56];
+    scalar_to_bytes(sum_words, sum_bytes);
+    const int is_zero = !scalar_is_valid(sum_words);
+    cvc_secure_zero(sum_words, sizeof(sum_words));
+
+    if (is_zero)
+    {
+        cvc_secure_zero(sum_bytes, sizeof(sum_bytes));
+        return CVC_ADD_SECRET_KEYS_ERROR_RESULT_ZERO;
+    }
+
+    // One scalar multiplication for the whole set of shares
+    BIG_256_56 sum;
+    BIG_256_56_fromBytes(sum, (char*)sum_bytes);
+    cvc_secure_zero(sum_bytes, sizeof(sum_bytes));
+
+    int extract_result = nist256_big_to_key_material(sum, result_key_material);
+    cvc_secure_zero(sum, sizeof(sum));
+    if (extract_result != 0)
+    {
+        return CVC_ADD_SECRET_KEYS_ERROR_KEY_EXTRACTION_FAILED;
+    }
+
+    return CVC_ADD_SECRET_KEYS_SUCCESS;
+}
+
+int cvc_split_nist256_secret_key(const unsigned char* key_bytes, int key_len, unsigned char* random_seed, int seed_len, int share_count, unsigned char* shares)
+{
+    // Basic parameter validation
+    if (!key_bytes || key_len != MODBYTES_256_56 || !random_seed || seed_len < 16 || share_count < 2 || !shares)
+    {
+        return CVC_ADD_SECRET_KEYS_ERROR_INVALID_PARAMS;
+    }
+
+    uint32_t key[8];
+    scalar_from_bytes(key_bytes, key);
+    if (!scalar_is_valid(key))
+    {
+        cvc_secure_zero(key, sizeof(key));
+        return CVC_ADD_SECRET_KEYS_ERROR_INVALID_KEY1;
+    }
+
+    // One generator seeded once produces every random share
+    csprng rng;
+    RAND_clean(&rng);
+    RAND_seed(&rng, seed_len, (char*)random_seed);
+
+    BIG_256_56 curve_order, random_share;
+    BIG_256_56_rcopy(curve_order, CURVE_Order_NIST256);
+
+    uint32_t share[8], last[8];
+    int result = CVC_ADD_SECRET_KEYS_SUCCESS;
+
+    // The final share is key - sum(random shares); redraw in the negligible case that it is zero
+    for (int attempt = 0;; attempt++)
+    {
+        if (attempt == 4)
+        {
+            result = CVC_ADD_SECRET_KEYS_ERROR_RESULT_ZERO;
+            break;
+        }
+
+        uint64_t columns[8] = { 0 };
+        int drawn = 0;
+        while (drawn < share_count - 1)
+        {
+            BIG_256_56_randomnum(random_share, curve_order, &rng);
+            if (BIG_256_56_iszilch(random_share))
+            {
+                continue;
+            }
+
+            unsigned char* out = shares + (size_t)drawn * MODBYTES_256_56;
+            BIG_256_56_toBytes((char*)out, random_share);
+            scalar_from_bytes(out, share);
+            for (int i = 0; i < 8; i++)
+            {
+                columns[i] += share[i];
+            }
+            drawn++;
+        }
+
+        // last = key + (n - sum), computed as key - sum with n added back on borrow
+        uint32_t sum[8];
+        scalar_reduce_columns(columns, sum);
+        cvc_secure_zero(columns, sizeof(columns));
+
+        int64_t borrow = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            borrow += (int64_t)key[i] - sum[i];
+            last[i] = (uint32_t)borrow;
+            borrow >>= 32;
+        }
+        const uint32_t add_n = (uint32_t)0 - (uint32_t)(borrow != 0);
+        uint64_t carry = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            carry += (uint64_t)last[i] + (nist256_n_words[i] & add_n);
+            last[i] = (uint32_t)carry;
+            carry >>= 32;
+        }
+        cvc_secure_zero(sum, sizeof(sum));
+
+        if (scalar_is_valid(last))
+        {
+            scalar_to_bytes(last, shares + (size_t)(share_count - 1) * MODBYTES_256_56);
+            break;
+        }
+    }
+
+    RAND_clean(&rng);
+    cvc_secure_zero(random_share, sizeof(random_share));
+    cvc_secure_zero(key, sizeof(key));
+    cvc_secure_zero(share, sizeof(share));
+    cvc_secure_zero(last, sizeof(last));
+
+    if (result != CVC_ADD_SECRET_KEYS_SUCCESS)
+    {
+        cvc_secure_zero(shares, (size_t)share_count * MODBYTES_256_56);
+    }
+
+    return result;
+}
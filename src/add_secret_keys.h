@@ -21,6 +21,7 @@ typedef enum
     CVC_ADD_SECRET_KEYS_ERROR_INVALID_KEY2 = -3,          /**< Second key is invalid (zero or >= curve order) */
     CVC_ADD_SECRET_KEYS_ERROR_RESULT_ZERO = -4,           /**< Result scalar is zero (invalid private key) */
     CVC_ADD_SECRET_KEYS_ERROR_KEY_EXTRACTION_FAILED = -5, /**< Failed to extract complete key material */
+    CVC_ADD_SECRET_KEYS_ERROR_INVALID_SHARE = -6,         /**< A share in a sum is invalid (zero or >= curve order) */
 } cvc_add_secret_keys_result_t;
 
 /**
@@ -45,6 +46,37 @@ typedef enum
  */
 int cvc_add_nist256_secret_keys(const unsigned char* key1_bytes, int key1_len, const unsigned char* key2_bytes, int key2_len, nist256_key_material_t* result_key_material);
 
+/**
+ * @brief Sum any number of NIST P-256 private key shares modulo curve order
+ *
+ * Every share is validated to lie in [1, n-1]. The shares are accumulated in 64-bit
+ * columns with no intermediate reduction; a single special-form reduction modulo n
+ * runs at the end, and the public key is computed once for the final scalar.
+ *
+ * @param keys Array of pointers to 32-byte big-endian scalars
+ * @param key_count Number of shares (must be >= 1)
+ * @param result_key_material Output structure to store the complete key material of the sum
+ * @return CVC_ADD_SECRET_KEYS_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_sum_nist256_secret_keys(const unsigned char* const* keys, int key_count, nist256_key_material_t* result_key_material);
+
+/**
+ * @brief Split a NIST P-256 private key into additive shares
+ *
+ * Draws share_count - 1 random shares in [1, n-1] from one CSPRNG seeded with
+ * random_seed, then sets the last share to key - sum(shares) mod n, so that
+ * cvc_sum_nist256_secret_keys over all shares returns the original key.
+ *
+ * @param key_bytes Private key as 32-byte big-endian scalar
+ * @param key_len Length of key bytes (must be 32)
+ * @param random_seed Array of random bytes for seeding the RNG (at least 16 bytes)
+ * @param seed_len Length of the random seed
+ * @param share_count Number of shares to produce (must be >= 2)
+ * @param shares Output buffer of share_count * 32 bytes
+ * @return CVC_ADD_SECRET_KEYS_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_split_nist256_secret_key(const unsigned char* key_bytes, int key_len, unsigned char* random_seed, int seed_len, int share_count, unsigned char* shares);
+
 #ifdef __cplusplus
 }
 #endif
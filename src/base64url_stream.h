@@ -0,0 +1,60 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef BASE64URL_STREAM_H
+#define BASE64URL_STREAM_H
+
+// Internal to jwt.c and sd_jwt.c; not part of the public API in cvc.h
+
+#include <limits.h>
+
+// Longest input whose encoded length still fits in an int
+#define CVC_BASE64URL_MAX_INPUT_LENGTH (INT_MAX / 4 * 3)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Incremental base64url encoder for output assembled from several pieces
+ *
+ * Whole 3-byte groups are encoded in place from each piece (with SSSE3 where the
+ * CPU has it); at most two bytes are carried over between updates.
+ */
+typedef struct
+{
+    char* output;         // Next characters are written at output + written
+    int written;          // Characters produced so far
+    unsigned int pending; // Bytes of an incomplete group, big-endian
+    int pending_len;      // Number of pending bytes (0..2)
+} cvc_base64url_stream_t;
+
+/**
+ * @brief Number of base64url characters (without padding) for len bytes
+ *
+ * @return Encoded length, or -1 if len is negative or above CVC_BASE64URL_MAX_INPUT_LENGTH
+ */
+int cvc_base64url_encoded_length(int len);
+
+/**
+ * @brief Start encoding into output, which must hold the whole encoded result
+ */
+void cvc_base64url_stream_init(cvc_base64url_stream_t* stream, char* output);
+
+/**
+ * @brief Append bytes to the stream
+ */
+void cvc_base64url_stream_update(cvc_base64url_stream_t* stream, const unsigned char* data, int len);
+
+/**
+ * @brief Flush the last partial group
+ *
+ * @return Total number of characters written
+ */
+int cvc_base64url_stream_final(cvc_base64url_stream_t* stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BASE64URL_STREAM_H
@@ -0,0 +1,129 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "batch.h"
+#include "add_secret_keys.h"
+#include "ecp_operations.h"
+#include "hash_to_field.h"
+#include "nist256_key_material.h"
+#include "secure_memory.h"
+#include <string.h>
+
+// Copy key material into a response output as private || X || Y
+static int write_key_material(const nist256_key_material_t* key_material, unsigned char* output)
+{
+    memcpy(output, key_material->private_key_bytes, MODBYTES_256_56);
+    memcpy(output + MODBYTES_256_56, key_material->public_key_x_bytes, MODBYTES_256_56);
+    memcpy(output + 2 * MODBYTES_256_56, key_material->public_key_y_bytes, MODBYTES_256_56);
+    return 3 * MODBYTES_256_56;
+}
+
+// Reserved byte, padding and the operand bytes past len_a / len_b are all zero
+static int unused_bytes_zero(const unsigned char* request, int len_a, int len_b)
+{
+    unsigned char bits = request[CVC_BATCH_REQUEST_RESERVED];
+    for (int i = len_a; i < CVC_BATCH_OPERAND_SIZE; i++)
+    {
+        bits |= request[CVC_BATCH_REQUEST_OPERAND_A + i];
+    }
+    for (int i = len_b; i < CVC_BATCH_OPERAND_SIZE; i++)
+    {
+        bits |= request[CVC_BATCH_REQUEST_OPERAND_B + i];
+    }
+    for (int i = CVC_BATCH_REQUEST_PADDING; i < CVC_BATCH_REQUEST_SIZE; i++)
+    {
+        bits |= request[i];
+    }
+    return bits == 0;
+}
+
+// Execute one request record; returns the status and sets *output_len on success
+static int execute_record(const unsigned char* request, const unsigned char* dst, int dst_len, unsigned char* output, int* output_len)
+{
+    const int len_a = request[CVC_BATCH_REQUEST_LEN_A];
+    const int len_b = request[CVC_BATCH_REQUEST_LEN_B];
+    const unsigned char* operand_a = request + CVC_BATCH_REQUEST_OPERAND_A;
+    const unsigned char* operand_b = request + CVC_BATCH_REQUEST_OPERAND_B;
+
+    if (len_a > CVC_BATCH_OPERAND_SIZE || len_b > CVC_BATCH_OPERAND_SIZE)
+    {
+        return CVC_BATCH_ERROR_INVALID_OPERAND;
+    }
+
+    if (!unused_bytes_zero(request, len_a, len_b))
+    {
+        return CVC_BATCH_ERROR_NONZERO_RESERVED;
+    }
+
+    nist256_key_material_t key_material;
+    int status;
+
+    switch (request[CVC_BATCH_REQUEST_OPCODE])
+    {
+        case CVC_BATCH_OP_DERIVE:
+            status = cvc_derive_secret_key_nist256(operand_a, len_a, operand_b, len_b, dst, dst_len, &key_material);
+            break;
+        case CVC_BATCH_OP_ADD_PUBLIC:
+            // Written straight into the response; no key material to wipe
+            return cvc_add_nist256_public_keys(operand_a, len_a, operand_b, len_b, output, CVC_BATCH_OUTPUT_SIZE, output_len);
+        case CVC_BATCH_OP_ADD_SECRET:
+            status = cvc_add_nist256_secret_keys(operand_a, len_a, operand_b, len_b, &key_material);
+            break;
+        case CVC_BATCH_OP_KEYGEN:
+            if (len_a == 0 || len_b != 0)
+            {
+                return CVC_BATCH_ERROR_INVALID_OPERAND;
+            }
+            status = nist256_generate_key_material((unsigned char*)operand_a, len_a, &key_material);
+            break;
+        default:
+            return CVC_BATCH_ERROR_INVALID_OPCODE;
+    }
+
+    if (status == 0)
+    {
+        *output_len = write_key_material(&key_material, output);
+    }
+    cvc_secure_zero(&key_material, sizeof(key_material));
+    return status;
+}
+
+int cvc_batch_execute(const unsigned char* requests, int request_count, const unsigned char* dst, int dst_len, unsigned char* responses, int responses_size)
+{
+    // Basic parameter validation
+    if (!requests || request_count <= 0 || dst_len < 0 || (dst_len > 0 && !dst) || !responses || responses_size < 0)
+    {
+        return CVC_BATCH_ERROR_INVALID_PARAMS;
+    }
+
+    if ((size_t)responses_size / CVC_BATCH_RESPONSE_SIZE < (size_t)request_count)
+    {
+        return CVC_BATCH_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    int succeeded = 0;
+    for (int i = 0; i < request_count; i++)
+    {
+        const unsigned char* request = requests + (size_t)i * CVC_BATCH_REQUEST_SIZE;
+        unsigned char* response = responses + (size_t)i * CVC_BATCH_RESPONSE_SIZE;
+        memset(response, 0, CVC_BATCH_RESPONSE_SIZE);
+
+        int output_len = 0;
+        const int status = execute_record(request, dst, dst_len, response + CVC_BATCH_RESPONSE_OUTPUT, &output_len);
+
+        response[CVC_BATCH_RESPONSE_OPCODE] = request[CVC_BATCH_REQUEST_OPCODE];
+        response[CVC_BATCH_RESPONSE_STATUS] = (unsigned char)(signed char)status;
+        if (status == 0)
+        {
+            response[CVC_BATCH_RESPONSE_LENGTH] = (unsigned char)output_len;
+            succeeded++;
+        }
+        else
+        {
+            // Never leave partial output behind in a failed record
+            cvc_secure_zero(response + CVC_BATCH_RESPONSE_OUTPUT, CVC_BATCH_OUTPUT_SIZE);
+        }
+    }
+
+    return succeeded;
+}
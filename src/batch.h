@@ -0,0 +1,96 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef BATCH_H
+#define BATCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Result codes for packed batch execution
+ *
+ * CVC_BATCH_ERROR_INVALID_OPCODE, CVC_BATCH_ERROR_INVALID_OPERAND and
+ * CVC_BATCH_ERROR_NONZERO_RESERVED are only ever reported in a response record's status byte. They share that byte with the result
+ * codes of the per-operation functions, so their values lie outside every range
+ * those functions use.
+ */
+typedef enum
+{
+    CVC_BATCH_SUCCESS = 0,                   /**< Operation completed successfully */
+    CVC_BATCH_ERROR_INVALID_PARAMS = -1,     /**< Invalid input parameters */
+    CVC_BATCH_ERROR_BUFFER_TOO_SMALL = -2,   /**< Response buffer cannot hold one record per request */
+    CVC_BATCH_ERROR_INVALID_OPCODE = -100,   /**< Record carried an unknown opcode */
+    CVC_BATCH_ERROR_INVALID_OPERAND = -101,  /**< Record operand lengths do not fit the opcode */
+    CVC_BATCH_ERROR_NONZERO_RESERVED = -102, /**< Record has a non-zero reserved, padding or unused operand byte */
+} cvc_batch_result_t;
+
+/**
+ * @brief Record opcodes (same values as cvc_queue_op_t)
+ */
+#define CVC_BATCH_OP_DERIVE 1     /**< a = master key, b = context; output = key material */
+#define CVC_BATCH_OP_ADD_PUBLIC 2 /**< a, b = 65-byte uncompressed keys; output = 65-byte key */
+#define CVC_BATCH_OP_ADD_SECRET 3 /**< a, b = 32-byte scalars; output = key material */
+#define CVC_BATCH_OP_KEYGEN 4     /**< a = random seed; output = key material */
+
+/**
+ * @brief Request record layout (all offsets in bytes)
+ *
+ * | 0      | 1     | 2     | 3        | 4..68         | 69..133       | 134..135 |
+ * | opcode | len_a | len_b | reserved | operand_a[65] | operand_b[65] | padding  |
+ *
+ * Unused operand bytes and reserved/padding bytes must be zero; a record that sets
+ * any of them fails with CVC_BATCH_ERROR_NONZERO_RESERVED, so later versions can give
+ * them a meaning without old libraries silently ignoring it.
+ */
+#define CVC_BATCH_OPERAND_SIZE 65
+#define CVC_BATCH_REQUEST_OPCODE 0
+#define CVC_BATCH_REQUEST_LEN_A 1
+#define CVC_BATCH_REQUEST_LEN_B 2
+#define CVC_BATCH_REQUEST_RESERVED 3
+#define CVC_BATCH_REQUEST_OPERAND_A 4
+#define CVC_BATCH_REQUEST_OPERAND_B (CVC_BATCH_REQUEST_OPERAND_A + CVC_BATCH_OPERAND_SIZE)
+#define CVC_BATCH_REQUEST_PADDING (CVC_BATCH_REQUEST_OPERAND_B + CVC_BATCH_OPERAND_SIZE)
+#define CVC_BATCH_REQUEST_SIZE 136
+
+/**
+ * @brief Response record layout (all offsets in bytes)
+ *
+ * | 0      | 1           | 2      | 3        | 4..99      | 100..103 |
+ * | opcode | status (i8) | length | reserved | output[96] | padding  |
+ *
+ * Key material output is private key || public X || public Y (32 bytes each).
+ * ADD_PUBLIC output is the 65-byte uncompressed public key.
+ */
+#define CVC_BATCH_OUTPUT_SIZE 96
+#define CVC_BATCH_RESPONSE_OPCODE 0
+#define CVC_BATCH_RESPONSE_STATUS 1
+#define CVC_BATCH_RESPONSE_LENGTH 2
+#define CVC_BATCH_RESPONSE_OUTPUT 4
+#define CVC_BATCH_RESPONSE_SIZE 104
+
+/**
+ * @brief Execute a packed batch of requests in a single call
+ *
+ * Each request record is processed independently and gets exactly one response
+ * record at the same index, so a whole batch crosses an FFI boundary (cgo, JNI,
+ * Swift) once with no per-item marshalling. A failing record does not stop the
+ * batch; its status byte carries the negative result code of the underlying cvc
+ * function (or a cvc_batch_result_t code) and its output is zeroed.
+ *
+ * @param requests Packed request records (request_count * CVC_BATCH_REQUEST_SIZE bytes)
+ * @param request_count Number of request records
+ * @param dst Domain Separation Tag used by every DERIVE record
+ * @param dst_len Length of the DST (may be 0 if the batch has no DERIVE records)
+ * @param responses Output buffer for packed response records
+ * @param responses_size Size of the response buffer in bytes
+ * @return Number of successful records (0..request_count), or a negative error code
+ */
+int cvc_batch_execute(const unsigned char* requests, int request_count, const unsigned char* dst, int dst_len, unsigned char* responses, int responses_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BATCH_H
@@ -33,6 +33,23 @@ extern "C" {
 #include "ecp_operations.h"       // Elliptic curve point operations
 #include "hash_to_field.h"
 #include "add_secret_keys.h"
+#include "key_cache.h"
+#include "queue.h"
+#include "batch.h"
+#include "ed25519_operations.h"
+#include "hash_to_curve.h"
+#include "sha256.h"
+#include "public_key_set.h"
+#include "stack_budget.h"
+#include "key_pool.h"
+#include "keypair.h"
+#include "ecdh.h"
+#include "point_table.h"
+#include "ecdsa.h"
+#include "jwt.h"
+#include "sd_jwt.h"
+#include "public_derive.h"
+#include "key_store.h"
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,346 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "ecdh.h"
+#include "nist256_point_utils.h"
+#include "point_table.h"
+#include "secure_memory.h"
+#include "stack_budget.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+// External ROM constants from rom_curve_NIST256.c
+extern const BIG_256_56 CURVE_Order_NIST256;
+
+// Peers multiplied in lockstep; their tables and accumulators live on the heap
+#define ECDH_LANES CVC_BATCH_LANES
+
+// Ranges this small (a single-peer call) use a workspace on the stack instead
+#ifdef CVC_LOW_STACK
+#define ECDH_STACK_LANES 1
+#else
+#define ECDH_STACK_LANES 4
+#endif
+
+// Upper bound on worker threads per batch call
+#define ECDH_MAX_THREADS 64
+
+typedef struct
+{
+    const signed char* digits; // Shared recoding of the secret
+    cvc_public_key_set_t* key_set;
+    const unsigned char* const* peer_keys;
+    unsigned char* shared_secrets;
+    int* results;
+    int start;  // First peer of this range
+    int end;    // One past the last peer of this range
+    int status; // First failure seen in this range
+} ecdh_range_t;
+
+// Workspace of one range: a row of multiples and an accumulator per lane
+typedef struct
+{
+    ECP_NIST256 (*rows)[NIST256_WINDOW_ENTRIES];
+    ECP_NIST256* accumulators;
+    int* peer_index;
+    int lanes; // Peers multiplied in lockstep
+} ecdh_workspace_t;
+
+// Heap backing of a full-width workspace
+typedef struct
+{
+    ECP_NIST256 rows[ECDH_LANES][NIST256_WINDOW_ENTRIES];
+    ECP_NIST256 accumulators[ECDH_LANES];
+    int peer_index[ECDH_LANES];
+} ecdh_lane_storage_t;
+
+static void set_result(ecdh_range_t* range, int index, int result)
+{
+    if (range->results)
+    {
+        range->results[index] = result;
+    }
+    if (result != CVC_ECDH_SUCCESS)
+    {
+        memset(range->shared_secrets + (size_t)index * CVC_ECDH_SHARED_SECRET_LENGTH, 0, CVC_ECDH_SHARED_SECRET_LENGTH);
+        if (range->status == CVC_ECDH_SUCCESS)
+        {
+            range->status = result;
+        }
+    }
+}
+
+// accumulators[l] = secret * rows[l][0] for every lane, walking the digits from the top
+static void multiply_lanes(const signed char* digits, ecdh_workspace_t* workspace, int lanes)
+{
+    ECP_NIST256 T;
+
+    for (int l = 0; l < lanes; l++)
+    {
+        nist256_select_multiple(&workspace->accumulators[l], workspace->rows[l], digits[NIST256_SIGNED_WINDOWS - 1]);
+    }
+
+    for (int i = NIST256_SIGNED_WINDOWS - 2; i >= 0; i--)
+    {
+        for (int l = 0; l < lanes; l++)
+        {
+            for (int k = 0; k < 4; k++)
+            {
+                ECP_NIST256_dbl(&workspace->accumulators[l]);
+            }
+        }
+        for (int l = 0; l < lanes; l++)
+        {
+            nist256_select_multiple(&T, workspace->rows[l], digits[i]);
+            ECP_NIST256_add(&workspace->accumulators[l], &T);
+        }
+    }
+
+    cvc_secure_zero(&T, sizeof(T));
+}
+
+static void multiply_range(ecdh_range_t* range, ecdh_workspace_t* workspace)
+{
+    int next = range->start;
+    while (next < range->end)
+    {
+        // Fill the lanes with the next valid peers
+        int lanes = 0;
+        while (lanes < workspace->lanes && next < range->end)
+        {
+            const int index = next++;
+            ECP_NIST256* row = workspace->rows[lanes];
+            if (!range->peer_keys[index] || !cvc_public_key_set_decode(range->key_set, range->peer_keys[index], &row[0]))
+            {
+                set_result(range, index, CVC_ECDH_ERROR_INVALID_PEER_KEY);
+                continue;
+            }
+
+            for (int j = 1; j < NIST256_WINDOW_ENTRIES; j++)
+            {
+                ECP_NIST256_copy(&row[j], &row[j - 1]);
+                ECP_NIST256_add(&row[j], &row[0]);
+            }
+            workspace->peer_index[lanes++] = index;
+        }
+
+        if (lanes == 0)
+        {
+            continue;
+        }
+
+        multiply_lanes(range->digits, workspace, lanes);
+
+        // One inversion for the whole group
+        nist256_batch_normalize(workspace->accumulators, lanes);
+
+        for (int l = 0; l < lanes; l++)
+        {
+            const int index = workspace->peer_index[l];
+
+            // P-256 has prime order, so a valid peer and a secret in [1, n-1] never give infinity
+            if (ECP_NIST256_isinf(&workspace->accumulators[l]))
+            {
+                set_result(range, index, CVC_ECDH_ERROR_INVALID_PEER_KEY);
+                continue;
+            }
+
+            BIG_256_56 x;
+            FP_NIST256_redc(x, &workspace->accumulators[l].x);
+            BIG_256_56_toBytes((char*)range->shared_secrets + (size_t)index * CVC_ECDH_SHARED_SECRET_LENGTH, x);
+            BIG_256_56_zero(x);
+            set_result(range, index, CVC_ECDH_SUCCESS);
+        }
+    }
+}
+
+static void process_range(ecdh_range_t* range)
+{
+    // Small ranges, every single-peer call among them, never touch the heap
+    if (range->end - range->start <= ECDH_STACK_LANES)
+    {
+        ECP_NIST256 rows[ECDH_STACK_LANES][NIST256_WINDOW_ENTRIES];
+        ECP_NIST256 accumulators[ECDH_STACK_LANES];
+        int peer_index[ECDH_STACK_LANES];
+        ecdh_workspace_t workspace = { rows, accumulators, peer_index, ECDH_STACK_LANES };
+        multiply_range(range, &workspace);
+
+        // Accumulators are shared secrets
+        cvc_secure_zero(accumulators, sizeof(accumulators));
+        return;
+    }
+
+    ecdh_lane_storage_t* storage = malloc(sizeof(ecdh_lane_storage_t));
+    if (!storage)
+    {
+        for (int i = range->start; i < range->end; i++)
+        {
+            set_result(range, i, CVC_ECDH_ERROR_ALLOCATION_FAILED);
+        }
+        return;
+    }
+
+    ecdh_workspace_t workspace = { storage->rows, storage->accumulators, storage->peer_index, ECDH_LANES };
+    multiply_range(range, &workspace);
+
+    // Accumulators are shared secrets
+    cvc_secure_zero(storage, sizeof(ecdh_lane_storage_t));
+    free(storage);
+}
+
+// Allocation failure outranks bad peer keys
+static int merge_status(int a, int b)
+{
+    if (a == CVC_ECDH_ERROR_ALLOCATION_FAILED || b == CVC_ECDH_ERROR_ALLOCATION_FAILED)
+    {
+        return CVC_ECDH_ERROR_ALLOCATION_FAILED;
+    }
+    return a != CVC_ECDH_SUCCESS ? a : b;
+}
+
+static void* range_worker(void* arg)
+{
+    process_range((ecdh_range_t*)arg);
+    return NULL;
+}
+
+int cvc_ecdh_nist256_batch(const unsigned char* secret_key_bytes, int secret_key_len, cvc_public_key_set_t* key_set, const unsigned char* const* peer_keys, int peer_count, int thread_count, unsigned char* shared_secrets, int* results)
+{
+    // Basic parameter validation
+    if (!secret_key_bytes || secret_key_len != CVC_ECDH_SECRET_KEY_LENGTH || !peer_keys || peer_count <= 0 || !shared_secrets)
+    {
+        return CVC_ECDH_ERROR_INVALID_PARAMS;
+    }
+
+    BIG_256_56 d, curve_order;
+    BIG_256_56_rcopy(curve_order, CURVE_Order_NIST256);
+    BIG_256_56_fromBytes(d, (char*)secret_key_bytes);
+    if (BIG_256_56_iszilch(d) || BIG_256_56_comp(d, curve_order) >= 0)
+    {
+        BIG_256_56_zero(d);
+        return CVC_ECDH_ERROR_INVALID_SECRET_KEY;
+    }
+
+    // Recode once for every peer
+    signed char digits[NIST256_SIGNED_WINDOWS];
+    nist256_recode_signed_window(d, digits);
+    BIG_256_56_zero(d);
+
+    // No point in a thread that would get less than one full group of lanes
+    int threads = thread_count < 1 ? 1 : thread_count;
+    const int groups = (peer_count + ECDH_LANES - 1) / ECDH_LANES;
+    if (threads > groups)
+    {
+        threads = groups;
+    }
+    if (threads > ECDH_MAX_THREADS)
+    {
+        threads = ECDH_MAX_THREADS;
+    }
+
+    // Ranges are whole lane groups, so only the last one can end in a partial group
+    const int groups_per_thread = (groups + threads - 1) / threads;
+    threads = (groups + groups_per_thread - 1) / groups_per_thread;
+    const int per_thread = groups_per_thread * ECDH_LANES;
+
+    ecdh_range_t ranges[ECDH_MAX_THREADS];
+    pthread_t workers[ECDH_MAX_THREADS];
+    int started[ECDH_MAX_THREADS] = { 0 };
+    for (int t = 0; t < threads; t++)
+    {
+        ranges[t].digits = digits;
+        ranges[t].key_set = key_set;
+        ranges[t].peer_keys = peer_keys;
+        ranges[t].shared_secrets = shared_secrets;
+        ranges[t].results = results;
+        ranges[t].start = t * per_thread < peer_count ? t * per_thread : peer_count;
+        ranges[t].end = (t + 1) * per_thread < peer_count ? (t + 1) * per_thread : peer_count;
+        ranges[t].status = CVC_ECDH_SUCCESS;
+    }
+
+    // The calling thread takes range 0; a worker that fails to start is run inline afterwards
+    for (int t = 1; t < threads; t++)
+    {
+        started[t] = pthread_create(&workers[t], NULL, range_worker, &ranges[t]) == 0;
+    }
+    process_range(&ranges[0]);
+
+    int status = ranges[0].status;
+    for (int t = 1; t < threads; t++)
+    {
+        if (started[t])
+        {
+            pthread_join(workers[t], NULL);
+        }
+        else
+        {
+            process_range(&ranges[t]);
+        }
+
+        status = merge_status(status, ranges[t].status);
+    }
+
+    cvc_secure_zero(digits, sizeof(digits));
+
+    return status;
+}
+
+int cvc_ecdh_nist256(const unsigned char* secret_key_bytes, int secret_key_len, cvc_public_key_set_t* key_set, const unsigned char* peer_key_bytes, int peer_key_len, unsigned char* shared_secret, int shared_secret_size)
+{
+    // Basic parameter validation
+    if (!peer_key_bytes || !shared_secret)
+    {
+        return CVC_ECDH_ERROR_INVALID_PARAMS;
+    }
+
+    if (shared_secret_size < CVC_ECDH_SHARED_SECRET_LENGTH)
+    {
+        return CVC_ECDH_ERROR_INSUFFICIENT_BUFFER;
+    }
+
+    if (peer_key_len != CVC_ECDH_PUBLIC_KEY_LENGTH)
+    {
+        return CVC_ECDH_ERROR_INVALID_PEER_KEY;
+    }
+
+    const unsigned char* const peers[1] = { peer_key_bytes };
+    return cvc_ecdh_nist256_batch(secret_key_bytes, secret_key_len, key_set, peers, 1, 1, shared_secret, NULL);
+}
+
+int cvc_ecdh_nist256_table(const unsigned char* secret_key_bytes, int secret_key_len, const cvc_nist256_point_table_t* peer_table, unsigned char* shared_secret, int shared_secret_size)
+{
+    // Basic parameter validation
+    if (!secret_key_bytes || secret_key_len != CVC_ECDH_SECRET_KEY_LENGTH || !peer_table || !shared_secret)
+    {
+        return CVC_ECDH_ERROR_INVALID_PARAMS;
+    }
+
+    if (shared_secret_size < CVC_ECDH_SHARED_SECRET_LENGTH)
+    {
+        return CVC_ECDH_ERROR_INSUFFICIENT_BUFFER;
+    }
+
+    BIG_256_56 d, curve_order;
+    BIG_256_56_rcopy(curve_order, CURVE_Order_NIST256);
+    BIG_256_56_fromBytes(d, (char*)secret_key_bytes);
+    if (BIG_256_56_iszilch(d) || BIG_256_56_comp(d, curve_order) >= 0)
+    {
+        BIG_256_56_zero(d);
+        return CVC_ECDH_ERROR_INVALID_SECRET_KEY;
+    }
+
+    ECP_NIST256 P;
+    nist256_point_table_mul(&P, peer_table, d);
+    BIG_256_56_zero(d);
+
+    BIG_256_56 x, y;
+    ECP_NIST256_get(x, y, &P);
+    BIG_256_56_toBytes((char*)shared_secret, x);
+
+    cvc_secure_zero(&P, sizeof(P));
+    BIG_256_56_zero(x);
+    BIG_256_56_zero(y);
+
+    return CVC_ECDH_SUCCESS;
+}
@@ -0,0 +1,92 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef ECDH_H
+#define ECDH_H
+
+#include "point_table.h"
+#include "public_key_set.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Lengths of the secret key, an uncompressed peer key and a shared secret (x-coordinate)
+#define CVC_ECDH_SECRET_KEY_LENGTH 32
+#define CVC_ECDH_PUBLIC_KEY_LENGTH 65
+#define CVC_ECDH_SHARED_SECRET_LENGTH 32
+
+/**
+ * @brief Result codes for ECDH operations
+ */
+typedef enum
+{
+    CVC_ECDH_SUCCESS = 0,                    /**< Operation completed successfully */
+    CVC_ECDH_ERROR_INVALID_PARAMS = -1,      /**< Invalid input parameters */
+    CVC_ECDH_ERROR_INVALID_SECRET_KEY = -2,  /**< Secret key is zero or >= curve order */
+    CVC_ECDH_ERROR_INVALID_PEER_KEY = -3,    /**< A peer public key is malformed or not on the curve */
+    CVC_ECDH_ERROR_INSUFFICIENT_BUFFER = -4, /**< Output buffer is too small */
+    CVC_ECDH_ERROR_ALLOCATION_FAILED = -5,   /**< Failed to allocate working memory */
+} cvc_ecdh_result_t;
+
+/**
+ * @brief NIST P-256 ECDH: x-coordinate of secret * peer public key
+ *
+ * @param secret_key_bytes 32-byte big-endian secret key
+ * @param secret_key_len Length of the secret key (must be 32)
+ * @param key_set Optional validated key set (may be NULL)
+ * @param peer_key_bytes Peer public key (65 bytes uncompressed)
+ * @param peer_key_len Length of the peer public key
+ * @param shared_secret Output buffer receiving the 32-byte shared secret
+ * @param shared_secret_size Size of the output buffer
+ * @return CVC_ECDH_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_ecdh_nist256(const unsigned char* secret_key_bytes, int secret_key_len, cvc_public_key_set_t* key_set, const unsigned char* peer_key_bytes, int peer_key_len, unsigned char* shared_secret, int shared_secret_size);
+
+/**
+ * @brief NIST P-256 ECDH of one secret key against many peer public keys
+ *
+ * The secret is recoded into signed radix-16 digits once for the whole batch. Peers
+ * are processed in groups of CVC_BATCH_LANES lanes (stack_budget.h), and each
+ * thread takes whole groups. Each lane gets a small table of multiples of
+ * its peer point, and the lanes walk the shared digits in lockstep, so the
+ * doublings and additions of different peers are interleaved. Every group ends with
+ * one batched affine conversion instead of one inversion per peer. Digit selection is
+ * constant time, so the secret does not leak through the access pattern.
+ *
+ * A bad peer key does not stop the batch: its output is zeroed, its entry in results
+ * (if given) is CVC_ECDH_ERROR_INVALID_PEER_KEY and the call returns that code once
+ * every other peer has been processed.
+ *
+ * @param secret_key_bytes 32-byte big-endian secret key
+ * @param secret_key_len Length of the secret key (must be 32)
+ * @param key_set Optional validated key set (may be NULL); must tolerate concurrent use
+ * @param peer_keys Array of peer_count pointers to 65-byte uncompressed public keys
+ * @param peer_count Number of peers
+ * @param thread_count Worker threads to spread the batch over (<= 1 runs on the calling thread)
+ * @param shared_secrets Output buffer of peer_count * 32 bytes
+ * @param results Optional array of peer_count per-peer result codes (may be NULL)
+ * @return CVC_ECDH_SUCCESS if every peer succeeded, or a negative error code
+ */
+int cvc_ecdh_nist256_batch(const unsigned char* secret_key_bytes, int secret_key_len, cvc_public_key_set_t* key_set, const unsigned char* const* peer_keys, int peer_count, int thread_count, unsigned char* shared_secrets, int* results);
+
+/**
+ * @brief NIST P-256 ECDH against a peer whose point table was precomputed
+ *
+ * For a hot peer key (an issuer or service key) build the table once with
+ * cvc_nist256_point_precompute; every agreement after that needs no doublings.
+ *
+ * @param secret_key_bytes 32-byte big-endian secret key
+ * @param secret_key_len Length of the secret key (must be 32)
+ * @param peer_table Table of the peer public key
+ * @param shared_secret Output buffer receiving the 32-byte shared secret
+ * @param shared_secret_size Size of the output buffer
+ * @return CVC_ECDH_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_ecdh_nist256_table(const unsigned char* secret_key_bytes, int secret_key_len, const cvc_nist256_point_table_t* peer_table, unsigned char* shared_secret, int shared_secret_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ECDH_H
@@ -0,0 +1,174 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "ecdsa.h"
+#include "nist256_base_tables.h"
+#include "nist256_point_utils.h"
+
+// External ROM constants
+extern const BIG_256_56 CURVE_Order_NIST256;
+extern const BIG_256_56 Modulus_NIST256;
+
+#define ECDSA_PUBLIC_KEY_LENGTH 65
+
+// Window widths of the two NAFs: G has a generated table, Q's table is built per call
+#define ECDSA_G_WIDTH 8
+#define ECDSA_Q_WIDTH 5
+#define ECDSA_G_ODD_MULTIPLES (1 << (ECDSA_G_WIDTH - 2))
+#define ECDSA_Q_ODD_MULTIPLES (1 << (ECDSA_Q_WIDTH - 2))
+
+#if ECDSA_G_ODD_MULTIPLES != NIST256_GENERATOR_ODD_MULTIPLES
+#error "ECDSA_G_WIDTH must match the generated odd multiples of G"
+#endif
+
+// multiples[i] = (2i + 1) * P
+static void fill_odd_multiples(ECP_NIST256* multiples, int count, ECP_NIST256* point)
+{
+    ECP_NIST256 twice;
+    ECP_NIST256_copy(&twice, point);
+    ECP_NIST256_dbl(&twice);
+
+    ECP_NIST256_copy(&multiples[0], point);
+    for (int i = 1; i < count; i++)
+    {
+        ECP_NIST256_copy(&multiples[i], &multiples[i - 1]);
+        ECP_NIST256_add(&multiples[i], &twice);
+    }
+}
+
+// R += digit * P for an odd NAF digit, reading |digit| * P from the odd multiples
+static void add_naf_digit(ECP_NIST256* R, const ECP_NIST256* multiples, int digit)
+{
+    if (digit > 0)
+    {
+        ECP_NIST256_add(R, (ECP_NIST256*)&multiples[digit >> 1]);
+    }
+    else if (digit < 0)
+    {
+        // The shared tables are read-only and must not be negated in place
+        ECP_NIST256 T;
+        ECP_NIST256_copy(&T, (ECP_NIST256*)&multiples[(-digit) >> 1]);
+        ECP_NIST256_neg(&T);
+        ECP_NIST256_add(R, &T);
+    }
+}
+
+// R = u1 * G + u2 * Q with one shared chain of doublings
+static void mul2_straus(ECP_NIST256* R, BIG_256_56 u1, ECP_NIST256* Q, BIG_256_56 u2)
+{
+    ECP_NIST256 q_multiples[ECDSA_Q_ODD_MULTIPLES];
+    fill_odd_multiples(q_multiples, ECDSA_Q_ODD_MULTIPLES, Q);
+
+    signed char g_naf[NIST256_WNAF_MAX_DIGITS], q_naf[NIST256_WNAF_MAX_DIGITS];
+    const int g_length = nist256_recode_wnaf(u1, ECDSA_G_WIDTH, g_naf);
+    const int q_length = nist256_recode_wnaf(u2, ECDSA_Q_WIDTH, q_naf);
+    const int length = g_length > q_length ? g_length : q_length;
+
+    ECP_NIST256_inf(R);
+    for (int i = length - 1; i >= 0; i--)
+    {
+        ECP_NIST256_dbl(R);
+        if (i < g_length)
+        {
+            add_naf_digit(R, nist256_generator_odd_multiples, g_naf[i]);
+        }
+        if (i < q_length)
+        {
+            add_naf_digit(R, q_multiples, q_naf[i]);
+        }
+    }
+}
+
+// x(R) mod n == r, checked as X == r * Z (or (r + n) * Z when that is still below p)
+static int projective_x_matches(ECP_NIST256* R, BIG_256_56 r, BIG_256_56 curve_order)
+{
+    FP_NIST256 candidate;
+    FP_NIST256_nres(&candidate, r);
+    FP_NIST256_mul(&candidate, &candidate, &R->z);
+    if (FP_NIST256_equals(&candidate, &R->x))
+    {
+        return 1;
+    }
+
+    BIG_256_56 wrapped, field_modulus;
+    BIG_256_56_rcopy(field_modulus, Modulus_NIST256);
+    BIG_256_56_add(wrapped, r, curve_order);
+    BIG_256_56_norm(wrapped);
+    if (BIG_256_56_comp(wrapped, field_modulus) >= 0)
+    {
+        return 0;
+    }
+
+    FP_NIST256_nres(&candidate, wrapped);
+    FP_NIST256_mul(&candidate, &candidate, &R->z);
+    return FP_NIST256_equals(&candidate, &R->x);
+}
+
+int nist256_ecdsa_verify(ECP_NIST256* public_point, const cvc_nist256_point_table_t* table, const unsigned char* digest, const unsigned char* signature)
+{
+    BIG_256_56 curve_order, r, s, e, w, u1, u2;
+    BIG_256_56_rcopy(curve_order, CURVE_Order_NIST256);
+    BIG_256_56_fromBytes(r, (char*)signature);
+    BIG_256_56_fromBytes(s, (char*)signature + MODBYTES_256_56);
+
+    // r and s must both lie in [1, n-1]
+    if (BIG_256_56_iszilch(r) || BIG_256_56_comp(r, curve_order) >= 0 || BIG_256_56_iszilch(s) || BIG_256_56_comp(s, curve_order) >= 0)
+    {
+        return 0;
+    }
+
+    BIG_256_56_fromBytes(e, (char*)digest);
+    BIG_256_56_mod(e, curve_order);
+    BIG_256_56_invmodp(w, s, curve_order);
+    BIG_256_56_modmul(u1, e, w, curve_order);
+    BIG_256_56_modmul(u2, r, w, curve_order);
+
+    // R = u1 * G + u2 * Q
+    ECP_NIST256 R;
+    if (table)
+    {
+        ECP_NIST256 T;
+        nist256_mul_base(&R, u1);
+        nist256_point_table_mul(&T, table, u2);
+        ECP_NIST256_add(&R, &T);
+    }
+    else
+    {
+        mul2_straus(&R, u1, public_point, u2);
+    }
+
+    if (ECP_NIST256_isinf(&R))
+    {
+        return 0;
+    }
+
+    return projective_x_matches(&R, r, curve_order);
+}
+
+int cvc_ecdsa_nist256_verify(cvc_public_key_set_t* key_set, const unsigned char* public_key_bytes, int public_key_len, const unsigned char* digest, int digest_len, const unsigned char* signature, int signature_len)
+{
+    // Basic parameter validation
+    if (!public_key_bytes || !digest || digest_len != CVC_ECDSA_DIGEST_LENGTH || !signature || signature_len != CVC_ECDSA_SIGNATURE_LENGTH)
+    {
+        return CVC_ECDSA_ERROR_INVALID_PARAMS;
+    }
+
+    ECP_NIST256 Q;
+    if (public_key_len != ECDSA_PUBLIC_KEY_LENGTH || !cvc_public_key_set_decode(key_set, public_key_bytes, &Q))
+    {
+        return CVC_ECDSA_ERROR_INVALID_PUBLIC_KEY;
+    }
+
+    return nist256_ecdsa_verify(&Q, NULL, digest, signature) ? CVC_ECDSA_SUCCESS : CVC_ECDSA_ERROR_INVALID_SIGNATURE;
+}
+
+int cvc_ecdsa_nist256_verify_table(const cvc_nist256_point_table_t* table, const unsigned char* digest, int digest_len, const unsigned char* signature, int signature_len)
+{
+    // Basic parameter validation
+    if (!table || !digest || digest_len != CVC_ECDSA_DIGEST_LENGTH || !signature || signature_len != CVC_ECDSA_SIGNATURE_LENGTH)
+    {
+        return CVC_ECDSA_ERROR_INVALID_PARAMS;
+    }
+
+    return nist256_ecdsa_verify(NULL, table, digest, signature) ? CVC_ECDSA_SUCCESS : CVC_ECDSA_ERROR_INVALID_SIGNATURE;
+}
@@ -0,0 +1,80 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef ECDSA_H
+#define ECDSA_H
+
+#include "point_table.h"
+#include "public_key_set.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// SHA-256 digest and raw r || s signature, as used by ES256
+#define CVC_ECDSA_DIGEST_LENGTH 32
+#define CVC_ECDSA_SIGNATURE_LENGTH 64
+
+/**
+ * @brief Result codes for ECDSA operations
+ */
+typedef enum
+{
+    CVC_ECDSA_SUCCESS = 0,                   /**< Signature is valid */
+    CVC_ECDSA_ERROR_INVALID_PARAMS = -1,     /**< Invalid input parameters */
+    CVC_ECDSA_ERROR_INVALID_PUBLIC_KEY = -2, /**< Public key is malformed or not on the curve */
+    CVC_ECDSA_ERROR_INVALID_SIGNATURE = -3,  /**< Signature does not verify */
+} cvc_ecdsa_result_t;
+
+/**
+ * @brief Verify an ECDSA P-256 signature over a SHA-256 digest
+ *
+ * Computes u1 * G + u2 * Q in one interleaved (Straus) pass: u1 is recoded as a
+ * width-8 NAF against a build-time table of 64 odd multiples of G, u2 as a width-5 NAF
+ * against 8 odd multiples of Q built per call, so the whole check is 256 doublings
+ * and about 75 additions. The result is compared with r in projective form, which
+ * saves the final field inversion. Verification only handles public data and is
+ * not constant time.
+ *
+ * @param key_set Optional validated key set (may be NULL)
+ * @param public_key_bytes 65-byte uncompressed public key
+ * @param public_key_len Length of the public key
+ * @param digest Message digest
+ * @param digest_len Length of the digest (must be 32)
+ * @param signature Signature r || s (big-endian)
+ * @param signature_len Length of the signature (must be 64)
+ * @return CVC_ECDSA_SUCCESS if valid, CVC_ECDSA_ERROR_INVALID_SIGNATURE if not, or another error code
+ */
+int cvc_ecdsa_nist256_verify(cvc_public_key_set_t* key_set, const unsigned char* public_key_bytes, int public_key_len, const unsigned char* digest, int digest_len, const unsigned char* signature, int signature_len);
+
+/**
+ * @brief Verify an ECDSA P-256 signature against a precomputed public key table
+ *
+ * Both u1 * G and u2 * Q come from fixed-base tables, so verification needs no point
+ * doublings at all. Worth it for issuer keys that verify many signatures.
+ *
+ * @param table Table of the public key from cvc_nist256_point_precompute
+ * @param digest Message digest
+ * @param digest_len Length of the digest (must be 32)
+ * @param signature Signature r || s (big-endian)
+ * @param signature_len Length of the signature (must be 64)
+ * @return CVC_ECDSA_SUCCESS if valid, CVC_ECDSA_ERROR_INVALID_SIGNATURE if not, or another error code
+ */
+int cvc_ecdsa_nist256_verify_table(const cvc_nist256_point_table_t* table, const unsigned char* digest, int digest_len, const unsigned char* signature, int signature_len);
+
+/**
+ * @brief Verify r || s over a 32-byte digest against a public point or its table
+ *
+ * @param public_point Finite public point (any Z); ignored when table is given
+ * @param table Optional table of the public point (may be NULL)
+ * @param digest 32-byte digest
+ * @param signature 64-byte signature r || s
+ * @return 1 if the signature is valid, 0 otherwise
+ */
+int nist256_ecdsa_verify(ECP_NIST256* public_point, const cvc_nist256_point_table_t* table, const unsigned char* digest, const unsigned char* signature);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ECDSA_H
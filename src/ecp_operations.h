@@ -4,6 +4,8 @@
 #ifndef ECP_OPERATIONS_H
 #define ECP_OPERATIONS_H
 
+#include "public_key_set.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -18,11 +20,15 @@ typedef enum
     CVC_ECP_ERROR_INVALID_KEY2_LENGTH = -2,      /**< Second key has invalid length */
     CVC_ECP_ERROR_INVALID_POINT_1 = -3,          /**< First key bytes do not represent a valid ECP point */
     CVC_ECP_ERROR_INVALID_POINT_2 = -4,          /**< Second key bytes do not represent a valid ECP point */
-    CVC_ECP_ERROR_POINT_1_AT_INFINITY = -5,      /**< First point is at infinity (invalid) */
-    CVC_ECP_ERROR_POINT_2_AT_INFINITY = -6,      /**< Second point is at infinity (invalid) */
+    CVC_ECP_ERROR_POINT_1_AT_INFINITY = -5,      /**< First point is at infinity (Ed25519 only; NIST P-256 reports CVC_ECP_ERROR_INVALID_POINT_1) */
+    CVC_ECP_ERROR_POINT_2_AT_INFINITY = -6,      /**< Second point is at infinity (Ed25519 only; NIST P-256 reports CVC_ECP_ERROR_INVALID_POINT_2) */
     CVC_ECP_ERROR_RESULT_AT_INFINITY = -7,       /**< Result point is at infinity (invalid) */
     CVC_ECP_ERROR_RESULT_CONVERSION_FAILED = -8, /**< Failed to convert result point to bytes */
-    CVC_ECP_ERROR_INSUFFICIENT_BUFFER = -9       /**< Result buffer is too small */
+    CVC_ECP_ERROR_INSUFFICIENT_BUFFER = -9,      /**< Result buffer is too small */
+    CVC_ECP_ERROR_INVALID_PARAMS = -10,          /**< Invalid input parameters */
+    CVC_ECP_ERROR_INVALID_POINT_N = -11,         /**< A key in a sum does not represent a valid ECP point */
+    CVC_ECP_ERROR_SMALL_ORDER_POINT_1 = -12,     /**< First point is not in the prime-order subgroup (Ed25519 torsion component) */
+    CVC_ECP_ERROR_SMALL_ORDER_POINT_2 = -13      /**< Second point is not in the prime-order subgroup (Ed25519 torsion component) */
 } cvc_ecp_result_t;
 
 /**
@@ -30,7 +36,9 @@ typedef enum
  *
  * This function performs elliptic curve point addition on the NIST P-256 curve.
  * Both input keys must be in uncompressed format (65 bytes: 0x04 || X || Y).
- * The result will also be in uncompressed format.
+ * The result will also be in uncompressed format. A key that is malformed, off the
+ * curve or the point at infinity is rejected with CVC_ECP_ERROR_INVALID_POINT_1 or
+ * CVC_ECP_ERROR_INVALID_POINT_2; the *_AT_INFINITY operand codes are not returned here.
  *
  * @param key1_bytes First public key in uncompressed format (65 bytes)
  * @param key1_len Length of first key bytes (must be 65)
@@ -43,6 +51,41 @@ typedef enum
  */
 int cvc_add_nist256_public_keys(const unsigned char* key1_bytes, int key1_len, const unsigned char* key2_bytes, int key2_len, unsigned char* result_bytes, int result_buffer_size, int* actual_result_len);
 
+/**
+ * @brief Add two NIST P-256 public keys, skipping validation of keys already in a set
+ *
+ * Same as cvc_add_nist256_public_keys, but each key is first looked up in key_set.
+ * Keys found there are used without re-running the SEC1 on-curve check; keys that
+ * are not found are validated in full and then remembered.
+ *
+ * @param key_set Validated public key set to consult (may be NULL)
+ * @param key1_bytes First public key in uncompressed format (65 bytes)
+ * @param key1_len Length of first key bytes (must be 65)
+ * @param key2_bytes Second public key in uncompressed format (65 bytes)
+ * @param key2_len Length of second key bytes (must be 65)
+ * @param result_bytes Output buffer for the result (must be at least 65 bytes)
+ * @param result_buffer_size Size of the result buffer
+ * @param actual_result_len Pointer to store the actual length of the result (will be 65)
+ * @return CVC_ECP_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_add_nist256_public_keys_cached(cvc_public_key_set_t* key_set, const unsigned char* key1_bytes, int key1_len, const unsigned char* key2_bytes, int key2_len, unsigned char* result_bytes, int result_buffer_size, int* actual_result_len);
+
+/**
+ * @brief Sum any number of NIST P-256 public keys
+ *
+ * The keys are accumulated in projective coordinates and converted to affine once.
+ * Each key is decoded through key_set as in cvc_add_nist256_public_keys_cached.
+ *
+ * @param key_set Validated public key set to consult (may be NULL)
+ * @param keys Array of pointers to 65-byte uncompressed public keys
+ * @param key_count Number of keys (must be >= 1)
+ * @param result_bytes Output buffer for the result (must be at least 65 bytes)
+ * @param result_buffer_size Size of the result buffer
+ * @param actual_result_len Pointer to store the actual length of the result (will be 65)
+ * @return CVC_ECP_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_sum_nist256_public_keys(cvc_public_key_set_t* key_set, const unsigned char* const* keys, int key_count, unsigned char* result_bytes, int result_buffer_size, int* actual_result_len);
+
 #ifdef __cplusplus
 }
 #endif
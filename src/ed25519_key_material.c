@@ -0,0 +1,197 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "ed25519_key_material.h"
+#include "secure_memory.h"
+#include <pthread.h>
+#include <string.h>
+
+// External ROM constants from rom_curve_Ed25519.c
+extern const BIG_256_56 CURVE_Order_Ed25519;
+
+// Signed radix-16 recoding of a 256-bit scalar: 64 windows, digits in [-8, 8]
+#define ED25519_WINDOWS 64
+#define ED25519_WINDOW_ENTRIES 8
+
+// table[i][j] = (j + 1) * 16^i * G
+static ECP_Ed25519 base_table[ED25519_WINDOWS][ED25519_WINDOW_ENTRIES];
+static pthread_once_t base_table_once = PTHREAD_ONCE_INIT;
+
+static void build_base_table(void)
+{
+    ECP_Ed25519 base;
+    ECP_Ed25519_generator(&base);
+
+    for (int i = 0; i < ED25519_WINDOWS; i++)
+    {
+        ECP_Ed25519_copy(&base_table[i][0], &base);
+        for (int j = 1; j < ED25519_WINDOW_ENTRIES; j++)
+        {
+            ECP_Ed25519_copy(&base_table[i][j], &base_table[i][j - 1]);
+            ECP_Ed25519_add(&base_table[i][j], &base);
+        }
+
+        // Next window base: 16 * base
+        for (int k = 0; k < 4; k++)
+        {
+            ECP_Ed25519_dbl(&base);
+        }
+    }
+}
+
+// 1 if a == b, 0 otherwise, without branching (a, b in [0, 255])
+static int ct_equal(unsigned int a, unsigned int b)
+{
+    return (int)(((a ^ b) - 1U) >> 31);
+}
+
+// Constant-time selection of digit * 16^window * G for digit in [-8, 8]
+static void select_base_multiple(ECP_Ed25519* T, int window, signed char digit)
+{
+    const unsigned int negative = (unsigned int)((unsigned char)digit >> 7);
+    const unsigned int magnitude = (unsigned int)(digit - ((-(int)negative & digit) * 2));
+
+    ECP_Ed25519_inf(T);
+    for (int j = 0; j < ED25519_WINDOW_ENTRIES; j++)
+    {
+        const int match = ct_equal(magnitude, (unsigned int)(j + 1));
+        FP_F25519_cmove(&T->x, &base_table[window][j].x, match);
+        FP_F25519_cmove(&T->y, &base_table[window][j].y, match);
+        FP_F25519_cmove(&T->z, &base_table[window][j].z, match);
+    }
+
+    // Negating an Edwards point negates x
+    FP_F25519 minus_x;
+    FP_F25519_neg(&minus_x, &T->x);
+    FP_F25519_norm(&minus_x);
+    FP_F25519_cmove(&T->x, &minus_x, (int)negative);
+}
+
+void ed25519_mul_base(ECP_Ed25519* P, BIG_256_56 d)
+{
+    pthread_once(&base_table_once, build_base_table);
+
+    // Little-endian nibbles of d
+    char bytes[MODBYTES_256_56];
+    BIG_256_56_toBytes(bytes, d);
+
+    signed char digits[ED25519_WINDOWS];
+    for (int i = 0; i < MODBYTES_256_56; i++)
+    {
+        const unsigned char byte = (unsigned char)bytes[MODBYTES_256_56 - 1 - i];
+        digits[2 * i] = (signed char)(byte & 15);
+        digits[2 * i + 1] = (signed char)(byte >> 4);
+    }
+
+    // Recode to signed digits in [-8, 7]; the top digit absorbs the final carry
+    // and stays small because d < 2^253
+    signed char carry = 0;
+    for (int i = 0; i < ED25519_WINDOWS - 1; i++)
+    {
+        digits[i] += carry;
+        carry = (signed char)((digits[i] + 8) >> 4);
+        digits[i] -= (signed char)(carry * 16);
+    }
+    digits[ED25519_WINDOWS - 1] += carry;
+
+    ECP_Ed25519 T;
+    ECP_Ed25519_inf(P);
+    for (int i = 0; i < ED25519_WINDOWS; i++)
+    {
+        select_base_multiple(&T, i, digits[i]);
+        ECP_Ed25519_add(P, &T);
+    }
+
+    // Wipe scalar-dependent intermediates
+    cvc_secure_zero(bytes, sizeof(bytes));
+    cvc_secure_zero(digits, sizeof(digits));
+    cvc_secure_zero(&T, sizeof(T));
+}
+
+int ed25519_generate_secret_key(BIG_256_56 secret_key, unsigned char* random_seed, int seed_len)
+{
+    if (!random_seed || seed_len < 16)
+    {
+        return -1; // Invalid parameters - need at least 16 bytes of seed
+    }
+
+    // Initialize and seed the cryptographically secure random number generator
+    csprng rng;
+    RAND_clean(&rng);
+    RAND_seed(&rng, seed_len, (char*)random_seed);
+
+    BIG_256_56 curve_order;
+    BIG_256_56_rcopy(curve_order, CURVE_Order_Ed25519);
+
+    // Generate a random number in the range [1, curve_order-1]
+    BIG_256_56_randomnum(secret_key, curve_order, &rng);
+    if (BIG_256_56_iszilch(secret_key))
+    {
+        BIG_256_56_randomnum(secret_key, curve_order, &rng);
+        if (BIG_256_56_iszilch(secret_key))
+        {
+            RAND_clean(&rng);
+            return -2; // Failed to generate non-zero key
+        }
+    }
+
+    RAND_clean(&rng);
+
+    return 0; // Success
+}
+
+int ed25519_big_to_key_material(BIG_256_56 d, ed25519_key_material_t* key_material)
+{
+    if (!key_material)
+    {
+        return -1; // Invalid parameter
+    }
+
+    // Clear the output structure
+    memset(key_material, 0, sizeof(ed25519_key_material_t));
+
+    // Calculate public key point: pub = d * G
+    ECP_Ed25519 pub;
+    ed25519_mul_base(&pub, d);
+
+    // Check if the result is the identity (invalid)
+    if (ECP_Ed25519_isinf(&pub))
+    {
+        return -2; // Invalid private key (resulted in the identity point)
+    }
+
+    // Extract the affine x and y coordinates from the public key point
+    BIG_256_56 x_coord, y_coord;
+    ECP_Ed25519_affine(&pub);
+    if (ECP_Ed25519_get(x_coord, y_coord, &pub) < 0)
+    {
+        return -4; // Failed to extract coordinates
+    }
+
+    // Convert BIG numbers to byte arrays
+    BIG_256_56_toBytes((char*)key_material->private_key_bytes, d);
+    BIG_256_56_toBytes((char*)key_material->public_key_x_bytes, x_coord);
+    BIG_256_56_toBytes((char*)key_material->public_key_y_bytes, y_coord);
+
+    return 0; // Success
+}
+
+int ed25519_generate_key_material(unsigned char* random_seed, int seed_len, ed25519_key_material_t* key_material)
+{
+    if (!key_material)
+    {
+        return -1; // Invalid parameter
+    }
+
+    BIG_256_56 secret_key;
+    int result = ed25519_generate_secret_key(secret_key, random_seed, seed_len);
+    if (result == 0)
+    {
+        result = ed25519_big_to_key_material(secret_key, key_material);
+    }
+
+    // Wipe the intermediate scalar
+    BIG_256_56_zero(secret_key);
+
+    return result;
+}
@@ -0,0 +1,73 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+
+#ifndef ED25519_KEY_MATERIAL_H
+#define ED25519_KEY_MATERIAL_H
+
+#include "big_256_56.h"
+#include "ecp_Ed25519.h"
+#include "core.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Structure to hold the extracted Ed25519 key material
+typedef struct
+{
+    unsigned char private_key_bytes[MODBYTES_256_56];
+    unsigned char public_key_x_bytes[MODBYTES_256_56];
+    unsigned char public_key_y_bytes[MODBYTES_256_56];
+} ed25519_key_material_t;
+
+/**
+ * @brief Compute P = d * G on Ed25519 using a precomputed fixed-base table
+ *
+ * The scalar is recoded into 64 signed radix-16 digits and each digit selects
+ * one of 8 precomputed multiples of 16^i * G in constant time, so the result
+ * costs 64 point additions and no doublings. The table is built once per process
+ * on first use.
+ *
+ * @param P Output point (projective)
+ * @param d Scalar in the range [0, curve_order-1]
+ */
+void ed25519_mul_base(ECP_Ed25519* P, BIG_256_56 d);
+
+/**
+ * @brief Generate a cryptographically secure random private key scalar for Ed25519
+ *
+ * @param secret_key Output parameter to store the generated scalar in [1, curve_order-1]
+ * @param random_seed Array of random bytes for seeding the RNG
+ * @param seed_len Length of the random seed array (at least 16, recommended: 32 bytes)
+ * @return 0 on success, non-zero on error
+ */
+int ed25519_generate_secret_key(BIG_256_56 secret_key, unsigned char* random_seed, int seed_len);
+
+/**
+ * @brief Extract key material from an Ed25519 private key scalar
+ *
+ * Computes the public point d * G with ed25519_mul_base and extracts the raw
+ * bytes of the scalar and the affine public key coordinates.
+ *
+ * @param d BIG_256_56 private key scalar
+ * @param key_material Pointer to structure to hold the extracted key material
+ * @return 0 on success, non-zero on error
+ */
+int ed25519_big_to_key_material(BIG_256_56 d, ed25519_key_material_t* key_material);
+
+/**
+ * @brief Generate a random Ed25519 key pair and extract its key material
+ *
+ * @param random_seed Array of random bytes for seeding the RNG
+ * @param seed_len Length of the random seed array (recommended: 32 bytes)
+ * @param key_material Pointer to structure to hold the generated key material
+ * @return 0 on success, non-zero on error
+ */
+int ed25519_generate_key_material(unsigned char* random_seed, int seed_len, ed25519_key_material_t* key_material);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ED25519_KEY_MATERIAL_H
@@ -0,0 +1,359 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "ed25519_operations.h"
+#include "secure_memory.h"
+#include <stdlib.h>
+#include <string.h>
+
+// External ROM constants
+extern const BIG_256_56 CURVE_Order_Ed25519;
+
+// Uniform scalar expansion length: ceil((253 + 128) / 8)
+#define ED25519_SCALAR_EXPAND_LENGTH 48
+
+// Expected length for uncompressed Ed25519 public key (0x04 + 32 bytes X + 32 bytes Y)
+#define ED25519_UNCOMPRESSED_KEY_LENGTH (2 * MODBYTES_256_56 + 1) // 65 bytes
+
+// Longest combined master key and context accepted for derivation
+#define DERIVE_KEY_MAX_INPUT 4096
+
+// SHA-512 block and digest sizes; Z_pad of expand_message_xmd is one block
+#define ED25519_SHA512_BLOCK 128
+#define ED25519_SHA512_DIGEST 64
+
+#if HASH_TYPE_Ed25519 != SHA512
+#error "ed25519_expand_scalar expects SHA-512"
+#endif
+
+static void hash512_absorb(hash512* h, const unsigned char* data, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        HASH512_process(h, data[i]);
+    }
+}
+
+// expand_message_xmd(SHA-512) of master_key || context to 48 bytes (ell = 1), without joining the inputs
+static void ed25519_expand_scalar(const unsigned char* master_key_bytes, int master_key_len, const unsigned char* context, int context_len, const unsigned char* dst, int dst_len, unsigned char* okm)
+{
+    hash512 h;
+    unsigned char b0[ED25519_SHA512_DIGEST], b1[ED25519_SHA512_DIGEST];
+
+    // b_0 = H(Z_pad || msg || I2OSP(48, 2) || I2OSP(0, 1) || DST || I2OSP(len(DST), 1))
+    HASH512_init(&h);
+    for (int i = 0; i < ED25519_SHA512_BLOCK; i++)
+    {
+        HASH512_process(&h, 0);
+    }
+    hash512_absorb(&h, master_key_bytes, master_key_len);
+    hash512_absorb(&h, context, context_len);
+    HASH512_process(&h, 0);
+    HASH512_process(&h, ED25519_SCALAR_EXPAND_LENGTH);
+    HASH512_process(&h, 0);
+    hash512_absorb(&h, dst, dst_len);
+    HASH512_process(&h, dst_len);
+    HASH512_hash(&h, (char*)b0);
+
+    // b_1 = H(b_0 || I2OSP(1, 1) || DST || I2OSP(len(DST), 1))
+    HASH512_init(&h);
+    hash512_absorb(&h, b0, sizeof(b0));
+    HASH512_process(&h, 1);
+    hash512_absorb(&h, dst, dst_len);
+    HASH512_process(&h, dst_len);
+    HASH512_hash(&h, (char*)b1);
+
+    memcpy(okm, b1, ED25519_SCALAR_EXPAND_LENGTH);
+    cvc_secure_zero(b0, sizeof(b0));
+    cvc_secure_zero(b1, sizeof(b1));
+    cvc_secure_zero(&h, sizeof(h));
+}
+
+int cvc_derive_secret_key_ed25519(const unsigned char* master_key_bytes, int master_key_len, const unsigned char* context, int context_len, const unsigned char* dst, int dst_len, ed25519_key_material_t* derived_key_material)
+{
+    // Basic parameter validation
+    if (!master_key_bytes || master_key_len <= 0 || !context || context_len <= 0 || !dst || dst_len <= 0 || !derived_key_material)
+    {
+        return CVC_DERIVE_KEY_ERROR_INVALID_PARAMS;
+    }
+
+    // Combine master key and context
+    int input_len = master_key_len + context_len;
+    if (input_len > DERIVE_KEY_MAX_INPUT) // Reasonable safety limit
+    {
+        return CVC_DERIVE_KEY_ERROR_INPUT_TOO_LARGE;
+    }
+
+    // Expand to 48 uniform bytes with SHA-512
+    char okm_buffer[ED25519_SCALAR_EXPAND_LENGTH];
+    if (dst_len <= 255)
+    {
+        ed25519_expand_scalar(master_key_bytes, master_key_len, context, context_len, dst, dst_len, (unsigned char*)okm_buffer);
+    }
+    else
+    {
+        // Long DSTs keep MIRACL's handling, which needs the joined input; keep it off the stack
+        unsigned char* input = malloc((size_t)input_len);
+        if (!input)
+        {
+            return CVC_DERIVE_KEY_ERROR_HASH_TO_FIELD_FAILED;
+        }
+        memcpy(input, master_key_bytes, master_key_len);
+        memcpy(input + master_key_len, context, context_len);
+
+        octet OKM = { 0, sizeof(okm_buffer), okm_buffer };
+        octet DST = { dst_len, dst_len, (char*)dst };
+        octet MESSAGE = { input_len, input_len, (char*)input };
+        XMD_Expand(MC_SHA2, HASH_TYPE_Ed25519, &OKM, ED25519_SCALAR_EXPAND_LENGTH, &DST, &MESSAGE);
+        cvc_secure_zero(input, input_len);
+        free(input);
+
+        if (OKM.len != ED25519_SCALAR_EXPAND_LENGTH)
+        {
+            return CVC_DERIVE_KEY_ERROR_HASH_TO_FIELD_FAILED;
+        }
+    }
+
+    // Reduce modulo the group order l
+    BIG_256_56 curve_order;
+    BIG_256_56_rcopy(curve_order, CURVE_Order_Ed25519);
+
+    DBIG_256_56 dx;
+    BIG_256_56 x;
+    BIG_256_56_dfromBytesLen(dx, okm_buffer, ED25519_SCALAR_EXPAND_LENGTH);
+    BIG_256_56_dmod(x, dx, curve_order);
+    cvc_secure_zero(okm_buffer, sizeof(okm_buffer));
+    BIG_256_56_dzero(dx);
+
+    // Check that we didn't get zero (extremely unlikely)
+    if (BIG_256_56_iszilch(x))
+    {
+        return CVC_DERIVE_KEY_ERROR_ZERO_SCALAR;
+    }
+
+    int extract_result = ed25519_big_to_key_material(x, derived_key_material);
+    BIG_256_56_zero(x);
+    if (extract_result != 0)
+    {
+        return CVC_DERIVE_KEY_ERROR_KEY_EXTRACTION_FAILED;
+    }
+
+    return CVC_DERIVE_KEY_SUCCESS;
+}
+
+int cvc_add_ed25519_secret_keys(const unsigned char* key1_bytes, int key1_len, const unsigned char* key2_bytes, int key2_len, ed25519_key_material_t* result_key_material)
+{
+    // Basic parameter validation
+    if (!key1_bytes || key1_len != MODBYTES_256_56 || !key2_bytes || key2_len != MODBYTES_256_56 || !result_key_material)
+    {
+        return CVC_ADD_SECRET_KEYS_ERROR_INVALID_PARAMS;
+    }
+
+    // Clear the output structure
+    memset(result_key_material, 0, sizeof(ed25519_key_material_t));
+
+    BIG_256_56 curve_order;
+    BIG_256_56_rcopy(curve_order, CURVE_Order_Ed25519);
+
+    BIG_256_56 d1, d2;
+    BIG_256_56_fromBytes(d1, (char*)key1_bytes);
+    BIG_256_56_fromBytes(d2, (char*)key2_bytes);
+
+    // Validate that both keys are in valid range [1, curve_order-1]
+    if (BIG_256_56_iszilch(d1) || BIG_256_56_comp(d1, curve_order) >= 0)
+    {
+        return CVC_ADD_SECRET_KEYS_ERROR_INVALID_KEY1;
+    }
+
+    if (BIG_256_56_iszilch(d2) || BIG_256_56_comp(d2, curve_order) >= 0)
+    {
+        return CVC_ADD_SECRET_KEYS_ERROR_INVALID_KEY2;
+    }
+
+    // sum = (d1 + d2) mod curve_order
+    BIG_256_56 sum;
+    BIG_256_56_add(sum, d1, d2);
+    BIG_256_56_mod(sum, curve_order);
+    BIG_256_56_zero(d1);
+    BIG_256_56_zero(d2);
+
+    if (BIG_256_56_iszilch(sum))
+    {
+        return CVC_ADD_SECRET_KEYS_ERROR_RESULT_ZERO;
+    }
+
+    int extract_result = ed25519_big_to_key_material(sum, result_key_material);
+    BIG_256_56_zero(sum);
+    if (extract_result != 0)
+    {
+        return CVC_ADD_SECRET_KEYS_ERROR_KEY_EXTRACTION_FAILED;
+    }
+
+    return CVC_ADD_SECRET_KEYS_SUCCESS;
+}
+
+// Returns 1 if l * P is the identity, i.e. P lies in the prime-order subgroup. Catches
+// pure torsion points and points with a torsion component alike; l and P are public,
+// so plain double-and-add is fine
+static int ed25519_in_prime_subgroup(ECP_Ed25519* P)
+{
+    BIG_256_56 order;
+    BIG_256_56_rcopy(order, CURVE_Order_Ed25519);
+
+    ECP_Ed25519 T;
+    ECP_Ed25519_inf(&T);
+    for (int i = BIG_256_56_nbits(order) - 1; i >= 0; i--)
+    {
+        ECP_Ed25519_dbl(&T);
+        if (BIG_256_56_bit(order, i))
+        {
+            ECP_Ed25519_add(&T, P);
+        }
+    }
+    return ECP_Ed25519_isinf(&T);
+}
+
+int cvc_add_ed25519_public_keys(const unsigned char* key1_bytes, int key1_len, const unsigned char* key2_bytes, int key2_len, unsigned char* result_bytes, int result_buffer_size, int* actual_result_len)
+{
+    // Validate input key lengths
+    if (!key1_bytes || key1_len != ED25519_UNCOMPRESSED_KEY_LENGTH)
+    {
+        return CVC_ECP_ERROR_INVALID_KEY1_LENGTH;
+    }
+
+    if (!key2_bytes || key2_len != ED25519_UNCOMPRESSED_KEY_LENGTH)
+    {
+        return CVC_ECP_ERROR_INVALID_KEY2_LENGTH;
+    }
+
+    if (!result_bytes || !actual_result_len || result_buffer_size < ED25519_UNCOMPRESSED_KEY_LENGTH)
+    {
+        return CVC_ECP_ERROR_INSUFFICIENT_BUFFER;
+    }
+
+    octet key1_octet = { key1_len, key1_len, (char*)key1_bytes };
+    octet key2_octet = { key2_len, key2_len, (char*)key2_bytes };
+
+    // Parse and validate the first key
+    ECP_Ed25519 point1;
+    if (!ECP_Ed25519_fromOctet(&point1, &key1_octet))
+    {
+        return CVC_ECP_ERROR_INVALID_POINT_1;
+    }
+
+    if (ECP_Ed25519_isinf(&point1))
+    {
+        return CVC_ECP_ERROR_POINT_1_AT_INFINITY;
+    }
+
+    if (!ed25519_in_prime_subgroup(&point1))
+    {
+        return CVC_ECP_ERROR_SMALL_ORDER_POINT_1;
+    }
+
+    // Parse and validate the second key
+    ECP_Ed25519 point2;
+    if (!ECP_Ed25519_fromOctet(&point2, &key2_octet))
+    {
+        return CVC_ECP_ERROR_INVALID_POINT_2;
+    }
+
+    if (ECP_Ed25519_isinf(&point2))
+    {
+        return CVC_ECP_ERROR_POINT_2_AT_INFINITY;
+    }
+
+    if (!ed25519_in_prime_subgroup(&point2))
+    {
+        return CVC_ECP_ERROR_SMALL_ORDER_POINT_2;
+    }
+
+    // Complete twisted Edwards addition, no special cases needed
+    ECP_Ed25519_add(&point1, &point2);
+
+    if (ECP_Ed25519_isinf(&point1))
+    {
+        return CVC_ECP_ERROR_RESULT_AT_INFINITY;
+    }
+
+    octet result_octet = { 0, result_buffer_size, (char*)result_bytes };
+    ECP_Ed25519_toOctet(&result_octet, &point1, false); // false = uncompressed
+
+    if (result_octet.len != ED25519_UNCOMPRESSED_KEY_LENGTH)
+    {
+        return CVC_ECP_ERROR_RESULT_CONVERSION_FAILED;
+    }
+
+    *actual_result_len = result_octet.len;
+
+    return CVC_ECP_SUCCESS;
+}
+
+// y little-endian with the sign of x in bit 255; y < p < 2^255 leaves that bit free
+static void ed25519_encode_rfc8032(const unsigned char* x_bytes, const unsigned char* y_bytes, unsigned char* output)
+{
+    for (int i = 0; i < MODBYTES_256_56; i++)
+    {
+        output[i] = y_bytes[MODBYTES_256_56 - 1 - i];
+    }
+    output[MODBYTES_256_56 - 1] |= (unsigned char)((x_bytes[MODBYTES_256_56 - 1] & 1) << 7);
+}
+
+int cvc_ed25519_public_key_to_rfc8032(const unsigned char* public_key, int public_key_len, unsigned char* rfc8032_key, int rfc8032_key_size)
+{
+    // Basic parameter validation
+    if (!public_key || public_key_len != ED25519_UNCOMPRESSED_KEY_LENGTH)
+    {
+        return CVC_ECP_ERROR_INVALID_KEY1_LENGTH;
+    }
+
+    if (!rfc8032_key || rfc8032_key_size < CVC_ED25519_RFC8032_PUBLIC_KEY_LENGTH)
+    {
+        return CVC_ECP_ERROR_INSUFFICIENT_BUFFER;
+    }
+
+    octet key_octet = { public_key_len, public_key_len, (char*)public_key };
+    ECP_Ed25519 point;
+    if (!ECP_Ed25519_fromOctet(&point, &key_octet))
+    {
+        return CVC_ECP_ERROR_INVALID_POINT_1;
+    }
+
+    if (ECP_Ed25519_isinf(&point))
+    {
+        return CVC_ECP_ERROR_POINT_1_AT_INFINITY;
+    }
+
+    if (!ed25519_in_prime_subgroup(&point))
+    {
+        return CVC_ECP_ERROR_SMALL_ORDER_POINT_1;
+    }
+
+    ed25519_encode_rfc8032(public_key + 1, public_key + 1 + MODBYTES_256_56, rfc8032_key);
+    return CVC_ECP_SUCCESS;
+}
+
+int cvc_ed25519_key_material_to_rfc8032(const ed25519_key_material_t* key_material, unsigned char* rfc8032_key, int rfc8032_key_size, unsigned char* scalar, int scalar_size)
+{
+    // Basic parameter validation
+    if (!key_material)
+    {
+        return CVC_ECP_ERROR_INVALID_PARAMS;
+    }
+
+    if (!rfc8032_key || rfc8032_key_size < CVC_ED25519_RFC8032_PUBLIC_KEY_LENGTH || (scalar && scalar_size < CVC_ED25519_RFC8032_SCALAR_LENGTH))
+    {
+        return CVC_ECP_ERROR_INSUFFICIENT_BUFFER;
+    }
+
+    ed25519_encode_rfc8032(key_material->public_key_x_bytes, key_material->public_key_y_bytes, rfc8032_key);
+    if (scalar)
+    {
+        for (int i = 0; i < MODBYTES_256_56; i++)
+        {
+            scalar[i] = key_material->private_key_bytes[MODBYTES_256_56 - 1 - i];
+        }
+    }
+
+    return CVC_ECP_SUCCESS;
+}
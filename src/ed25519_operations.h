@@ -0,0 +1,122 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+
+#ifndef ED25519_OPERATIONS_H
+#define ED25519_OPERATIONS_H
+
+#include "ed25519_key_material.h"
+#include "add_secret_keys.h"
+#include "ecp_operations.h"
+#include "hash_to_field.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Lengths of an RFC 8032 public key and of a little-endian secret scalar
+#define CVC_ED25519_RFC8032_PUBLIC_KEY_LENGTH 32
+#define CVC_ED25519_RFC8032_SCALAR_LENGTH 32
+
+/*
+ * Key encoding: these functions use the conventions of the NIST P-256 API, not
+ * RFC 8032. Secret keys are raw 32-byte big-endian scalars in [1, l-1] and public
+ * keys are 65-byte 0x04 || X || Y. A derived or summed scalar has no RFC 8032 seed,
+ * so the secret keys cannot be passed to eddsa_Ed25519 or to any signer that
+ * expects a seed. cvc_ed25519_public_key_to_rfc8032 gives the standard 32-byte
+ * public key, which any Ed25519 verifier accepts. The signer must then take the
+ * secret scalar directly (an "expanded" secret key); cvc_ed25519_key_material_to_rfc8032
+ * also returns that scalar in little-endian form.
+ */
+
+/**
+ * @brief Derive an Ed25519 secret key from master key material and context
+ *
+ * Ed25519 counterpart of cvc_derive_secret_key_nist256. The concatenation
+ * master_key || context is expanded with expand_message_xmd (SHA-512) to 48 bytes
+ * and reduced modulo the group order l, which gives a scalar with negligible bias
+ * (RFC 9380 hash_to_field with k = 128). The public key is computed with the
+ * fixed-base table.
+ *
+ * @param master_key_bytes Master key material
+ * @param master_key_len Length of master key material
+ * @param context Context for derivation
+ * @param context_len Length of context
+ * @param dst Domain Separation Tag
+ * @param dst_len Length of DST
+ * @param derived_key_material Output structure to store the derived key material
+ * @return CVC_DERIVE_KEY_SUCCESS on success, or a negative cvc_derive_key_result_t on failure
+ */
+int cvc_derive_secret_key_ed25519(const unsigned char* master_key_bytes, int master_key_len, const unsigned char* context, int context_len, const unsigned char* dst, int dst_len, ed25519_key_material_t* derived_key_material);
+
+/**
+ * @brief Add two Ed25519 private key scalars modulo the group order
+ *
+ * Both keys must be 32-byte big-endian scalars in the range [1, l-1].
+ *
+ * @param key1_bytes First private key
+ * @param key1_len Length of first key bytes (must be 32)
+ * @param key2_bytes Second private key
+ * @param key2_len Length of second key bytes (must be 32)
+ * @param result_key_material Output structure to store the complete key material
+ * @return CVC_ADD_SECRET_KEYS_SUCCESS on success, or a negative cvc_add_secret_keys_result_t on failure
+ */
+int cvc_add_ed25519_secret_keys(const unsigned char* key1_bytes, int key1_len, const unsigned char* key2_bytes, int key2_len, ed25519_key_material_t* result_key_material);
+
+/**
+ * @brief Add two Ed25519 public keys
+ *
+ * Keys use the same 65-byte uncompressed encoding as the NIST P-256 API
+ * (0x04 || X || Y, big-endian affine coordinates). Both keys must lie in the
+ * prime-order subgroup, checked as l * P == identity: the identity is rejected
+ * with CVC_ECP_ERROR_POINT_n_AT_INFINITY, and small-order points as well as
+ * points with a small-order component with CVC_ECP_ERROR_SMALL_ORDER_POINT_n.
+ * The check costs about one scalar multiplication per key.
+ *
+ * @param key1_bytes First public key
+ * @param key1_len Length of first key (must be 65)
+ * @param key2_bytes Second public key
+ * @param key2_len Length of second key (must be 65)
+ * @param result_bytes Buffer to store the resulting public key
+ * @param result_buffer_size Size of the result buffer (must be at least 65)
+ * @param actual_result_len Output parameter for the actual result length
+ * @return CVC_ECP_SUCCESS on success, or a negative cvc_ecp_result_t on failure
+ */
+int cvc_add_ed25519_public_keys(const unsigned char* key1_bytes, int key1_len, const unsigned char* key2_bytes, int key2_len, unsigned char* result_bytes, int result_buffer_size, int* actual_result_len);
+
+/**
+ * @brief Convert a 65-byte uncompressed Ed25519 public key to the RFC 8032 encoding
+ *
+ * The result is the 32-byte little-endian y coordinate with the low bit of x in
+ * the top bit (RFC 8032, section 5.1.2). The key is validated as in
+ * cvc_add_ed25519_public_keys.
+ *
+ * @param public_key Public key (0x04 || X || Y)
+ * @param public_key_len Length of the public key (must be 65)
+ * @param rfc8032_key Output buffer receiving the 32-byte encoded point
+ * @param rfc8032_key_size Size of the output buffer
+ * @return CVC_ECP_SUCCESS on success, or a negative cvc_ecp_result_t on failure
+ */
+int cvc_ed25519_public_key_to_rfc8032(const unsigned char* public_key, int public_key_len, unsigned char* rfc8032_key, int rfc8032_key_size);
+
+/**
+ * @brief Encode Ed25519 key material in RFC 8032 byte order
+ *
+ * The public key is encoded as in cvc_ed25519_public_key_to_rfc8032. The scalar
+ * is the private key in 32-byte little-endian form: the "s" of an RFC 8032
+ * expanded secret key, already reduced mod l. It is not a seed.
+ *
+ * @param key_material Key material from this API
+ * @param rfc8032_key Output buffer receiving the 32-byte encoded public key
+ * @param rfc8032_key_size Size of the public key buffer
+ * @param scalar Output buffer receiving the 32-byte little-endian scalar (may be NULL)
+ * @param scalar_size Size of the scalar buffer
+ * @return CVC_ECP_SUCCESS on success, or a negative cvc_ecp_result_t on failure
+ */
+int cvc_ed25519_key_material_to_rfc8032(const ed25519_key_material_t* key_material, unsigned char* rfc8032_key, int rfc8032_key_size, unsigned char* scalar, int scalar_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ED25519_OPERATIONS_H
@@ -0,0 +1,191 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "hash_to_curve.h"
+#include "hash_to_field.h"
+#include "nist256_point_utils.h"
+#include "sha256.h"
+#include "stack_budget.h"
+#include "core.h"
+#include <pthread.h>
+
+// External ROM constants
+extern const BIG_256_56 CURVE_B_NIST256;
+extern const BIG_256_56 Modulus_NIST256;
+
+// Simplified SWU constants for P-256 (RFC 9380, Section 8.2 and Appendix F.2)
+static FP_NIST256 sswu_a;  // A = -3
+static FP_NIST256 sswu_b;  // B
+static FP_NIST256 sswu_z;  // Z = -10
+static FP_NIST256 sswu_c2; // sqrt(-Z)
+static BIG_256_56 sswu_c1; // (p - 3) / 4
+static pthread_once_t sswu_once = PTHREAD_ONCE_INIT;
+
+static void init_sswu_constants(void)
+{
+    FP_NIST256_from_int(&sswu_a, CURVE_A_NIST256);
+    FP_NIST256_rcopy(&sswu_b, CURVE_B_NIST256);
+    FP_NIST256_from_int(&sswu_z, -10);
+
+    // c1 = (p - 3) / 4
+    BIG_256_56_rcopy(sswu_c1, Modulus_NIST256);
+    BIG_256_56_dec(sswu_c1, 3);
+    BIG_256_56_norm(sswu_c1);
+    BIG_256_56_shr(sswu_c1, 2);
+
+    // c2 = sqrt(10) = 10^((p + 1) / 4)
+    BIG_256_56 exponent;
+    BIG_256_56_copy(exponent, sswu_c1);
+    BIG_256_56_inc(exponent, 1);
+    BIG_256_56_norm(exponent);
+
+    FP_NIST256 ten;
+    FP_NIST256_from_int(&ten, 10);
+    FP_NIST256_pow(&sswu_c2, &ten, exponent);
+}
+
+// sqrt_ratio for p = 3 mod 4 (RFC 9380, Appendix F.2.1.2); returns 1 if u / v is square
+static int sqrt_ratio_3mod4(FP_NIST256* y, FP_NIST256* u, FP_NIST256* v)
+{
+    FP_NIST256 tv1, tv2, tv3, y1, y2;
+
+    FP_NIST256_sqr(&tv1, v);               // 1. tv1 = v^2
+    FP_NIST256_mul(&tv2, u, v);            // 2. tv2 = u * v
+    FP_NIST256_mul(&tv1, &tv1, &tv2);      // 3. tv1 = tv1 * tv2
+    FP_NIST256_pow(&y1, &tv1, sswu_c1);    // 4. y1 = tv1^c1
+    FP_NIST256_mul(&y1, &y1, &tv2);        // 5. y1 = y1 * tv2
+    FP_NIST256_mul(&y2, &y1, &sswu_c2);    // 6. y2 = y1 * c2
+    FP_NIST256_sqr(&tv3, &y1);             // 7. tv3 = y1^2
+    FP_NIST256_mul(&tv3, &tv3, v);         // 8. tv3 = tv3 * v
+    FP_NIST256_sub(&tv3, &tv3, u);         // 9. isQR = tv3 == u
+    const int is_qr = FP_NIST256_iszilch(&tv3);
+
+    FP_NIST256_copy(y, &y2);               // 10. y = CMOV(y2, y1, isQR)
+    FP_NIST256_cmove(y, &y1, is_qr);
+    return is_qr;
+}
+
+void cvc_map_to_curve_nist256(ECP_NIST256* point, FP_NIST256* u)
+{
+    pthread_once(&sswu_once, init_sswu_constants);
+
+    FP_NIST256 tv1, tv2, tv3, tv4, tv5, tv6, x, y, y1, one;
+    FP_NIST256_one(&one);
+
+    FP_NIST256_sqr(&tv1, u);                                  // 1. tv1 = u^2
+    FP_NIST256_mul(&tv1, &sswu_z, &tv1);                      // 2. tv1 = Z * tv1
+    FP_NIST256_sqr(&tv2, &tv1);                               // 3. tv2 = tv1^2
+    FP_NIST256_add(&tv2, &tv2, &tv1);                         // 4. tv2 = tv2 + tv1
+    FP_NIST256_add(&tv3, &tv2, &one);                         // 5. tv3 = tv2 + 1
+    FP_NIST256_mul(&tv3, &sswu_b, &tv3);                      // 6. tv3 = B * tv3
+    FP_NIST256_neg(&tv4, &tv2);                               // 7. tv4 = CMOV(Z, -tv2, tv2 != 0)
+    FP_NIST256_cmove(&tv4, &sswu_z, FP_NIST256_iszilch(&tv2));
+    FP_NIST256_mul(&tv4, &sswu_a, &tv4);                      // 8. tv4 = A * tv4
+    FP_NIST256_sqr(&tv2, &tv3);                               // 9. tv2 = tv3^2
+    FP_NIST256_sqr(&tv6, &tv4);                               // 10. tv6 = tv4^2
+    FP_NIST256_mul(&tv5, &sswu_a, &tv6);                      // 11. tv5 = A * tv6
+    FP_NIST256_add(&tv2, &tv2, &tv5);                         // 12. tv2 = tv2 + tv5
+    FP_NIST256_mul(&tv2, &tv2, &tv3);                         // 13. tv2 = tv2 * tv3
+    FP_NIST256_mul(&tv6, &tv6, &tv4);                         // 14. tv6 = tv6 * tv4
+    FP_NIST256_mul(&tv5, &sswu_b, &tv6);                      // 15. tv5 = B * tv6
+    FP_NIST256_add(&tv2, &tv2, &tv5);                         // 16. tv2 = tv2 + tv5
+    FP_NIST256_mul(&x, &tv1, &tv3);                           // 17. x = tv1 * tv3
+    // 18. (is_gx1_square, y1) = sqrt_ratio(tv2, tv6)
+    const int is_gx1_square = sqrt_ratio_3mod4(&y1, &tv2, &tv6);
+    FP_NIST256_mul(&y, &tv1, u);                              // 19. y = tv1 * u
+    FP_NIST256_mul(&y, &y, &y1);                              // 20. y = y * y1
+    FP_NIST256_cmove(&x, &tv3, is_gx1_square);                // 21. x = CMOV(x, tv3, is_gx1_square)
+    FP_NIST256_cmove(&y, &y1, is_gx1_square);                 // 22. y = CMOV(y, y1, is_gx1_square)
+
+    // 23-24. Fix the sign of y so that sgn0(u) == sgn0(y)
+    FP_NIST256 minus_y;
+    FP_NIST256_neg(&minus_y, &y);
+    FP_NIST256_cmove(&y, &minus_y, FP_NIST256_sign(u) ^ FP_NIST256_sign(&y));
+
+    // 25. x = x / tv4, kept projective: (x : y * tv4 : tv4)
+    FP_NIST256_copy(&point->x, &x);
+    FP_NIST256_mul(&point->y, &y, &tv4);
+    FP_NIST256_copy(&point->z, &tv4);
+    FP_NIST256_reduce(&point->x);
+    FP_NIST256_reduce(&point->y);
+    FP_NIST256_reduce(&point->z);
+}
+
+// hash_to_curve without the final affine conversion
+static int hash_to_curve_projective(const unsigned char* dst, int dst_len, const unsigned char* message, int message_len, ECP_NIST256* point)
+{
+    FP_NIST256 u[2];
+    if (cvc_hash_to_field_nist256(MC_SHA2, HASH_TYPE_NIST256, dst, dst_len, message, message_len, 2, u) != CVC_HASH_TO_FIELD_SUCCESS)
+    {
+        return CVC_HASH_TO_CURVE_ERROR_HASH_TO_FIELD_FAILED;
+    }
+
+    ECP_NIST256 q1;
+    cvc_map_to_curve_nist256(point, &u[0]);
+    cvc_map_to_curve_nist256(&q1, &u[1]);
+
+    // Complete addition; the P-256 cofactor is 1 so clear_cofactor is a no-op
+    ECP_NIST256_add(point, &q1);
+
+    return CVC_HASH_TO_CURVE_SUCCESS;
+}
+
+int cvc_hash_to_curve_nist256(const unsigned char* dst, int dst_len, const unsigned char* message, int message_len, ECP_NIST256* point)
+{
+    // Basic parameter validation
+    if (!dst || dst_len <= 0 || !message || message_len <= 0 || !point)
+    {
+        return CVC_HASH_TO_CURVE_ERROR_INVALID_PARAMS;
+    }
+
+    int result = hash_to_curve_projective(dst, dst_len, message, message_len, point);
+    if (result != CVC_HASH_TO_CURVE_SUCCESS)
+    {
+        return result;
+    }
+
+    ECP_NIST256_affine(point);
+
+    return CVC_HASH_TO_CURVE_SUCCESS;
+}
+
+int cvc_hash_to_curve_nist256_batch(const unsigned char* dst, int dst_len, const unsigned char* const* messages, const int* message_lens, int count, ECP_NIST256* points)
+{
+    // Basic parameter validation
+    if (!dst || dst_len <= 0 || !messages || !message_lens || count <= 0 || !points)
+    {
+        return CVC_HASH_TO_CURVE_ERROR_INVALID_PARAMS;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (!messages[i] || message_lens[i] <= 0)
+        {
+            return CVC_HASH_TO_CURVE_ERROR_INVALID_PARAMS;
+        }
+    }
+
+    // Field elements for a chunk of messages come out of one lockstep XMD pass
+    FP_NIST256 u[CVC_BATCH_LANES * 2];
+    for (int start = 0; start < count; start += CVC_BATCH_LANES)
+    {
+        const int chunk = count - start < CVC_BATCH_LANES ? count - start : CVC_BATCH_LANES;
+        if (cvc_hash_to_field_nist256_batch(MC_SHA2, HASH_TYPE_NIST256, dst, dst_len, messages + start, message_lens + start, chunk, 2, u) != CVC_HASH_TO_FIELD_SUCCESS)
+        {
+            return CVC_HASH_TO_CURVE_ERROR_HASH_TO_FIELD_FAILED;
+        }
+
+        for (int i = 0; i < chunk; i++)
+        {
+            ECP_NIST256 q1;
+            cvc_map_to_curve_nist256(&points[start + i], &u[2 * i]);
+            cvc_map_to_curve_nist256(&q1, &u[2 * i + 1]);
+            ECP_NIST256_add(&points[start + i], &q1);
+        }
+    }
+
+    // One inversion per chunk instead of one per message
+    nist256_batch_normalize(points, count);
+
+    return CVC_HASH_TO_CURVE_SUCCESS;
+}
@@ -0,0 +1,73 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef HASH_TO_CURVE_H
+#define HASH_TO_CURVE_H
+
+#include "ecp_NIST256.h"
+#include "fp_NIST256.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Result codes for hash-to-curve operations
+ */
+typedef enum
+{
+    CVC_HASH_TO_CURVE_SUCCESS = 0,                    /**< Operation completed successfully */
+    CVC_HASH_TO_CURVE_ERROR_INVALID_PARAMS = -1,      /**< Invalid input parameters */
+    CVC_HASH_TO_CURVE_ERROR_HASH_TO_FIELD_FAILED = -2 /**< Hash-to-field operation failed */
+} cvc_hash_to_curve_result_t;
+
+/**
+ * @brief Map a field element to a NIST P-256 point with the simplified SWU map
+ *
+ * Constant-time implementation of map_to_curve_simple_swu (RFC 9380, Appendix F.2)
+ * with Z = -10. P-256 needs no isogeny. The point is returned in projective form
+ * (X = xn, Y = y * xd, Z = xd) so no inversion is spent here.
+ *
+ * @param point Output point (projective)
+ * @param u Field element to map
+ */
+void cvc_map_to_curve_nist256(ECP_NIST256* point, FP_NIST256* u);
+
+/**
+ * @brief Hash a message to a NIST P-256 point (P256_XMD:SHA-256_SSWU_RO_)
+ *
+ * Implements hash_to_curve from RFC 9380 Section 3: two field elements from
+ * cvc_hash_to_field_nist256, two simplified SWU maps, one point addition. The
+ * P-256 cofactor is 1, so cofactor clearing is the identity. The result is affine.
+ *
+ * @param dst Domain Separation Tag
+ * @param dst_len Length of DST
+ * @param message Input message
+ * @param message_len Length of message
+ * @param point Output point (affine, Z = 1)
+ * @return CVC_HASH_TO_CURVE_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_hash_to_curve_nist256(const unsigned char* dst, int dst_len, const unsigned char* message, int message_len, ECP_NIST256* point);
+
+/**
+ * @brief Hash many messages to NIST P-256 points with shared inversions
+ *
+ * Produces the same points as cvc_hash_to_curve_nist256 for every message. The
+ * maps stay projective and all final affine conversions share a single field
+ * inversion per 64 messages, which removes the dominant per-message inversion cost.
+ *
+ * @param dst Domain Separation Tag shared by all messages
+ * @param dst_len Length of DST
+ * @param messages Array of message pointers
+ * @param message_lens Array of message lengths
+ * @param count Number of messages
+ * @param points Output array of count points (affine, Z = 1)
+ * @return CVC_HASH_TO_CURVE_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_hash_to_curve_nist256_batch(const unsigned char* dst, int dst_len, const unsigned char* const* messages, const int* message_lens, int count, ECP_NIST256* points);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HASH_TO_CURVE_H
@@ -5,20 +5,217 @@
 #include "fp_NIST256.h"
 #include "big_256_56.h"
 #include "core.h"
+#include <stdlib.h>
 #include <string.h>
 
 #include "nist256_key_material.h"
+#include "sha256.h"
+#include "secure_memory.h"
+#include "stack_budget.h"
 
 // External ROM constants
 extern const BIG_256_56 CURVE_Order_NIST256;
 extern const BIG_256_56 Modulus_NIST256;
 
+// Largest XMD expansion a single call will produce
+#define HASH_TO_FIELD_MAX_EXPANSION 2048
+
+// Per-message OKM capacity of the lockstep batch path; low-stack builds only batch the two elements of hash_to_curve
+#ifdef CVC_LOW_STACK
+#define HASH_TO_FIELD_BATCH_OKM_LEN 96
+#else
+#define HASH_TO_FIELD_BATCH_OKM_LEN 512
+#endif
+
+// Longest combined master key and context accepted for derivation
+#define DERIVE_KEY_MAX_INPUT 4096
+
+// L = ceil((ceil(log2(p)) + k) / 8) for P-256 with k = 128 (RFC 9380, Section 8.2)
+#define NIST256_SHA256_L 48
+
+// The limb packing in nist256_words_to_big assumes MIRACL's 64-bit build of BIG_256_56
+#if BASEBITS_256_56 != 56 || NLEN_256_56 != 5
+#error "nist256_words_to_big expects 5 limbs of 56 bits"
+#endif
+
+// P-256 prime p = 2^256 - 2^224 + 2^192 + 2^96 - 1 as little-endian 32-bit words
+static const uint32_t nist256_p_words[8] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xFFFFFFFF };
+
 // Helper function to calculate ceiling division
 static int ceil_divide(const int a, const int b)
 {
     return (a + b - 1) / b;
 }
 
+// Helper function to reduce consecutive L-byte OKM chunks into field elements
+static int okm_to_field_elements(const unsigned char* okm, const int L, const int count, BIG_256_56 field_modulus, FP_NIST256* field_elements)
+{
+    for (int i = 0; i < count; i++)
+    {
+        // Extract L bytes for this field element
+        char fd[2 * MODBYTES_256_56]; // A DBIG holds at most this many bytes
+        if (L > (int)sizeof(fd))
+        {
+            return CVC_HASH_TO_FIELD_ERROR_EXPANSION_TOO_LARGE;
+        }
+
+        for (int j = 0; j < L; j++)
+        {
+            fd[j] = (char)okm[i * L + j];
+        }
+
+        // Convert bytes to DBIG
+        DBIG_256_56 dx;
+        BIG_256_56_dfromBytesLen(dx, fd, L);
+
+        // Reduce modulo field modulus
+        BIG_256_56 w;
+        BIG_256_56_dmod(w, dx, field_modulus);
+
+        // Convert to field element (Montgomery form)
+        FP_NIST256_nres(&field_elements[i], w);
+    }
+
+    return CVC_HASH_TO_FIELD_SUCCESS;
+}
+
+// Reduce a 48-byte big-endian integer modulo p with the NIST special-form identity (FIPS 186-4, D.2.3)
+static void nist256_reduce_384(const unsigned char* bytes, uint32_t r[8])
+{
+    // c[0] is the least significant 32-bit word; c[8..11] hold the part above 2^256
+    int64_t c[12];
+    for (int i = 0; i < 12; i++)
+    {
+        const unsigned char* p = bytes + 4 * (11 - i);
+        c[i] = (int64_t)(((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3]);
+    }
+
+    // s1 + 2*s2 + s4 + s5 - s6 - s7 - s8 - s9 with c12..c15 = 0
+    int64_t w[8];
+    w[0] = c[0] + c[8] + c[9] - c[11];
+    w[1] = c[1] + c[9] + c[10];
+    w[2] = c[2] + c[10] + c[11];
+    w[3] = c[3] + 2 * c[11] - c[8] - c[9];
+    w[4] = c[4] - c[9] - c[10];
+    w[5] = c[5] - c[10] - c[11];
+    w[6] = c[6] - c[8] - c[9];
+    w[7] = c[7] + c[8] - c[10] - c[11];
+
+    int64_t carry = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        carry += w[i];
+        r[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+
+    // Fold the signed carry back in with 2^256 = 2^224 - 2^192 - 2^96 + 1 (mod p); two folds always reach [0, 2^256)
+    for (int fold = 0; fold < 2; fold++)
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            w[i] = r[i];
+        }
+        w[0] += carry;
+        w[3] -= carry;
+        w[6] -= carry;
+        w[7] += carry;
+
+        carry = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            carry += w[i];
+            r[i] = (uint32_t)carry;
+            carry >>= 32;
+        }
+    }
+
+    // r < 2^256 < 2p, so one constant-time conditional subtraction finishes the reduction
+    uint32_t difference[8];
+    int64_t borrow = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        borrow += (int64_t)r[i] - nist256_p_words[i];
+        difference[i] = (uint32_t)borrow;
+        borrow >>= 32;
+    }
+
+    const uint32_t keep_r = (uint32_t)0 - (uint32_t)(borrow != 0);
+    for (int i = 0; i < 8; i++)
+    {
+        r[i] = (r[i] & keep_r) | (difference[i] & ~keep_r);
+    }
+}
+
+// Pack eight 32-bit words into BIG_256_56 limbs without a byte round trip
+static void nist256_words_to_big(const uint32_t r[8], BIG_256_56 out)
+{
+    const uint64_t q0 = (uint64_t)r[0] | ((uint64_t)r[1] << 32);
+    const uint64_t q1 = (uint64_t)r[2] | ((uint64_t)r[3] << 32);
+    const uint64_t q2 = (uint64_t)r[4] | ((uint64_t)r[5] << 32);
+    const uint64_t q3 = (uint64_t)r[6] | ((uint64_t)r[7] << 32);
+
+    out[0] = (chunk)(q0 & BMASK_256_56);
+    out[1] = (chunk)(((q0 >> 56) | (q1 << 8)) & BMASK_256_56);
+    out[2] = (chunk)(((q1 >> 48) | (q2 << 16)) & BMASK_256_56);
+    out[3] = (chunk)(((q2 >> 40) | (q3 << 24)) & BMASK_256_56);
+    out[4] = (chunk)(q3 >> 32);
+}
+
+// Turn count consecutive 48-byte OKM chunks into Montgomery-form field elements
+static void nist256_sha256_okm_to_field_elements(const unsigned char* okm, const int count, FP_NIST256* field_elements)
+{
+    for (int i = 0; i < count; i++)
+    {
+        uint32_t r[8];
+        BIG_256_56 w;
+        nist256_reduce_384(okm + i * NIST256_SHA256_L, r);
+        nist256_words_to_big(r, w);
+        FP_NIST256_nres(&field_elements[i], w);
+    }
+}
+
+// Stream hash_to_field over prefix || message, reducing each 48-byte chunk as it is produced
+static int nist256_sha256_hash_to_field(const unsigned char* dst, const int dst_len, const unsigned char* prefix, const int prefix_len, const unsigned char* message, const int message_len, const int count,
+    FP_NIST256* field_elements)
+{
+    // Same limit as the buffered generic path, so both accept the same counts
+    const int total_expansion_len = NIST256_SHA256_L * count;
+    if (total_expansion_len > HASH_TO_FIELD_MAX_EXPANSION)
+    {
+        return CVC_HASH_TO_FIELD_ERROR_EXPANSION_TOO_LARGE;
+    }
+
+    cvc_xmd_sha256_ctx xmd;
+    if (cvc_xmd_sha256_init(&xmd, dst, dst_len, prefix, prefix_len, message, message_len, total_expansion_len) != CVC_SHA256_SUCCESS)
+    {
+        return CVC_HASH_TO_FIELD_ERROR_EXPAND_FAILED;
+    }
+
+    unsigned char okm[NIST256_SHA256_L];
+    for (int i = 0; i < count; i++)
+    {
+        cvc_xmd_sha256_read(&xmd, okm, NIST256_SHA256_L);
+        nist256_sha256_okm_to_field_elements(okm, 1, &field_elements[i]);
+    }
+
+    cvc_secure_zero(okm, sizeof(okm));
+    cvc_xmd_sha256_clear(&xmd);
+
+    return CVC_HASH_TO_FIELD_SUCCESS;
+}
+
+int cvc_hash_to_field_nist256_sha256(const unsigned char* dst, const int dst_len, const unsigned char* message, const int message_len, const int count, FP_NIST256* field_elements)
+{
+    // Basic parameter validation
+    if (!dst || dst_len <= 0 || dst_len > 255 || !message || message_len <= 0 || count <= 0 || !field_elements)
+    {
+        return CVC_HASH_TO_FIELD_ERROR_INVALID_PARAMS;
+    }
+
+    return nist256_sha256_hash_to_field(dst, dst_len, NULL, 0, message, message_len, count, field_elements);
+}
+
 int cvc_hash_to_field_nist256(const int hash, const int hash_len, const unsigned char* dst, const int dst_len, const unsigned char* message, const int message_len, const int count, FP_NIST256* field_elements)
 {
     // Basic parameter validationw
@@ -27,6 +224,12 @@ int cvc_hash_to_field_nist256(const int hash, const int hash_len, const unsigned
         return CVC_HASH_TO_FIELD_ERROR_INVALID_PARAMS;
     }
 
+    // P-256 with SHA-256 has fixed parameters and a specialized reduction
+    if (hash == MC_SHA2 && hash_len == SHA256 && dst_len <= 255)
+    {
+        return cvc_hash_to_field_nist256_sha256(dst, dst_len, message, message_len, count, field_elements);
+    }
+
     // Get field modulus from ROM
     BIG_256_56 field_modulus;
     BIG_256_56_rcopy(field_modulus, Modulus_NIST256);
@@ -42,13 +245,21 @@ int cvc_hash_to_field_nist256(const int hash, const int hash_len, const unsigned
 
     // Allocate buffer for XMD expansion
     int total_expansion_len = L * count;
-    if (total_expansion_len > 2048) // Reasonable safety limit
+    if (total_expansion_len > HASH_TO_FIELD_MAX_EXPANSION) // Reasonable safety limit
     {
         return CVC_HASH_TO_FIELD_ERROR_EXPANSION_TOO_LARGE;
     }
 
-    char okm_buffer[2048];
-    octet OKM = { 0, sizeof(okm_buffer), okm_buffer };
+#ifdef CVC_LOW_STACK
+    char* okm_buffer = malloc(HASH_TO_FIELD_MAX_EXPANSION);
+    if (!okm_buffer)
+    {
+        return CVC_HASH_TO_FIELD_ERROR_EXPAND_FAILED;
+    }
+#else
+    char okm_buffer[HASH_TO_FIELD_MAX_EXPANSION];
+#endif
+    octet OKM = { 0, HASH_TO_FIELD_MAX_EXPANSION, okm_buffer };
 
     // Create octets for DST and message
     octet DST = { dst_len, dst_len, (char*)dst };
@@ -57,64 +268,109 @@ int cvc_hash_to_field_nist256(const int hash, const int hash_len, const unsigned
     // Perform XMD expansion
     XMD_Expand(hash, hash_len, &OKM, total_expansion_len, &DST, &MESSAGE);
 
-    // Check if expansion succeeded (basic validation)
-    if (OKM.len != total_expansion_len)
+    // Check if expansion succeeded (basic validation), then process each field element
+    int result = CVC_HASH_TO_FIELD_ERROR_EXPAND_FAILED;
+    if (OKM.len == total_expansion_len)
     {
-        return CVC_HASH_TO_FIELD_ERROR_EXPAND_FAILED;
+        result = okm_to_field_elements((const unsigned char*)OKM.val, L, count, field_modulus, field_elements);
     }
 
-    // Process each field element
-    for (int i = 0; i < count; i++)
+#ifdef CVC_LOW_STACK
+    free(okm_buffer);
+#endif
+
+    return result;
+}
+
+int cvc_hash_to_field_nist256_batch(const int hash, const int hash_len, const unsigned char* dst, const int dst_len, const unsigned char* const* messages, const int* message_lens, const int message_count, const int count, FP_NIST256* field_elements)
+{
+    // Basic parameter validation
+    if (!dst || dst_len <= 0 || !messages || !message_lens || message_count <= 0 || count <= 0 || !field_elements)
     {
-        // Extract L bytes for this field element
-        char fd[256]; // Should be sufficient for any reasonable L
-        if (L > sizeof(fd))
+        return CVC_HASH_TO_FIELD_ERROR_INVALID_PARAMS;
+    }
+
+    for (int i = 0; i < message_count; i++)
+    {
+        if (!messages[i] || message_lens[i] <= 0)
         {
-            return CVC_HASH_TO_FIELD_ERROR_EXPANSION_TOO_LARGE;
+            return CVC_HASH_TO_FIELD_ERROR_INVALID_PARAMS;
         }
+    }
 
-        for (int j = 0; j < L; j++)
+    const int total_expansion_len = NIST256_SHA256_L * count;
+
+    // Only SHA-256 expansions that fit the per-lane buffer run in lockstep
+    if (hash != MC_SHA2 || hash_len != SHA256 || dst_len > 255 || total_expansion_len > HASH_TO_FIELD_BATCH_OKM_LEN)
+    {
+        for (int i = 0; i < message_count; i++)
         {
-            fd[j] = OKM.val[i * L + j];
+            int result = cvc_hash_to_field_nist256(hash, hash_len, dst, dst_len, messages[i], message_lens[i], count, &field_elements[i * count]);
+            if (result != CVC_HASH_TO_FIELD_SUCCESS)
+            {
+                return result;
+            }
         }
+        return CVC_HASH_TO_FIELD_SUCCESS;
+    }
 
-        // Convert bytes to DBIG
-        DBIG_256_56 dx;
-        BIG_256_56_dfromBytesLen(dx, fd, L);
+    unsigned char okm_buffer[CVC_BATCH_LANES * HASH_TO_FIELD_BATCH_OKM_LEN];
+    for (int start = 0; start < message_count; start += CVC_BATCH_LANES)
+    {
+        const int lanes = message_count - start < CVC_BATCH_LANES ? message_count - start : CVC_BATCH_LANES;
 
-        // Reduce modulo field modulus
-        BIG_256_56 w;
-        BIG_256_56_dmod(w, dx, field_modulus);
+        if (cvc_expand_message_xmd_sha256_batch(dst, dst_len, messages + start, message_lens + start, lanes, okm_buffer, total_expansion_len) != CVC_SHA256_SUCCESS)
+        {
+            return CVC_HASH_TO_FIELD_ERROR_EXPAND_FAILED;
+        }
 
-        // Convert to field element (Montgomery form)
-        FP_NIST256_nres(&field_elements[i], w);
+        for (int i = 0; i < lanes; i++)
+        {
+            nist256_sha256_okm_to_field_elements(okm_buffer + i * total_expansion_len, count, &field_elements[(start + i) * count]);
+        }
     }
 
+    cvc_secure_zero(okm_buffer, sizeof(okm_buffer));
+
     return CVC_HASH_TO_FIELD_SUCCESS;
 }
 
-int cvc_derive_secret_key_nist256(const unsigned char* master_key_bytes, int master_key_len, const unsigned char* context, int context_len, const unsigned char* dst, int dst_len, nist256_key_material_t* derived_key_material)
+int cvc_derive_secret_scalar_nist256(const unsigned char* master_key_bytes, int master_key_len, const unsigned char* context, int context_len, const unsigned char* dst, int dst_len, BIG_256_56 scalar)
 {
     // Basic parameter validation
-    if (!master_key_bytes || master_key_len <= 0 || !context || context_len <= 0 || !dst || dst_len <= 0 || !derived_key_material)
+    if (!master_key_bytes || master_key_len <= 0 || !context || context_len <= 0 || !dst || dst_len <= 0)
     {
         return CVC_DERIVE_KEY_ERROR_INVALID_PARAMS;
     }
 
     // Combine master key and context
     int input_len = master_key_len + context_len;
-    if (input_len > 4096) // Reasonable safety limit
+    if (input_len > DERIVE_KEY_MAX_INPUT) // Reasonable safety limit
     {
         return CVC_DERIVE_KEY_ERROR_INPUT_TOO_LARGE;
     }
 
-    unsigned char input[4096];
-    memcpy(input, master_key_bytes, master_key_len);
-    memcpy(input + master_key_len, context, context_len);
-
-    // Hash to field to get field element
+    // Hash to field to get field element; the SHA-256 path absorbs master key and context without joining them
     FP_NIST256 field_element;
-    int hash_result = cvc_hash_to_field_nist256(MC_SHA2, HASH_TYPE_NIST256, dst, dst_len, input, input_len, 1, &field_element);
+    int hash_result;
+    if (dst_len <= 255)
+    {
+        hash_result = nist256_sha256_hash_to_field(dst, dst_len, master_key_bytes, master_key_len, context, context_len, 1, &field_element);
+    }
+    else
+    {
+        // Long DSTs go through MIRACL, which needs the joined input; keep it off the stack
+        unsigned char* input = malloc((size_t)input_len);
+        if (!input)
+        {
+            return CVC_DERIVE_KEY_ERROR_HASH_TO_FIELD_FAILED;
+        }
+        memcpy(input, master_key_bytes, master_key_len);
+        memcpy(input + master_key_len, context, context_len);
+        hash_result = cvc_hash_to_field_nist256(MC_SHA2, HASH_TYPE_NIST256, dst, dst_len, input, input_len, 1, &field_element);
+        cvc_secure_zero(input, (size_t)input_len);
+        free(input);
+    }
 
     if (hash_result != CVC_HASH_TO_FIELD_SUCCESS)
     {
@@ -122,22 +378,39 @@ int cvc_derive_secret_key_nist256(const unsigned char* master_key_bytes, int mas
     }
 
     // Extract the underlying BIG from the field element
-    BIG_256_56 x;
-    FP_NIST256_redc(x, &field_element);
+    FP_NIST256_redc(scalar, &field_element);
 
     // Reduce modulo curve order to ensure valid scalar
     BIG_256_56 curve_order;
     BIG_256_56_rcopy(curve_order, CURVE_Order_NIST256);
-    BIG_256_56_mod(x, curve_order);
+    BIG_256_56_mod(scalar, curve_order);
 
     // Check that we didn't get zero (extremely unlikely)
-    if (BIG_256_56_iszilch(x))
+    if (BIG_256_56_iszilch(scalar))
     {
         return CVC_DERIVE_KEY_ERROR_ZERO_SCALAR;
     }
 
+    return CVC_DERIVE_KEY_SUCCESS;
+}
+
+int cvc_derive_secret_key_nist256(const unsigned char* master_key_bytes, int master_key_len, const unsigned char* context, int context_len, const unsigned char* dst, int dst_len, nist256_key_material_t* derived_key_material)
+{
+    if (!derived_key_material)
+    {
+        return CVC_DERIVE_KEY_ERROR_INVALID_PARAMS;
+    }
+
+    BIG_256_56 x;
+    const int derive_result = cvc_derive_secret_scalar_nist256(master_key_bytes, master_key_len, context, context_len, dst, dst_len, x);
+    if (derive_result != CVC_DERIVE_KEY_SUCCESS)
+    {
+        return derive_result;
+    }
+
     // Extract key material using existing function
     int extract_result = nist256_big_to_key_material(x, derived_key_material);
+    BIG_256_56_zero(x);
     if (extract_result != 0)
     {
         return CVC_DERIVE_KEY_ERROR_KEY_EXTRACTION_FAILED;
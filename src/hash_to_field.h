@@ -55,6 +55,45 @@ typedef enum
  */
 int cvc_hash_to_field_nist256(const int hash, const int hash_len, const unsigned char* dst, const int dst_len, const unsigned char* message, const int message_len, const int count, FP_NIST256* field_elements);
 
+/**
+ * @brief hash_to_field specialized for P-256 with expand_message_xmd(SHA-256)
+ *
+ * The parameters are fixed at compile time (L = 48), so each 48-byte OKM chunk is
+ * reduced in place with the NIST special-form 384 to 256-bit reduction and packed
+ * straight into Montgomery form. cvc_hash_to_field_nist256 routes MC_SHA2/SHA256
+ * requests here; the result is identical to the generic path.
+ *
+ * @param dst Domain Separation Tag as byte array (1..255 bytes)
+ * @param dst_len Length of the DST
+ * @param message Input message to be hashed
+ * @param message_len Length of the input message
+ * @param count Number of field elements to generate (1..42)
+ * @param field_elements Output array to store the generated field elements (must be pre-allocated)
+ * @return CVC_HASH_TO_FIELD_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_hash_to_field_nist256_sha256(const unsigned char* dst, const int dst_len, const unsigned char* message, const int message_len, const int count, FP_NIST256* field_elements);
+
+/**
+ * @brief Hash many messages to field elements with a shared DST
+ *
+ * Equivalent to calling cvc_hash_to_field_nist256 on every message, but for SHA-256
+ * the expand_message_xmd step of up to CVC_SHA256_MAX_LANES messages runs in
+ * lockstep on the multi-buffer SHA-256 kernels. Other hash functions, DSTs over 255
+ * bytes and expansions over 512 bytes per message take the per-message path.
+ *
+ * @param hash Hash function family (e.g., MC_SHA2)
+ * @param hash_len Hash function output length (e.g., HASH_TYPE_NIST256 for SHA-256)
+ * @param dst Domain Separation Tag as byte array
+ * @param dst_len Length of the DST
+ * @param messages Input messages
+ * @param message_lens Length of each message
+ * @param message_count Number of messages
+ * @param count Number of field elements per message (must be > 0)
+ * @param field_elements Output array of message_count * count elements; message i writes at i * count
+ * @return CVC_HASH_TO_FIELD_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_hash_to_field_nist256_batch(const int hash, const int hash_len, const unsigned char* dst, const int dst_len, const unsigned char* const* messages, const int* message_lens, const int message_count, const int count, FP_NIST256* field_elements);
+
 /**
  * @brief Derive a secret key from master key material using hash-to-field
  *
@@ -79,6 +118,24 @@ int cvc_hash_to_field_nist256(const int hash, const int hash_len, const unsigned
  */
 int cvc_derive_secret_key_nist256(const unsigned char* master_key_bytes, int master_key_len, const unsigned char* context, int context_len, const unsigned char* dst, int dst_len, nist256_key_material_t* derived_key_material);
 
+/**
+ * @brief Derive only the secret scalar, without computing the public key
+ *
+ * Steps 1-3 of cvc_derive_secret_key_nist256: the same inputs give the same scalar.
+ * Intended for callers that keep keys in internal form (see keypair.h) and compute
+ * the public point themselves.
+ *
+ * @param master_key_bytes Master key material as byte array
+ * @param master_key_len Length of the master key material
+ * @param context Context bytes for key derivation (for domain separation)
+ * @param context_len Length of the context
+ * @param dst Domain Separation Tag as byte array
+ * @param dst_len Length of the DST
+ * @param scalar Output scalar in [1, curve_order-1]
+ * @return CVC_DERIVE_KEY_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_derive_secret_scalar_nist256(const unsigned char* master_key_bytes, int master_key_len, const unsigned char* context, int context_len, const unsigned char* dst, int dst_len, BIG_256_56 scalar);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,791 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "jwt.h"
+#include "base64url_stream.h"
+#include "ecdsa.h"
+#include "sha256.h"
+#include <pthread.h>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CVC_BASE64_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#define JWT_MAX_THREADS 64
+#define JWT_MIN_TOKENS_PER_THREAD 8 // Below this a thread costs more than the signatures it takes
+
+static const char base64url_alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// One worker's share of a signing batch
+typedef struct
+{
+    const cvc_nist256_keypair_t* keypair;
+    const cvc_sha256_ctx* prefix_ctx; // SHA-256 state after base64url(header) || '.'
+    const char* prefix;               // base64url(header) || '.'
+    int prefix_len;
+    const char* const* claims;
+    const int* claims_lens;
+    char* arena;
+    const int* token_offsets;
+    const int* token_lens;
+    int* results;
+    int start;  // First token of this range
+    int end;    // One past the last token of this range
+    int status; // First failure seen in this range
+} jwt_sign_range_t;
+
+// Six-bit value of a base64url character, or -1
+static int base64url_value(unsigned char c)
+{
+    if (c >= 'A' && c <= 'Z')
+    {
+        return c - 'A';
+    }
+    if (c >= 'a' && c <= 'z')
+    {
+        return c - 'a' + 26;
+    }
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0' + 52;
+    }
+    if (c == '-')
+    {
+        return 62;
+    }
+    if (c == '_')
+    {
+        return 63;
+    }
+    return -1;
+}
+
+int cvc_base64url_encoded_length(int len)
+{
+    if (len < 0 || len > CVC_BASE64URL_MAX_INPUT_LENGTH)
+    {
+        return -1;
+    }
+
+    return len / 3 * 4 + (len % 3 ? len % 3 + 1 : 0);
+}
+
+// ============================================================================
+// base64url encoding kernels
+// ============================================================================
+
+// Encode whole 3-byte groups; len must be a multiple of 3
+static int base64url_encode_groups_portable(const unsigned char* input, int len, char* output)
+{
+    int written = 0;
+    for (int i = 0; i < len; i += 3)
+    {
+        const unsigned int group = ((unsigned int)input[i] << 16) | ((unsigned int)input[i + 1] << 8) | input[i + 2];
+        output[written++] = base64url_alphabet[group >> 18];
+        output[written++] = base64url_alphabet[(group >> 12) & 63];
+        output[written++] = base64url_alphabet[(group >> 6) & 63];
+        output[written++] = base64url_alphabet[group & 63];
+    }
+    return written;
+}
+
+#ifdef CVC_BASE64_X86
+// 12 input bytes to 16 characters per step: split into 6-bit indices with two
+// multiplies, then map each index range to its ASCII offset with one byte shuffle
+__attribute__((target("ssse3"))) static int base64url_encode_groups_ssse3(const unsigned char* input, int len, char* output)
+{
+    const __m128i spread = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0);
+
+    int i = 0;
+    int written = 0;
+
+    // Each 16-byte load uses 12 bytes, so stop while 16 are still readable
+    for (; i + 16 <= len; i += 12, written += 16)
+    {
+        const __m128i bytes = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(input + i)), spread);
+        const __m128i high = _mm_mulhi_epu16(_mm_and_si128(bytes, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+        const __m128i low = _mm_mullo_epi16(_mm_and_si128(bytes, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+        const __m128i indices = _mm_or_si128(high, low);
+
+        // 0..25 -> 13, 26..51 -> 0, 52..63 -> 1..12: the slot of the offset to add
+        __m128i slots = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        slots = _mm_or_si128(slots, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+        _mm_storeu_si128((__m128i*)(output + written), _mm_add_epi8(_mm_shuffle_epi8(offsets, slots), indices));
+    }
+
+    return written + base64url_encode_groups_portable(input + i, len - i, output + written);
+}
+
+static int cpu_has_ssse3(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    {
+        return 0;
+    }
+    return (ecx >> 9) & 1;
+}
+#endif
+
+typedef int (*base64url_groups_fn)(const unsigned char* input, int len, char* output);
+
+static base64url_groups_fn base64url_groups_kernel = base64url_encode_groups_portable;
+static pthread_once_t base64url_dispatch_once = PTHREAD_ONCE_INIT;
+
+static void select_base64url_kernel(void)
+{
+#ifdef CVC_BASE64_X86
+    if (cpu_has_ssse3())
+    {
+        base64url_groups_kernel = base64url_encode_groups_ssse3;
+    }
+#endif
+}
+
+// Encode without bounds checks; output must hold cvc_base64url_encoded_length(len) characters
+static int base64url_encode_raw(const unsigned char* input, int len, char* output)
+{
+    cvc_base64url_stream_t stream;
+    cvc_base64url_stream_init(&stream, output);
+    cvc_base64url_stream_update(&stream, input, len);
+    return cvc_base64url_stream_final(&stream);
+}
+
+void cvc_base64url_stream_init(cvc_base64url_stream_t* stream, char* output)
+{
+    pthread_once(&base64url_dispatch_once, select_base64url_kernel);
+    stream->output = output;
+    stream->written = 0;
+    stream->pending = 0;
+    stream->pending_len = 0;
+}
+
+void cvc_base64url_stream_update(cvc_base64url_stream_t* stream, const unsigned char* data, int len)
+{
+    // Complete a group left over from the previous update
+    while (stream->pending_len > 0 && len > 0)
+    {
+        stream->pending = (stream->pending << 8) | *data++;
+        len--;
+        if (++stream->pending_len == 3)
+        {
+            const unsigned char group[3] = { (unsigned char)(stream->pending >> 16), (unsigned char)(stream->pending >> 8), (unsigned char)stream->pending };
+            stream->written += base64url_encode_groups_portable(group, 3, stream->output + stream->written);
+            stream->pending = 0;
+            stream->pending_len = 0;
+        }
+    }
+
+    // Whole groups go straight through the vector kernel
+    const int whole = len / 3 * 3;
+    if (whole > 0)
+    {
+        stream->written += base64url_groups_kernel(data, whole, stream->output + stream->written);
+        data += whole;
+        len -= whole;
+    }
+
+    for (int i = 0; i < len; i++)
+    {
+        stream->pending = (stream->pending << 8) | data[i];
+        stream->pending_len++;
+    }
+}
+
+int cvc_base64url_stream_final(cvc_base64url_stream_t* stream)
+{
+    char* output = stream->output + stream->written;
+    if (stream->pending_len == 1)
+    {
+        output[0] = base64url_alphabet[(stream->pending >> 2) & 63];
+        output[1] = base64url_alphabet[(stream->pending << 4) & 63];
+        stream->written += 2;
+    }
+    else if (stream->pending_len == 2)
+    {
+        output[0] = base64url_alphabet[(stream->pending >> 10) & 63];
+        output[1] = base64url_alphabet[(stream->pending >> 4) & 63];
+        output[2] = base64url_alphabet[(stream->pending << 2) & 63];
+        stream->written += 3;
+    }
+
+    stream->pending = 0;
+    stream->pending_len = 0;
+    return stream->written;
+}
+
+int cvc_base64url_encode(const unsigned char* input, int input_len, char* output, int output_size, int* output_len)
+{
+    // Basic parameter validation
+    if ((!input && input_len > 0) || input_len < 0 || input_len > CVC_BASE64URL_MAX_INPUT_LENGTH || !output || !output_len)
+    {
+        return CVC_JWT_ERROR_INVALID_PARAMS;
+    }
+
+    if (output_size < cvc_base64url_encoded_length(input_len))
+    {
+        return CVC_JWT_ERROR_INSUFFICIENT_BUFFER;
+    }
+
+    *output_len = base64url_encode_raw(input, input_len, output);
+    return CVC_JWT_SUCCESS;
+}
+
+int cvc_base64url_decode(const char* input, int input_len, unsigned char* output, int output_size, int* output_len)
+{
+    // Basic parameter validation
+    if (!input || input_len < 0 || !output || !output_len)
+    {
+        return CVC_JWT_ERROR_INVALID_PARAMS;
+    }
+
+    // A single leftover character cannot carry a whole byte
+    if (input_len % 4 == 1)
+    {
+        return CVC_JWT_ERROR_MALFORMED_TOKEN;
+    }
+
+    const int decoded_len = input_len / 4 * 3 + (input_len % 4 ? input_len % 4 - 1 : 0);
+    if (output_size < decoded_len)
+    {
+        return CVC_JWT_ERROR_INSUFFICIENT_BUFFER;
+    }
+
+    unsigned int accumulator = 0;
+    int bits = 0;
+    int written = 0;
+    for (int i = 0; i < input_len; i++)
+    {
+        const int value = base64url_value((unsigned char)input[i]);
+        if (value < 0)
+        {
+            return CVC_JWT_ERROR_MALFORMED_TOKEN;
+        }
+
+        accumulator = (accumulator << 6) | (unsigned int)value;
+        bits += 6;
+        if (bits >= 8)
+        {
+            bits -= 8;
+            output[written++] = (unsigned char)(accumulator >> bits);
+            accumulator &= (1U << bits) - 1;
+        }
+    }
+
+    // Leftover bits of the last character must be zero
+    if (accumulator != 0)
+    {
+        return CVC_JWT_ERROR_MALFORMED_TOKEN;
+    }
+
+    *output_len = written;
+    return CVC_JWT_SUCCESS;
+}
+
+static int skip_whitespace(const unsigned char* json, int len, int pos)
+{
+    while (pos < len && (json[pos] == ' ' || json[pos] == '\t' || json[pos] == '\r' || json[pos] == '\n'))
+    {
+        pos++;
+    }
+    return pos;
+}
+
+// Skip a JSON string starting at its opening quote; returns the position after the closing quote or -1
+static int skip_string(const unsigned char* json, int len, int pos, int* escaped)
+{
+    *escaped = 0;
+    for (pos++; pos < len; pos++)
+    {
+        if (json[pos] == '\\')
+        {
+            *escaped = 1;
+            pos++;
+        }
+        else if (json[pos] == '"')
+        {
+            return pos + 1;
+        }
+        else if (json[pos] < 0x20)
+        {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+// Skip any JSON value; nested containers are matched by bracket depth, not fully validated
+static int skip_value(const unsigned char* json, int len, int pos)
+{
+    int escaped;
+    if (pos >= len)
+    {
+        return -1;
+    }
+
+    if (json[pos] == '"')
+    {
+        return skip_string(json, len, pos, &escaped);
+    }
+
+    if (json[pos] == '{' || json[pos] == '[')
+    {
+        int depth = 0;
+        while (pos < len)
+        {
+            if (json[pos] == '"')
+            {
+                pos = skip_string(json, len, pos, &escaped);
+                if (pos < 0)
+                {
+                    return -1;
+                }
+                continue;
+            }
+            if (json[pos] == '{' || json[pos] == '[')
+            {
+                depth++;
+            }
+            else if (json[pos] == '}' || json[pos] == ']')
+            {
+                if (--depth == 0)
+                {
+                    return pos + 1;
+                }
+            }
+            pos++;
+        }
+        return -1;
+    }
+
+    // Number or literal
+    const int start = pos;
+    while (pos < len && json[pos] != ',' && json[pos] != '}' && json[pos] != ']' && json[pos] != ' ' && json[pos] != '\t' && json[pos] != '\r' && json[pos] != '\n')
+    {
+        pos++;
+    }
+    return pos > start ? pos : -1;
+}
+
+// Walk the members of a top-level JSON object and locate the one named name.
+// A name that appears more than once is ambiguous between parsers and refused outright.
+static int find_member(const unsigned char* json, int len, const char* name, int name_len, int* value_start, int* value_end)
+{
+    int pos = skip_whitespace(json, len, 0);
+    if (pos >= len || json[pos] != '{')
+    {
+        return CVC_JWT_ERROR_MALFORMED_TOKEN;
+    }
+    pos = skip_whitespace(json, len, pos + 1);
+
+    int matches = 0;
+    if (pos < len && json[pos] == '}')
+    {
+        pos++;
+    }
+    else
+    {
+        for (;;)
+        {
+            int escaped;
+            if (pos >= len || json[pos] != '"')
+            {
+                return CVC_JWT_ERROR_MALFORMED_TOKEN;
+            }
+            const int key_start = pos + 1;
+            pos = skip_string(json, len, pos, &escaped);
+            if (pos < 0)
+            {
+                return CVC_JWT_ERROR_MALFORMED_TOKEN;
+            }
+            const int is_match = !escaped && pos - 1 - key_start == name_len && memcmp(json + key_start, name, (size_t)name_len) == 0;
+
+            pos = skip_whitespace(json, len, pos);
+            if (pos >= len || json[pos] != ':')
+            {
+                return CVC_JWT_ERROR_MALFORMED_TOKEN;
+            }
+            pos = skip_whitespace(json, len, pos + 1);
+
+            const int start = pos;
+            pos = skip_value(json, len, pos);
+            if (pos < 0)
+            {
+                return CVC_JWT_ERROR_MALFORMED_TOKEN;
+            }
+            if (is_match)
+            {
+                matches++;
+                *value_start = start;
+                *value_end = pos;
+            }
+
+            pos = skip_whitespace(json, len, pos);
+            if (pos < len && json[pos] == ',')
+            {
+                pos = skip_whitespace(json, len, pos + 1);
+                continue;
+            }
+            if (pos < len && json[pos] == '}')
+            {
+                pos++;
+                break;
+            }
+            return CVC_JWT_ERROR_MALFORMED_TOKEN;
+        }
+    }
+
+    if (skip_whitespace(json, len, pos) != len || matches > 1)
+    {
+        return CVC_JWT_ERROR_MALFORMED_TOKEN;
+    }
+
+    return matches == 1 ? CVC_JWT_SUCCESS : CVC_JWT_ERROR_CLAIM_NOT_FOUND;
+}
+
+// The header must be an object with exactly one "alg": "ES256"
+static int check_header_algorithm(const unsigned char* json, int len)
+{
+    int value_start = 0, value_end = 0;
+    const int result = find_member(json, len, "alg", 3, &value_start, &value_end);
+    if (result == CVC_JWT_ERROR_CLAIM_NOT_FOUND)
+    {
+        return CVC_JWT_ERROR_UNSUPPORTED_ALGORITHM;
+    }
+    if (result != CVC_JWT_SUCCESS)
+    {
+        return result;
+    }
+
+    return value_end - value_start == 7 && memcmp(json + value_start, "\"ES256\"", 7) == 0 ? CVC_JWT_SUCCESS : CVC_JWT_ERROR_UNSUPPORTED_ALGORITHM;
+}
+
+int cvc_jws_parse(const char* token, int token_len, cvc_jws_view_t* view)
+{
+    // Basic parameter validation
+    if (!token || token_len <= 0 || !view)
+    {
+        return CVC_JWT_ERROR_INVALID_PARAMS;
+    }
+
+    const char* first_dot = memchr(token, '.', (size_t)token_len);
+    if (!first_dot)
+    {
+        return CVC_JWT_ERROR_MALFORMED_TOKEN;
+    }
+    const char* second_dot = memchr(first_dot + 1, '.', (size_t)(token + token_len - first_dot - 1));
+    if (!second_dot || memchr(second_dot + 1, '.', (size_t)(token + token_len - second_dot - 1)))
+    {
+        return CVC_JWT_ERROR_MALFORMED_TOKEN;
+    }
+
+    view->header_offset = 0;
+    view->header_len = (int)(first_dot - token);
+    view->payload_offset = view->header_len + 1;
+    view->payload_len = (int)(second_dot - first_dot - 1);
+    view->signature_offset = (int)(second_dot - token + 1);
+    view->signature_len = token_len - view->signature_offset;
+
+    return CVC_JWT_SUCCESS;
+}
+
+int cvc_jwt_find_claim(const unsigned char* json, int json_len, const char* name, int* value_offset, int* value_len)
+{
+    // Basic parameter validation
+    if (!json || json_len < 0 || !name || !value_offset || !value_len)
+    {
+        return CVC_JWT_ERROR_INVALID_PARAMS;
+    }
+
+    int value_start = 0, value_end = 0;
+    const int result = find_member(json, json_len, name, (int)strlen(name), &value_start, &value_end);
+    if (result != CVC_JWT_SUCCESS)
+    {
+        return result;
+    }
+
+    *value_offset = value_start;
+    *value_len = value_end - value_start;
+    return CVC_JWT_SUCCESS;
+}
+
+// Split the token, check the header and produce the signing input digest and raw signature
+static int prepare_es256(const char* token, int token_len, cvc_jws_view_t* view, unsigned char* digest, unsigned char* signature)
+{
+    int result = cvc_jws_parse(token, token_len, view);
+    if (result != CVC_JWT_SUCCESS)
+    {
+        return result;
+    }
+
+    unsigned char header[CVC_JWT_MAX_HEADER_LENGTH];
+    int header_len = 0;
+    result = cvc_base64url_decode(token + view->header_offset, view->header_len, header, sizeof(header), &header_len);
+    if (result != CVC_JWT_SUCCESS)
+    {
+        return CVC_JWT_ERROR_MALFORMED_TOKEN;
+    }
+
+    result = check_header_algorithm(header, header_len);
+    if (result != CVC_JWT_SUCCESS)
+    {
+        return result;
+    }
+
+    int signature_len = 0;
+    result = cvc_base64url_decode(token + view->signature_offset, view->signature_len, signature, CVC_ECDSA_SIGNATURE_LENGTH, &signature_len);
+    if (result != CVC_JWT_SUCCESS || signature_len != CVC_ECDSA_SIGNATURE_LENGTH)
+    {
+        return CVC_JWT_ERROR_MALFORMED_TOKEN;
+    }
+
+    // The signing input is the ASCII text header.payload, hashed where it lies
+    cvc_sha256((const unsigned char*)token, (size_t)(view->signature_offset - 1), digest);
+
+    return CVC_JWT_SUCCESS;
+}
+
+int cvc_jwt_verify_es256_view(const char* token, int token_len, cvc_public_key_set_t* key_set, const unsigned char* public_key_bytes, int public_key_len, cvc_jws_view_t* view)
+{
+    // Basic parameter validation
+    if (!token || token_len <= 0 || !public_key_bytes)
+    {
+        return CVC_JWT_ERROR_INVALID_PARAMS;
+    }
+
+    cvc_jws_view_t local_view;
+    unsigned char digest[CVC_ECDSA_DIGEST_LENGTH];
+    unsigned char signature[CVC_ECDSA_SIGNATURE_LENGTH];
+    const int result = prepare_es256(token, token_len, view ? view : &local_view, digest, signature);
+    if (result != CVC_JWT_SUCCESS)
+    {
+        return result;
+    }
+
+    switch (cvc_ecdsa_nist256_verify(key_set, public_key_bytes, public_key_len, digest, sizeof(digest), signature, sizeof(signature)))
+    {
+        case CVC_ECDSA_SUCCESS:
+            return CVC_JWT_SUCCESS;
+        case CVC_ECDSA_ERROR_INVALID_PUBLIC_KEY:
+            return CVC_JWT_ERROR_INVALID_PUBLIC_KEY;
+        default:
+            return CVC_JWT_ERROR_INVALID_SIGNATURE;
+    }
+}
+
+int cvc_jwt_verify_es256(const char* token, int token_len, cvc_public_key_set_t* key_set, const unsigned char* public_key_bytes, int public_key_len)
+{
+    return cvc_jwt_verify_es256_view(token, token_len, key_set, public_key_bytes, public_key_len, NULL);
+}
+
+int cvc_jwt_verify_es256_table_view(const char* token, int token_len, const cvc_nist256_point_table_t* table, cvc_jws_view_t* view)
+{
+    // Basic parameter validation
+    if (!token || token_len <= 0 || !table)
+    {
+        return CVC_JWT_ERROR_INVALID_PARAMS;
+    }
+
+    cvc_jws_view_t local_view;
+    unsigned char digest[CVC_ECDSA_DIGEST_LENGTH];
+    unsigned char signature[CVC_ECDSA_SIGNATURE_LENGTH];
+    const int result = prepare_es256(token, token_len, view ? view : &local_view, digest, signature);
+    if (result != CVC_JWT_SUCCESS)
+    {
+        return result;
+    }
+
+    return cvc_ecdsa_nist256_verify_table(table, digest, sizeof(digest), signature, sizeof(signature)) == CVC_ECDSA_SUCCESS ? CVC_JWT_SUCCESS : CVC_JWT_ERROR_INVALID_SIGNATURE;
+}
+
+int cvc_jwt_verify_es256_table(const char* token, int token_len, const cvc_nist256_point_table_t* table)
+{
+    return cvc_jwt_verify_es256_table_view(token, token_len, table, NULL);
+}
+
+int cvc_jwt_es256_token_length(int header_len, int claims_len)
+{
+    const int encoded_header = cvc_base64url_encoded_length(header_len);
+    const int encoded_claims = cvc_base64url_encoded_length(claims_len);
+    if (encoded_header < 0 || encoded_claims < 0)
+    {
+        return -1;
+    }
+
+    // Each part fits in an int on its own, but their sum may not
+    const long long length = (long long)encoded_header + 1 + encoded_claims + 1 + cvc_base64url_encoded_length(CVC_ECDSA_SIGNATURE_LENGTH);
+    return length > INT_MAX ? -1 : (int)length;
+}
+
+// Write one token at its arena offset: prefix, base64url(claims), '.', base64url(signature)
+static int sign_one(const jwt_sign_range_t* range, int index)
+{
+    char* token = range->arena + range->token_offsets[index];
+    memcpy(token, range->prefix, (size_t)range->prefix_len);
+
+    int len = range->prefix_len;
+    len += base64url_encode_raw((const unsigned char*)range->claims[index], range->claims_lens[index], token + len);
+
+    // Resume from the header midstate and absorb only the payload
+    cvc_sha256_ctx ctx = *range->prefix_ctx;
+    unsigned char digest[CVC_ECDSA_DIGEST_LENGTH];
+    cvc_sha256_update(&ctx, (const unsigned char*)token + range->prefix_len, (size_t)(len - range->prefix_len));
+    cvc_sha256_final(&ctx, digest);
+
+    unsigned char signature[CVC_ECDSA_SIGNATURE_LENGTH];
+    if (cvc_nist256_keypair_sign(range->keypair, digest, sizeof(digest), signature, sizeof(signature)) != CVC_KEYPAIR_SUCCESS)
+    {
+        return CVC_JWT_ERROR_SIGNING_FAILED;
+    }
+
+    token[len++] = '.';
+    base64url_encode_raw(signature, sizeof(signature), token + len);
+    return CVC_JWT_SUCCESS;
+}
+
+static void set_sign_result(jwt_sign_range_t* range, int index, int result)
+{
+    if (range->results)
+    {
+        range->results[index] = result;
+    }
+    if (result != CVC_JWT_SUCCESS)
+    {
+        // An unsigned payload must not look like a token
+        memset(range->arena + range->token_offsets[index], 0, (size_t)range->token_lens[index]);
+        if (range->status == CVC_JWT_SUCCESS)
+        {
+            range->status = result;
+        }
+    }
+}
+
+static void* sign_range_worker(void* arg)
+{
+    jwt_sign_range_t* range = arg;
+    for (int i = range->start; i < range->end; i++)
+    {
+        set_sign_result(range, i, sign_one(range, i));
+    }
+    return NULL;
+}
+
+int cvc_jwt_sign_es256_batch(const cvc_nist256_keypair_t* keypair, const char* header_json, int header_len, const char* const* claims, const int* claims_lens, int count, int thread_count, char* arena, int arena_size, int* token_offsets, int* token_lens, int* results)
+{
+    // Basic parameter validation
+    if (!keypair || !header_json || header_len <= 0 || header_len > CVC_JWT_MAX_HEADER_LENGTH || !claims || !claims_lens || count <= 0 || !arena || !token_offsets || !token_lens)
+    {
+        return CVC_JWT_ERROR_INVALID_PARAMS;
+    }
+
+    // Refuse to issue tokens that cvc_jwt_verify_es256 would reject
+    const int header_result = check_header_algorithm((const unsigned char*)header_json, header_len);
+    if (header_result != CVC_JWT_SUCCESS)
+    {
+        return header_result;
+    }
+
+    // Lay out the arena up front so workers write disjoint slices
+    long long total = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (!claims[i] || claims_lens[i] < 0)
+        {
+            return CVC_JWT_ERROR_INVALID_PARAMS;
+        }
+        token_offsets[i] = (int)total;
+        token_lens[i] = cvc_jwt_es256_token_length(header_len, claims_lens[i]);
+        if (token_lens[i] < 0)
+        {
+            return CVC_JWT_ERROR_INVALID_PARAMS;
+        }
+        total += token_lens[i];
+        if (total > arena_size)
+        {
+            return CVC_JWT_ERROR_INSUFFICIENT_BUFFER;
+        }
+    }
+
+    // Header encoded and hashed once for the whole batch
+    char prefix[CVC_JWT_MAX_HEADER_LENGTH / 3 * 4 + 5];
+    int prefix_len = base64url_encode_raw((const unsigned char*)header_json, header_len, prefix);
+    prefix[prefix_len++] = '.';
+
+    cvc_sha256_ctx prefix_ctx;
+    cvc_sha256_init(&prefix_ctx);
+    cvc_sha256_update(&prefix_ctx, (const unsigned char*)prefix, (size_t)prefix_len);
+
+    int threads = thread_count < 1 ? 1 : thread_count;
+    const int max_useful = (count + JWT_MIN_TOKENS_PER_THREAD - 1) / JWT_MIN_TOKENS_PER_THREAD;
+    if (threads > max_useful)
+    {
+        threads = max_useful;
+    }
+    if (threads > JWT_MAX_THREADS)
+    {
+        threads = JWT_MAX_THREADS;
+    }
+
+    jwt_sign_range_t ranges[JWT_MAX_THREADS];
+    pthread_t workers[JWT_MAX_THREADS];
+    int started[JWT_MAX_THREADS] = { 0 };
+    const int per_thread = (count + threads - 1) / threads;
+    for (int t = 0; t < threads; t++)
+    {
+        ranges[t].keypair = keypair;
+        ranges[t].prefix_ctx = &prefix_ctx;
+        ranges[t].prefix = prefix;
+        ranges[t].prefix_len = prefix_len;
+        ranges[t].claims = claims;
+        ranges[t].claims_lens = claims_lens;
+        ranges[t].arena = arena;
+        ranges[t].token_offsets = token_offsets;
+        ranges[t].token_lens = token_lens;
+        ranges[t].results = results;
+        ranges[t].status = CVC_JWT_SUCCESS;
+        ranges[t].start = t * per_thread < count ? t * per_thread : count;
+        ranges[t].end = (t + 1) * per_thread < count ? (t + 1) * per_thread : count;
+    }
+
+    // The calling thread takes range 0; a worker that fails to start is run inline afterwards
+    for (int t = 1; t < threads; t++)
+    {
+        started[t] = pthread_create(&workers[t], NULL, sign_range_worker, &ranges[t]) == 0;
+    }
+    sign_range_worker(&ranges[0]);
+
+    int status = ranges[0].status;
+    for (int t = 1; t < threads; t++)
+    {
+        if (started[t])
+        {
+            pthread_join(workers[t], NULL);
+        }
+        else
+        {
+            sign_range_worker(&ranges[t]);
+        }
+        if (status == CVC_JWT_SUCCESS)
+        {
+            status = ranges[t].status;
+        }
+    }
+
+    return status;
+}
+
+int cvc_jwt_sign_es256(const cvc_nist256_keypair_t* keypair, const char* header_json, int header_len, const char* claims, int claims_len, char* token, int token_size, int* token_len)
+{
+    // Basic parameter validation
+    if (!claims || !token_len)
+    {
+        return CVC_JWT_ERROR_INVALID_PARAMS;
+    }
+
+    int offset = 0;
+    return cvc_jwt_sign_es256_batch(keypair, header_json, header_len, &claims, &claims_len, 1, 1, token, token_size, &offset, token_len, NULL);
+}
@@ -0,0 +1,219 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef JWT_H
+#define JWT_H
+
+#include "keypair.h"
+#include "point_table.h"
+#include "public_key_set.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Largest protected header JSON accepted for verification and for signing
+#define CVC_JWT_MAX_HEADER_LENGTH 512
+
+/**
+ * @brief Result codes for JWT operations
+ */
+typedef enum
+{
+    CVC_JWT_SUCCESS = 0,                      /**< Operation completed successfully */
+    CVC_JWT_ERROR_INVALID_PARAMS = -1,        /**< Invalid input parameters */
+    CVC_JWT_ERROR_MALFORMED_TOKEN = -2,       /**< Token structure, base64url or header JSON is invalid */
+    CVC_JWT_ERROR_UNSUPPORTED_ALGORITHM = -3, /**< Header "alg" is missing or not ES256 */
+    CVC_JWT_ERROR_INVALID_PUBLIC_KEY = -4,    /**< Public key is malformed or not on the curve */
+    CVC_JWT_ERROR_INVALID_SIGNATURE = -5,     /**< Signature does not verify */
+    CVC_JWT_ERROR_INSUFFICIENT_BUFFER = -6,   /**< Output buffer is too small */
+    CVC_JWT_ERROR_CLAIM_NOT_FOUND = -7,       /**< Object has no member with the requested name */
+    CVC_JWT_ERROR_SIGNING_FAILED = -8,        /**< Signing a token failed; its bytes in the output are zeroed */
+} cvc_jwt_result_t;
+
+/**
+ * @brief Segments of a compact JWS as offsets into the caller's token buffer
+ *
+ * Nothing is copied or decoded: each segment is still base64url text inside the
+ * original token, so claims can be decoded lazily, only when and if they are needed.
+ */
+typedef struct
+{
+    int header_offset;    /**< Start of the base64url protected header */
+    int header_len;       /**< Length of the protected header segment */
+    int payload_offset;   /**< Start of the base64url payload */
+    int payload_len;      /**< Length of the payload segment */
+    int signature_offset; /**< Start of the base64url signature */
+    int signature_len;    /**< Length of the signature segment */
+} cvc_jws_view_t;
+
+/**
+ * @brief Encode bytes as unpadded base64url (RFC 4648, Section 5)
+ *
+ * @param input Bytes to encode (may be NULL if input_len is 0)
+ * @param input_len Number of bytes
+ * @param output Output buffer of at least (input_len * 4 + 2) / 3 characters (not NUL-terminated)
+ * @param output_size Size of the output buffer
+ * @param output_len Receives the number of characters written
+ * @return CVC_JWT_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_base64url_encode(const unsigned char* input, int input_len, char* output, int output_size, int* output_len);
+
+/**
+ * @brief Decode unpadded base64url (RFC 4648, Section 5) as used by JWS
+ *
+ * Padding, whitespace and non-zero trailing bits are rejected, so every byte string
+ * has exactly one accepted encoding.
+ *
+ * @param input Encoded characters
+ * @param input_len Number of characters
+ * @param output Output buffer of at least input_len * 3 / 4 bytes
+ * @param output_size Size of the output buffer
+ * @param output_len Receives the number of decoded bytes
+ * @return CVC_JWT_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_base64url_decode(const char* input, int input_len, unsigned char* output, int output_size, int* output_len);
+
+/**
+ * @brief Split a compact JWS into its three segments without decoding them
+ *
+ * @param token Compact serialization (not necessarily NUL-terminated)
+ * @param token_len Length of the token
+ * @param view Receives the segment offsets
+ * @return CVC_JWT_SUCCESS on success, or CVC_JWT_ERROR_MALFORMED_TOKEN if the token does not have exactly two dots
+ */
+int cvc_jws_parse(const char* token, int token_len, cvc_jws_view_t* view);
+
+/**
+ * @brief Locate a top-level member of a JSON object, e.g. a claim in a decoded payload
+ *
+ * The object is walked once without allocating; nested values are skipped, not
+ * validated. The returned range is the raw JSON value (a string keeps its quotes).
+ * A member name that occurs more than once is reported as malformed.
+ *
+ * @param json JSON object text
+ * @param json_len Length of the JSON text
+ * @param name NUL-terminated member name (matched without unescaping)
+ * @param value_offset Receives the offset of the value in json
+ * @param value_len Receives the length of the value
+ * @return CVC_JWT_SUCCESS, CVC_JWT_ERROR_CLAIM_NOT_FOUND, or another error code
+ */
+int cvc_jwt_find_claim(const unsigned char* json, int json_len, const char* name, int* value_offset, int* value_len);
+
+/**
+ * @brief Verify the signature of a compact ES256 JWS / JWT
+ *
+ * Checks that the token has three base64url segments, that the protected header is
+ * a JSON object whose "alg" member is exactly "ES256", and that the 64-byte signature
+ * verifies over SHA-256 of header.payload with cvc_ecdsa_nist256_verify. Claims are
+ * not decoded or checked; expiry, audience and the like remain the caller's job.
+ * The path does no heap allocation: the header and signature are decoded into
+ * fixed stack buffers and header.payload is hashed where it lies in the token.
+ *
+ * @param token Compact serialization (not necessarily NUL-terminated)
+ * @param token_len Length of the token
+ * @param key_set Optional validated key set (may be NULL)
+ * @param public_key_bytes 65-byte uncompressed issuer public key
+ * @param public_key_len Length of the public key
+ * @return CVC_JWT_SUCCESS if valid, CVC_JWT_ERROR_INVALID_SIGNATURE if not, or another error code
+ */
+int cvc_jwt_verify_es256(const char* token, int token_len, cvc_public_key_set_t* key_set, const unsigned char* public_key_bytes, int public_key_len);
+
+/**
+ * @brief Verify an ES256 token and return the offsets of its segments
+ *
+ * Same as cvc_jwt_verify_es256; on success the view locates the payload so the caller
+ * can decode it with cvc_base64url_decode and look up claims with cvc_jwt_find_claim.
+ *
+ * @param token Compact serialization (not necessarily NUL-terminated)
+ * @param token_len Length of the token
+ * @param key_set Optional validated key set (may be NULL)
+ * @param public_key_bytes 65-byte uncompressed issuer public key
+ * @param public_key_len Length of the public key
+ * @param view Receives the segment offsets (may be NULL)
+ * @return CVC_JWT_SUCCESS if valid, CVC_JWT_ERROR_INVALID_SIGNATURE if not, or another error code
+ */
+int cvc_jwt_verify_es256_view(const char* token, int token_len, cvc_public_key_set_t* key_set, const unsigned char* public_key_bytes, int public_key_len, cvc_jws_view_t* view);
+
+/**
+ * @brief Verify an ES256 token against a precomputed issuer key table
+ *
+ * Same checks as cvc_jwt_verify_es256, with the signature checked through
+ * cvc_ecdsa_nist256_verify_table.
+ *
+ * @param token Compact serialization (not necessarily NUL-terminated)
+ * @param token_len Length of the token
+ * @param table Table of the issuer public key
+ * @return CVC_JWT_SUCCESS if valid, CVC_JWT_ERROR_INVALID_SIGNATURE if not, or another error code
+ */
+int cvc_jwt_verify_es256_table(const char* token, int token_len, const cvc_nist256_point_table_t* table);
+
+/**
+ * @brief Verify an ES256 token against a key table and return the offsets of its segments
+ *
+ * @param token Compact serialization (not necessarily NUL-terminated)
+ * @param token_len Length of the token
+ * @param table Table of the issuer public key
+ * @param view Receives the segment offsets (may be NULL)
+ * @return CVC_JWT_SUCCESS if valid, CVC_JWT_ERROR_INVALID_SIGNATURE if not, or another error code
+ */
+int cvc_jwt_verify_es256_table_view(const char* token, int token_len, const cvc_nist256_point_table_t* table, cvc_jws_view_t* view);
+
+/**
+ * @brief Length of the compact ES256 token for a header and claims of the given sizes
+ *
+ * @param header_len Length of the header JSON
+ * @param claims_len Length of the claims JSON
+ * @return Token length in bytes, or -1 for negative inputs or a token longer than INT_MAX
+ */
+int cvc_jwt_es256_token_length(int header_len, int claims_len);
+
+/**
+ * @brief Issue a batch of ES256 tokens that share one header and one signing key
+ *
+ * The header is checked ("alg" must be "ES256"), base64url-encoded and absorbed into
+ * SHA-256 once; every token then resumes from that midstate and hashes only its own
+ * payload. Signing is spread over up to thread_count threads (the calling thread
+ * included), and tokens are written back to back into the arena in input order,
+ * without NUL terminators. Claims are signed as given; they are not parsed.
+ *
+ * A token whose signing fails does not stop the batch: its slice of the arena is
+ * zeroed, its entry in results (if given) is CVC_JWT_ERROR_SIGNING_FAILED and the
+ * call returns that code once every other token has been signed.
+ *
+ * @param keypair Signing key pair
+ * @param header_json Protected header JSON
+ * @param header_len Length of the header (at most CVC_JWT_MAX_HEADER_LENGTH)
+ * @param claims Claims JSON of each token
+ * @param claims_lens Length of each claims JSON
+ * @param count Number of tokens
+ * @param thread_count Maximum number of threads to use (values < 1 mean 1)
+ * @param arena Output buffer receiving all tokens
+ * @param arena_size Size of the arena; the sum of cvc_jwt_es256_token_length over the batch is enough
+ * @param token_offsets Receives the offset of each token in the arena
+ * @param token_lens Receives the length of each token
+ * @param results Optional array of count per-token result codes (may be NULL)
+ * @return CVC_JWT_SUCCESS if every token was signed, or a negative error code
+ */
+int cvc_jwt_sign_es256_batch(const cvc_nist256_keypair_t* keypair, const char* header_json, int header_len, const char* const* claims, const int* claims_lens, int count, int thread_count, char* arena, int arena_size, int* token_offsets, int* token_lens, int* results);
+
+/**
+ * @brief Issue a single ES256 token
+ *
+ * @param keypair Signing key pair
+ * @param header_json Protected header JSON
+ * @param header_len Length of the header (at most CVC_JWT_MAX_HEADER_LENGTH)
+ * @param claims Claims JSON
+ * @param claims_len Length of the claims JSON
+ * @param token Output buffer of at least cvc_jwt_es256_token_length(header_len, claims_len) bytes
+ * @param token_size Size of the output buffer
+ * @param token_len Receives the token length (the token is not NUL-terminated)
+ * @return CVC_JWT_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_jwt_sign_es256(const cvc_nist256_keypair_t* keypair, const char* header_json, int header_len, const char* claims, int claims_len, char* token, int token_size, int* token_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JWT_H
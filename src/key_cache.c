@@ -0,0 +1,332 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "key_cache.h"
+#include "hash_to_field.h"
+#include "secure_memory.h"
+#include "set_associative.h"
+#include "sha256.h"
+#include "core.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Number of entries per set; lookups and evictions scan one set only
+#define KEY_CACHE_WAYS 8
+
+// Default number of shards when the config leaves it at 0
+#define KEY_CACHE_DEFAULT_SHARDS 16
+
+// HMAC-SHA256 block size and minimum/maximum hash key length
+#define KEY_CACHE_HMAC_BLOCK 64
+#define KEY_CACHE_MIN_HASH_KEY 16
+
+typedef struct
+{
+    cvc_set_way_t way;                         // Stamp is the shard clock value of the last access
+    unsigned char tag[CVC_SHA256_DIGEST_SIZE]; // HMAC of the derivation inputs
+    nist256_key_material_t key_material;       // Cached derivation result
+} key_cache_entry_t;
+
+typedef struct
+{
+    cvc_sha256_ctx inner; // SHA-256 state after absorbing (key ^ ipad)
+    cvc_sha256_ctx outer; // SHA-256 state after absorbing (key ^ opad)
+} key_cache_hmac_t;
+
+typedef struct
+{
+    pthread_mutex_t lock;
+    key_cache_entry_t* entries; // sets_per_shard * ways entries
+    uint64_t clock;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t entry_count;
+} key_cache_shard_t;
+
+struct cvc_key_cache
+{
+    key_cache_shard_t* shards;
+    cvc_set_geometry_t geometry;
+    int memory_locked;
+    key_cache_hmac_t* hmac; // Lives at the start of the locked region
+    void* region;           // Locked allocation holding hmac state and all entries
+    size_t region_size;
+};
+
+// Absorb a 4-byte big-endian length followed by the field bytes
+static void hash_process_field(cvc_sha256_ctx* ctx, const unsigned char* data, int len)
+{
+    const unsigned char length_prefix[4] = { (unsigned char)(len >> 24), (unsigned char)(len >> 16), (unsigned char)(len >> 8), (unsigned char)len };
+    cvc_sha256_update(ctx, length_prefix, sizeof(length_prefix));
+    cvc_sha256_update(ctx, data, (size_t)len);
+}
+
+static void compute_tag(const key_cache_hmac_t* hmac, const unsigned char* master_key_bytes, int master_key_len, const unsigned char* context, int context_len, const unsigned char* dst, int dst_len, unsigned char* tag)
+{
+    cvc_sha256_ctx ctx;
+    unsigned char inner_digest[CVC_SHA256_DIGEST_SIZE];
+
+    ctx = hmac->inner;
+    hash_process_field(&ctx, master_key_bytes, master_key_len);
+    hash_process_field(&ctx, context, context_len);
+    hash_process_field(&ctx, dst, dst_len);
+    cvc_sha256_final(&ctx, inner_digest);
+
+    ctx = hmac->outer;
+    cvc_sha256_update(&ctx, inner_digest, sizeof(inner_digest));
+    cvc_sha256_final(&ctx, tag);
+
+    cvc_secure_zero(inner_digest, sizeof(inner_digest));
+}
+
+// Constant-time tag comparison
+static int tags_equal(const unsigned char* a, const unsigned char* b)
+{
+    unsigned char diff = 0;
+    for (int i = 0; i < CVC_SHA256_DIGEST_SIZE; i++)
+    {
+        diff |= a[i] ^ b[i];
+    }
+    return diff == 0;
+}
+
+static void locate(const cvc_key_cache_t* cache, const unsigned char* tag, key_cache_shard_t** shard, key_cache_entry_t** set)
+{
+    // The tag is uniformly distributed, so any of its bytes make a good index
+    const uint32_t shard_bits = ((uint32_t)tag[0] << 24) | ((uint32_t)tag[1] << 16) | ((uint32_t)tag[2] << 8) | tag[3];
+    const uint32_t set_bits = ((uint32_t)tag[4] << 24) | ((uint32_t)tag[5] << 16) | ((uint32_t)tag[6] << 8) | tag[7];
+
+    int shard_index;
+    size_t first_entry;
+    cvc_set_geometry_locate(&cache->geometry, shard_bits, set_bits, &shard_index, &first_entry);
+    *shard = &cache->shards[shard_index];
+    *set = &(*shard)->entries[first_entry];
+}
+
+int cvc_key_cache_create(const cvc_key_cache_config_t* config, const unsigned char* hash_key, int hash_key_len, cvc_key_cache_t** cache)
+{
+    // Basic parameter validation
+    if (!config || config->max_entries <= 0 || !hash_key || hash_key_len < KEY_CACHE_MIN_HASH_KEY || hash_key_len > KEY_CACHE_HMAC_BLOCK || !cache)
+    {
+        return CVC_KEY_CACHE_ERROR_INVALID_PARAMS;
+    }
+
+    *cache = NULL;
+
+    // HMAC state and entries share one locked region; entries start on a cache line
+    const size_t entries_offset = (sizeof(key_cache_hmac_t) + 63) & ~(size_t)63;
+
+    // Capacity is bounded by both the entry count and the byte budget, which covers the
+    // whole locked region as cvc_secure_alloc rounds it up to pages
+    int capacity = config->max_entries;
+    if (config->max_bytes > 0)
+    {
+        const size_t page = cvc_secure_page_size();
+        const size_t usable = config->max_bytes / page * page;
+        const size_t by_bytes = usable > entries_offset ? (usable - entries_offset) / sizeof(key_cache_entry_t) : 0;
+        if (by_bytes == 0)
+        {
+            return CVC_KEY_CACHE_ERROR_INVALID_PARAMS;
+        }
+        if (by_bytes < (size_t)capacity)
+        {
+            capacity = (int)by_bytes;
+        }
+    }
+
+    cvc_set_geometry_t geometry;
+    cvc_set_geometry_init(&geometry, capacity, KEY_CACHE_WAYS, config->shard_count, KEY_CACHE_DEFAULT_SHARDS);
+
+    cvc_key_cache_t* result = calloc(1, sizeof(cvc_key_cache_t));
+    if (!result)
+    {
+        return CVC_KEY_CACHE_ERROR_ALLOCATION_FAILED;
+    }
+
+    result->shards = calloc((size_t)geometry.shard_count, sizeof(key_cache_shard_t));
+    if (!result->shards)
+    {
+        free(result);
+        return CVC_KEY_CACHE_ERROR_ALLOCATION_FAILED;
+    }
+
+    const size_t entries_per_shard = cvc_set_geometry_shard_entries(&geometry);
+    result->region_size = entries_offset + (size_t)geometry.shard_count * entries_per_shard * sizeof(key_cache_entry_t);
+    result->region = cvc_secure_alloc(result->region_size, &result->memory_locked);
+    if (!result->region)
+    {
+        free(result->shards);
+        free(result);
+        return CVC_KEY_CACHE_ERROR_ALLOCATION_FAILED;
+    }
+
+    if (!result->memory_locked && !config->allow_unlocked)
+    {
+        cvc_secure_free(result->region, result->region_size);
+        free(result->shards);
+        free(result);
+        return CVC_KEY_CACHE_ERROR_LOCK_FAILED;
+    }
+
+    result->geometry = geometry;
+    result->hmac = (key_cache_hmac_t*)result->region;
+
+    key_cache_entry_t* entries = (key_cache_entry_t*)((unsigned char*)result->region + entries_offset);
+    for (int i = 0; i < geometry.shard_count; i++)
+    {
+        pthread_mutex_init(&result->shards[i].lock, NULL);
+        result->shards[i].entries = entries + (size_t)i * entries_per_shard;
+    }
+
+    // Precompute the HMAC inner and outer states from the hash key
+    unsigned char key_block[KEY_CACHE_HMAC_BLOCK] = { 0 };
+    memcpy(key_block, hash_key, hash_key_len);
+
+    unsigned char inner_block[KEY_CACHE_HMAC_BLOCK], outer_block[KEY_CACHE_HMAC_BLOCK];
+    for (int i = 0; i < KEY_CACHE_HMAC_BLOCK; i++)
+    {
+        inner_block[i] = key_block[i] ^ 0x36;
+        outer_block[i] = key_block[i] ^ 0x5c;
+    }
+
+    cvc_sha256_init(&result->hmac->inner);
+    cvc_sha256_init(&result->hmac->outer);
+    cvc_sha256_update(&result->hmac->inner, inner_block, sizeof(inner_block));
+    cvc_sha256_update(&result->hmac->outer, outer_block, sizeof(outer_block));
+    cvc_secure_zero(key_block, sizeof(key_block));
+    cvc_secure_zero(inner_block, sizeof(inner_block));
+    cvc_secure_zero(outer_block, sizeof(outer_block));
+
+    *cache = result;
+    return CVC_KEY_CACHE_SUCCESS;
+}
+
+void cvc_key_cache_destroy(cvc_key_cache_t* cache)
+{
+    if (!cache)
+    {
+        return;
+    }
+
+    for (int i = 0; i < cache->geometry.shard_count; i++)
+    {
+        pthread_mutex_destroy(&cache->shards[i].lock);
+    }
+
+    // Zeroizes the HMAC state and every entry before unmapping
+    cvc_secure_free(cache->region, cache->region_size);
+    free(cache->shards);
+    free(cache);
+}
+
+void cvc_key_cache_clear(cvc_key_cache_t* cache)
+{
+    if (!cache)
+    {
+        return;
+    }
+
+    const size_t entries_per_shard = cvc_set_geometry_shard_entries(&cache->geometry);
+    for (int i = 0; i < cache->geometry.shard_count; i++)
+    {
+        key_cache_shard_t* shard = &cache->shards[i];
+        pthread_mutex_lock(&shard->lock);
+        cvc_secure_zero(shard->entries, entries_per_shard * sizeof(key_cache_entry_t));
+        shard->entry_count = 0;
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+int cvc_key_cache_get_stats(cvc_key_cache_t* cache, cvc_key_cache_stats_t* stats)
+{
+    if (!cache || !stats)
+    {
+        return CVC_KEY_CACHE_ERROR_INVALID_PARAMS;
+    }
+
+    memset(stats, 0, sizeof(cvc_key_cache_stats_t));
+    for (int i = 0; i < cache->geometry.shard_count; i++)
+    {
+        key_cache_shard_t* shard = &cache->shards[i];
+        pthread_mutex_lock(&shard->lock);
+        stats->hits += shard->hits;
+        stats->misses += shard->misses;
+        stats->evictions += shard->evictions;
+        stats->entries += shard->entry_count;
+        pthread_mutex_unlock(&shard->lock);
+    }
+
+    stats->bytes = stats->entries * sizeof(key_cache_entry_t);
+    stats->capacity = (uint64_t)cache->geometry.shard_count * cvc_set_geometry_shard_entries(&cache->geometry);
+    stats->memory_locked = cache->memory_locked;
+
+    return CVC_KEY_CACHE_SUCCESS;
+}
+
+int cvc_derive_secret_key_nist256_cached(cvc_key_cache_t* cache, const unsigned char* master_key_bytes, int master_key_len, const unsigned char* context, int context_len, const unsigned char* dst, int dst_len, nist256_key_material_t* derived_key_material)
+{
+    // Without a cache, or with inputs the derivation would reject, defer entirely
+    if (!cache || !master_key_bytes || master_key_len <= 0 || !context || context_len <= 0 || !dst || dst_len <= 0 || !derived_key_material)
+    {
+        return cvc_derive_secret_key_nist256(master_key_bytes, master_key_len, context, context_len, dst, dst_len, derived_key_material);
+    }
+
+    unsigned char tag[CVC_SHA256_DIGEST_SIZE];
+    compute_tag(cache->hmac, master_key_bytes, master_key_len, context, context_len, dst, dst_len, tag);
+
+    key_cache_shard_t* shard;
+    key_cache_entry_t* set;
+    locate(cache, tag, &shard, &set);
+
+    // Lookup
+    pthread_mutex_lock(&shard->lock);
+    for (int i = 0; i < cache->geometry.ways; i++)
+    {
+        if (set[i].way.in_use && tags_equal(set[i].tag, tag))
+        {
+            memcpy(derived_key_material, &set[i].key_material, sizeof(nist256_key_material_t));
+            set[i].way.stamp = ++shard->clock;
+            shard->hits++;
+            pthread_mutex_unlock(&shard->lock);
+            return CVC_DERIVE_KEY_SUCCESS;
+        }
+    }
+    shard->misses++;
+    pthread_mutex_unlock(&shard->lock);
+
+    // Miss: derive outside the lock so other lookups in this shard are not blocked
+    const int derive_result = cvc_derive_secret_key_nist256(master_key_bytes, master_key_len, context, context_len, dst, dst_len, derived_key_material);
+    if (derive_result != CVC_DERIVE_KEY_SUCCESS)
+    {
+        return derive_result;
+    }
+
+    // Insert, unless a concurrent caller already did; prefer a free way, otherwise evict the LRU one
+    pthread_mutex_lock(&shard->lock);
+    int present = 0;
+    for (int i = 0; i < cache->geometry.ways && !present; i++)
+    {
+        present = set[i].way.in_use && tags_equal(set[i].tag, tag);
+    }
+
+    if (!present)
+    {
+        key_cache_entry_t* victim = &set[cvc_set_victim(set, sizeof(key_cache_entry_t), cache->geometry.ways)];
+        if (victim->way.in_use)
+        {
+            cvc_secure_zero(victim, sizeof(key_cache_entry_t));
+            shard->evictions++;
+            shard->entry_count--;
+        }
+        memcpy(victim->tag, tag, CVC_SHA256_DIGEST_SIZE);
+        memcpy(&victim->key_material, derived_key_material, sizeof(nist256_key_material_t));
+        victim->way.stamp = ++shard->clock;
+        victim->way.in_use = 1;
+        shard->entry_count++;
+    }
+    pthread_mutex_unlock(&shard->lock);
+
+    return CVC_DERIVE_KEY_SUCCESS;
+}
@@ -0,0 +1,125 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef KEY_CACHE_H
+#define KEY_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "nist256_key_material.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Result codes for derived key cache operations
+ */
+typedef enum
+{
+    CVC_KEY_CACHE_SUCCESS = 0,                  /**< Operation completed successfully */
+    CVC_KEY_CACHE_ERROR_INVALID_PARAMS = -1,    /**< Invalid input parameters */
+    CVC_KEY_CACHE_ERROR_ALLOCATION_FAILED = -2, /**< Failed to allocate cache memory */
+    CVC_KEY_CACHE_ERROR_LOCK_FAILED = -3,       /**< Failed to lock cache memory into RAM */
+} cvc_key_cache_result_t;
+
+/**
+ * @brief Sizing and behaviour of a derived key cache
+ */
+typedef struct
+{
+    int max_entries;    /**< Maximum number of cached derivations (must be > 0) */
+    size_t max_bytes;   /**< Maximum bytes of locked memory: HMAC state and entries, rounded up to whole pages (0 = no byte limit) */
+    int shard_count;    /**< Number of independently locked shards (0 = default, rounded down to a power of two) */
+    int allow_unlocked; /**< If non-zero, fall back to unlocked memory when mlock fails instead of failing */
+} cvc_key_cache_config_t;
+
+/**
+ * @brief Snapshot of cache counters
+ */
+typedef struct
+{
+    uint64_t hits;      /**< Lookups answered from the cache */
+    uint64_t misses;    /**< Lookups that required a full derivation */
+    uint64_t evictions; /**< Entries zeroized to make room for new ones */
+    uint64_t entries;   /**< Entries currently held */
+    uint64_t bytes;     /**< Bytes currently occupied by held entries */
+    uint64_t capacity;  /**< Maximum number of entries the cache can hold */
+    int memory_locked;  /**< 1 if entry memory is locked into RAM */
+} cvc_key_cache_stats_t;
+
+/**
+ * @brief Opaque bounded cache of derived NIST P-256 key material
+ */
+typedef struct cvc_key_cache cvc_key_cache_t;
+
+/**
+ * @brief Create a bounded, sharded cache for cvc_derive_secret_key_nist256 results
+ *
+ * Entries are addressed by HMAC-SHA256(hash_key, master_key || context || dst), with
+ * every field length-prefixed, so the cache never stores the master key itself and
+ * lookups do not reveal inputs to anyone without the hash key. Entry memory is locked
+ * into RAM and zeroized on eviction, clear and destroy.
+ *
+ * The cache is set-associative: each shard has its own mutex and evicts the least
+ * recently used entry of a set when the set is full. Capacity is the smaller of
+ * max_entries and the number of entries that fit next to the HMAC state in
+ * max_bytes rounded down to whole pages (cvc_secure_page_size), so the locked
+ * allocation never exceeds max_bytes. A max_bytes too small for one entry is
+ * rejected with CVC_KEY_CACHE_ERROR_INVALID_PARAMS.
+ *
+ * @param config Cache sizing (see cvc_key_cache_config_t)
+ * @param hash_key Secret key for the lookup HMAC (should be random, at least 16 bytes)
+ * @param hash_key_len Length of hash_key (16..64 bytes)
+ * @param cache Output pointer receiving the new cache
+ * @return CVC_KEY_CACHE_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_key_cache_create(const cvc_key_cache_config_t* config, const unsigned char* hash_key, int hash_key_len, cvc_key_cache_t** cache);
+
+/**
+ * @brief Zeroize all entries and release the cache
+ *
+ * @param cache Cache to destroy (NULL is ignored). No other thread may use it concurrently.
+ */
+void cvc_key_cache_destroy(cvc_key_cache_t* cache);
+
+/**
+ * @brief Zeroize and drop all entries, keeping counters
+ *
+ * @param cache Cache to clear
+ */
+void cvc_key_cache_clear(cvc_key_cache_t* cache);
+
+/**
+ * @brief Read the cache counters
+ *
+ * @param cache Cache to inspect
+ * @param stats Output structure receiving the counters
+ * @return CVC_KEY_CACHE_SUCCESS on success, or CVC_KEY_CACHE_ERROR_INVALID_PARAMS
+ */
+int cvc_key_cache_get_stats(cvc_key_cache_t* cache, cvc_key_cache_stats_t* stats);
+
+/**
+ * @brief Derive a secret key, answering repeated derivations from the cache
+ *
+ * Produces exactly the same key material as cvc_derive_secret_key_nist256. On a miss
+ * the derivation runs without holding any cache lock and the result is inserted
+ * afterwards. Passing a NULL cache performs an uncached derivation.
+ *
+ * @param cache Cache to consult (may be NULL)
+ * @param master_key_bytes Master key material as byte array
+ * @param master_key_len Length of the master key material
+ * @param context Context bytes for key derivation (for domain separation)
+ * @param context_len Length of the context
+ * @param dst Domain Separation Tag as byte array
+ * @param dst_len Length of the DST
+ * @param derived_key_material Output structure to store the derived key material
+ * @return CVC_DERIVE_KEY_SUCCESS on success, or a negative cvc_derive_key_result_t code on failure
+ */
+int cvc_derive_secret_key_nist256_cached(cvc_key_cache_t* cache, const unsigned char* master_key_bytes, int master_key_len, const unsigned char* context, int context_len, const unsigned char* dst, int dst_len, nist256_key_material_t* derived_key_material);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KEY_CACHE_H
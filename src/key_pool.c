@@ -0,0 +1,199 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "key_pool.h"
+#include "secure_memory.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+
+// Slot indices must fit the low half of the tagged head with room for the +1 bias
+#define KEY_POOL_MAX_SLOTS (1 << 24)
+
+// Two cache lines per slot, so neighbouring keys never share a line
+#define KEY_POOL_SLOT_SIZE 128
+
+_Static_assert(sizeof(nist256_key_material_t) <= KEY_POOL_SLOT_SIZE, "key material must fit one pool slot");
+
+// Free-list head: low 32 bits hold the index of the top slot plus one (0 = empty),
+// high 32 bits a counter bumped on every change so a stale head never compares equal (ABA)
+#define KEY_POOL_INDEX_MASK 0xFFFFFFFFULL
+#define KEY_POOL_TAG_ONE (1ULL << 32)
+
+struct cvc_key_pool
+{
+    _Atomic uint64_t head;
+    _Atomic uint32_t* next;         // next[i] = index + 1 of the slot below i on the free stack
+    _Atomic unsigned char* in_use;  // Allocation flag per slot; catches double and foreign frees
+    unsigned char* slots;           // Locked region
+    size_t region_size;
+    int slot_count;
+    int memory_locked;
+    _Atomic uint64_t allocated;
+    _Atomic uint64_t exhausted;
+};
+
+static void push_free(cvc_key_pool_t* pool, uint32_t index)
+{
+    uint64_t old_head = atomic_load_explicit(&pool->head, memory_order_relaxed);
+    uint64_t new_head;
+    do
+    {
+        atomic_store_explicit(&pool->next[index], (uint32_t)(old_head & KEY_POOL_INDEX_MASK), memory_order_relaxed);
+        new_head = ((old_head & ~KEY_POOL_INDEX_MASK) + KEY_POOL_TAG_ONE) | (uint64_t)(index + 1);
+    } while (!atomic_compare_exchange_weak_explicit(&pool->head, &old_head, new_head, memory_order_release, memory_order_relaxed));
+}
+
+// Returns index + 1 of the popped slot, or 0 if the stack is empty
+static uint32_t pop_free(cvc_key_pool_t* pool)
+{
+    uint64_t old_head = atomic_load_explicit(&pool->head, memory_order_acquire);
+    for (;;)
+    {
+        const uint32_t top = (uint32_t)(old_head & KEY_POOL_INDEX_MASK);
+        if (top == 0)
+        {
+            return 0;
+        }
+
+        // next[] is never freed, so reading it for a slot another thread just took is harmless; the tag makes that CAS fail
+        const uint32_t below = atomic_load_explicit(&pool->next[top - 1], memory_order_relaxed);
+        const uint64_t new_head = ((old_head & ~KEY_POOL_INDEX_MASK) + KEY_POOL_TAG_ONE) | below;
+        if (atomic_compare_exchange_weak_explicit(&pool->head, &old_head, new_head, memory_order_acquire, memory_order_acquire))
+        {
+            return top;
+        }
+    }
+}
+
+int cvc_key_pool_create(const cvc_key_pool_config_t* config, cvc_key_pool_t** pool)
+{
+    // Basic parameter validation
+    if (!config || config->slot_count <= 0 || config->slot_count > KEY_POOL_MAX_SLOTS || !pool)
+    {
+        return CVC_KEY_POOL_ERROR_INVALID_PARAMS;
+    }
+
+    *pool = NULL;
+
+    cvc_key_pool_t* result = calloc(1, sizeof(cvc_key_pool_t));
+    if (!result)
+    {
+        return CVC_KEY_POOL_ERROR_ALLOCATION_FAILED;
+    }
+
+    const size_t slot_count = (size_t)config->slot_count;
+    result->next = calloc(slot_count, sizeof(*result->next));
+    result->in_use = calloc(slot_count, sizeof(*result->in_use));
+    result->region_size = slot_count * KEY_POOL_SLOT_SIZE;
+    result->slots = cvc_secure_alloc(result->region_size, &result->memory_locked);
+    if (!result->next || !result->in_use || !result->slots)
+    {
+        cvc_secure_free(result->slots, result->region_size);
+        free((void*)result->next);
+        free((void*)result->in_use);
+        free(result);
+        return CVC_KEY_POOL_ERROR_ALLOCATION_FAILED;
+    }
+
+    if (!result->memory_locked && !config->allow_unlocked)
+    {
+        cvc_secure_free(result->slots, result->region_size);
+        free((void*)result->next);
+        free((void*)result->in_use);
+        free(result);
+        return CVC_KEY_POOL_ERROR_LOCK_FAILED;
+    }
+
+    result->slot_count = config->slot_count;
+    atomic_init(&result->allocated, 0);
+    atomic_init(&result->exhausted, 0);
+
+    // Chain every slot so slot 0 is on top; lower addresses are handed out first
+    for (size_t i = 0; i < slot_count; i++)
+    {
+        atomic_init(&result->next[i], i + 1 < slot_count ? (uint32_t)(i + 2) : 0);
+        atomic_init(&result->in_use[i], 0);
+    }
+    atomic_init(&result->head, 1);
+
+    *pool = result;
+    return CVC_KEY_POOL_SUCCESS;
+}
+
+void cvc_key_pool_destroy(cvc_key_pool_t* pool)
+{
+    if (!pool)
+    {
+        return;
+    }
+
+    // cvc_secure_free zeroizes the whole region, including slots still in use
+    cvc_secure_free(pool->slots, pool->region_size);
+    free((void*)pool->next);
+    free((void*)pool->in_use);
+    free(pool);
+}
+
+nist256_key_material_t* cvc_key_pool_alloc(cvc_key_pool_t* pool)
+{
+    if (!pool)
+    {
+        return NULL;
+    }
+
+    const uint32_t top = pop_free(pool);
+    if (top == 0)
+    {
+        atomic_fetch_add_explicit(&pool->exhausted, 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    atomic_store_explicit(&pool->in_use[top - 1], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&pool->allocated, 1, memory_order_relaxed);
+
+    // Free slots are kept zeroed, so there is nothing to clear here
+    return (nist256_key_material_t*)(pool->slots + (size_t)(top - 1) * KEY_POOL_SLOT_SIZE);
+}
+
+int cvc_key_pool_free(cvc_key_pool_t* pool, nist256_key_material_t* key)
+{
+    // Basic parameter validation
+    if (!pool || !key)
+    {
+        return CVC_KEY_POOL_ERROR_INVALID_PARAMS;
+    }
+
+    const unsigned char* address = (const unsigned char*)key;
+    if (address < pool->slots || address >= pool->slots + pool->region_size || (size_t)(address - pool->slots) % KEY_POOL_SLOT_SIZE != 0)
+    {
+        return CVC_KEY_POOL_ERROR_NOT_ALLOCATED;
+    }
+
+    const uint32_t index = (uint32_t)((size_t)(address - pool->slots) / KEY_POOL_SLOT_SIZE);
+    if (index >= (uint32_t)pool->slot_count || atomic_exchange_explicit(&pool->in_use[index], 0, memory_order_relaxed) != 1)
+    {
+        return CVC_KEY_POOL_ERROR_NOT_ALLOCATED;
+    }
+
+    // Wipe before the slot becomes visible to other allocators
+    cvc_secure_zero(key, KEY_POOL_SLOT_SIZE);
+    atomic_fetch_sub_explicit(&pool->allocated, 1, memory_order_relaxed);
+    push_free(pool, index);
+
+    return CVC_KEY_POOL_SUCCESS;
+}
+
+int cvc_key_pool_get_stats(cvc_key_pool_t* pool, cvc_key_pool_stats_t* stats)
+{
+    if (!pool || !stats)
+    {
+        return CVC_KEY_POOL_ERROR_INVALID_PARAMS;
+    }
+
+    stats->capacity = (uint64_t)pool->slot_count;
+    stats->in_use = atomic_load_explicit(&pool->allocated, memory_order_relaxed);
+    stats->exhausted = atomic_load_explicit(&pool->exhausted, memory_order_relaxed);
+    stats->memory_locked = pool->memory_locked;
+
+    return CVC_KEY_POOL_SUCCESS;
+}
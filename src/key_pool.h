@@ -0,0 +1,111 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef KEY_POOL_H
+#define KEY_POOL_H
+
+#include <stdint.h>
+#include "nist256_key_material.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Result codes for key pool operations
+ */
+typedef enum
+{
+    CVC_KEY_POOL_SUCCESS = 0,                  /**< Operation completed successfully */
+    CVC_KEY_POOL_ERROR_INVALID_PARAMS = -1,    /**< Invalid input parameters */
+    CVC_KEY_POOL_ERROR_ALLOCATION_FAILED = -2, /**< Failed to allocate pool memory */
+    CVC_KEY_POOL_ERROR_LOCK_FAILED = -3,       /**< Failed to lock pool memory into RAM */
+    CVC_KEY_POOL_ERROR_NOT_ALLOCATED = -4,     /**< Slot is not from this pool or is already free */
+} cvc_key_pool_result_t;
+
+/**
+ * @brief Sizing and behaviour of a key pool
+ */
+typedef struct
+{
+    int slot_count;     /**< Number of key slots (1..2^24) */
+    int allow_unlocked; /**< If non-zero, fall back to unlocked memory when mlock fails instead of failing */
+} cvc_key_pool_config_t;
+
+/**
+ * @brief Snapshot of pool counters
+ */
+typedef struct
+{
+    uint64_t capacity;  /**< Total number of slots */
+    uint64_t in_use;    /**< Slots currently allocated */
+    uint64_t exhausted; /**< Allocations refused because every slot was in use */
+    int memory_locked;  /**< 1 if slot memory is locked into RAM */
+} cvc_key_pool_stats_t;
+
+/**
+ * @brief Opaque pool of fixed-size slots for NIST P-256 key material
+ */
+typedef struct cvc_key_pool cvc_key_pool_t;
+
+/**
+ * @brief Create a pool of key slots in locked, zeroed memory
+ *
+ * All slots live in one region from cvc_secure_alloc, so they never reach swap or
+ * core dumps. Slots are padded to two cache lines so threads working on neighbouring
+ * keys do not share a line. Free slots form a lock-free stack with a tagged head:
+ * allocate and free are a single compare-and-swap in the common case.
+ *
+ * @param config Pool sizing (see cvc_key_pool_config_t)
+ * @param pool Output pointer receiving the new pool
+ * @return CVC_KEY_POOL_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_key_pool_create(const cvc_key_pool_config_t* config, cvc_key_pool_t** pool);
+
+/**
+ * @brief Zeroize every slot and release the pool
+ *
+ * @param pool Pool to destroy (NULL is ignored). No other thread may use it concurrently,
+ *             and every slot pointer handed out becomes invalid.
+ */
+void cvc_key_pool_destroy(cvc_key_pool_t* pool);
+
+/**
+ * @brief Take a zeroed slot from the pool
+ *
+ * The slot is an ordinary nist256_key_material_t and can be passed directly as the
+ * output of cvc_derive_secret_key_nist256, cvc_add_nist256_secret_keys,
+ * nist256_generate_key_material and the other key producing functions. Safe to call
+ * from any number of threads.
+ *
+ * @param pool Pool to allocate from
+ * @return Zeroed slot, or NULL if the pool is exhausted (or pool is NULL)
+ */
+nist256_key_material_t* cvc_key_pool_alloc(cvc_key_pool_t* pool);
+
+/**
+ * @brief Zeroize a slot and return it to the pool
+ *
+ * Pointers that did not come from this pool and slots that are already free are
+ * rejected, so a double free cannot hand one slot to two owners.
+ *
+ * @param pool Pool the slot came from
+ * @param key Slot returned by cvc_key_pool_alloc
+ * @return CVC_KEY_POOL_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_key_pool_free(cvc_key_pool_t* pool, nist256_key_material_t* key);
+
+/**
+ * @brief Read the pool counters
+ *
+ * @param pool Pool to inspect
+ * @param stats Output structure receiving the counters
+ * @return CVC_KEY_POOL_SUCCESS on success, or CVC_KEY_POOL_ERROR_INVALID_PARAMS
+ */
+int cvc_key_pool_get_stats(cvc_key_pool_t* pool, cvc_key_pool_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KEY_POOL_H
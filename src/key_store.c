@@ -0,0 +1,454 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "key_store.h"
+#include "sha256.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const unsigned char key_store_magic[4] = { 'C', 'V', 'K', 'S' };
+
+// Slot layout: context digest, then X || Y
+#define SLOT_X_OFFSET CVC_SHA256_DIGEST_SIZE
+#define SLOT_Y_OFFSET (CVC_SHA256_DIGEST_SIZE + MODBYTES_256_56)
+
+struct cvc_key_store
+{
+    const unsigned char* base;  // Read-only mapping of the whole file
+    const unsigned char* slots; // base + CVC_KEY_STORE_HEADER_SIZE
+    size_t size;                // Mapped length
+    uint32_t slot_mask;         // Slot count - 1
+    int count;                  // Entries, from the header
+};
+
+static uint32_t load_le32(const unsigned char* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void store_le32(unsigned char* p, uint32_t v)
+{
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+// Home slot of a digest; SHA-256 output is uniform, so its low bits need no further mixing
+static uint32_t home_slot(const unsigned char* digest, uint32_t slot_mask)
+{
+    return load_le32(digest) & slot_mask;
+}
+
+// An all-zero digest marks a free slot (a real one has probability 2^-256)
+static int slot_is_free(const unsigned char* slot)
+{
+    unsigned char acc = 0;
+    for (int i = 0; i < CVC_SHA256_DIGEST_SIZE; i++)
+    {
+        acc |= slot[i];
+    }
+    return acc == 0;
+}
+
+// Push buffered data and the file's contents to stable storage
+static int flush_file(FILE* file)
+{
+    if (fflush(file) != 0)
+    {
+        return 0;
+    }
+#ifdef _WIN32
+    return FlushFileBuffers((HANDLE)_get_osfhandle(_fileno(file))) != 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+#ifndef _WIN32
+// Make a rename within the directory of path durable
+static int sync_parent_directory(const char* path)
+{
+    const char* slash = strrchr(path, '/');
+    char* directory = NULL;
+    if (slash)
+    {
+        const size_t directory_len = slash == path ? 1 : (size_t)(slash - path);
+        directory = malloc(directory_len + 1);
+        if (!directory)
+        {
+            return 0;
+        }
+        memcpy(directory, path, directory_len);
+        directory[directory_len] = '\0';
+    }
+
+    const int fd = open(directory ? directory : ".", O_RDONLY);
+    free(directory);
+    if (fd < 0)
+    {
+        return 0;
+    }
+    const int synced = fsync(fd) == 0;
+    close(fd);
+    return synced;
+}
+#endif
+
+// Write to a temporary file next to path, flush it to disk and rename it into place
+static int write_file(const char* path, const unsigned char* data, size_t size)
+{
+    const size_t path_len = strlen(path);
+    char* tmp_path = malloc(path_len + sizeof(".tmp"));
+    if (!tmp_path)
+    {
+        return CVC_KEY_STORE_ERROR_ALLOCATION_FAILED;
+    }
+    memcpy(tmp_path, path, path_len);
+    memcpy(tmp_path + path_len, ".tmp", sizeof(".tmp"));
+
+    int result = CVC_KEY_STORE_ERROR_IO_FAILED;
+    FILE* file = fopen(tmp_path, "wb");
+    if (file)
+    {
+        // Without the flush a crash after the rename could leave an empty or truncated store
+        const int written = fwrite(data, 1, size, file) == size && flush_file(file);
+        if (fclose(file) == 0 && written)
+        {
+#ifdef _WIN32
+            const int renamed = MoveFileExA(tmp_path, path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+            const int renamed = rename(tmp_path, path) == 0;
+#endif
+            if (renamed)
+            {
+                result = CVC_KEY_STORE_SUCCESS;
+#ifndef _WIN32
+                // The new store is in place either way, but its directory entry may not survive a crash
+                if (!sync_parent_directory(path))
+                {
+                    result = CVC_KEY_STORE_ERROR_IO_FAILED;
+                }
+#endif
+            }
+        }
+        if (result != CVC_KEY_STORE_SUCCESS)
+        {
+            remove(tmp_path);
+        }
+    }
+
+    free(tmp_path);
+    return result;
+}
+
+int cvc_key_store_write(const char* path, const unsigned char* const* contexts, const int* context_lens, const nist256_key_material_t* key_materials, int count)
+{
+    // Basic parameter validation
+    if (!path || !contexts || !context_lens || !key_materials || count <= 0 || count > CVC_KEY_STORE_MAX_ENTRIES)
+    {
+        return CVC_KEY_STORE_ERROR_INVALID_PARAMS;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (!contexts[i] || context_lens[i] <= 0)
+        {
+            return CVC_KEY_STORE_ERROR_INVALID_PARAMS;
+        }
+    }
+
+    // Load factor at most 1/2 keeps probe sequences short and guarantees a free slot
+    uint32_t slot_count = 2;
+    while (slot_count < 2 * (uint32_t)count)
+    {
+        slot_count <<= 1;
+    }
+
+    const uint64_t total = CVC_KEY_STORE_HEADER_SIZE + (uint64_t)slot_count * CVC_KEY_STORE_SLOT_SIZE;
+    if (total > SIZE_MAX)
+    {
+        return CVC_KEY_STORE_ERROR_ALLOCATION_FAILED;
+    }
+
+    unsigned char* digests = malloc((size_t)count * CVC_SHA256_DIGEST_SIZE);
+    unsigned char* image = calloc(1, (size_t)total);
+    if (!digests || !image)
+    {
+        free(digests);
+        free(image);
+        return CVC_KEY_STORE_ERROR_ALLOCATION_FAILED;
+    }
+
+    int result = CVC_KEY_STORE_SUCCESS;
+    if (cvc_sha256_batch(contexts, context_lens, count, digests) != CVC_SHA256_SUCCESS)
+    {
+        result = CVC_KEY_STORE_ERROR_INVALID_PARAMS;
+    }
+
+    memcpy(image, key_store_magic, sizeof(key_store_magic));
+    store_le32(image + 4, CVC_KEY_STORE_VERSION);
+    store_le32(image + 8, slot_count);
+    store_le32(image + 12, (uint32_t)count);
+    store_le32(image + 16, CVC_KEY_STORE_SLOT_SIZE);
+
+    unsigned char* slots = image + CVC_KEY_STORE_HEADER_SIZE;
+    const uint32_t slot_mask = slot_count - 1;
+    for (int i = 0; i < count && result == CVC_KEY_STORE_SUCCESS; i++)
+    {
+        const unsigned char* digest = digests + (size_t)i * CVC_SHA256_DIGEST_SIZE;
+        uint32_t index = home_slot(digest, slot_mask);
+        unsigned char* slot = slots + (size_t)index * CVC_KEY_STORE_SLOT_SIZE;
+        while (!slot_is_free(slot))
+        {
+            if (memcmp(slot, digest, CVC_SHA256_DIGEST_SIZE) == 0)
+            {
+                result = CVC_KEY_STORE_ERROR_DUPLICATE_CONTEXT;
+                break;
+            }
+            index = (index + 1) & slot_mask;
+            slot = slots + (size_t)index * CVC_KEY_STORE_SLOT_SIZE;
+        }
+
+        if (result == CVC_KEY_STORE_SUCCESS)
+        {
+            memcpy(slot, digest, CVC_SHA256_DIGEST_SIZE);
+            memcpy(slot + SLOT_X_OFFSET, key_materials[i].public_key_x_bytes, MODBYTES_256_56);
+            memcpy(slot + SLOT_Y_OFFSET, key_materials[i].public_key_y_bytes, MODBYTES_256_56);
+        }
+    }
+
+    if (result == CVC_KEY_STORE_SUCCESS)
+    {
+        result = write_file(path, image, (size_t)total);
+    }
+
+    free(digests);
+    free(image);
+    return result;
+}
+
+// Map the whole file read-only; *size receives its length
+static int map_file(const char* path, const unsigned char** base, size_t* size)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return CVC_KEY_STORE_ERROR_IO_FAILED;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size))
+    {
+        CloseHandle(file);
+        return CVC_KEY_STORE_ERROR_IO_FAILED;
+    }
+    if ((uint64_t)file_size.QuadPart < CVC_KEY_STORE_HEADER_SIZE || (uint64_t)file_size.QuadPart > SIZE_MAX)
+    {
+        CloseHandle(file);
+        return CVC_KEY_STORE_ERROR_INVALID_FORMAT;
+    }
+
+    // The view keeps the mapping, and the mapping the file, alive after the handles close
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping)
+    {
+        return CVC_KEY_STORE_ERROR_IO_FAILED;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view)
+    {
+        return CVC_KEY_STORE_ERROR_IO_FAILED;
+    }
+
+    *base = view;
+    *size = (size_t)file_size.QuadPart;
+#else
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return CVC_KEY_STORE_ERROR_IO_FAILED;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return CVC_KEY_STORE_ERROR_IO_FAILED;
+    }
+    if (st.st_size < CVC_KEY_STORE_HEADER_SIZE || (uint64_t)st.st_size > SIZE_MAX)
+    {
+        close(fd);
+        return CVC_KEY_STORE_ERROR_INVALID_FORMAT;
+    }
+
+    // The mapping outlives the descriptor
+    void* view = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED)
+    {
+        return CVC_KEY_STORE_ERROR_IO_FAILED;
+    }
+
+#ifdef MADV_RANDOM
+    // Lookups touch one or two slots at random; read-ahead would only waste page cache
+    madvise(view, (size_t)st.st_size, MADV_RANDOM);
+#endif
+
+    *base = view;
+    *size = (size_t)st.st_size;
+#endif
+
+    return CVC_KEY_STORE_SUCCESS;
+}
+
+static void unmap_file(const unsigned char* base, size_t size)
+{
+#ifdef _WIN32
+    (void)size;
+    UnmapViewOfFile(base);
+#else
+    munmap((void*)base, size);
+#endif
+}
+
+// Header checks; the slots themselves are never scanned
+static int check_header(const unsigned char* base, size_t size, uint32_t* slot_count, uint32_t* entry_count)
+{
+    if (memcmp(base, key_store_magic, sizeof(key_store_magic)) != 0 || load_le32(base + 4) != CVC_KEY_STORE_VERSION || load_le32(base + 16) != CVC_KEY_STORE_SLOT_SIZE)
+    {
+        return CVC_KEY_STORE_ERROR_INVALID_FORMAT;
+    }
+
+    // Reserved for later versions, so a version 1 reader insists they are zero
+    for (int i = 20; i < CVC_KEY_STORE_HEADER_SIZE; i++)
+    {
+        if (base[i] != 0)
+        {
+            return CVC_KEY_STORE_ERROR_INVALID_FORMAT;
+        }
+    }
+
+    *slot_count = load_le32(base + 8);
+    *entry_count = load_le32(base + 12);
+
+    // A power of two, a free slot for every miss to stop at, and exactly the slots on disk
+    if (*slot_count < 2 || (*slot_count & (*slot_count - 1)) != 0 || *entry_count > CVC_KEY_STORE_MAX_ENTRIES || *entry_count >= *slot_count)
+    {
+        return CVC_KEY_STORE_ERROR_INVALID_FORMAT;
+    }
+    if (CVC_KEY_STORE_HEADER_SIZE + (uint64_t)*slot_count * CVC_KEY_STORE_SLOT_SIZE != (uint64_t)size)
+    {
+        return CVC_KEY_STORE_ERROR_INVALID_FORMAT;
+    }
+
+    return CVC_KEY_STORE_SUCCESS;
+}
+
+int cvc_key_store_open(const char* path, cvc_key_store_t** store)
+{
+    // Basic parameter validation
+    if (!path || !store)
+    {
+        return CVC_KEY_STORE_ERROR_INVALID_PARAMS;
+    }
+    *store = NULL;
+
+    const unsigned char* base;
+    size_t size;
+    int result = map_file(path, &base, &size);
+    if (result != CVC_KEY_STORE_SUCCESS)
+    {
+        return result;
+    }
+
+    uint32_t slot_count, entry_count;
+    result = check_header(base, size, &slot_count, &entry_count);
+    if (result != CVC_KEY_STORE_SUCCESS)
+    {
+        unmap_file(base, size);
+        return result;
+    }
+
+    cvc_key_store_t* handle = malloc(sizeof(cvc_key_store_t));
+    if (!handle)
+    {
+        unmap_file(base, size);
+        return CVC_KEY_STORE_ERROR_ALLOCATION_FAILED;
+    }
+
+    handle->base = base;
+    handle->slots = base + CVC_KEY_STORE_HEADER_SIZE;
+    handle->size = size;
+    handle->slot_mask = slot_count - 1;
+    handle->count = (int)entry_count;
+
+    *store = handle;
+    return CVC_KEY_STORE_SUCCESS;
+}
+
+void cvc_key_store_close(cvc_key_store_t* store)
+{
+    if (store)
+    {
+        unmap_file(store->base, store->size);
+        free(store);
+    }
+}
+
+int cvc_key_store_count(const cvc_key_store_t* store)
+{
+    return store ? store->count : 0;
+}
+
+int cvc_key_store_lookup(const cvc_key_store_t* store, const unsigned char* context, int context_len, unsigned char* public_key, int public_key_size)
+{
+    // Basic parameter validation
+    if (!store || !context || context_len <= 0 || !public_key)
+    {
+        return CVC_KEY_STORE_ERROR_INVALID_PARAMS;
+    }
+
+    if (public_key_size < CVC_KEY_STORE_PUBLIC_KEY_LENGTH)
+    {
+        return CVC_KEY_STORE_ERROR_INSUFFICIENT_BUFFER;
+    }
+
+    unsigned char digest[CVC_SHA256_DIGEST_SIZE];
+    cvc_sha256(context, (size_t)context_len, digest);
+
+    // Bounded by the slot count so a corrupted file with no free slot cannot loop forever
+    uint32_t index = home_slot(digest, store->slot_mask);
+    for (uint32_t probes = 0; probes <= store->slot_mask; probes++)
+    {
+        const unsigned char* slot = store->slots + (size_t)index * CVC_KEY_STORE_SLOT_SIZE;
+        if (memcmp(slot, digest, CVC_SHA256_DIGEST_SIZE) == 0)
+        {
+            public_key[0] = 0x04;
+            memcpy(public_key + 1, slot + SLOT_X_OFFSET, 2 * MODBYTES_256_56);
+            return CVC_KEY_STORE_SUCCESS;
+        }
+        if (slot_is_free(slot))
+        {
+            break;
+        }
+        index = (index + 1) & store->slot_mask;
+    }
+
+    return CVC_KEY_STORE_ERROR_NOT_FOUND;
+}
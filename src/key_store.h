@@ -0,0 +1,117 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef KEY_STORE_H
+#define KEY_STORE_H
+
+#include "nist256_key_material.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Store file layout (all integers little-endian):
+ *
+ *     header   32 bytes: magic "CVKS", version, slot count, entry count, slot size, 12 reserved bytes (zero)
+ *     slots    slot count * 96 bytes: SHA-256(context) || X || Y, all zero when empty
+ *
+ * The slot count is a power of two at least twice the entry count, and a context
+ * lives in the first free slot at or after the low bits of its digest (linear
+ * probing). Only public halves are written.
+ */
+#define CVC_KEY_STORE_HEADER_SIZE 32
+#define CVC_KEY_STORE_SLOT_SIZE 96
+#define CVC_KEY_STORE_VERSION 1
+#define CVC_KEY_STORE_MAX_ENTRIES (1 << 26)
+#define CVC_KEY_STORE_PUBLIC_KEY_LENGTH 65
+
+/**
+ * @brief Result codes for key store operations
+ */
+typedef enum
+{
+    CVC_KEY_STORE_SUCCESS = 0,                    /**< Operation completed successfully */
+    CVC_KEY_STORE_ERROR_INVALID_PARAMS = -1,      /**< Invalid input parameters */
+    CVC_KEY_STORE_ERROR_ALLOCATION_FAILED = -2,   /**< Failed to allocate the table or the store handle */
+    CVC_KEY_STORE_ERROR_DUPLICATE_CONTEXT = -3,   /**< The same context appears twice in one write */
+    CVC_KEY_STORE_ERROR_IO_FAILED = -4,           /**< The file could not be created, written, opened or mapped */
+    CVC_KEY_STORE_ERROR_INVALID_FORMAT = -5,      /**< File is truncated, has a bad magic or an unsupported layout */
+    CVC_KEY_STORE_ERROR_NOT_FOUND = -6,           /**< No key is stored for the context */
+    CVC_KEY_STORE_ERROR_INSUFFICIENT_BUFFER = -7, /**< Output buffer is too small */
+} cvc_key_store_result_t;
+
+/**
+ * @brief Opaque read-only mapping of a key store file
+ *
+ * Opening maps the file and checks the 32-byte header; nothing else is read or
+ * copied, so startup cost does not grow with the number of keys and every process
+ * that opens the same file shares its pages through the page cache. Lookups hash
+ * the context once and probe the mapped slots in place. A store is immutable and
+ * may be shared between threads.
+ */
+typedef struct cvc_key_store cvc_key_store_t;
+
+/**
+ * @brief Write the public halves of key materials to a store file
+ *
+ * The table is built in memory, written to "<path>.tmp", flushed to stable storage
+ * and renamed over path (and the directory synced), so a reader that opens path
+ * sees either the old or the new store, even after a crash. On POSIX systems
+ * existing mappings of the old file stay valid; Windows refuses to replace a file
+ * that is still mapped. Private key bytes are never read.
+ *
+ * @param path File to create or replace
+ * @param contexts Context of each key (the lookup key)
+ * @param context_lens Length of each context
+ * @param key_materials Key material of each context; only the public halves are stored
+ * @param count Number of keys (1..CVC_KEY_STORE_MAX_ENTRIES)
+ * @return CVC_KEY_STORE_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_key_store_write(const char* path, const unsigned char* const* contexts, const int* context_lens, const nist256_key_material_t* key_materials, int count);
+
+/**
+ * @brief Map a store file read-only
+ *
+ * @param path Store file written by cvc_key_store_write
+ * @param store Output pointer receiving the new store handle
+ * @return CVC_KEY_STORE_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_key_store_open(const char* path, cvc_key_store_t** store);
+
+/**
+ * @brief Unmap a store
+ *
+ * @param store Store to close (NULL is ignored)
+ */
+void cvc_key_store_close(cvc_key_store_t* store);
+
+/**
+ * @brief Number of keys in a store
+ *
+ * @param store Open store
+ * @return Entry count, or 0 if store is NULL
+ */
+int cvc_key_store_count(const cvc_key_store_t* store);
+
+/**
+ * @brief Look up the public key stored for a context
+ *
+ * One SHA-256 of the context and, at the store's load factor of at most one half,
+ * about 1.5 slot reads on average for a hit. The key is copied as stored; decode
+ * it with validation if the file is not trusted.
+ *
+ * @param store Open store
+ * @param context Context bytes
+ * @param context_len Length of the context
+ * @param public_key Output buffer receiving the 65-byte uncompressed public key
+ * @param public_key_size Size of the output buffer
+ * @return CVC_KEY_STORE_SUCCESS on success, CVC_KEY_STORE_ERROR_NOT_FOUND if the context is absent, or another negative error code
+ */
+int cvc_key_store_lookup(const cvc_key_store_t* store, const unsigned char* context, int context_len, unsigned char* public_key, int public_key_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KEY_STORE_H
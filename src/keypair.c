@@ -0,0 +1,490 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "keypair.h"
+#include "ecdsa.h"
+#include "hash_to_field.h"
+#include "nist256_point_utils.h"
+#include "point_table.h"
+#include "secure_memory.h"
+#include "sha256.h"
+#include <string.h>
+
+// External ROM constants from rom_curve_NIST256.c
+extern const BIG_256_56 CURVE_Order_NIST256;
+
+struct cvc_nist256_keypair
+{
+    BIG_256_56 secret;                                            // d in [1, n-1]
+    ECP_NIST256 public_point;                                     // Q = d * G with Z = 1
+    unsigned char public_key_bytes[CVC_KEYPAIR_PUBLIC_KEY_LENGTH]; // Uncompressed encoding of Q
+    cvc_nist256_point_table_t* table;                             // Multiples of Q, only with CVC_KEYPAIR_PRECOMPUTE
+};
+
+// Allocate a key pair for d; public_point (Z = 1) is computed from d when NULL
+static int keypair_create(BIG_256_56 d, const ECP_NIST256* public_point, int flags, cvc_nist256_keypair_t** keypair)
+{
+    BIG_256_56 curve_order;
+    BIG_256_56_rcopy(curve_order, CURVE_Order_NIST256);
+    if (BIG_256_56_iszilch(d) || BIG_256_56_comp(d, curve_order) >= 0)
+    {
+        return CVC_KEYPAIR_ERROR_INVALID_KEY;
+    }
+
+    cvc_nist256_keypair_t* result = cvc_secure_alloc(sizeof(cvc_nist256_keypair_t), NULL);
+    if (!result)
+    {
+        return CVC_KEYPAIR_ERROR_ALLOCATION_FAILED;
+    }
+
+    BIG_256_56_copy(result->secret, d);
+    if (public_point)
+    {
+        result->public_point = *public_point;
+    }
+    else
+    {
+        nist256_mul_base(&result->public_point, d);
+        ECP_NIST256_affine(&result->public_point);
+    }
+    nist256_affine_to_bytes(&result->public_point, result->public_key_bytes);
+
+    if (flags & CVC_KEYPAIR_PRECOMPUTE)
+    {
+        if (nist256_point_table_build(&result->public_point, &result->table) != CVC_POINT_TABLE_SUCCESS)
+        {
+            cvc_secure_free(result, sizeof(cvc_nist256_keypair_t));
+            return CVC_KEYPAIR_ERROR_ALLOCATION_FAILED;
+        }
+    }
+
+    *keypair = result;
+    return CVC_KEYPAIR_SUCCESS;
+}
+
+int cvc_nist256_keypair_from_secret(const unsigned char* secret_key_bytes, int secret_key_len, int flags, cvc_nist256_keypair_t** keypair)
+{
+    // Basic parameter validation
+    if (!secret_key_bytes || secret_key_len != MODBYTES_256_56 || !keypair)
+    {
+        return CVC_KEYPAIR_ERROR_INVALID_PARAMS;
+    }
+
+    *keypair = NULL;
+
+    BIG_256_56 d;
+    BIG_256_56_fromBytes(d, (char*)secret_key_bytes);
+    const int result = keypair_create(d, NULL, flags, keypair);
+    BIG_256_56_zero(d);
+
+    return result;
+}
+
+int cvc_nist256_keypair_generate(unsigned char* random_seed, int seed_len, int flags, cvc_nist256_keypair_t** keypair)
+{
+    // Basic parameter validation
+    if (!random_seed || seed_len < 16 || !keypair)
+    {
+        return CVC_KEYPAIR_ERROR_INVALID_PARAMS;
+    }
+
+    *keypair = NULL;
+
+    BIG_256_56 d;
+    if (nist256_generate_secret_key(d, random_seed, seed_len) != 0)
+    {
+        BIG_256_56_zero(d);
+        return CVC_KEYPAIR_ERROR_INVALID_KEY;
+    }
+    const int result = keypair_create(d, NULL, flags, keypair);
+    BIG_256_56_zero(d);
+
+    return result;
+}
+
+int cvc_nist256_keypair_derive(const unsigned char* master_key_bytes, int master_key_len, const unsigned char* context, int context_len, const unsigned char* dst, int dst_len, int flags, cvc_nist256_keypair_t** keypair)
+{
+    // Basic parameter validation
+    if (!master_key_bytes || master_key_len <= 0 || !context || context_len <= 0 || !dst || dst_len <= 0 || !keypair)
+    {
+        return CVC_KEYPAIR_ERROR_INVALID_PARAMS;
+    }
+
+    *keypair = NULL;
+
+    BIG_256_56 d;
+    if (cvc_derive_secret_scalar_nist256(master_key_bytes, master_key_len, context, context_len, dst, dst_len, d) != CVC_DERIVE_KEY_SUCCESS)
+    {
+        BIG_256_56_zero(d);
+        return CVC_KEYPAIR_ERROR_DERIVE_FAILED;
+    }
+    const int result = keypair_create(d, NULL, flags, keypair);
+    BIG_256_56_zero(d);
+
+    return result;
+}
+
+int cvc_nist256_keypair_derive_child(const cvc_nist256_keypair_t* parent, const unsigned char* context, int context_len, const unsigned char* dst, int dst_len, int flags, cvc_nist256_keypair_t** child)
+{
+    // Basic parameter validation
+    if (!parent || !child)
+    {
+        return CVC_KEYPAIR_ERROR_INVALID_PARAMS;
+    }
+
+    BIG_256_56 parent_secret;
+    BIG_256_56_copy(parent_secret, (chunk*)parent->secret);
+    unsigned char master_key_bytes[MODBYTES_256_56];
+    BIG_256_56_toBytes((char*)master_key_bytes, parent_secret);
+
+    const int result = cvc_nist256_keypair_derive(master_key_bytes, sizeof(master_key_bytes), context, context_len, dst, dst_len, flags, child);
+
+    cvc_secure_zero(master_key_bytes, sizeof(master_key_bytes));
+    BIG_256_56_zero(parent_secret);
+
+    return result;
+}
+
+int cvc_nist256_keypair_add(const cvc_nist256_keypair_t* a, const cvc_nist256_keypair_t* b, int flags, cvc_nist256_keypair_t** sum)
+{
+    // Basic parameter validation
+    if (!a || !b || !sum)
+    {
+        return CVC_KEYPAIR_ERROR_INVALID_PARAMS;
+    }
+
+    *sum = NULL;
+
+    BIG_256_56 curve_order, d;
+    BIG_256_56_rcopy(curve_order, CURVE_Order_NIST256);
+    BIG_256_56_modadd(d, (chunk*)a->secret, (chunk*)b->secret, curve_order);
+    if (BIG_256_56_iszilch(d))
+    {
+        return CVC_KEYPAIR_ERROR_RESULT_ZERO;
+    }
+
+    // Both public points are affine, so the sum costs one inversion instead of d * G
+    ECP_NIST256 p = a->public_point;
+    ECP_NIST256 q = b->public_point;
+    ECP_NIST256 public_point;
+    if (!nist256_add_affine(&public_point, &p, &q))
+    {
+        BIG_256_56_zero(d);
+        return CVC_KEYPAIR_ERROR_RESULT_ZERO;
+    }
+
+    const int result = keypair_create(d, &public_point, flags, sum);
+    BIG_256_56_zero(d);
+
+    return result;
+}
+
+int cvc_nist256_keypair_ecdh(const cvc_nist256_keypair_t* keypair, cvc_public_key_set_t* key_set, const unsigned char* peer_key_bytes, int peer_key_len, unsigned char* shared_secret, int shared_secret_size)
+{
+    // Basic parameter validation
+    if (!keypair || !peer_key_bytes || !shared_secret)
+    {
+        return CVC_KEYPAIR_ERROR_INVALID_PARAMS;
+    }
+
+    if (shared_secret_size < CVC_KEYPAIR_SHARED_SECRET_LENGTH)
+    {
+        return CVC_KEYPAIR_ERROR_INSUFFICIENT_BUFFER;
+    }
+
+    ECP_NIST256 P;
+    if (peer_key_len != CVC_KEYPAIR_PUBLIC_KEY_LENGTH || !cvc_public_key_set_decode(key_set, peer_key_bytes, &P))
+    {
+        return CVC_KEYPAIR_ERROR_INVALID_PEER_KEY;
+    }
+
+    // MIRACL's variable-base multiplication is a constant-time fixed window
+    BIG_256_56 d;
+    BIG_256_56_copy(d, (chunk*)keypair->secret);
+    ECP_NIST256_mul(&P, d);
+    BIG_256_56_zero(d);
+
+    // P-256 has prime order, so a valid peer key and d in [1, n-1] never give infinity
+    if (ECP_NIST256_isinf(&P))
+    {
+        return CVC_KEYPAIR_ERROR_INVALID_PEER_KEY;
+    }
+
+    BIG_256_56 x, y;
+    ECP_NIST256_get(x, y, &P);
+    BIG_256_56_toBytes((char*)shared_secret, x);
+
+    cvc_secure_zero(&P, sizeof(P));
+    BIG_256_56_zero(x);
+    BIG_256_56_zero(y);
+
+    return CVC_KEYPAIR_SUCCESS;
+}
+
+int cvc_nist256_keypair_ecdh_table(const cvc_nist256_keypair_t* keypair, const cvc_nist256_point_table_t* peer_table, unsigned char* shared_secret, int shared_secret_size)
+{
+    // Basic parameter validation
+    if (!keypair || !peer_table || !shared_secret)
+    {
+        return CVC_KEYPAIR_ERROR_INVALID_PARAMS;
+    }
+
+    if (shared_secret_size < CVC_KEYPAIR_SHARED_SECRET_LENGTH)
+    {
+        return CVC_KEYPAIR_ERROR_INSUFFICIENT_BUFFER;
+    }
+
+    // The peer was validated when its table was built, so only lookups and additions remain
+    BIG_256_56 d, x, y;
+    BIG_256_56_copy(d, (chunk*)keypair->secret);
+    ECP_NIST256 P;
+    nist256_point_table_mul(&P, peer_table, d);
+    BIG_256_56_zero(d);
+
+    ECP_NIST256_get(x, y, &P);
+    BIG_256_56_toBytes((char*)shared_secret, x);
+
+    cvc_secure_zero(&P, sizeof(P));
+    BIG_256_56_zero(x);
+    BIG_256_56_zero(y);
+
+    return CVC_KEYPAIR_SUCCESS;
+}
+
+// HMAC-SHA-256 with a 32-byte key over the concatenation of up to four parts
+static void hmac_sha256(const unsigned char key[CVC_SHA256_DIGEST_SIZE], const unsigned char* const* parts, const size_t* part_lens, int part_count, unsigned char mac[CVC_SHA256_DIGEST_SIZE])
+{
+    unsigned char pad[64];
+    unsigned char inner_digest[CVC_SHA256_DIGEST_SIZE];
+    cvc_sha256_ctx ctx;
+
+    memset(pad, 0x36, sizeof(pad));
+    for (int i = 0; i < CVC_SHA256_DIGEST_SIZE; i++)
+    {
+        pad[i] ^= key[i];
+    }
+    cvc_sha256_init(&ctx);
+    cvc_sha256_update(&ctx, pad, sizeof(pad));
+    for (int i = 0; i < part_count; i++)
+    {
+        cvc_sha256_update(&ctx, parts[i], part_lens[i]);
+    }
+    cvc_sha256_final(&ctx, inner_digest);
+
+    memset(pad, 0x5C, sizeof(pad));
+    for (int i = 0; i < CVC_SHA256_DIGEST_SIZE; i++)
+    {
+        pad[i] ^= key[i];
+    }
+    cvc_sha256_init(&ctx);
+    cvc_sha256_update(&ctx, pad, sizeof(pad));
+    cvc_sha256_update(&ctx, inner_digest, sizeof(inner_digest));
+    cvc_sha256_final(&ctx, mac);
+
+    cvc_secure_zero(pad, sizeof(pad));
+    cvc_secure_zero(inner_digest, sizeof(inner_digest));
+    cvc_secure_zero(&ctx, sizeof(ctx));
+}
+
+// HMAC-DRBG state of RFC 6979, Section 3.2
+typedef struct
+{
+    unsigned char k[CVC_SHA256_DIGEST_SIZE];
+    unsigned char v[CVC_SHA256_DIGEST_SIZE];
+    int started;
+} rfc6979_state_t;
+
+// K = HMAC_K(V || separator [|| x || h]), V = HMAC_K(V)
+static void rfc6979_update(rfc6979_state_t* state, unsigned char separator, const unsigned char* x, const unsigned char* h)
+{
+    const unsigned char* parts[4] = { state->v, &separator, x, h };
+    const size_t part_lens[4] = { sizeof(state->v), 1, MODBYTES_256_56, MODBYTES_256_56 };
+    hmac_sha256(state->k, parts, part_lens, x ? 4 : 2, state->k);
+
+    const unsigned char* v_part[1] = { state->v };
+    const size_t v_len[1] = { sizeof(state->v) };
+    hmac_sha256(state->k, v_part, v_len, 1, state->v);
+}
+
+// Steps a-f: seed the DRBG with the private key and the reduced digest
+static void rfc6979_init(rfc6979_state_t* state, const unsigned char* x, const unsigned char* h)
+{
+    memset(state->v, 0x01, sizeof(state->v));
+    memset(state->k, 0x00, sizeof(state->k));
+    state->started = 0;
+    rfc6979_update(state, 0x00, x, h);
+    rfc6979_update(state, 0x01, x, h);
+}
+
+// Step h: next candidate in [1, n-1]; every call after the first reseeds as for a rejected k
+static void rfc6979_next(rfc6979_state_t* state, BIG_256_56 curve_order, BIG_256_56 out)
+{
+    for (;;)
+    {
+        if (state->started)
+        {
+            rfc6979_update(state, 0x00, NULL, NULL);
+        }
+        state->started = 1;
+
+        // qlen = hlen = 256, so one HMAC output is exactly one candidate
+        const unsigned char* v_part[1] = { state->v };
+        const size_t v_len[1] = { sizeof(state->v) };
+        hmac_sha256(state->k, v_part, v_len, 1, state->v);
+
+        BIG_256_56_fromBytes(out, (char*)state->v);
+        if (!BIG_256_56_iszilch(out) && BIG_256_56_comp(out, curve_order) < 0)
+        {
+            return;
+        }
+    }
+}
+
+// e = digest mod n (bits2int for qlen = 256, then one reduction)
+static void digest_to_scalar(const unsigned char* digest, BIG_256_56 curve_order, BIG_256_56 e)
+{
+    BIG_256_56_fromBytes(e, (char*)digest);
+    BIG_256_56_mod(e, curve_order);
+}
+
+// x-coordinate of a finite point, reduced mod n
+static void point_x_mod_order(ECP_NIST256* R, BIG_256_56 curve_order, BIG_256_56 r)
+{
+    BIG_256_56 y;
+    ECP_NIST256_get(r, y, R);
+    BIG_256_56_mod(r, curve_order);
+}
+
+int cvc_nist256_keypair_sign(const cvc_nist256_keypair_t* keypair, const unsigned char* digest, int digest_len, unsigned char* signature, int signature_size)
+{
+    // Basic parameter validation
+    if (!keypair || !digest || digest_len != CVC_KEYPAIR_DIGEST_LENGTH || !signature)
+    {
+        return CVC_KEYPAIR_ERROR_INVALID_PARAMS;
+    }
+
+    if (signature_size < CVC_KEYPAIR_SIGNATURE_LENGTH)
+    {
+        return CVC_KEYPAIR_ERROR_INSUFFICIENT_BUFFER;
+    }
+
+    BIG_256_56 curve_order, d, e, k, k_inverse, blind, r, s, t;
+    BIG_256_56_rcopy(curve_order, CURVE_Order_NIST256);
+    BIG_256_56_copy(d, (chunk*)keypair->secret);
+    digest_to_scalar(digest, curve_order, e);
+
+    unsigned char x_bytes[MODBYTES_256_56], h_bytes[MODBYTES_256_56];
+    BIG_256_56_toBytes((char*)x_bytes, d);
+    BIG_256_56_toBytes((char*)h_bytes, e);
+
+    rfc6979_state_t drbg;
+    rfc6979_init(&drbg, x_bytes, h_bytes);
+
+    ECP_NIST256 R;
+    for (;;)
+    {
+        rfc6979_next(&drbg, curve_order, k);
+
+        // r = x(k * G) mod n
+        nist256_mul_base(&R, k);
+        ECP_NIST256_affine(&R);
+        point_x_mod_order(&R, curve_order, r);
+        if (BIG_256_56_iszilch(r))
+        {
+            continue;
+        }
+
+        // k^-1 = b * (k * b)^-1, so the variable-time inversion never sees k itself
+        rfc6979_next(&drbg, curve_order, blind);
+        BIG_256_56_modmul(t, k, blind, curve_order);
+        BIG_256_56_invmodp(k_inverse, t, curve_order);
+        BIG_256_56_modmul(k_inverse, k_inverse, blind, curve_order);
+
+        // s = k^-1 * (e + r * d) mod n
+        BIG_256_56_modmul(t, r, d, curve_order);
+        BIG_256_56_modadd(t, t, e, curve_order);
+        BIG_256_56_modmul(s, k_inverse, t, curve_order);
+        if (!BIG_256_56_iszilch(s))
+        {
+            break;
+        }
+    }
+
+    BIG_256_56_toBytes((char*)signature, r);
+    BIG_256_56_toBytes((char*)signature + MODBYTES_256_56, s);
+
+    // Wipe everything derived from d or k
+    BIG_256_56_zero(d);
+    BIG_256_56_zero(k);
+    BIG_256_56_zero(k_inverse);
+    BIG_256_56_zero(blind);
+    BIG_256_56_zero(t);
+    cvc_secure_zero(x_bytes, sizeof(x_bytes));
+    cvc_secure_zero(&drbg, sizeof(drbg));
+    cvc_secure_zero(&R, sizeof(R));
+
+    return CVC_KEYPAIR_SUCCESS;
+}
+
+int cvc_nist256_keypair_verify(const cvc_nist256_keypair_t* keypair, const unsigned char* digest, int digest_len, const unsigned char* signature, int signature_len)
+{
+    // Basic parameter validation
+    if (!keypair || !digest || digest_len != CVC_KEYPAIR_DIGEST_LENGTH || !signature || signature_len != CVC_KEYPAIR_SIGNATURE_LENGTH)
+    {
+        return CVC_KEYPAIR_ERROR_INVALID_PARAMS;
+    }
+
+    return nist256_ecdsa_verify((ECP_NIST256*)&keypair->public_point, keypair->table, digest, signature) ? CVC_KEYPAIR_SUCCESS : CVC_KEYPAIR_ERROR_INVALID_SIGNATURE;
+}
+
+int cvc_nist256_keypair_export(const cvc_nist256_keypair_t* keypair, nist256_key_material_t* key_material)
+{
+    if (!keypair || !key_material)
+    {
+        return CVC_KEYPAIR_ERROR_INVALID_PARAMS;
+    }
+
+    BIG_256_56 d;
+    BIG_256_56_copy(d, (chunk*)keypair->secret);
+    BIG_256_56_toBytes((char*)key_material->private_key_bytes, d);
+    BIG_256_56_zero(d);
+
+    memcpy(key_material->public_key_x_bytes, keypair->public_key_bytes + 1, MODBYTES_256_56);
+    memcpy(key_material->public_key_y_bytes, keypair->public_key_bytes + 1 + MODBYTES_256_56, MODBYTES_256_56);
+
+    return CVC_KEYPAIR_SUCCESS;
+}
+
+int cvc_nist256_keypair_public_key(const cvc_nist256_keypair_t* keypair, unsigned char* public_key, int public_key_size)
+{
+    if (!keypair || !public_key)
+    {
+        return CVC_KEYPAIR_ERROR_INVALID_PARAMS;
+    }
+
+    if (public_key_size < CVC_KEYPAIR_PUBLIC_KEY_LENGTH)
+    {
+        return CVC_KEYPAIR_ERROR_INSUFFICIENT_BUFFER;
+    }
+
+    memcpy(public_key, keypair->public_key_bytes, CVC_KEYPAIR_PUBLIC_KEY_LENGTH);
+
+    return CVC_KEYPAIR_SUCCESS;
+}
+
+const cvc_nist256_point_table_t* cvc_nist256_keypair_table(const cvc_nist256_keypair_t* keypair)
+{
+    return keypair ? keypair->table : NULL;
+}
+
+void cvc_nist256_keypair_destroy(cvc_nist256_keypair_t* keypair)
+{
+    if (!keypair)
+    {
+        return;
+    }
+
+    // The table only holds multiples of the public point
+    cvc_nist256_point_table_destroy(keypair->table);
+    cvc_secure_free(keypair, sizeof(cvc_nist256_keypair_t));
+}
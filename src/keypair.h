@@ -0,0 +1,224 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef KEYPAIR_H
+#define KEYPAIR_H
+
+#include "nist256_key_material.h"
+#include "point_table.h"
+#include "public_key_set.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Length of an uncompressed public key and of an ECDSA signature (r || s)
+#define CVC_KEYPAIR_PUBLIC_KEY_LENGTH 65
+#define CVC_KEYPAIR_SIGNATURE_LENGTH 64
+#define CVC_KEYPAIR_SHARED_SECRET_LENGTH 32
+#define CVC_KEYPAIR_DIGEST_LENGTH 32
+
+/**
+ * @brief Creation flags for key pairs
+ */
+#define CVC_KEYPAIR_PRECOMPUTE 1 /**< Build a fixed-base table of the public point (speeds up verify, costs ~75 KB) */
+
+/**
+ * @brief Result codes for key pair operations
+ */
+typedef enum
+{
+    CVC_KEYPAIR_SUCCESS = 0,                    /**< Operation completed successfully */
+    CVC_KEYPAIR_ERROR_INVALID_PARAMS = -1,      /**< Invalid input parameters */
+    CVC_KEYPAIR_ERROR_ALLOCATION_FAILED = -2,   /**< Failed to allocate the key pair or its table */
+    CVC_KEYPAIR_ERROR_INVALID_KEY = -3,         /**< Secret key is zero or >= curve order */
+    CVC_KEYPAIR_ERROR_RESULT_ZERO = -4,         /**< Sum of secret keys is zero */
+    CVC_KEYPAIR_ERROR_DERIVE_FAILED = -5,       /**< Key derivation failed */
+    CVC_KEYPAIR_ERROR_INVALID_PEER_KEY = -6,    /**< Peer public key is malformed or not on the curve */
+    CVC_KEYPAIR_ERROR_INSUFFICIENT_BUFFER = -7, /**< Output buffer is too small */
+    CVC_KEYPAIR_ERROR_INVALID_SIGNATURE = -8,   /**< Signature does not verify */
+} cvc_keypair_result_t;
+
+/**
+ * @brief Opaque NIST P-256 key pair kept in internal form
+ *
+ * Holds the secret scalar as a BIG_256_56 and the public point as an affine
+ * ECP_NIST256 together with its encoding, so chained operations (derive, add, ECDH,
+ * sign) never re-parse bytes. The structure lives in memory from cvc_secure_alloc.
+ * A key pair is immutable after creation and may be used from any number of threads.
+ */
+typedef struct cvc_nist256_keypair cvc_nist256_keypair_t;
+
+/**
+ * @brief Create a key pair from a 32-byte big-endian secret key
+ *
+ * @param secret_key_bytes Secret key bytes
+ * @param secret_key_len Length of the secret key (must be 32)
+ * @param flags 0 or CVC_KEYPAIR_PRECOMPUTE
+ * @param keypair Output pointer receiving the new key pair
+ * @return CVC_KEYPAIR_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_nist256_keypair_from_secret(const unsigned char* secret_key_bytes, int secret_key_len, int flags, cvc_nist256_keypair_t** keypair);
+
+/**
+ * @brief Generate a random key pair from seed bytes
+ *
+ * Same scalar as nist256_generate_secret_key for the same seed.
+ *
+ * @param random_seed Array of random bytes for seeding the RNG (at least 16 bytes)
+ * @param seed_len Length of the random seed array
+ * @param flags 0 or CVC_KEYPAIR_PRECOMPUTE
+ * @param keypair Output pointer receiving the new key pair
+ * @return CVC_KEYPAIR_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_nist256_keypair_generate(unsigned char* random_seed, int seed_len, int flags, cvc_nist256_keypair_t** keypair);
+
+/**
+ * @brief Derive a key pair from master key material
+ *
+ * Produces the same key as cvc_derive_secret_key_nist256 with the same inputs.
+ *
+ * @param master_key_bytes Master key material as byte array
+ * @param master_key_len Length of the master key material
+ * @param context Context bytes for key derivation
+ * @param context_len Length of the context
+ * @param dst Domain Separation Tag as byte array
+ * @param dst_len Length of the DST
+ * @param flags 0 or CVC_KEYPAIR_PRECOMPUTE
+ * @param keypair Output pointer receiving the new key pair
+ * @return CVC_KEYPAIR_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_nist256_keypair_derive(const unsigned char* master_key_bytes, int master_key_len, const unsigned char* context, int context_len, const unsigned char* dst, int dst_len, int flags, cvc_nist256_keypair_t** keypair);
+
+/**
+ * @brief Derive a child key pair using a parent's secret key as master key material
+ *
+ * Equivalent to cvc_derive_secret_key_nist256(parent private key bytes, ...), without
+ * the parent ever leaving internal form in the caller's memory.
+ *
+ * @param parent Parent key pair
+ * @param context Context bytes for key derivation
+ * @param context_len Length of the context
+ * @param dst Domain Separation Tag as byte array
+ * @param dst_len Length of the DST
+ * @param flags 0 or CVC_KEYPAIR_PRECOMPUTE
+ * @param child Output pointer receiving the new key pair
+ * @return CVC_KEYPAIR_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_nist256_keypair_derive_child(const cvc_nist256_keypair_t* parent, const unsigned char* context, int context_len, const unsigned char* dst, int dst_len, int flags, cvc_nist256_keypair_t** child);
+
+/**
+ * @brief Add two key pairs: secret d1 + d2 mod n, public Q1 + Q2
+ *
+ * The public key of the sum is one point addition of the stored points instead of a
+ * full scalar multiplication, and matches cvc_add_nist256_secret_keys.
+ *
+ * @param a First key pair
+ * @param b Second key pair
+ * @param flags 0 or CVC_KEYPAIR_PRECOMPUTE
+ * @param sum Output pointer receiving the new key pair
+ * @return CVC_KEYPAIR_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_nist256_keypair_add(const cvc_nist256_keypair_t* a, const cvc_nist256_keypair_t* b, int flags, cvc_nist256_keypair_t** sum);
+
+/**
+ * @brief ECDH: x-coordinate of secret * peer public key
+ *
+ * The peer key is fully validated (SEC1 uncompressed, on the curve, not infinity);
+ * passing a public key set reuses earlier validations of the same key.
+ *
+ * @param keypair Own key pair
+ * @param key_set Optional validated key set (may be NULL)
+ * @param peer_key_bytes Peer public key (65 bytes uncompressed)
+ * @param peer_key_len Length of the peer public key
+ * @param shared_secret Output buffer receiving the 32-byte shared x-coordinate
+ * @param shared_secret_size Size of the output buffer
+ * @return CVC_KEYPAIR_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_nist256_keypair_ecdh(const cvc_nist256_keypair_t* keypair, cvc_public_key_set_t* key_set, const unsigned char* peer_key_bytes, int peer_key_len, unsigned char* shared_secret, int shared_secret_size);
+
+/**
+ * @brief ECDH against a peer whose point table was precomputed
+ *
+ * Same result as cvc_nist256_keypair_ecdh with the table's public key, but the
+ * multiplication is only table lookups and additions. Worth it for a peer key (an
+ * issuer or service key) that many key pairs agree with.
+ *
+ * @param keypair Own key pair
+ * @param peer_table Table from cvc_nist256_point_precompute or cvc_nist256_keypair_table
+ * @param shared_secret Output buffer receiving the 32-byte shared x-coordinate
+ * @param shared_secret_size Size of the output buffer
+ * @return CVC_KEYPAIR_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_nist256_keypair_ecdh_table(const cvc_nist256_keypair_t* keypair, const cvc_nist256_point_table_t* peer_table, unsigned char* shared_secret, int shared_secret_size);
+
+/**
+ * @brief Deterministic ECDSA signature (RFC 6979, HMAC-SHA-256) over a SHA-256 digest
+ *
+ * The nonce point comes from a shared fixed-base table of G; the nonce inversion is
+ * blinded with a second value from the same HMAC-DRBG.
+ *
+ * @param keypair Signing key pair
+ * @param digest Message digest
+ * @param digest_len Length of the digest (must be 32)
+ * @param signature Output buffer receiving r || s (64 bytes, big-endian)
+ * @param signature_size Size of the output buffer
+ * @return CVC_KEYPAIR_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_nist256_keypair_sign(const cvc_nist256_keypair_t* keypair, const unsigned char* digest, int digest_len, unsigned char* signature, int signature_size);
+
+/**
+ * @brief Verify an ECDSA signature against the key pair's public key
+ *
+ * Same check as cvc_ecdsa_nist256_verify. With CVC_KEYPAIR_PRECOMPUTE, u2 * Q is read
+ * from the key's own table and u1 * G from the shared base table, so verification
+ * needs no point doublings.
+ *
+ * @param keypair Key pair whose public key is checked
+ * @param digest Message digest
+ * @param digest_len Length of the digest (must be 32)
+ * @param signature Signature r || s
+ * @param signature_len Length of the signature (must be 64)
+ * @return CVC_KEYPAIR_SUCCESS if valid, CVC_KEYPAIR_ERROR_INVALID_SIGNATURE if not, or another error code
+ */
+int cvc_nist256_keypair_verify(const cvc_nist256_keypair_t* keypair, const unsigned char* digest, int digest_len, const unsigned char* signature, int signature_len);
+
+/**
+ * @brief Export the key pair as ordinary key material
+ *
+ * @param keypair Key pair to export
+ * @param key_material Output structure (e.g. a slot from cvc_key_pool_alloc)
+ * @return CVC_KEYPAIR_SUCCESS on success, or CVC_KEYPAIR_ERROR_INVALID_PARAMS
+ */
+int cvc_nist256_keypair_export(const cvc_nist256_keypair_t* keypair, nist256_key_material_t* key_material);
+
+/**
+ * @brief Copy the uncompressed public key encoding
+ *
+ * @param keypair Key pair
+ * @param public_key Output buffer receiving 65 bytes
+ * @param public_key_size Size of the output buffer
+ * @return CVC_KEYPAIR_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_nist256_keypair_public_key(const cvc_nist256_keypair_t* keypair, unsigned char* public_key, int public_key_size);
+
+/**
+ * @brief Point table of the key pair's public key
+ *
+ * @param keypair Key pair
+ * @return The table built by CVC_KEYPAIR_PRECOMPUTE (owned by the key pair), or NULL
+ */
+const cvc_nist256_point_table_t* cvc_nist256_keypair_table(const cvc_nist256_keypair_t* keypair);
+
+/**
+ * @brief Zeroize and release a key pair
+ *
+ * @param keypair Key pair to destroy (NULL is ignored)
+ */
+void cvc_nist256_keypair_destroy(cvc_nist256_keypair_t* keypair);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KEYPAIR_H
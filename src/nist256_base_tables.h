@@ -0,0 +1,34 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef NIST256_BASE_TABLES_H
+#define NIST256_BASE_TABLES_H
+
+#include "nist256_point_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Odd multiples G, 3G, ..., 127G for a width-8 NAF of the generator
+#define NIST256_GENERATOR_ODD_MULTIPLES 64
+
+/*
+ * Generator tables computed at build time by cmake/gen_nist256_base_tables.py.
+ * They are const data in MIRACL's internal form (affine, Montgomery residues fully
+ * reduced), so they sit in read-only pages shared by every process that maps the
+ * library, and need no initialization. tests/test_base_tables.c checks them
+ * against MIRACL's own arithmetic.
+ */
+
+// rows[i][j] = (j + 1) * 16^i * G, Z = 1: the signed-window comb of nist256_mul_base
+extern const ECP_NIST256 nist256_base_rows[NIST256_SIGNED_WINDOWS][NIST256_WINDOW_ENTRIES];
+
+// nist256_generator_odd_multiples[i] = (2i + 1) * G, Z = 1
+extern const ECP_NIST256 nist256_generator_odd_multiples[NIST256_GENERATOR_ODD_MULTIPLES];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NIST256_BASE_TABLES_H
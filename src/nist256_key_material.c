@@ -95,4 +95,24 @@ int nist256_big_to_key_material(BIG_256_56 d, nist256_key_material_t* key_materi
     BIG_256_56_toBytes((char*)key_material->public_key_y_bytes, y_coord);
 
     return 0; // Success
+}
+
+int nist256_generate_key_material(unsigned char* random_seed, int seed_len, nist256_key_material_t* key_material)
+{
+    if (!key_material)
+    {
+        return -1; // Invalid parameter
+    }
+
+    BIG_256_56 secret_key;
+    int result = nist256_generate_secret_key(secret_key, random_seed, seed_len);
+    if (result == 0)
+    {
+        result = nist256_big_to_key_material(secret_key, key_material);
+    }
+
+    // Wipe the intermediate scalar
+    BIG_256_56_zero(secret_key);
+
+    return result;
 }
\ No newline at end of file
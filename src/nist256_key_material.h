@@ -47,6 +47,19 @@ int nist256_generate_secret_key(BIG_256_56 secret_key, unsigned char* random_see
  */
 int nist256_big_to_key_material(BIG_256_56 d, nist256_key_material_t* key_material);
 
+/**
+ * @brief Generate a random NIST P-256 key pair and extract its key material
+ *
+ * Convenience wrapper combining nist256_generate_secret_key and
+ * nist256_big_to_key_material. The intermediate scalar is wiped before returning.
+ *
+ * @param random_seed Array of random bytes for seeding the RNG
+ * @param seed_len Length of the random seed array (recommended: 32 bytes)
+ * @param key_material Pointer to structure to hold the generated key material
+ * @return 0 on success, non-zero on error
+ */
+int nist256_generate_key_material(unsigned char* random_seed, int seed_len, nist256_key_material_t* key_material);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,229 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "nist256_point_utils.h"
+#include "secure_memory.h"
+
+// Points normalized per inversion; bounds the prefix product buffer on the stack
+#ifdef CVC_LOW_STACK
+#define NIST256_NORMALIZE_CHUNK 16
+#else
+#define NIST256_NORMALIZE_CHUNK 64
+#endif
+
+// Copy Z of a point, substituting 1 for points at infinity so they don't zero the product
+static void nonzero_z(FP_NIST256* z, ECP_NIST256* P, FP_NIST256* one)
+{
+    FP_NIST256_copy(z, &P->z);
+    FP_NIST256_cmove(z, one, FP_NIST256_iszilch(&P->z));
+}
+
+static void normalize_chunk(ECP_NIST256* points, int count, FP_NIST256* one)
+{
+    FP_NIST256 prefix[NIST256_NORMALIZE_CHUNK];
+    FP_NIST256 z, accumulator;
+
+    // prefix[i] = z_0 * z_1 * ... * z_i
+    FP_NIST256_copy(&accumulator, one);
+    for (int i = 0; i < count; i++)
+    {
+        nonzero_z(&z, &points[i], one);
+        FP_NIST256_mul(&accumulator, &accumulator, &z);
+        FP_NIST256_copy(&prefix[i], &accumulator);
+    }
+
+    // inverse = 1 / (z_0 * ... * z_{count-1})
+    FP_NIST256 inverse;
+    FP_NIST256_inv(&inverse, &accumulator, NULL);
+
+    for (int i = count - 1; i >= 0; i--)
+    {
+        // z_inverse = 1 / z_i; inverse becomes 1 / (z_0 * ... * z_{i-1})
+        FP_NIST256 z_inverse;
+        if (i > 0)
+        {
+            FP_NIST256_mul(&z_inverse, &inverse, &prefix[i - 1]);
+        }
+        else
+        {
+            FP_NIST256_copy(&z_inverse, &inverse);
+        }
+        nonzero_z(&z, &points[i], one);
+        FP_NIST256_mul(&inverse, &inverse, &z);
+
+        const int at_infinity = FP_NIST256_iszilch(&points[i].z);
+        FP_NIST256_mul(&points[i].x, &points[i].x, &z_inverse);
+        FP_NIST256_mul(&points[i].y, &points[i].y, &z_inverse);
+        FP_NIST256_reduce(&points[i].x);
+        FP_NIST256_reduce(&points[i].y);
+
+        // Z = 1, except at infinity where it stays 0
+        FP_NIST256_cmove(&points[i].z, one, 1 - at_infinity);
+    }
+}
+
+void nist256_batch_normalize(ECP_NIST256* points, int count)
+{
+    if (!points || count <= 0)
+    {
+        return;
+    }
+
+    FP_NIST256 one;
+    FP_NIST256_one(&one);
+
+    for (int start = 0; start < count; start += NIST256_NORMALIZE_CHUNK)
+    {
+        const int remaining = count - start;
+        normalize_chunk(points + start, remaining < NIST256_NORMALIZE_CHUNK ? remaining : NIST256_NORMALIZE_CHUNK, &one);
+    }
+}
+
+int nist256_add_affine(ECP_NIST256* result, ECP_NIST256* p, ECP_NIST256* q)
+{
+    FP_NIST256 numerator, denominator, lambda, t;
+
+    FP_NIST256_sub(&denominator, &q->x, &p->x);
+    if (FP_NIST256_iszilch(&denominator))
+    {
+        // Same x: either Q = P (double) or Q = -P (infinity); P-256 has no points with y = 0
+        if (!FP_NIST256_equals(&p->y, &q->y) || FP_NIST256_iszilch(&p->y))
+        {
+            ECP_NIST256_inf(result);
+            return 0;
+        }
+
+        // lambda = (3 * x^2 + a) / (2 * y) with a = -3, i.e. 3 * (x - 1) * (x + 1) / (2 * y)
+        FP_NIST256 one, x_minus_one, x_plus_one;
+        FP_NIST256_one(&one);
+        FP_NIST256_sub(&x_minus_one, &p->x, &one);
+        FP_NIST256_add(&x_plus_one, &p->x, &one);
+        FP_NIST256_mul(&numerator, &x_minus_one, &x_plus_one);
+        FP_NIST256_imul(&numerator, &numerator, 3);
+        FP_NIST256_add(&denominator, &p->y, &p->y);
+    }
+    else
+    {
+        // lambda = (y2 - y1) / (x2 - x1)
+        FP_NIST256_sub(&numerator, &q->y, &p->y);
+    }
+
+    FP_NIST256_inv(&lambda, &denominator, NULL);
+    FP_NIST256_mul(&lambda, &lambda, &numerator);
+
+    // x3 = lambda^2 - x1 - x2, y3 = lambda * (x1 - x3) - y1; result may alias p or q
+    FP_NIST256 x3, y3;
+    FP_NIST256_sqr(&x3, &lambda);
+    FP_NIST256_sub(&x3, &x3, &p->x);
+    FP_NIST256_sub(&x3, &x3, &q->x);
+    FP_NIST256_sub(&t, &p->x, &x3);
+    FP_NIST256_mul(&y3, &lambda, &t);
+    FP_NIST256_sub(&y3, &y3, &p->y);
+
+    FP_NIST256_copy(&result->x, &x3);
+    FP_NIST256_copy(&result->y, &y3);
+    FP_NIST256_one(&result->z);
+    FP_NIST256_reduce(&result->x);
+    FP_NIST256_reduce(&result->y);
+
+    return 1;
+}
+
+void nist256_affine_to_bytes(ECP_NIST256* point, unsigned char* bytes)
+{
+    BIG_256_56 coordinate;
+
+    bytes[0] = 0x04;
+    FP_NIST256_redc(coordinate, &point->x);
+    BIG_256_56_toBytes((char*)bytes + 1, coordinate);
+    FP_NIST256_redc(coordinate, &point->y);
+    BIG_256_56_toBytes((char*)bytes + 1 + MODBYTES_256_56, coordinate);
+}
+
+void nist256_recode_signed_window(BIG_256_56 d, signed char* digits)
+{
+    // Little-endian nibbles of d
+    char bytes[MODBYTES_256_56];
+    BIG_256_56_toBytes(bytes, d);
+
+    for (int i = 0; i < MODBYTES_256_56; i++)
+    {
+        const unsigned char byte = (unsigned char)bytes[MODBYTES_256_56 - 1 - i];
+        digits[2 * i] = (signed char)(byte & 15);
+        digits[2 * i + 1] = (signed char)(byte >> 4);
+    }
+
+    // Recode to signed digits in [-8, 7]; the extra top digit takes the final carry
+    signed char carry = 0;
+    for (int i = 0; i < NIST256_SIGNED_WINDOWS - 1; i++)
+    {
+        digits[i] += carry;
+        carry = (signed char)((digits[i] + 8) >> 4);
+        digits[i] -= (signed char)(carry * 16);
+    }
+    digits[NIST256_SIGNED_WINDOWS - 1] = carry;
+
+    cvc_secure_zero(bytes, sizeof(bytes));
+}
+
+int nist256_recode_wnaf(BIG_256_56 d, int width, signed char* naf)
+{
+    const int full = 1 << width;
+    const int half = full >> 1;
+
+    BIG_256_56 k;
+    BIG_256_56_copy(k, d);
+    BIG_256_56_norm(k);
+
+    int length = 0;
+    while (!BIG_256_56_iszilch(k))
+    {
+        int digit = 0;
+        if (BIG_256_56_parity(k))
+        {
+            // Signed residue mod 2^w clears the next w - 1 bits
+            digit = BIG_256_56_lastbits(k, width);
+            if (digit >= half)
+            {
+                digit -= full;
+                BIG_256_56_inc(k, -digit);
+            }
+            else
+            {
+                BIG_256_56_dec(k, digit);
+            }
+            BIG_256_56_norm(k);
+        }
+        naf[length++] = (signed char)digit;
+        BIG_256_56_fshr(k, 1);
+    }
+
+    return length;
+}
+
+// 1 if a == b, 0 otherwise, without branching (a, b in [0, 255])
+static int ct_equal(unsigned int a, unsigned int b)
+{
+    return (int)(((a ^ b) - 1U) >> 31);
+}
+
+void nist256_select_multiple(ECP_NIST256* T, ECP_NIST256* row, signed char digit)
+{
+    const unsigned int negative = (unsigned int)((unsigned char)digit >> 7);
+    const unsigned int magnitude = (unsigned int)(digit - ((-(int)negative & digit) * 2));
+
+    ECP_NIST256_inf(T);
+    for (int j = 0; j < NIST256_WINDOW_ENTRIES; j++)
+    {
+        const int match = ct_equal(magnitude, (unsigned int)(j + 1));
+        FP_NIST256_cmove(&T->x, &row[j].x, match);
+        FP_NIST256_cmove(&T->y, &row[j].y, match);
+        FP_NIST256_cmove(&T->z, &row[j].z, match);
+    }
+
+    // Negating a Weierstrass point negates y
+    FP_NIST256 minus_y;
+    FP_NIST256_neg(&minus_y, &T->y);
+    FP_NIST256_norm(&minus_y);
+    FP_NIST256_cmove(&T->y, &minus_y, (int)negative);
+}
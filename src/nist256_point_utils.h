@@ -0,0 +1,102 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+
+#ifndef NIST256_POINT_UTILS_H
+#define NIST256_POINT_UTILS_H
+
+#include "ecp_NIST256.h"
+
+// Signed radix-16 recoding of a scalar below 2^256: 64 digits in [-8, 7] plus a carry digit
+#define NIST256_SIGNED_WINDOWS 65
+
+// Multiples 1..8 of a window base, enough for any digit magnitude
+#define NIST256_WINDOW_ENTRIES 8
+
+// Longest width-w NAF of a scalar below 2^256 (one digit more than its bit length)
+#define NIST256_WNAF_MAX_DIGITS 257
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Convert an array of projective points to affine form (Z = 1) in place
+ *
+ * Uses Montgomery's simultaneous inversion trick, so normalizing n points costs
+ * one field inversion plus about 3n multiplications instead of n inversions.
+ * Points at infinity are left at infinity.
+ *
+ * @param points Array of points to normalize
+ * @param count Number of points in the array
+ */
+void nist256_batch_normalize(ECP_NIST256* points, int count);
+
+/**
+ * @brief Add two affine points and return the sum in affine form
+ *
+ * Both inputs must have Z = 1 (e.g. fresh from ECP_NIST256_fromOctet). The chord or,
+ * for P = Q, tangent slope costs one field inversion, the same inversion the affine
+ * conversion after a projective addition would need, so the whole addition is one
+ * inversion plus a handful of multiplications. Not constant time: intended for
+ * public points only.
+ *
+ * @param result Output point with Z = 1 (may alias p or q)
+ * @param p First affine point
+ * @param q Second affine point
+ * @return 1 on success, 0 if the sum is the point at infinity (q = -p)
+ */
+int nist256_add_affine(ECP_NIST256* result, ECP_NIST256* p, ECP_NIST256* q);
+
+/**
+ * @brief Write an affine point (Z = 1) as a 65-byte uncompressed encoding
+ *
+ * @param point Finite point with Z = 1
+ * @param bytes Output buffer of at least 65 bytes
+ */
+void nist256_affine_to_bytes(ECP_NIST256* point, unsigned char* bytes);
+
+/**
+ * @brief Recode a scalar into signed radix-16 digits, least significant first
+ *
+ * digits[0..63] lie in [-8, 7] and digits[64] in {0, 1}, so every digit selects one of
+ * NIST256_WINDOW_ENTRIES multiples plus a sign. The recoding has no data-dependent
+ * branches and every window is non-sparse, which keeps secret scalars safe to use.
+ *
+ * @param d Scalar below 2^256
+ * @param digits Output array of NIST256_SIGNED_WINDOWS digits
+ */
+void nist256_recode_signed_window(BIG_256_56 d, signed char* digits);
+
+/**
+ * @brief Recode a scalar into width-w non-adjacent form, least significant first
+ *
+ * Every non-zero digit is odd with magnitude below 2^(w-1), and any w consecutive
+ * digits hold at most one non-zero digit, so a multiplication needs the odd
+ * multiples 1, 3, ..., 2^(w-1) - 1 and about 256 / (w + 1) additions. The digit
+ * pattern depends on the scalar: use for public scalars only.
+ *
+ * @param d Scalar below 2^256
+ * @param width Window width in [2, 8]
+ * @param naf Output array of NIST256_WNAF_MAX_DIGITS digits
+ * @return Number of digits written (0 for d = 0)
+ */
+int nist256_recode_wnaf(BIG_256_56 d, int width, signed char* naf);
+
+/**
+ * @brief Constant-time selection of digit * row[0] from a row of multiples
+ *
+ * Reads every entry of the row and negates with a conditional move, so neither the
+ * magnitude nor the sign of the digit shows in the memory access pattern.
+ *
+ * @param T Output point (infinity for digit 0)
+ * @param row NIST256_WINDOW_ENTRIES points, row[j] = (j + 1) * row[0]
+ * @param digit Digit in [-8, 8]
+ */
+void nist256_select_multiple(ECP_NIST256* T, ECP_NIST256* row, signed char digit);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NIST256_POINT_UTILS_H
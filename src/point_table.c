@@ -0,0 +1,263 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "point_table.h"
+#include "nist256_base_tables.h"
+#include "nist256_point_utils.h"
+#include "public_key_set.h"
+#include "secure_memory.h"
+#include "sha256.h"
+#include <stdlib.h>
+#include <string.h>
+
+// External ROM constants from rom_curve_NIST256.c and rom_field_NIST256.c
+extern const BIG_256_56 CURVE_Order_NIST256;
+extern const BIG_256_56 Modulus_NIST256;
+
+#define POINT_TABLE_KEY_LENGTH 65
+
+#if NIST256_SIGNED_WINDOWS * NIST256_WINDOW_ENTRIES != CVC_POINT_TABLE_ENTRY_COUNT
+#error "CVC_POINT_TABLE_ENTRY_COUNT must match the signed window layout"
+#endif
+
+struct cvc_nist256_point_table
+{
+    ECP_NIST256 rows[NIST256_SIGNED_WINDOWS][NIST256_WINDOW_ENTRIES]; // rows[i][j] = (j + 1) * 16^i * P, Z = 1
+    unsigned char point_bytes[POINT_TABLE_KEY_LENGTH];                 // Uncompressed encoding of P
+};
+
+static const unsigned char point_table_magic[CVC_POINT_TABLE_MAGIC_LENGTH] = { 'C', 'V', 'P', 'T' };
+
+static void fill_rows(cvc_nist256_point_table_t* table, ECP_NIST256* point)
+{
+    ECP_NIST256 base;
+    ECP_NIST256_copy(&base, point);
+
+    for (int i = 0; i < NIST256_SIGNED_WINDOWS; i++)
+    {
+        ECP_NIST256_copy(&table->rows[i][0], &base);
+        for (int j = 1; j < NIST256_WINDOW_ENTRIES; j++)
+        {
+            ECP_NIST256_copy(&table->rows[i][j], &table->rows[i][j - 1]);
+            ECP_NIST256_add(&table->rows[i][j], &base);
+        }
+
+        // Next window base: 16 * base
+        for (int k = 0; k < 4; k++)
+        {
+            ECP_NIST256_dbl(&base);
+        }
+    }
+
+    // Affine entries serialize directly and cost one batched inversion per chunk
+    nist256_batch_normalize(&table->rows[0][0], CVC_POINT_TABLE_ENTRY_COUNT);
+    nist256_affine_to_bytes(&table->rows[0][0], table->point_bytes);
+}
+
+// Constant-time comb walk over rows of multiples, shared by key tables and the generator table
+static void mul_rows(ECP_NIST256* result, const ECP_NIST256 rows[][NIST256_WINDOW_ENTRIES], BIG_256_56 d)
+{
+    signed char digits[NIST256_SIGNED_WINDOWS];
+    nist256_recode_signed_window(d, digits);
+
+    ECP_NIST256 T;
+    ECP_NIST256_inf(result);
+    for (int i = 0; i < NIST256_SIGNED_WINDOWS; i++)
+    {
+        nist256_select_multiple(&T, (ECP_NIST256*)rows[i], digits[i]);
+        ECP_NIST256_add(result, &T);
+    }
+
+    // Wipe scalar-dependent intermediates
+    cvc_secure_zero(digits, sizeof(digits));
+    cvc_secure_zero(&T, sizeof(T));
+}
+
+void nist256_point_table_mul(ECP_NIST256* result, const cvc_nist256_point_table_t* table, BIG_256_56 d)
+{
+    mul_rows(result, table->rows, d);
+}
+
+void nist256_mul_base(ECP_NIST256* result, BIG_256_56 d)
+{
+    // Generated at build time, see nist256_base_tables.h
+    mul_rows(result, nist256_base_rows, d);
+}
+
+int nist256_point_table_build(ECP_NIST256* point, cvc_nist256_point_table_t** table)
+{
+    // Basic parameter validation
+    if (!point || !table || ECP_NIST256_isinf(point))
+    {
+        return CVC_POINT_TABLE_ERROR_INVALID_PARAMS;
+    }
+
+    *table = NULL;
+
+    cvc_nist256_point_table_t* result = malloc(sizeof(cvc_nist256_point_table_t));
+    if (!result)
+    {
+        return CVC_POINT_TABLE_ERROR_ALLOCATION_FAILED;
+    }
+
+    fill_rows(result, point);
+
+    *table = result;
+    return CVC_POINT_TABLE_SUCCESS;
+}
+
+int cvc_nist256_point_precompute(const unsigned char* public_key_bytes, int public_key_len, cvc_nist256_point_table_t** table)
+{
+    // Basic parameter validation
+    if (!public_key_bytes || !table)
+    {
+        return CVC_POINT_TABLE_ERROR_INVALID_PARAMS;
+    }
+
+    *table = NULL;
+
+    ECP_NIST256 point;
+    if (public_key_len != POINT_TABLE_KEY_LENGTH || !cvc_public_key_set_decode(NULL, public_key_bytes, &point))
+    {
+        return CVC_POINT_TABLE_ERROR_INVALID_POINT;
+    }
+
+    return nist256_point_table_build(&point, table);
+}
+
+void cvc_nist256_point_table_destroy(cvc_nist256_point_table_t* table)
+{
+    free(table);
+}
+
+int cvc_nist256_point_table_public_key(const cvc_nist256_point_table_t* table, unsigned char* public_key, int public_key_size)
+{
+    if (!table || !public_key)
+    {
+        return CVC_POINT_TABLE_ERROR_INVALID_PARAMS;
+    }
+
+    if (public_key_size < POINT_TABLE_KEY_LENGTH)
+    {
+        return CVC_POINT_TABLE_ERROR_INSUFFICIENT_BUFFER;
+    }
+
+    memcpy(public_key, table->point_bytes, POINT_TABLE_KEY_LENGTH);
+
+    return CVC_POINT_TABLE_SUCCESS;
+}
+
+int cvc_nist256_point_table_multiply(const cvc_nist256_point_table_t* table, const unsigned char* scalar_bytes, int scalar_len, unsigned char* result_bytes, int result_buffer_size)
+{
+    // Basic parameter validation
+    if (!table || !scalar_bytes || scalar_len != MODBYTES_256_56 || !result_bytes)
+    {
+        return CVC_POINT_TABLE_ERROR_INVALID_PARAMS;
+    }
+
+    if (result_buffer_size < POINT_TABLE_KEY_LENGTH)
+    {
+        return CVC_POINT_TABLE_ERROR_INSUFFICIENT_BUFFER;
+    }
+
+    BIG_256_56 d, curve_order;
+    BIG_256_56_rcopy(curve_order, CURVE_Order_NIST256);
+    BIG_256_56_fromBytes(d, (char*)scalar_bytes);
+    if (BIG_256_56_iszilch(d) || BIG_256_56_comp(d, curve_order) >= 0)
+    {
+        BIG_256_56_zero(d);
+        return CVC_POINT_TABLE_ERROR_INVALID_SCALAR;
+    }
+
+    ECP_NIST256 result;
+    nist256_point_table_mul(&result, table, d);
+    BIG_256_56_zero(d);
+
+    ECP_NIST256_affine(&result);
+    nist256_affine_to_bytes(&result, result_bytes);
+
+    return CVC_POINT_TABLE_SUCCESS;
+}
+
+int cvc_nist256_point_table_serialize(const cvc_nist256_point_table_t* table, unsigned char* output, int output_size)
+{
+    if (!table || !output)
+    {
+        return CVC_POINT_TABLE_ERROR_INVALID_PARAMS;
+    }
+
+    if (output_size < CVC_POINT_TABLE_SERIALIZED_SIZE)
+    {
+        return CVC_POINT_TABLE_ERROR_INSUFFICIENT_BUFFER;
+    }
+
+    memcpy(output, point_table_magic, CVC_POINT_TABLE_MAGIC_LENGTH);
+    unsigned char* cursor = output + CVC_POINT_TABLE_MAGIC_LENGTH;
+
+    // The entries are already affine, so each one is just its X || Y
+    unsigned char entry[POINT_TABLE_KEY_LENGTH];
+    const ECP_NIST256* entries = &table->rows[0][0];
+    for (int i = 0; i < CVC_POINT_TABLE_ENTRY_COUNT; i++)
+    {
+        nist256_affine_to_bytes((ECP_NIST256*)&entries[i], entry);
+        memcpy(cursor, entry + 1, POINT_TABLE_KEY_LENGTH - 1);
+        cursor += POINT_TABLE_KEY_LENGTH - 1;
+    }
+
+    cvc_sha256(output, (size_t)(cursor - output), cursor);
+
+    return CVC_POINT_TABLE_SUCCESS;
+}
+
+int cvc_nist256_point_table_deserialize(const unsigned char* input, int input_len, cvc_nist256_point_table_t** table)
+{
+    // Basic parameter validation
+    if (!input || !table)
+    {
+        return CVC_POINT_TABLE_ERROR_INVALID_PARAMS;
+    }
+
+    *table = NULL;
+
+    const size_t body_len = CVC_POINT_TABLE_SERIALIZED_SIZE - CVC_SHA256_DIGEST_SIZE;
+    unsigned char checksum[CVC_SHA256_DIGEST_SIZE];
+    if (input_len != CVC_POINT_TABLE_SERIALIZED_SIZE || memcmp(input, point_table_magic, CVC_POINT_TABLE_MAGIC_LENGTH) != 0)
+    {
+        return CVC_POINT_TABLE_ERROR_INVALID_ENCODING;
+    }
+    cvc_sha256(input, body_len, checksum);
+    if (memcmp(checksum, input + body_len, CVC_SHA256_DIGEST_SIZE) != 0)
+    {
+        return CVC_POINT_TABLE_ERROR_INVALID_ENCODING;
+    }
+
+    cvc_nist256_point_table_t* result = malloc(sizeof(cvc_nist256_point_table_t));
+    if (!result)
+    {
+        return CVC_POINT_TABLE_ERROR_ALLOCATION_FAILED;
+    }
+
+    // Coordinates must be canonical (< p): ECP_NIST256_set reduces them mod p first, so
+    // x + p would otherwise load as x. It then rejects every entry, the first entry of
+    // each row included, that is not on the curve.
+    BIG_256_56 modulus;
+    BIG_256_56_rcopy(modulus, Modulus_NIST256);
+    const unsigned char* cursor = input + CVC_POINT_TABLE_MAGIC_LENGTH;
+    ECP_NIST256* entries = &result->rows[0][0];
+    for (int i = 0; i < CVC_POINT_TABLE_ENTRY_COUNT; i++)
+    {
+        BIG_256_56 x, y;
+        BIG_256_56_fromBytes(x, (char*)cursor);
+        BIG_256_56_fromBytes(y, (char*)cursor + MODBYTES_256_56);
+        if (BIG_256_56_comp(x, modulus) >= 0 || BIG_256_56_comp(y, modulus) >= 0 || !ECP_NIST256_set(&entries[i], x, y))
+        {
+            free(result);
+            return CVC_POINT_TABLE_ERROR_INVALID_ENCODING;
+        }
+        cursor += 2 * MODBYTES_256_56;
+    }
+    nist256_affine_to_bytes(&result->rows[0][0], result->point_bytes);
+
+    *table = result;
+    return CVC_POINT_TABLE_SUCCESS;
+}
@@ -0,0 +1,140 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef POINT_TABLE_H
+#define POINT_TABLE_H
+
+#include "ecp_NIST256.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Serialized table: 4-byte magic, 65 x 8 affine points as X || Y, SHA-256 of everything before it
+#define CVC_POINT_TABLE_MAGIC_LENGTH 4
+#define CVC_POINT_TABLE_ENTRY_COUNT (65 * 8)
+#define CVC_POINT_TABLE_SERIALIZED_SIZE (CVC_POINT_TABLE_MAGIC_LENGTH + CVC_POINT_TABLE_ENTRY_COUNT * 64 + 32)
+
+/**
+ * @brief Result codes for point table operations
+ */
+typedef enum
+{
+    CVC_POINT_TABLE_SUCCESS = 0,                    /**< Operation completed successfully */
+    CVC_POINT_TABLE_ERROR_INVALID_PARAMS = -1,      /**< Invalid input parameters */
+    CVC_POINT_TABLE_ERROR_ALLOCATION_FAILED = -2,   /**< Failed to allocate the table */
+    CVC_POINT_TABLE_ERROR_INVALID_POINT = -3,       /**< Public key is malformed or not on the curve */
+    CVC_POINT_TABLE_ERROR_INVALID_SCALAR = -4,      /**< Scalar is zero or >= curve order */
+    CVC_POINT_TABLE_ERROR_INVALID_ENCODING = -5,    /**< Serialized table is truncated, corrupted or has a bad magic */
+    CVC_POINT_TABLE_ERROR_INSUFFICIENT_BUFFER = -6, /**< Output buffer is too small */
+} cvc_point_table_result_t;
+
+/**
+ * @brief Opaque precomputed multiples of one NIST P-256 point
+ *
+ * Row i holds 1..8 times 16^i * P in affine form for all 65 signed radix-16 digits, so
+ * a multiplication by any scalar is 65 constant-time lookups and additions with no
+ * doublings. A table costs about 75 KB and takes two to three ordinary scalar
+ * multiplications to build; it pays off for points such as an issuer key or a
+ * blinding base that are multiplied by fresh scalars over and over. Tables are
+ * immutable and may be shared between threads.
+ */
+typedef struct cvc_nist256_point_table cvc_nist256_point_table_t;
+
+/**
+ * @brief Build the table for a public key
+ *
+ * @param public_key_bytes 65-byte uncompressed public key (fully validated)
+ * @param public_key_len Length of the public key
+ * @param table Output pointer receiving the new table
+ * @return CVC_POINT_TABLE_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_nist256_point_precompute(const unsigned char* public_key_bytes, int public_key_len, cvc_nist256_point_table_t** table);
+
+/**
+ * @brief Release a table
+ *
+ * @param table Table to destroy (NULL is ignored)
+ */
+void cvc_nist256_point_table_destroy(cvc_nist256_point_table_t* table);
+
+/**
+ * @brief Copy the public key the table was built for
+ *
+ * @param table Table
+ * @param public_key Output buffer receiving 65 bytes
+ * @param public_key_size Size of the output buffer
+ * @return CVC_POINT_TABLE_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_nist256_point_table_public_key(const cvc_nist256_point_table_t* table, unsigned char* public_key, int public_key_size);
+
+/**
+ * @brief Multiply the table's point by a scalar: result = scalar * P
+ *
+ * Constant time in the scalar, so it is safe for secret scalars.
+ *
+ * @param table Table of P
+ * @param scalar_bytes 32-byte big-endian scalar in [1, curve_order-1]
+ * @param scalar_len Length of the scalar (must be 32)
+ * @param result_bytes Output buffer receiving the 65-byte uncompressed result
+ * @param result_buffer_size Size of the output buffer
+ * @return CVC_POINT_TABLE_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_nist256_point_table_multiply(const cvc_nist256_point_table_t* table, const unsigned char* scalar_bytes, int scalar_len, unsigned char* result_bytes, int result_buffer_size);
+
+/**
+ * @brief Write a table in a portable form that can be stored and loaded later
+ *
+ * @param table Table to serialize
+ * @param output Output buffer of at least CVC_POINT_TABLE_SERIALIZED_SIZE bytes
+ * @param output_size Size of the output buffer
+ * @return CVC_POINT_TABLE_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_nist256_point_table_serialize(const cvc_nist256_point_table_t* table, unsigned char* output, int output_size);
+
+/**
+ * @brief Load a table written by cvc_nist256_point_table_serialize
+ *
+ * Checks the magic, the trailing SHA-256, that every coordinate is below the field
+ * prime and that every entry is on the curve. This catches truncation and corruption
+ * but is not authentication: only load tables from storage you trust as much as the
+ * public key itself.
+ *
+ * @param input Serialized table
+ * @param input_len Length of the serialized table (must be CVC_POINT_TABLE_SERIALIZED_SIZE)
+ * @param table Output pointer receiving the new table
+ * @return CVC_POINT_TABLE_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_nist256_point_table_deserialize(const unsigned char* input, int input_len, cvc_nist256_point_table_t** table);
+
+/**
+ * @brief Build a table from a finite point in internal form
+ *
+ * @param point Point to precompute (any Z)
+ * @param table Output pointer receiving the new table
+ * @return CVC_POINT_TABLE_SUCCESS on success, or a negative error code on failure
+ */
+int nist256_point_table_build(ECP_NIST256* point, cvc_nist256_point_table_t** table);
+
+/**
+ * @brief result = d * P from a table of P, in constant time (d below 2^256)
+ *
+ * @param result Output point (projective)
+ * @param table Table of P
+ * @param d Scalar
+ */
+void nist256_point_table_mul(ECP_NIST256* result, const cvc_nist256_point_table_t* table, BIG_256_56 d);
+
+/**
+ * @brief result = d * G from the generator table generated at build time (read-only, no setup)
+ *
+ * @param result Output point (projective)
+ * @param d Scalar below 2^256
+ */
+void nist256_mul_base(ECP_NIST256* result, BIG_256_56 d);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // POINT_TABLE_H
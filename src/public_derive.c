@@ -0,0 +1,261 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "public_derive.h"
+#include "hash_to_field.h"
+#include "nist256_point_utils.h"
+#include "point_table.h"
+#include "secure_memory.h"
+#include "stack_budget.h"
+#include <stdlib.h>
+#include <string.h>
+
+// External ROM constants from rom_curve_NIST256.c
+extern const BIG_256_56 CURVE_Order_NIST256;
+
+// Same limit on master key plus context as cvc_derive_secret_scalar_nist256
+#define PUBLIC_DERIVE_MAX_INPUT 4096
+
+// Master public key in both forms the derivation needs
+typedef struct
+{
+    ECP_NIST256 point;                                        // M with Z = 1
+    unsigned char bytes[CVC_PUBLIC_DERIVE_PUBLIC_KEY_LENGTH]; // Uncompressed encoding of M, hashed into every tweak
+} master_key_t;
+
+// Validate the per-context inputs; *max_context_len receives the longest context
+static int check_contexts(const unsigned char* const* contexts, const int* context_lens, int count, const unsigned char* dst, int dst_len, int* max_context_len)
+{
+    if (!contexts || !context_lens || count <= 0 || !dst || dst_len <= 0)
+    {
+        return CVC_PUBLIC_DERIVE_ERROR_INVALID_PARAMS;
+    }
+
+    *max_context_len = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (!contexts[i] || context_lens[i] <= 0 || context_lens[i] > PUBLIC_DERIVE_MAX_INPUT - CVC_PUBLIC_DERIVE_PUBLIC_KEY_LENGTH)
+        {
+            return CVC_PUBLIC_DERIVE_ERROR_INVALID_PARAMS;
+        }
+        if (context_lens[i] > *max_context_len)
+        {
+            *max_context_len = context_lens[i];
+        }
+    }
+
+    return CVC_PUBLIC_DERIVE_SUCCESS;
+}
+
+// t_l = hash_to_field(dst, M || context_l) mod n for one group of lanes
+static int hash_tweaks(const master_key_t* master, const unsigned char* const* contexts, const int* context_lens, int lanes, const unsigned char* dst, int dst_len, unsigned char* joined, BIG_256_56* tweaks)
+{
+    const unsigned char* messages[CVC_BATCH_LANES];
+    int message_lens[CVC_BATCH_LANES];
+    FP_NIST256 elements[CVC_BATCH_LANES];
+
+    size_t offset = 0;
+    for (int l = 0; l < lanes; l++)
+    {
+        memcpy(joined + offset, master->bytes, CVC_PUBLIC_DERIVE_PUBLIC_KEY_LENGTH);
+        memcpy(joined + offset + CVC_PUBLIC_DERIVE_PUBLIC_KEY_LENGTH, contexts[l], context_lens[l]);
+        messages[l] = joined + offset;
+        message_lens[l] = CVC_PUBLIC_DERIVE_PUBLIC_KEY_LENGTH + context_lens[l];
+        offset += (size_t)message_lens[l];
+    }
+
+    if (cvc_hash_to_field_nist256_batch(MC_SHA2, HASH_TYPE_NIST256, dst, dst_len, messages, message_lens, lanes, 1, elements) != CVC_HASH_TO_FIELD_SUCCESS)
+    {
+        return CVC_PUBLIC_DERIVE_ERROR_HASH_TO_FIELD_FAILED;
+    }
+
+    BIG_256_56 curve_order;
+    BIG_256_56_rcopy(curve_order, CURVE_Order_NIST256);
+    for (int l = 0; l < lanes; l++)
+    {
+        FP_NIST256_redc(tweaks[l], &elements[l]);
+        BIG_256_56_mod(tweaks[l], curve_order);
+    }
+
+    return CVC_PUBLIC_DERIVE_SUCCESS;
+}
+
+// points[l] = M + t_l * G in affine form, with one inversion for the group
+static int derive_points(const master_key_t* master, BIG_256_56* tweaks, ECP_NIST256* points, int lanes)
+{
+    for (int l = 0; l < lanes; l++)
+    {
+        // Rejected like a zero scalar in cvc_derive_secret_scalar_nist256
+        if (BIG_256_56_iszilch(tweaks[l]))
+        {
+            return CVC_PUBLIC_DERIVE_ERROR_INVALID_DERIVED_KEY;
+        }
+
+        nist256_mul_base(&points[l], tweaks[l]);
+        ECP_NIST256_add(&points[l], (ECP_NIST256*)&master->point);
+    }
+
+    nist256_batch_normalize(points, lanes);
+
+    // Only if M = -t * G, i.e. the derived secret is zero
+    for (int l = 0; l < lanes; l++)
+    {
+        if (ECP_NIST256_isinf(&points[l]))
+        {
+            return CVC_PUBLIC_DERIVE_ERROR_INVALID_DERIVED_KEY;
+        }
+    }
+
+    return CVC_PUBLIC_DERIVE_SUCCESS;
+}
+
+// Shared batch driver: public keys only when master_secret is NULL, key material otherwise
+static int derive_batch(const master_key_t* master, chunk* master_secret, const unsigned char* const* contexts, const int* context_lens, int count, const unsigned char* dst, int dst_len, int max_context_len, unsigned char* public_keys,
+    nist256_key_material_t* key_materials)
+{
+    unsigned char* joined = malloc((size_t)CVC_BATCH_LANES * (size_t)(CVC_PUBLIC_DERIVE_PUBLIC_KEY_LENGTH + max_context_len));
+    if (!joined)
+    {
+        return CVC_PUBLIC_DERIVE_ERROR_ALLOCATION_FAILED;
+    }
+
+    BIG_256_56 tweaks[CVC_BATCH_LANES];
+    ECP_NIST256 points[CVC_BATCH_LANES];
+    BIG_256_56 curve_order, d;
+    BIG_256_56_rcopy(curve_order, CURVE_Order_NIST256);
+
+    int result = CVC_PUBLIC_DERIVE_SUCCESS;
+    for (int start = 0; start < count && result == CVC_PUBLIC_DERIVE_SUCCESS; start += CVC_BATCH_LANES)
+    {
+        const int lanes = count - start < CVC_BATCH_LANES ? count - start : CVC_BATCH_LANES;
+
+        result = hash_tweaks(master, contexts + start, context_lens + start, lanes, dst, dst_len, joined, tweaks);
+        if (result == CVC_PUBLIC_DERIVE_SUCCESS)
+        {
+            result = derive_points(master, tweaks, points, lanes);
+        }
+        if (result != CVC_PUBLIC_DERIVE_SUCCESS)
+        {
+            break;
+        }
+
+        for (int l = 0; l < lanes; l++)
+        {
+            if (!master_secret)
+            {
+                nist256_affine_to_bytes(&points[l], public_keys + (size_t)(start + l) * CVC_PUBLIC_DERIVE_PUBLIC_KEY_LENGTH);
+                continue;
+            }
+
+            // d = m + t mod n; D above is already d * G
+            nist256_key_material_t* key_material = &key_materials[start + l];
+            unsigned char encoded[CVC_PUBLIC_DERIVE_PUBLIC_KEY_LENGTH];
+            BIG_256_56_modadd(d, master_secret, tweaks[l], curve_order);
+            BIG_256_56_toBytes((char*)key_material->private_key_bytes, d);
+            nist256_affine_to_bytes(&points[l], encoded);
+            memcpy(key_material->public_key_x_bytes, encoded + 1, MODBYTES_256_56);
+            memcpy(key_material->public_key_y_bytes, encoded + 1 + MODBYTES_256_56, MODBYTES_256_56);
+        }
+    }
+
+    // Tweaks are public, but d and a partial batch of derived secrets are not
+    BIG_256_56_zero(d);
+    if (result != CVC_PUBLIC_DERIVE_SUCCESS)
+    {
+        if (master_secret)
+        {
+            cvc_secure_zero(key_materials, (size_t)count * sizeof(nist256_key_material_t));
+        }
+        else
+        {
+            memset(public_keys, 0, (size_t)count * CVC_PUBLIC_DERIVE_PUBLIC_KEY_LENGTH);
+        }
+    }
+
+    free(joined);
+    return result;
+}
+
+int cvc_derive_public_keys_nist256_batch(cvc_public_key_set_t* key_set, const unsigned char* master_public_key, int master_public_key_len, const unsigned char* const* contexts, const int* context_lens, int count, const unsigned char* dst, int dst_len, unsigned char* derived_public_keys)
+{
+    // Basic parameter validation
+    if (!master_public_key || !derived_public_keys)
+    {
+        return CVC_PUBLIC_DERIVE_ERROR_INVALID_PARAMS;
+    }
+
+    int max_context_len;
+    const int check_result = check_contexts(contexts, context_lens, count, dst, dst_len, &max_context_len);
+    if (check_result != CVC_PUBLIC_DERIVE_SUCCESS)
+    {
+        return check_result;
+    }
+
+    master_key_t master;
+    if (master_public_key_len != CVC_PUBLIC_DERIVE_PUBLIC_KEY_LENGTH || !cvc_public_key_set_decode(key_set, master_public_key, &master.point))
+    {
+        return CVC_PUBLIC_DERIVE_ERROR_INVALID_PUBLIC_KEY;
+    }
+    memcpy(master.bytes, master_public_key, CVC_PUBLIC_DERIVE_PUBLIC_KEY_LENGTH);
+
+    return derive_batch(&master, NULL, contexts, context_lens, count, dst, dst_len, max_context_len, derived_public_keys, NULL);
+}
+
+int cvc_derive_public_key_nist256(cvc_public_key_set_t* key_set, const unsigned char* master_public_key, int master_public_key_len, const unsigned char* context, int context_len, const unsigned char* dst, int dst_len, unsigned char* derived_public_key, int derived_public_key_size)
+{
+    // Basic parameter validation
+    if (!derived_public_key)
+    {
+        return CVC_PUBLIC_DERIVE_ERROR_INVALID_PARAMS;
+    }
+
+    if (derived_public_key_size < CVC_PUBLIC_DERIVE_PUBLIC_KEY_LENGTH)
+    {
+        return CVC_PUBLIC_DERIVE_ERROR_INSUFFICIENT_BUFFER;
+    }
+
+    const unsigned char* const contexts[1] = { context };
+    return cvc_derive_public_keys_nist256_batch(key_set, master_public_key, master_public_key_len, contexts, &context_len, 1, dst, dst_len, derived_public_key);
+}
+
+int cvc_derive_additive_secret_keys_nist256_batch(const unsigned char* master_secret_key, int master_secret_key_len, const unsigned char* const* contexts, const int* context_lens, int count, const unsigned char* dst, int dst_len, nist256_key_material_t* derived_key_materials)
+{
+    // Basic parameter validation
+    if (!master_secret_key || master_secret_key_len != CVC_PUBLIC_DERIVE_SECRET_KEY_LENGTH || !derived_key_materials)
+    {
+        return CVC_PUBLIC_DERIVE_ERROR_INVALID_PARAMS;
+    }
+
+    int max_context_len;
+    const int check_result = check_contexts(contexts, context_lens, count, dst, dst_len, &max_context_len);
+    if (check_result != CVC_PUBLIC_DERIVE_SUCCESS)
+    {
+        return check_result;
+    }
+
+    BIG_256_56 m, curve_order;
+    BIG_256_56_rcopy(curve_order, CURVE_Order_NIST256);
+    BIG_256_56_fromBytes(m, (char*)master_secret_key);
+    if (BIG_256_56_iszilch(m) || BIG_256_56_comp(m, curve_order) >= 0)
+    {
+        BIG_256_56_zero(m);
+        return CVC_PUBLIC_DERIVE_ERROR_INVALID_SECRET_KEY;
+    }
+
+    // M = m * G once; every tweak hashes its encoding
+    master_key_t master;
+    nist256_mul_base(&master.point, m);
+    ECP_NIST256_affine(&master.point);
+    nist256_affine_to_bytes(&master.point, master.bytes);
+
+    const int result = derive_batch(&master, m, contexts, context_lens, count, dst, dst_len, max_context_len, NULL, derived_key_materials);
+    BIG_256_56_zero(m);
+
+    return result;
+}
+
+int cvc_derive_additive_secret_key_nist256(const unsigned char* master_secret_key, int master_secret_key_len, const unsigned char* context, int context_len, const unsigned char* dst, int dst_len, nist256_key_material_t* derived_key_material)
+{
+    const unsigned char* const contexts[1] = { context };
+    return cvc_derive_additive_secret_keys_nist256_batch(master_secret_key, master_secret_key_len, contexts, &context_len, 1, dst, dst_len, derived_key_material);
+}
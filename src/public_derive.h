@@ -0,0 +1,124 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef PUBLIC_DERIVE_H
+#define PUBLIC_DERIVE_H
+
+#include "nist256_key_material.h"
+#include "public_key_set.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Lengths of a master secret key and of an uncompressed public key
+#define CVC_PUBLIC_DERIVE_SECRET_KEY_LENGTH 32
+#define CVC_PUBLIC_DERIVE_PUBLIC_KEY_LENGTH 65
+
+/**
+ * @brief Result codes for additive (public) key derivation
+ */
+typedef enum
+{
+    CVC_PUBLIC_DERIVE_SUCCESS = 0,                     /**< Operation completed successfully */
+    CVC_PUBLIC_DERIVE_ERROR_INVALID_PARAMS = -1,       /**< Invalid input parameters */
+    CVC_PUBLIC_DERIVE_ERROR_INVALID_PUBLIC_KEY = -2,   /**< Master public key is malformed or not on the curve */
+    CVC_PUBLIC_DERIVE_ERROR_INVALID_SECRET_KEY = -3,   /**< Master secret key is zero or >= curve order */
+    CVC_PUBLIC_DERIVE_ERROR_HASH_TO_FIELD_FAILED = -4, /**< Hash-to-field operation failed */
+    CVC_PUBLIC_DERIVE_ERROR_INVALID_DERIVED_KEY = -5,  /**< Zero tweak or derived key (negligible probability) */
+    CVC_PUBLIC_DERIVE_ERROR_INSUFFICIENT_BUFFER = -6,  /**< Output buffer is too small */
+    CVC_PUBLIC_DERIVE_ERROR_ALLOCATION_FAILED = -7,    /**< Failed to allocate working memory */
+} cvc_public_derive_result_t;
+
+/*
+ * Additive derivation: with master key pair (m, M = m * G) and
+ *
+ *     t = hash_to_field(dst, M || context) mod n
+ *
+ * (M as its 65-byte uncompressed encoding; exactly cvc_derive_secret_scalar_nist256
+ * with M in place of the master key material), the derived key pair is
+ *
+ *     d = m + t mod n,    D = M + t * G.
+ *
+ * Anyone holding M can compute D, but d needs m. The secret-side functions give
+ * key material whose public half is the D of the public-side functions.
+ */
+
+/**
+ * @brief Derive the public key for a context from a master public key
+ *
+ * One fixed-base multiplication t * G (shared generator table) plus one addition.
+ *
+ * @param key_set Optional validated key set for the master key (may be NULL)
+ * @param master_public_key Master public key (65 bytes uncompressed)
+ * @param master_public_key_len Length of the master public key
+ * @param context Context bytes for key derivation
+ * @param context_len Length of the context
+ * @param dst Domain Separation Tag as byte array
+ * @param dst_len Length of the DST
+ * @param derived_public_key Output buffer receiving the 65-byte derived public key
+ * @param derived_public_key_size Size of the output buffer
+ * @return CVC_PUBLIC_DERIVE_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_derive_public_key_nist256(cvc_public_key_set_t* key_set, const unsigned char* master_public_key, int master_public_key_len, const unsigned char* context, int context_len, const unsigned char* dst, int dst_len, unsigned char* derived_public_key, int derived_public_key_size);
+
+/**
+ * @brief Derive the public keys for many contexts from one master public key
+ *
+ * Equivalent to cvc_derive_public_key_nist256 per context. The master key is decoded
+ * once, the tweaks are hashed with the multi-buffer hash_to_field, and every group
+ * of derived points shares one batched affine conversion.
+ *
+ * @param key_set Optional validated key set for the master key (may be NULL)
+ * @param master_public_key Master public key (65 bytes uncompressed)
+ * @param master_public_key_len Length of the master public key
+ * @param contexts Context of each derived key
+ * @param context_lens Length of each context
+ * @param count Number of contexts
+ * @param dst Domain Separation Tag as byte array
+ * @param dst_len Length of the DST
+ * @param derived_public_keys Output of count * 65 bytes; key i is written at offset i * 65
+ * @return CVC_PUBLIC_DERIVE_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_derive_public_keys_nist256_batch(cvc_public_key_set_t* key_set, const unsigned char* master_public_key, int master_public_key_len, const unsigned char* const* contexts, const int* context_lens, int count, const unsigned char* dst, int dst_len, unsigned char* derived_public_keys);
+
+/**
+ * @brief Derive the key pair for a context from a master secret key
+ *
+ * The secret-side counterpart of cvc_derive_public_key_nist256: the public half of
+ * the result equals the public derivation from m * G with the same inputs.
+ *
+ * @param master_secret_key 32-byte big-endian master secret key
+ * @param master_secret_key_len Length of the master secret key (must be 32)
+ * @param context Context bytes for key derivation
+ * @param context_len Length of the context
+ * @param dst Domain Separation Tag as byte array
+ * @param dst_len Length of the DST
+ * @param derived_key_material Output structure to store the derived key material
+ * @return CVC_PUBLIC_DERIVE_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_derive_additive_secret_key_nist256(const unsigned char* master_secret_key, int master_secret_key_len, const unsigned char* context, int context_len, const unsigned char* dst, int dst_len, nist256_key_material_t* derived_key_material);
+
+/**
+ * @brief Derive the key pairs for many contexts from one master secret key
+ *
+ * Equivalent to cvc_derive_additive_secret_key_nist256 per context; m * G is
+ * computed once for the whole batch.
+ *
+ * @param master_secret_key 32-byte big-endian master secret key
+ * @param master_secret_key_len Length of the master secret key (must be 32)
+ * @param contexts Context of each derived key
+ * @param context_lens Length of each context
+ * @param count Number of contexts
+ * @param dst Domain Separation Tag as byte array
+ * @param dst_len Length of the DST
+ * @param derived_key_materials Output array of count key materials
+ * @return CVC_PUBLIC_DERIVE_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_derive_additive_secret_keys_nist256_batch(const unsigned char* master_secret_key, int master_secret_key_len, const unsigned char* const* contexts, const int* context_lens, int count, const unsigned char* dst, int dst_len, nist256_key_material_t* derived_key_materials);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PUBLIC_DERIVE_H
@@ -0,0 +1,272 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "public_key_set.h"
+#include "set_associative.h"
+#include "core.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Number of entries per set; lookups and evictions scan one set only
+#define PUBLIC_KEY_SET_WAYS 4
+
+// Default number of shards when the config leaves it at 0
+#define PUBLIC_KEY_SET_DEFAULT_SHARDS 16
+
+#define PUBLIC_KEY_SET_MIN_SEED 16
+
+typedef struct
+{
+    cvc_set_way_t way;                                     // Stamp is the shard clock value at insertion
+    uint64_t hash;                                         // Seeded hash of the encoding
+    unsigned char encoding[CVC_PUBLIC_KEY_SET_KEY_LENGTH]; // Validated uncompressed key
+    ECP_NIST256 point;                                     // Decoded point, z = 1
+} public_key_set_entry_t;
+
+typedef struct
+{
+    pthread_rwlock_t lock;
+    public_key_set_entry_t* entries; // sets_per_shard * ways entries
+    uint64_t clock;                  // Guarded by the write lock
+    uint64_t evictions;              // Guarded by the write lock
+    uint64_t entry_count;            // Guarded by the write lock
+    atomic_uint_fast64_t hits;       // Updated under the read lock
+    atomic_uint_fast64_t misses;
+} public_key_set_shard_t;
+
+struct cvc_public_key_set
+{
+    public_key_set_shard_t* shards;
+    public_key_set_entry_t* entries;
+    cvc_set_geometry_t geometry;
+    uint64_t seed[2];
+};
+
+static uint64_t load_le64(const unsigned char* p)
+{
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; i--)
+    {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+// Multiply-xorshift hash over the 64 coordinate bytes, keyed by the set seed
+static uint64_t hash_encoding(const cvc_public_key_set_t* set, const unsigned char* key_bytes)
+{
+    uint64_t h = set->seed[0] ^ key_bytes[0];
+    for (int i = 1; i < CVC_PUBLIC_KEY_SET_KEY_LENGTH; i += 8)
+    {
+        h = (h ^ load_le64(key_bytes + i)) * 0x9E3779B97F4A7C15ULL;
+        h ^= h >> 32;
+    }
+    h ^= set->seed[1];
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 31;
+    return h;
+}
+
+static void locate(const cvc_public_key_set_t* set, uint64_t hash, public_key_set_shard_t** shard, public_key_set_entry_t** entries)
+{
+    int shard_index;
+    size_t first_entry;
+    cvc_set_geometry_locate(&set->geometry, (uint32_t)hash, (uint32_t)(hash >> 32), &shard_index, &first_entry);
+    *shard = &set->shards[shard_index];
+    *entries = &(*shard)->entries[first_entry];
+}
+
+static int entry_matches(const public_key_set_entry_t* entry, uint64_t hash, const unsigned char* key_bytes)
+{
+    return entry->way.in_use && entry->hash == hash && memcmp(entry->encoding, key_bytes, CVC_PUBLIC_KEY_SET_KEY_LENGTH) == 0;
+}
+
+int cvc_public_key_set_create(const cvc_public_key_set_config_t* config, const unsigned char* hash_seed, int hash_seed_len, cvc_public_key_set_t** set)
+{
+    // Basic parameter validation
+    if (!config || config->max_entries <= 0 || !hash_seed || hash_seed_len < PUBLIC_KEY_SET_MIN_SEED || !set)
+    {
+        return CVC_PUBLIC_KEY_SET_ERROR_INVALID_PARAMS;
+    }
+
+    *set = NULL;
+
+    cvc_set_geometry_t geometry;
+    cvc_set_geometry_init(&geometry, config->max_entries, PUBLIC_KEY_SET_WAYS, config->shard_count, PUBLIC_KEY_SET_DEFAULT_SHARDS);
+
+    cvc_public_key_set_t* result = calloc(1, sizeof(cvc_public_key_set_t));
+    if (!result)
+    {
+        return CVC_PUBLIC_KEY_SET_ERROR_ALLOCATION_FAILED;
+    }
+
+    const size_t entries_per_shard = cvc_set_geometry_shard_entries(&geometry);
+    result->shards = calloc((size_t)geometry.shard_count, sizeof(public_key_set_shard_t));
+    result->entries = calloc((size_t)geometry.shard_count * entries_per_shard, sizeof(public_key_set_entry_t));
+    if (!result->shards || !result->entries)
+    {
+        free(result->shards);
+        free(result->entries);
+        free(result);
+        return CVC_PUBLIC_KEY_SET_ERROR_ALLOCATION_FAILED;
+    }
+
+    result->geometry = geometry;
+
+    // Fold the whole seed into two words
+    for (int i = 0; i < hash_seed_len; i++)
+    {
+        uint64_t* word = &result->seed[(i / 8) & 1];
+        *word = (*word << 8 | *word >> 56) ^ hash_seed[i];
+    }
+
+    for (int i = 0; i < geometry.shard_count; i++)
+    {
+        pthread_rwlock_init(&result->shards[i].lock, NULL);
+        atomic_init(&result->shards[i].hits, 0);
+        atomic_init(&result->shards[i].misses, 0);
+        result->shards[i].entries = result->entries + (size_t)i * entries_per_shard;
+    }
+
+    *set = result;
+    return CVC_PUBLIC_KEY_SET_SUCCESS;
+}
+
+void cvc_public_key_set_destroy(cvc_public_key_set_t* set)
+{
+    if (!set)
+    {
+        return;
+    }
+
+    for (int i = 0; i < set->geometry.shard_count; i++)
+    {
+        pthread_rwlock_destroy(&set->shards[i].lock);
+    }
+
+    free(set->entries);
+    free(set->shards);
+    free(set);
+}
+
+void cvc_public_key_set_clear(cvc_public_key_set_t* set)
+{
+    if (!set)
+    {
+        return;
+    }
+
+    const size_t entries_per_shard = cvc_set_geometry_shard_entries(&set->geometry);
+    for (int i = 0; i < set->geometry.shard_count; i++)
+    {
+        public_key_set_shard_t* shard = &set->shards[i];
+        pthread_rwlock_wrlock(&shard->lock);
+        memset(shard->entries, 0, entries_per_shard * sizeof(public_key_set_entry_t));
+        shard->entry_count = 0;
+        pthread_rwlock_unlock(&shard->lock);
+    }
+}
+
+int cvc_public_key_set_get_stats(cvc_public_key_set_t* set, cvc_public_key_set_stats_t* stats)
+{
+    if (!set || !stats)
+    {
+        return CVC_PUBLIC_KEY_SET_ERROR_INVALID_PARAMS;
+    }
+
+    memset(stats, 0, sizeof(cvc_public_key_set_stats_t));
+    for (int i = 0; i < set->geometry.shard_count; i++)
+    {
+        public_key_set_shard_t* shard = &set->shards[i];
+        pthread_rwlock_rdlock(&shard->lock);
+        stats->hits += atomic_load_explicit(&shard->hits, memory_order_relaxed);
+        stats->misses += atomic_load_explicit(&shard->misses, memory_order_relaxed);
+        stats->evictions += shard->evictions;
+        stats->entries += shard->entry_count;
+        pthread_rwlock_unlock(&shard->lock);
+    }
+
+    stats->capacity = (uint64_t)set->geometry.shard_count * cvc_set_geometry_shard_entries(&set->geometry);
+
+    return CVC_PUBLIC_KEY_SET_SUCCESS;
+}
+
+// Full SEC1 validation of an uncompressed key
+static int validate_key(const unsigned char* key_bytes, ECP_NIST256* point)
+{
+    if (key_bytes[0] != 0x04)
+    {
+        return 0;
+    }
+
+    octet key_octet = { CVC_PUBLIC_KEY_SET_KEY_LENGTH, CVC_PUBLIC_KEY_SET_KEY_LENGTH, (char*)key_bytes };
+    return ECP_NIST256_fromOctet(point, &key_octet) && !ECP_NIST256_isinf(point);
+}
+
+int cvc_public_key_set_decode(cvc_public_key_set_t* set, const unsigned char* key_bytes, ECP_NIST256* point)
+{
+    if (!key_bytes || !point)
+    {
+        return 0;
+    }
+
+    if (!set)
+    {
+        return validate_key(key_bytes, point);
+    }
+
+    const uint64_t hash = hash_encoding(set, key_bytes);
+    public_key_set_shard_t* shard;
+    public_key_set_entry_t* entries;
+    locate(set, hash, &shard, &entries);
+
+    // Lookup
+    pthread_rwlock_rdlock(&shard->lock);
+    for (int i = 0; i < set->geometry.ways; i++)
+    {
+        if (entry_matches(&entries[i], hash, key_bytes))
+        {
+            ECP_NIST256_copy(point, &entries[i].point);
+            pthread_rwlock_unlock(&shard->lock);
+            atomic_fetch_add_explicit(&shard->hits, 1, memory_order_relaxed);
+            return 1;
+        }
+    }
+    pthread_rwlock_unlock(&shard->lock);
+    atomic_fetch_add_explicit(&shard->misses, 1, memory_order_relaxed);
+
+    // Miss: validate outside the lock; invalid keys are never remembered
+    if (!validate_key(key_bytes, point))
+    {
+        return 0;
+    }
+
+    // Insert, unless a concurrent caller already did; prefer a free way, otherwise evict the oldest one
+    pthread_rwlock_wrlock(&shard->lock);
+    int present = 0;
+    for (int i = 0; i < set->geometry.ways && !present; i++)
+    {
+        present = entry_matches(&entries[i], hash, key_bytes);
+    }
+
+    if (!present)
+    {
+        public_key_set_entry_t* victim = &entries[cvc_set_victim(entries, sizeof(public_key_set_entry_t), set->geometry.ways)];
+        if (victim->way.in_use)
+        {
+            shard->evictions++;
+            shard->entry_count--;
+        }
+        victim->hash = hash;
+        victim->way.stamp = ++shard->clock;
+        memcpy(victim->encoding, key_bytes, CVC_PUBLIC_KEY_SET_KEY_LENGTH);
+        ECP_NIST256_copy(&victim->point, point);
+        victim->way.in_use = 1;
+        shard->entry_count++;
+    }
+    pthread_rwlock_unlock(&shard->lock);
+
+    return 1;
+}
@@ -0,0 +1,111 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef PUBLIC_KEY_SET_H
+#define PUBLIC_KEY_SET_H
+
+#include <stdint.h>
+#include "ecp_NIST256.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Length of an uncompressed NIST P-256 public key (0x04 || X || Y)
+#define CVC_PUBLIC_KEY_SET_KEY_LENGTH 65
+
+/**
+ * @brief Result codes for validated public key set operations
+ */
+typedef enum
+{
+    CVC_PUBLIC_KEY_SET_SUCCESS = 0,                  /**< Operation completed successfully */
+    CVC_PUBLIC_KEY_SET_ERROR_INVALID_PARAMS = -1,    /**< Invalid input parameters */
+    CVC_PUBLIC_KEY_SET_ERROR_ALLOCATION_FAILED = -2, /**< Failed to allocate set memory */
+} cvc_public_key_set_result_t;
+
+/**
+ * @brief Sizing of a validated public key set
+ */
+typedef struct
+{
+    int max_entries; /**< Maximum number of remembered keys (must be > 0) */
+    int shard_count; /**< Number of independently locked shards (0 = default, rounded down to a power of two) */
+} cvc_public_key_set_config_t;
+
+/**
+ * @brief Snapshot of set counters
+ */
+typedef struct
+{
+    uint64_t hits;      /**< Lookups answered without validation */
+    uint64_t misses;    /**< Lookups that needed full SEC1 validation */
+    uint64_t evictions; /**< Entries dropped to make room for new ones */
+    uint64_t entries;   /**< Entries currently held */
+    uint64_t capacity;  /**< Maximum number of entries the set can hold */
+} cvc_public_key_set_stats_t;
+
+/**
+ * @brief Opaque bounded set of uncompressed P-256 encodings that passed validation
+ */
+typedef struct cvc_public_key_set cvc_public_key_set_t;
+
+/**
+ * @brief Create a bounded, sharded set of validated public keys
+ *
+ * Entries are addressed by a seeded 64-bit hash of the 65-byte encoding and confirmed
+ * with a full comparison, so a hash collision can never admit an unvalidated key.
+ * Each entry also keeps the decoded point, so a hit skips both the curve-equation
+ * check and the conversion into Montgomery form. Each shard has a reader-writer
+ * lock; lookups only take it for reading. Full sets evict their oldest entry.
+ *
+ * @param config Set sizing (see cvc_public_key_set_config_t)
+ * @param hash_seed Random bytes keying the slot hash, so callers cannot aim keys at one set (at least 16 bytes)
+ * @param hash_seed_len Length of hash_seed
+ * @param set Output pointer receiving the new set
+ * @return CVC_PUBLIC_KEY_SET_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_public_key_set_create(const cvc_public_key_set_config_t* config, const unsigned char* hash_seed, int hash_seed_len, cvc_public_key_set_t** set);
+
+/**
+ * @brief Release the set
+ *
+ * @param set Set to destroy (NULL is ignored). No other thread may use it concurrently.
+ */
+void cvc_public_key_set_destroy(cvc_public_key_set_t* set);
+
+/**
+ * @brief Drop all entries, keeping counters
+ *
+ * @param set Set to clear
+ */
+void cvc_public_key_set_clear(cvc_public_key_set_t* set);
+
+/**
+ * @brief Read the set counters
+ *
+ * @param set Set to inspect
+ * @param stats Output structure receiving the counters
+ * @return CVC_PUBLIC_KEY_SET_SUCCESS on success, or CVC_PUBLIC_KEY_SET_ERROR_INVALID_PARAMS
+ */
+int cvc_public_key_set_get_stats(cvc_public_key_set_t* set, cvc_public_key_set_stats_t* stats);
+
+/**
+ * @brief Decode an uncompressed public key, validating it only if the set has not seen it
+ *
+ * On a hit the stored point is copied out. On a miss the key goes through
+ * ECP_NIST256_fromOctet and, if it is a valid finite point, is remembered.
+ * Passing a NULL set always validates.
+ *
+ * @param set Set to consult (may be NULL)
+ * @param key_bytes Public key in uncompressed format (65 bytes)
+ * @param point Output point (affine, z = 1)
+ * @return 1 if the key is a valid finite point, 0 otherwise
+ */
+int cvc_public_key_set_decode(cvc_public_key_set_t* set, const unsigned char* key_bytes, ECP_NIST256* point);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PUBLIC_KEY_SET_H
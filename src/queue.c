@@ -0,0 +1,393 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "queue.h"
+#include "add_secret_keys.h"
+#include "ecp_operations.h"
+#include "hash_to_field.h"
+#include "secure_memory.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Upper bound on the in-flight limit, keeps ring allocations reasonable
+#define QUEUE_MAX_CAPACITY (1 << 20)
+
+// Size of a cache line, used to keep the ring indices on separate lines
+#define QUEUE_CACHE_LINE 64
+
+// Bounded multi-producer/multi-consumer ring (Vyukov). Every cell starts with a
+// sequence number that tells producers and consumers whether the cell is free
+// for the current lap; the payload follows at a fixed offset.
+typedef struct
+{
+    unsigned char* cells;
+    size_t cell_size;
+    size_t payload_size;
+    size_t mask;
+    char pad0[QUEUE_CACHE_LINE];
+    _Atomic size_t enqueue_pos;
+    char pad1[QUEUE_CACHE_LINE - sizeof(size_t)];
+    _Atomic size_t dequeue_pos;
+    char pad2[QUEUE_CACHE_LINE - sizeof(size_t)];
+} queue_ring_t;
+
+struct cvc_queue
+{
+    queue_ring_t submissions;
+    queue_ring_t completions;
+    _Atomic int in_flight;
+    int capacity;
+    _Atomic int idle_workers;
+    _Atomic int stopping;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_t* workers;
+    int worker_count;
+};
+
+// Payload offset inside a cell; keeps the payload 8-byte aligned
+#define QUEUE_PAYLOAD_OFFSET 8
+
+static _Atomic size_t* ring_sequence(const queue_ring_t* ring, size_t pos)
+{
+    return (_Atomic size_t*)(ring->cells + (pos & ring->mask) * ring->cell_size);
+}
+
+static unsigned char* ring_payload(const queue_ring_t* ring, size_t pos)
+{
+    return ring->cells + (pos & ring->mask) * ring->cell_size + QUEUE_PAYLOAD_OFFSET;
+}
+
+static int ring_init(queue_ring_t* ring, size_t capacity, size_t payload_size)
+{
+    ring->payload_size = payload_size;
+    ring->cell_size = (QUEUE_PAYLOAD_OFFSET + payload_size + 7) & ~(size_t)7;
+    ring->mask = capacity - 1;
+    ring->cells = calloc(capacity, ring->cell_size);
+    if (!ring->cells)
+    {
+        return -1;
+    }
+
+    for (size_t i = 0; i < capacity; i++)
+    {
+        atomic_init(ring_sequence(ring, i), i);
+    }
+    atomic_init(&ring->enqueue_pos, 0);
+    atomic_init(&ring->dequeue_pos, 0);
+
+    return 0;
+}
+
+static void ring_free(queue_ring_t* ring)
+{
+    if (ring->cells)
+    {
+        // Payloads may hold key material
+        cvc_secure_zero(ring->cells, (ring->mask + 1) * ring->cell_size);
+        free(ring->cells);
+        ring->cells = NULL;
+    }
+}
+
+// Returns 1 if the payload was stored, 0 if the ring is full
+static int ring_push(queue_ring_t* ring, const void* payload)
+{
+    size_t pos = atomic_load_explicit(&ring->enqueue_pos, memory_order_relaxed);
+    for (;;)
+    {
+        const size_t sequence = atomic_load_explicit(ring_sequence(ring, pos), memory_order_acquire);
+        const intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+        if (diff == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&ring->enqueue_pos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return 0;
+        }
+        else
+        {
+            pos = atomic_load_explicit(&ring->enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    memcpy(ring_payload(ring, pos), payload, ring->payload_size);
+    atomic_store_explicit(ring_sequence(ring, pos), pos + 1, memory_order_release);
+    return 1;
+}
+
+// Returns 1 if a payload was taken, 0 if the ring is empty
+static int ring_pop(queue_ring_t* ring, void* payload)
+{
+    size_t pos = atomic_load_explicit(&ring->dequeue_pos, memory_order_relaxed);
+    for (;;)
+    {
+        const size_t sequence = atomic_load_explicit(ring_sequence(ring, pos), memory_order_acquire);
+        const intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+        if (diff == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&ring->dequeue_pos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return 0;
+        }
+        else
+        {
+            pos = atomic_load_explicit(&ring->dequeue_pos, memory_order_relaxed);
+        }
+    }
+
+    unsigned char* cell_payload = ring_payload(ring, pos);
+    memcpy(payload, cell_payload, ring->payload_size);
+    cvc_secure_zero(cell_payload, ring->payload_size);
+    atomic_store_explicit(ring_sequence(ring, pos), pos + ring->mask + 1, memory_order_release);
+    return 1;
+}
+
+static int ring_is_empty(const queue_ring_t* ring)
+{
+    const size_t pos = atomic_load_explicit(&ring->dequeue_pos, memory_order_relaxed);
+    const size_t sequence = atomic_load_explicit(ring_sequence(ring, pos), memory_order_acquire);
+    return (intptr_t)sequence - (intptr_t)(pos + 1) < 0;
+}
+
+static void execute_job(const cvc_queue_job_t* job, cvc_queue_completion_t* completion)
+{
+    memset(completion, 0, sizeof(cvc_queue_completion_t));
+    completion->user_data = job->user_data;
+    completion->op = job->op;
+
+    switch (job->op)
+    {
+        case CVC_QUEUE_OP_DERIVE:
+            completion->status = cvc_derive_secret_key_nist256(job->master_key, job->master_key_len, job->context, job->context_len, job->dst, job->dst_len, &completion->key_material);
+            break;
+        case CVC_QUEUE_OP_ADD_PUBLIC:
+        {
+            int result_len = 0;
+            completion->status = cvc_add_nist256_public_keys(job->key1, sizeof(job->key1), job->key2, sizeof(job->key2), completion->public_key, sizeof(completion->public_key), &result_len);
+            break;
+        }
+        case CVC_QUEUE_OP_ADD_SECRET:
+            completion->status = cvc_add_nist256_secret_keys(job->key1, MODBYTES_256_56, job->key2, MODBYTES_256_56, &completion->key_material);
+            break;
+        case CVC_QUEUE_OP_KEYGEN:
+            completion->status = nist256_generate_key_material((unsigned char*)job->seed, sizeof(job->seed), &completion->key_material);
+            break;
+        default:
+            completion->status = CVC_QUEUE_ERROR_INVALID_OPERATION;
+            break;
+    }
+}
+
+static void wait_for_work(cvc_queue_t* queue)
+{
+    pthread_mutex_lock(&queue->lock);
+    atomic_fetch_add(&queue->idle_workers, 1);
+    // Pairs with the fence in cvc_queue_submit: either we see the new job or the submitter sees us idle
+    atomic_thread_fence(memory_order_seq_cst);
+    while (!atomic_load(&queue->stopping) && ring_is_empty(&queue->submissions))
+    {
+        pthread_cond_wait(&queue->wake, &queue->lock);
+    }
+    atomic_fetch_sub(&queue->idle_workers, 1);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+static void* queue_worker(void* arg)
+{
+    cvc_queue_t* queue = arg;
+    cvc_queue_job_t job;
+    cvc_queue_completion_t completion;
+
+    while (!atomic_load(&queue->stopping))
+    {
+        if (!ring_pop(&queue->submissions, &job))
+        {
+            wait_for_work(queue);
+            continue;
+        }
+
+        execute_job(&job, &completion);
+
+        // Admission control in cvc_queue_submit guarantees a completion slot;
+        // a push can only fail transiently while a poller is mid-pop
+        while (!ring_push(&queue->completions, &completion))
+        {
+            sched_yield();
+        }
+
+        cvc_secure_zero(&job, sizeof(job));
+        cvc_secure_zero(&completion, sizeof(completion));
+    }
+
+    return NULL;
+}
+
+static void stop_workers(cvc_queue_t* queue, int started)
+{
+    atomic_store(&queue->stopping, 1);
+    pthread_mutex_lock(&queue->lock);
+    pthread_cond_broadcast(&queue->wake);
+    pthread_mutex_unlock(&queue->lock);
+
+    for (int i = 0; i < started; i++)
+    {
+        pthread_join(queue->workers[i], NULL);
+    }
+}
+
+static void release_queue(cvc_queue_t* queue)
+{
+    ring_free(&queue->submissions);
+    ring_free(&queue->completions);
+    pthread_cond_destroy(&queue->wake);
+    pthread_mutex_destroy(&queue->lock);
+    free(queue->workers);
+    free(queue);
+}
+
+int cvc_queue_create(int worker_count, int capacity, cvc_queue_t** queue)
+{
+    // Basic parameter validation
+    if (worker_count <= 0 || capacity <= 0 || capacity > QUEUE_MAX_CAPACITY || !queue)
+    {
+        return CVC_QUEUE_ERROR_INVALID_PARAMS;
+    }
+
+    *queue = NULL;
+
+    size_t ring_capacity = 1;
+    while (ring_capacity < (size_t)capacity)
+    {
+        ring_capacity *= 2;
+    }
+
+    cvc_queue_t* result = calloc(1, sizeof(cvc_queue_t));
+    if (!result)
+    {
+        return CVC_QUEUE_ERROR_ALLOCATION_FAILED;
+    }
+
+    pthread_mutex_init(&result->lock, NULL);
+    pthread_cond_init(&result->wake, NULL);
+    atomic_init(&result->in_flight, 0);
+    atomic_init(&result->idle_workers, 0);
+    atomic_init(&result->stopping, 0);
+    result->capacity = (int)ring_capacity;
+
+    result->workers = calloc((size_t)worker_count, sizeof(pthread_t));
+    if (!result->workers || ring_init(&result->submissions, ring_capacity, sizeof(cvc_queue_job_t)) != 0 || ring_init(&result->completions, ring_capacity, sizeof(cvc_queue_completion_t)) != 0)
+    {
+        release_queue(result);
+        return CVC_QUEUE_ERROR_ALLOCATION_FAILED;
+    }
+
+    for (int i = 0; i < worker_count; i++)
+    {
+        if (pthread_create(&result->workers[i], NULL, queue_worker, result) != 0)
+        {
+            stop_workers(result, i);
+            release_queue(result);
+            return CVC_QUEUE_ERROR_THREAD_START_FAILED;
+        }
+    }
+    result->worker_count = worker_count;
+
+    *queue = result;
+    return CVC_QUEUE_SUCCESS;
+}
+
+void cvc_queue_destroy(cvc_queue_t* queue)
+{
+    if (!queue)
+    {
+        return;
+    }
+
+    stop_workers(queue, queue->worker_count);
+    release_queue(queue);
+}
+
+int cvc_queue_submit(cvc_queue_t* queue, const cvc_queue_job_t* jobs, int job_count)
+{
+    if (!queue || !jobs || job_count < 0)
+    {
+        return CVC_QUEUE_ERROR_INVALID_PARAMS;
+    }
+
+    // Reserve in-flight slots for as many jobs as fit, in one step
+    int current = atomic_load(&queue->in_flight);
+    int accepted;
+    do
+    {
+        const int available = queue->capacity - current;
+        accepted = job_count < available ? job_count : available;
+        if (accepted <= 0)
+        {
+            return 0;
+        }
+    } while (!atomic_compare_exchange_weak(&queue->in_flight, &current, current + accepted));
+
+    for (int i = 0; i < accepted; i++)
+    {
+        // The reservation guarantees space; a push can only fail transiently
+        while (!ring_push(&queue->submissions, &jobs[i]))
+        {
+            sched_yield();
+        }
+    }
+
+    // Wake sleeping workers (see wait_for_work for the pairing fence)
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load(&queue->idle_workers) > 0)
+    {
+        pthread_mutex_lock(&queue->lock);
+        pthread_cond_broadcast(&queue->wake);
+        pthread_mutex_unlock(&queue->lock);
+    }
+
+    return accepted;
+}
+
+int cvc_queue_poll(cvc_queue_t* queue, cvc_queue_completion_t* completions, int max_completions)
+{
+    if (!queue || !completions || max_completions < 0)
+    {
+        return CVC_QUEUE_ERROR_INVALID_PARAMS;
+    }
+
+    int drained = 0;
+    while (drained < max_completions && ring_pop(&queue->completions, &completions[drained]))
+    {
+        drained++;
+    }
+
+    if (drained > 0)
+    {
+        atomic_fetch_sub(&queue->in_flight, drained);
+    }
+
+    return drained;
+}
+
+int cvc_queue_in_flight(cvc_queue_t* queue)
+{
+    if (!queue)
+    {
+        return CVC_QUEUE_ERROR_INVALID_PARAMS;
+    }
+
+    return atomic_load(&queue->in_flight);
+}
@@ -0,0 +1,144 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef QUEUE_H
+#define QUEUE_H
+
+#include <stdint.h>
+#include "nist256_key_material.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Result codes for submission/completion queue operations
+ */
+typedef enum
+{
+    CVC_QUEUE_SUCCESS = 0,                    /**< Operation completed successfully */
+    CVC_QUEUE_ERROR_INVALID_PARAMS = -1,      /**< Invalid input parameters */
+    CVC_QUEUE_ERROR_ALLOCATION_FAILED = -2,   /**< Failed to allocate queue memory */
+    CVC_QUEUE_ERROR_THREAD_START_FAILED = -3, /**< Failed to start a worker thread */
+    CVC_QUEUE_ERROR_INVALID_OPERATION = -4,   /**< Job carried an unknown operation code */
+} cvc_queue_result_t;
+
+/**
+ * @brief Operations that can be submitted to a queue
+ */
+typedef enum
+{
+    CVC_QUEUE_OP_DERIVE = 1,     /**< cvc_derive_secret_key_nist256 */
+    CVC_QUEUE_OP_ADD_PUBLIC = 2, /**< cvc_add_nist256_public_keys */
+    CVC_QUEUE_OP_ADD_SECRET = 3, /**< cvc_add_nist256_secret_keys */
+    CVC_QUEUE_OP_KEYGEN = 4,     /**< nist256_generate_key_material */
+} cvc_queue_op_t;
+
+/**
+ * @brief A job submitted to the queue
+ *
+ * Fixed-size operands are copied into the queue on submission. The derive operands
+ * are referenced by pointer and must stay valid until the matching completion has
+ * been polled.
+ */
+typedef struct
+{
+    uint64_t user_data; /**< Opaque caller value echoed in the completion */
+    int op;             /**< One of cvc_queue_op_t */
+
+    // CVC_QUEUE_OP_DERIVE
+    const unsigned char* master_key; /**< Master key material */
+    int master_key_len;              /**< Length of the master key material */
+    const unsigned char* context;    /**< Derivation context */
+    int context_len;                 /**< Length of the context */
+    const unsigned char* dst;        /**< Domain Separation Tag */
+    int dst_len;                     /**< Length of the DST */
+
+    // CVC_QUEUE_OP_ADD_PUBLIC (65-byte uncompressed keys) and CVC_QUEUE_OP_ADD_SECRET (first 32 bytes)
+    unsigned char key1[65]; /**< First operand */
+    unsigned char key2[65]; /**< Second operand */
+
+    // CVC_QUEUE_OP_KEYGEN
+    unsigned char seed[32]; /**< Random seed for key generation */
+} cvc_queue_job_t;
+
+/**
+ * @brief The result of one job
+ */
+typedef struct
+{
+    uint64_t user_data;                  /**< Value from the submitted job */
+    int op;                              /**< Operation of the submitted job */
+    int status;                          /**< Result code of the underlying cvc function (0 = success) */
+    nist256_key_material_t key_material; /**< Result of DERIVE, ADD_SECRET and KEYGEN */
+    unsigned char public_key[65];        /**< Result of ADD_PUBLIC (uncompressed) */
+} cvc_queue_completion_t;
+
+/**
+ * @brief Opaque submission/completion queue with its own worker threads
+ */
+typedef struct cvc_queue cvc_queue_t;
+
+/**
+ * @brief Create a queue and start its worker threads
+ *
+ * Submissions and completions travel through bounded lock-free rings, so a caller
+ * can hand over thousands of jobs in one call and drain finished results in bulk
+ * later (e.g. once per cgo crossing). At most `capacity` jobs may be in flight
+ * (submitted but not yet polled) at any time.
+ *
+ * @param worker_count Number of worker threads (must be > 0)
+ * @param capacity Maximum number of in-flight jobs (rounded up to a power of two)
+ * @param queue Output pointer receiving the new queue
+ * @return CVC_QUEUE_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_queue_create(int worker_count, int capacity, cvc_queue_t** queue);
+
+/**
+ * @brief Stop the workers and release the queue
+ *
+ * Jobs that have not completed are discarded. No other thread may use the queue
+ * concurrently with or after this call.
+ *
+ * @param queue Queue to destroy (NULL is ignored)
+ */
+void cvc_queue_destroy(cvc_queue_t* queue);
+
+/**
+ * @brief Submit jobs without blocking
+ *
+ * Jobs are accepted in order until the in-flight limit is reached.
+ *
+ * @param queue Queue to submit to
+ * @param jobs Array of jobs
+ * @param job_count Number of jobs in the array
+ * @return Number of jobs accepted (0..job_count), or CVC_QUEUE_ERROR_INVALID_PARAMS
+ */
+int cvc_queue_submit(cvc_queue_t* queue, const cvc_queue_job_t* jobs, int job_count);
+
+/**
+ * @brief Drain completed jobs without blocking
+ *
+ * Completions are returned in the order jobs finished, which is not necessarily
+ * submission order; use user_data to match them up.
+ *
+ * @param queue Queue to poll
+ * @param completions Output array
+ * @param max_completions Capacity of the output array
+ * @return Number of completions written (0..max_completions), or CVC_QUEUE_ERROR_INVALID_PARAMS
+ */
+int cvc_queue_poll(cvc_queue_t* queue, cvc_queue_completion_t* completions, int max_completions);
+
+/**
+ * @brief Number of jobs submitted but not yet polled
+ *
+ * @param queue Queue to inspect
+ * @return In-flight job count, or CVC_QUEUE_ERROR_INVALID_PARAMS
+ */
+int cvc_queue_in_flight(cvc_queue_t* queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // QUEUE_H
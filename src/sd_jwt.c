@@ -0,0 +1,173 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "sd_jwt.h"
+#include "base64url_stream.h"
+#include "sha256.h"
+#include <string.h>
+
+// Disclosures hashed per cvc_sha256_batch call
+#define SD_JWT_DIGEST_CHUNK 64
+
+// Bytes an escaped JSON string body takes
+static long long escaped_length(const char* text, int len)
+{
+    long long escaped = 0;
+    for (int i = 0; i < len; i++)
+    {
+        const unsigned char c = (unsigned char)text[i];
+        if (c == '"' || c == '\\')
+        {
+            escaped += 2;
+        }
+        else if (c < 0x20)
+        {
+            escaped += 6; // \u00XX
+        }
+        else
+        {
+            escaped++;
+        }
+    }
+    return escaped;
+}
+
+// Append "text" as a JSON string, escaping through a small staging buffer
+static void stream_json_string(cvc_base64url_stream_t* stream, const char* text, int len)
+{
+    static const char hex[] = "0123456789abcdef";
+    unsigned char staging[64];
+    int staged = 0;
+
+    staging[staged++] = '"';
+    for (int i = 0; i < len; i++)
+    {
+        // Room for the longest escape (\u00XX) plus the closing quote
+        if (staged > (int)sizeof(staging) - 7)
+        {
+            cvc_base64url_stream_update(stream, staging, staged);
+            staged = 0;
+        }
+
+        const unsigned char c = (unsigned char)text[i];
+        if (c == '"' || c == '\\')
+        {
+            staging[staged++] = '\\';
+            staging[staged++] = c;
+        }
+        else if (c < 0x20)
+        {
+            memcpy(staging + staged, "\\u00", 4);
+            staging[staged + 4] = (unsigned char)hex[c >> 4];
+            staging[staged + 5] = (unsigned char)hex[c & 15];
+            staged += 6;
+        }
+        else
+        {
+            staging[staged++] = c;
+        }
+    }
+    staging[staged++] = '"';
+
+    cvc_base64url_stream_update(stream, staging, staged);
+}
+
+// Length of the JSON array [salt, name, value] without whitespace
+static long long json_length(const cvc_sd_jwt_disclosure_input_t* input)
+{
+    long long len = 1 + (escaped_length(input->salt, input->salt_len) + 2) + 1 + (long long)input->value_len + 1;
+    if (input->name)
+    {
+        len += (escaped_length(input->name, input->name_len) + 2) + 1;
+    }
+    return len;
+}
+
+static int valid_input(const cvc_sd_jwt_disclosure_input_t* input)
+{
+    return input && input->salt && input->salt_len > 0 && input->value && input->value_len > 0 && (!input->name || input->name_len >= 0);
+}
+
+int cvc_sd_jwt_disclosure_length(const cvc_sd_jwt_disclosure_input_t* input)
+{
+    if (!valid_input(input))
+    {
+        return -1;
+    }
+
+    const long long len = json_length(input);
+    return len > CVC_BASE64URL_MAX_INPUT_LENGTH ? -1 : cvc_base64url_encoded_length((int)len);
+}
+
+int cvc_sd_jwt_disclosures(const cvc_sd_jwt_disclosure_input_t* inputs, int count, char* arena, int arena_size, int* disclosure_offsets, int* disclosure_lens, char* digests)
+{
+    // Basic parameter validation
+    if (!inputs || count <= 0 || !arena || !disclosure_offsets || !disclosure_lens || !digests)
+    {
+        return CVC_SD_JWT_ERROR_INVALID_PARAMS;
+    }
+
+    // Lay out the arena before writing anything
+    long long total = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (!valid_input(&inputs[i]))
+        {
+            return CVC_SD_JWT_ERROR_INVALID_PARAMS;
+        }
+        disclosure_offsets[i] = (int)total;
+        disclosure_lens[i] = cvc_sd_jwt_disclosure_length(&inputs[i]);
+        if (disclosure_lens[i] < 0)
+        {
+            return CVC_SD_JWT_ERROR_INVALID_PARAMS;
+        }
+        total += disclosure_lens[i];
+        if (total > arena_size)
+        {
+            return CVC_SD_JWT_ERROR_INSUFFICIENT_BUFFER;
+        }
+    }
+
+    // Disclosures: the JSON array is encoded as it is produced
+    for (int i = 0; i < count; i++)
+    {
+        const cvc_sd_jwt_disclosure_input_t* input = &inputs[i];
+        cvc_base64url_stream_t stream;
+        cvc_base64url_stream_init(&stream, arena + disclosure_offsets[i]);
+
+        cvc_base64url_stream_update(&stream, (const unsigned char*)"[", 1);
+        stream_json_string(&stream, input->salt, input->salt_len);
+        cvc_base64url_stream_update(&stream, (const unsigned char*)",", 1);
+        if (input->name)
+        {
+            stream_json_string(&stream, input->name, input->name_len);
+            cvc_base64url_stream_update(&stream, (const unsigned char*)",", 1);
+        }
+        cvc_base64url_stream_update(&stream, (const unsigned char*)input->value, input->value_len);
+        cvc_base64url_stream_update(&stream, (const unsigned char*)"]", 1);
+        cvc_base64url_stream_final(&stream);
+    }
+
+    // Digests: SHA-256 over the ASCII disclosures, many lanes at a time
+    const unsigned char* messages[SD_JWT_DIGEST_CHUNK];
+    unsigned char hashes[SD_JWT_DIGEST_CHUNK][CVC_SHA256_DIGEST_SIZE];
+    for (int start = 0; start < count; start += SD_JWT_DIGEST_CHUNK)
+    {
+        const int chunk = count - start < SD_JWT_DIGEST_CHUNK ? count - start : SD_JWT_DIGEST_CHUNK;
+        for (int k = 0; k < chunk; k++)
+        {
+            messages[k] = (const unsigned char*)arena + disclosure_offsets[start + k];
+        }
+        cvc_sha256_batch(messages, disclosure_lens + start, chunk, &hashes[0][0]);
+
+        for (int k = 0; k < chunk; k++)
+        {
+            cvc_base64url_stream_t stream;
+            cvc_base64url_stream_init(&stream, digests + (size_t)(start + k) * CVC_SD_JWT_DIGEST_LENGTH);
+            cvc_base64url_stream_update(&stream, hashes[k], CVC_SHA256_DIGEST_SIZE);
+            cvc_base64url_stream_final(&stream);
+        }
+    }
+
+    return CVC_SD_JWT_SUCCESS;
+}
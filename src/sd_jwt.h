@@ -0,0 +1,74 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef SD_JWT_H
+#define SD_JWT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// base64url of a SHA-256 digest, as listed in "_sd" arrays
+#define CVC_SD_JWT_DIGEST_LENGTH 43
+
+/**
+ * @brief Result codes for SD-JWT operations
+ */
+typedef enum
+{
+    CVC_SD_JWT_SUCCESS = 0,                    /**< Operation completed successfully */
+    CVC_SD_JWT_ERROR_INVALID_PARAMS = -1,      /**< Invalid input parameters */
+    CVC_SD_JWT_ERROR_INSUFFICIENT_BUFFER = -2, /**< Arena is too small */
+} cvc_sd_jwt_result_t;
+
+/**
+ * @brief One selectively disclosable claim
+ *
+ * The salt and name are written as JSON strings (escaped as needed); the value is
+ * copied verbatim and must already be serialized JSON (e.g. "\"Berlin\"", "42" or
+ * "{\"country\":\"DE\"}"). A NULL name produces an array element disclosure.
+ */
+typedef struct
+{
+    const char* salt;  /**< Salt, e.g. base64url of 16 random bytes */
+    int salt_len;      /**< Length of the salt */
+    const char* name;  /**< Claim name, or NULL for an array element */
+    int name_len;      /**< Length of the claim name */
+    const char* value; /**< Claim value as JSON text */
+    int value_len;     /**< Length of the value */
+} cvc_sd_jwt_disclosure_input_t;
+
+/**
+ * @brief Length of the disclosure string for one entry
+ *
+ * @param input Entry
+ * @return Length in characters, or -1 for invalid input or a disclosure longer than INT_MAX
+ */
+int cvc_sd_jwt_disclosure_length(const cvc_sd_jwt_disclosure_input_t* input);
+
+/**
+ * @brief Build disclosures and their "_sd" digests for many claims in one call
+ *
+ * Disclosure i is base64url of the JSON array [salt, name, value] (or [salt, value])
+ * without whitespace, and its digest is base64url(SHA-256(disclosure)). The JSON is
+ * never materialized: it is base64url-encoded straight into the arena as it is
+ * produced, with an SSSE3 kernel for the bulk of each value where available. The
+ * digests are then computed with multi-buffer SHA-256 over the disclosures in place.
+ * Nothing is allocated.
+ *
+ * @param inputs Entries
+ * @param count Number of entries
+ * @param arena Output buffer receiving all disclosures back to back (not NUL-terminated)
+ * @param arena_size Size of the arena; the sum of cvc_sd_jwt_disclosure_length over the entries is enough
+ * @param disclosure_offsets Receives the offset of each disclosure in the arena
+ * @param disclosure_lens Receives the length of each disclosure
+ * @param digests Output buffer of count * CVC_SD_JWT_DIGEST_LENGTH characters
+ * @return CVC_SD_JWT_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_sd_jwt_disclosures(const cvc_sd_jwt_disclosure_input_t* inputs, int count, char* arena, int arena_size, int* disclosure_offsets, int* disclosure_lens, char* digests);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SD_JWT_H
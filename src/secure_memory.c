@@ -0,0 +1,113 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "secure_memory.h"
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Calling memset through a volatile pointer prevents dead-store elimination
+static void* (*const volatile secure_memset)(void*, int, size_t) = memset;
+
+static size_t page_size(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (size_t)info.dwPageSize;
+#else
+    long size = sysconf(_SC_PAGESIZE);
+    return size > 0 ? (size_t)size : 4096;
+#endif
+}
+
+static size_t round_to_pages(size_t size)
+{
+    const size_t page = page_size();
+    return (size + page - 1) / page * page;
+}
+
+size_t cvc_secure_page_size(void)
+{
+    return page_size();
+}
+
+void cvc_secure_zero(void* ptr, size_t len)
+{
+    if (ptr && len > 0)
+    {
+        secure_memset(ptr, 0, len);
+    }
+}
+
+void* cvc_secure_alloc(size_t size, int* locked)
+{
+    if (locked)
+    {
+        *locked = 0;
+    }
+
+    if (size == 0)
+    {
+        return NULL;
+    }
+
+    const size_t total = round_to_pages(size);
+
+#ifdef _WIN32
+    void* ptr = VirtualAlloc(NULL, total, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (!ptr)
+    {
+        return NULL;
+    }
+
+    if (VirtualLock(ptr, total) && locked)
+    {
+        *locked = 1;
+    }
+#else
+    void* ptr = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+#ifdef MADV_DONTDUMP
+    // Keep secrets out of core dumps (Linux only, best effort)
+    madvise(ptr, total, MADV_DONTDUMP);
+#endif
+
+    if (mlock(ptr, total) == 0 && locked)
+    {
+        *locked = 1;
+    }
+#endif
+
+    // Anonymous mappings are already zeroed, but be explicit about the contract
+    memset(ptr, 0, total);
+    return ptr;
+}
+
+void cvc_secure_free(void* ptr, size_t size)
+{
+    if (!ptr || size == 0)
+    {
+        return;
+    }
+
+    const size_t total = round_to_pages(size);
+    cvc_secure_zero(ptr, total);
+
+#ifdef _WIN32
+    VirtualUnlock(ptr, total);
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    munlock(ptr, total);
+    munmap(ptr, total);
+#endif
+}
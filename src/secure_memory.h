@@ -0,0 +1,55 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef SECURE_MEMORY_H
+#define SECURE_MEMORY_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Allocate page-aligned memory intended to hold secret key material
+ *
+ * The memory is zero-initialized, excluded from core dumps where the platform
+ * supports it, and locked into RAM (mlock / VirtualLock) so it is never written
+ * to swap. Locking can fail when the process exceeds its locked-memory limit;
+ * in that case the allocation is still returned and *locked is set to 0 so the
+ * caller can decide whether unlocked memory is acceptable.
+ *
+ * @param size Number of bytes to allocate (rounded up to whole pages)
+ * @param locked Optional output, set to 1 if the pages were locked, 0 otherwise
+ * @return Pointer to the allocation, or NULL on failure
+ */
+void* cvc_secure_alloc(size_t size, int* locked);
+
+/**
+ * @brief Granularity cvc_secure_alloc rounds sizes up to
+ *
+ * @return System page size in bytes
+ */
+size_t cvc_secure_page_size(void);
+
+/**
+ * @brief Zeroize, unlock and release memory obtained from cvc_secure_alloc
+ *
+ * @param ptr Pointer returned by cvc_secure_alloc (NULL is ignored)
+ * @param size The size that was passed to cvc_secure_alloc
+ */
+void cvc_secure_free(void* ptr, size_t size);
+
+/**
+ * @brief Overwrite memory with zeros in a way the compiler cannot elide
+ *
+ * @param ptr Memory to clear
+ * @param len Number of bytes to clear
+ */
+void cvc_secure_zero(void* ptr, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SECURE_MEMORY_H
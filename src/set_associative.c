@@ -0,0 +1,60 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "set_associative.h"
+
+// Largest power of two that is <= value (value must be > 0)
+static int floor_power_of_two(int value)
+{
+    int result = 1;
+    while (result <= value / 2)
+    {
+        result *= 2;
+    }
+    return result;
+}
+
+void cvc_set_geometry_init(cvc_set_geometry_t* geometry, int capacity, int max_ways, int requested_shards, int default_shards)
+{
+    const int ways = capacity < max_ways ? capacity : max_ways;
+    int shard_count = requested_shards > 0 ? requested_shards : default_shards;
+    if (shard_count > capacity / ways)
+    {
+        shard_count = capacity / ways;
+    }
+    shard_count = floor_power_of_two(shard_count);
+
+    geometry->shard_count = shard_count;
+    geometry->sets_per_shard = capacity / (shard_count * ways);
+    geometry->ways = ways;
+}
+
+size_t cvc_set_geometry_shard_entries(const cvc_set_geometry_t* geometry)
+{
+    return (size_t)geometry->sets_per_shard * (size_t)geometry->ways;
+}
+
+void cvc_set_geometry_locate(const cvc_set_geometry_t* geometry, uint32_t shard_bits, uint32_t set_bits, int* shard, size_t* first_entry)
+{
+    *shard = (int)(shard_bits & (uint32_t)(geometry->shard_count - 1));
+    *first_entry = (size_t)(set_bits % (uint32_t)geometry->sets_per_shard) * (size_t)geometry->ways;
+}
+
+int cvc_set_victim(const void* set, size_t entry_size, int ways)
+{
+    const unsigned char* base = set;
+    int victim = 0;
+    for (int i = 0; i < ways; i++)
+    {
+        const cvc_set_way_t* way = (const cvc_set_way_t*)(base + (size_t)i * entry_size);
+        if (!way->in_use)
+        {
+            return i;
+        }
+        if (way->stamp < ((const cvc_set_way_t*)(base + (size_t)victim * entry_size))->stamp)
+        {
+            victim = i;
+        }
+    }
+    return victim;
+}
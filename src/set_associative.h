@@ -0,0 +1,86 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef SET_ASSOCIATIVE_H
+#define SET_ASSOCIATIVE_H
+
+// Internal to key_cache.c and public_key_set.c; not part of the public API in cvc.h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Shape of a sharded set-associative table
+ *
+ * Entries are split into shard_count independently locked shards (a power of two),
+ * each holding sets_per_shard sets of ways entries. A lookup or an eviction scans
+ * one set only.
+ */
+typedef struct
+{
+    int shard_count;
+    int sets_per_shard;
+    int ways;
+} cvc_set_geometry_t;
+
+/**
+ * @brief Bookkeeping every entry starts with
+ *
+ * Entry types put this first so cvc_set_victim can walk a set of any entry size.
+ */
+typedef struct
+{
+    uint64_t stamp; // Shard clock value the eviction order is based on
+    int in_use;
+} cvc_set_way_t;
+
+/**
+ * @brief Size a table for at most capacity entries
+ *
+ * Sets get up to max_ways ways; the shard count (requested_shards, or
+ * default_shards when that is 0) is capped so every shard has at least one set and
+ * rounded down to a power of two. Entries left over by the rounding are not used.
+ *
+ * @param geometry Output geometry
+ * @param capacity Maximum number of entries (must be > 0)
+ * @param max_ways Associativity to use when the capacity allows it
+ * @param requested_shards Shard count from the caller's config (0 = default)
+ * @param default_shards Shard count used when requested_shards is 0
+ */
+void cvc_set_geometry_init(cvc_set_geometry_t* geometry, int capacity, int max_ways, int requested_shards, int default_shards);
+
+/**
+ * @brief Number of entries in one shard
+ */
+size_t cvc_set_geometry_shard_entries(const cvc_set_geometry_t* geometry);
+
+/**
+ * @brief Shard and first entry of the set that uniformly distributed bits select
+ *
+ * @param geometry Table geometry
+ * @param shard_bits Bits choosing the shard
+ * @param set_bits Bits choosing the set within the shard
+ * @param shard Receives the shard index
+ * @param first_entry Receives the index of the set's first entry within the shard
+ */
+void cvc_set_geometry_locate(const cvc_set_geometry_t* geometry, uint32_t shard_bits, uint32_t set_bits, int* shard, size_t* first_entry);
+
+/**
+ * @brief Way of a set to fill next: the first free one, otherwise the one with the lowest stamp
+ *
+ * @param set First entry of the set; each entry starts with a cvc_set_way_t
+ * @param entry_size Size of one entry
+ * @param ways Number of ways in the set
+ * @return Index of the way to fill
+ */
+int cvc_set_victim(const void* set, size_t entry_size, int ways);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SET_ASSOCIATIVE_H
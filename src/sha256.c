@@ -0,0 +1,944 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "sha256.h"
+#include "secure_memory.h"
+#include "stack_budget.h"
+#include <pthread.h>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CVC_SHA256_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_SHA2))
+#define CVC_SHA256_ARMV8 1
+#include <arm_neon.h>
+#if defined(__linux__) || defined(__ANDROID__)
+#include <sys/auxv.h>
+#ifndef HWCAP_SHA2
+#define HWCAP_SHA2 (1 << 6)
+#endif
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+#endif
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static const uint32_t sha256_iv[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+
+// ============================================================================
+// Portable kernel
+// ============================================================================
+
+#define ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static uint32_t load_be32(const unsigned char* p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static void store_be32(unsigned char* p, uint32_t v)
+{
+    p[0] = (unsigned char)(v >> 24);
+    p[1] = (unsigned char)(v >> 16);
+    p[2] = (unsigned char)(v >> 8);
+    p[3] = (unsigned char)v;
+}
+
+static void sha256_compress_portable(uint32_t state[8], const unsigned char* blocks, size_t block_count)
+{
+    uint32_t w[64];
+
+    while (block_count--)
+    {
+        for (int t = 0; t < 16; t++)
+        {
+            w[t] = load_be32(blocks + 4 * t);
+        }
+        for (int t = 16; t < 64; t++)
+        {
+            const uint32_t s0 = ROTR32(w[t - 15], 7) ^ ROTR32(w[t - 15], 18) ^ (w[t - 15] >> 3);
+            const uint32_t s1 = ROTR32(w[t - 2], 17) ^ ROTR32(w[t - 2], 19) ^ (w[t - 2] >> 10);
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int t = 0; t < 64; t++)
+        {
+            const uint32_t t1 = h + (ROTR32(e, 6) ^ ROTR32(e, 11) ^ ROTR32(e, 25)) + ((e & f) ^ (~e & g)) + sha256_k[t] + w[t];
+            const uint32_t t2 = (ROTR32(a, 2) ^ ROTR32(a, 13) ^ ROTR32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+        blocks += CVC_SHA256_BLOCK_SIZE;
+    }
+}
+
+// ============================================================================
+// x86 SHA-NI kernel
+// ============================================================================
+
+#ifdef CVC_SHA256_X86
+__attribute__((target("sha,sse4.1,ssse3"))) static void sha256_compress_shani(uint32_t state[8], const unsigned char* blocks, size_t block_count)
+{
+    const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // The SHA-NI round instructions work on (ABEF, CDGH) register halves
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[0]), 0xB1); // CDAB
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[4]), 0x1B); // EFGH
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);                                    // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);                                         // CDGH
+
+    while (block_count--)
+    {
+        const __m128i abef_save = state0;
+        const __m128i cdgh_save = state1;
+
+        __m128i w[4];
+        for (int i = 0; i < 4; i++)
+        {
+            w[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + 16 * i)), byte_swap);
+        }
+
+        // 16 groups of 4 rounds; w[i & 3] holds message words 4i..4i+3 and is
+        // replaced by words 4(i+4)..4(i+4)+3 once consumed
+        for (int i = 0; i < 16; i++)
+        {
+            __m128i msg = _mm_add_epi32(w[i & 3], _mm_loadu_si128((const __m128i*)&sha256_k[4 * i]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+            msg = _mm_shuffle_epi32(msg, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+            if (i < 12)
+            {
+                __m128i next = _mm_sha256msg1_epu32(w[i & 3], w[(i + 1) & 3]);
+                next = _mm_add_epi32(next, _mm_alignr_epi8(w[(i + 3) & 3], w[(i + 2) & 3], 4));
+                w[i & 3] = _mm_sha256msg2_epu32(next, w[(i + 3) & 3]);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+        blocks += CVC_SHA256_BLOCK_SIZE;
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);       // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);    // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0); // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);    // HGFE
+    _mm_storeu_si128((__m128i*)&state[0], state0);
+    _mm_storeu_si128((__m128i*)&state[4], state1);
+}
+
+static int cpu_has_shani(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    {
+        return 0;
+    }
+    const int has_ssse3 = (ecx >> 9) & 1;
+    const int has_sse41 = (ecx >> 19) & 1;
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+    {
+        return 0;
+    }
+    const int has_sha = (ebx >> 29) & 1;
+
+    return has_ssse3 && has_sse41 && has_sha;
+}
+#endif
+
+// ============================================================================
+// ARMv8 crypto extension kernel
+// ============================================================================
+
+#ifdef CVC_SHA256_ARMV8
+static void sha256_compress_armv8(uint32_t state[8], const unsigned char* blocks, size_t block_count)
+{
+    uint32x4_t state0 = vld1q_u32(&state[0]);
+    uint32x4_t state1 = vld1q_u32(&state[4]);
+
+    while (block_count--)
+    {
+        const uint32x4_t abcd_save = state0;
+        const uint32x4_t efgh_save = state1;
+
+        uint32x4_t w[4];
+        for (int i = 0; i < 4; i++)
+        {
+            w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 16 * i)));
+        }
+
+        for (int i = 0; i < 16; i++)
+        {
+            const uint32x4_t msg = vaddq_u32(w[i & 3], vld1q_u32(&sha256_k[4 * i]));
+            if (i < 12)
+            {
+                w[i & 3] = vsha256su1q_u32(vsha256su0q_u32(w[i & 3], w[(i + 1) & 3]), w[(i + 2) & 3], w[(i + 3) & 3]);
+            }
+
+            const uint32x4_t abcd = state0;
+            state0 = vsha256hq_u32(state0, state1, msg);
+            state1 = vsha256h2q_u32(state1, abcd, msg);
+        }
+
+        state0 = vaddq_u32(state0, abcd_save);
+        state1 = vaddq_u32(state1, efgh_save);
+        blocks += CVC_SHA256_BLOCK_SIZE;
+    }
+
+    vst1q_u32(&state[0], state0);
+    vst1q_u32(&state[4], state1);
+}
+
+static int cpu_has_armv8_sha2(void)
+{
+#if defined(__APPLE__)
+    return 1; // Every Apple arm64 core implements the SHA-2 instructions
+#elif defined(__linux__) || defined(__ANDROID__)
+    return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#elif defined(_WIN32)
+    return IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE) != 0;
+#else
+    return 0;
+#endif
+}
+#endif
+
+// ============================================================================
+// Multi-buffer kernels: one independent block per lane, lanes in lockstep
+// ============================================================================
+
+#ifdef CVC_SHA256_X86
+static uint32_t load_be32_lane(const unsigned char* p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return __builtin_bswap32(v);
+}
+
+#define MB_ROTR256(x, n) _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+
+__attribute__((target("avx2"))) static void sha256_compress_lanes_avx2(uint32_t* const* states, const unsigned char* const* blocks)
+{
+    __m256i w[64];
+    for (int t = 0; t < 16; t++)
+    {
+        w[t] = _mm256_setr_epi32((int)load_be32_lane(blocks[0] + 4 * t), (int)load_be32_lane(blocks[1] + 4 * t), (int)load_be32_lane(blocks[2] + 4 * t), (int)load_be32_lane(blocks[3] + 4 * t), (int)load_be32_lane(blocks[4] + 4 * t),
+            (int)load_be32_lane(blocks[5] + 4 * t), (int)load_be32_lane(blocks[6] + 4 * t), (int)load_be32_lane(blocks[7] + 4 * t));
+    }
+    for (int t = 16; t < 64; t++)
+    {
+        const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(MB_ROTR256(w[t - 15], 7), MB_ROTR256(w[t - 15], 18)), _mm256_srli_epi32(w[t - 15], 3));
+        const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(MB_ROTR256(w[t - 2], 17), MB_ROTR256(w[t - 2], 19)), _mm256_srli_epi32(w[t - 2], 10));
+        w[t] = _mm256_add_epi32(_mm256_add_epi32(w[t - 16], s0), _mm256_add_epi32(w[t - 7], s1));
+    }
+
+    // Transpose the lane states into one register per state word
+    __m256i v[8];
+    for (int j = 0; j < 8; j++)
+    {
+        v[j] = _mm256_setr_epi32((int)states[0][j], (int)states[1][j], (int)states[2][j], (int)states[3][j], (int)states[4][j], (int)states[5][j], (int)states[6][j], (int)states[7][j]);
+    }
+
+    __m256i a = v[0], b = v[1], c = v[2], d = v[3], e = v[4], f = v[5], g = v[6], h = v[7];
+    for (int t = 0; t < 64; t++)
+    {
+        const __m256i sigma1 = _mm256_xor_si256(_mm256_xor_si256(MB_ROTR256(e, 6), MB_ROTR256(e, 11)), MB_ROTR256(e, 25));
+        const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        const __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(h, sigma1), _mm256_add_epi32(ch, w[t])), _mm256_set1_epi32((int)sha256_k[t]));
+        const __m256i sigma0 = _mm256_xor_si256(_mm256_xor_si256(MB_ROTR256(a, 2), MB_ROTR256(a, 13)), MB_ROTR256(a, 22));
+        const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(t1, _mm256_add_epi32(sigma0, maj));
+    }
+
+    v[0] = _mm256_add_epi32(v[0], a);
+    v[1] = _mm256_add_epi32(v[1], b);
+    v[2] = _mm256_add_epi32(v[2], c);
+    v[3] = _mm256_add_epi32(v[3], d);
+    v[4] = _mm256_add_epi32(v[4], e);
+    v[5] = _mm256_add_epi32(v[5], f);
+    v[6] = _mm256_add_epi32(v[6], g);
+    v[7] = _mm256_add_epi32(v[7], h);
+
+    uint32_t words[8][8];
+    for (int j = 0; j < 8; j++)
+    {
+        _mm256_storeu_si256((__m256i*)words[j], v[j]);
+    }
+    for (int lane = 0; lane < 8; lane++)
+    {
+        for (int j = 0; j < 8; j++)
+        {
+            states[lane][j] = words[j][lane];
+        }
+    }
+}
+
+__attribute__((target("avx512f"))) static void sha256_compress_lanes_avx512(uint32_t* const* states, const unsigned char* const* blocks)
+{
+    __m512i w[64];
+    uint32_t lane_words[16];
+    for (int t = 0; t < 16; t++)
+    {
+        for (int lane = 0; lane < 16; lane++)
+        {
+            lane_words[lane] = load_be32_lane(blocks[lane] + 4 * t);
+        }
+        w[t] = _mm512_loadu_si512(lane_words);
+    }
+    for (int t = 16; t < 64; t++)
+    {
+        const __m512i s0 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(w[t - 15], 7), _mm512_ror_epi32(w[t - 15], 18), _mm512_srli_epi32(w[t - 15], 3), 0x96);
+        const __m512i s1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(w[t - 2], 17), _mm512_ror_epi32(w[t - 2], 19), _mm512_srli_epi32(w[t - 2], 10), 0x96);
+        w[t] = _mm512_add_epi32(_mm512_add_epi32(w[t - 16], s0), _mm512_add_epi32(w[t - 7], s1));
+    }
+
+    __m512i v[8];
+    for (int j = 0; j < 8; j++)
+    {
+        for (int lane = 0; lane < 16; lane++)
+        {
+            lane_words[lane] = states[lane][j];
+        }
+        v[j] = _mm512_loadu_si512(lane_words);
+    }
+
+    __m512i a = v[0], b = v[1], c = v[2], d = v[3], e = v[4], f = v[5], g = v[6], h = v[7];
+    for (int t = 0; t < 64; t++)
+    {
+        // 0x96 = x ^ y ^ z, 0xCA = (x & y) | (~x & z), 0xE8 = majority(x, y, z)
+        const __m512i sigma1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(e, 6), _mm512_ror_epi32(e, 11), _mm512_ror_epi32(e, 25), 0x96);
+        const __m512i ch = _mm512_ternarylogic_epi32(e, f, g, 0xCA);
+        const __m512i t1 = _mm512_add_epi32(_mm512_add_epi32(_mm512_add_epi32(h, sigma1), _mm512_add_epi32(ch, w[t])), _mm512_set1_epi32((int)sha256_k[t]));
+        const __m512i sigma0 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(a, 2), _mm512_ror_epi32(a, 13), _mm512_ror_epi32(a, 22), 0x96);
+        const __m512i maj = _mm512_ternarylogic_epi32(a, b, c, 0xE8);
+        h = g;
+        g = f;
+        f = e;
+        e = _mm512_add_epi32(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm512_add_epi32(t1, _mm512_add_epi32(sigma0, maj));
+    }
+
+    v[0] = _mm512_add_epi32(v[0], a);
+    v[1] = _mm512_add_epi32(v[1], b);
+    v[2] = _mm512_add_epi32(v[2], c);
+    v[3] = _mm512_add_epi32(v[3], d);
+    v[4] = _mm512_add_epi32(v[4], e);
+    v[5] = _mm512_add_epi32(v[5], f);
+    v[6] = _mm512_add_epi32(v[6], g);
+    v[7] = _mm512_add_epi32(v[7], h);
+
+    for (int j = 0; j < 8; j++)
+    {
+        _mm512_storeu_si512(lane_words, v[j]);
+        for (int lane = 0; lane < 16; lane++)
+        {
+            states[lane][j] = lane_words[lane];
+        }
+    }
+}
+
+// XCR0 bits the OS must have enabled before AVX state may be used
+static uint64_t read_xcr0(void)
+{
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((uint64_t)edx << 32) | eax;
+}
+
+// Returns the widest usable multi-buffer lane count: 16 (AVX-512F), 8 (AVX2) or 0
+static int cpu_multibuffer_lanes(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !((ecx >> 27) & 1) || !((ecx >> 28) & 1))
+    {
+        return 0; // No OSXSAVE or no AVX
+    }
+    const uint64_t xcr0 = read_xcr0();
+    if ((xcr0 & 0x6) != 0x6 || !__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+    {
+        return 0;
+    }
+    if (((ebx >> 16) & 1) && (xcr0 & 0xE6) == 0xE6)
+    {
+        return 16;
+    }
+    return ((ebx >> 5) & 1) ? 8 : 0;
+}
+#endif
+
+// ============================================================================
+// Runtime dispatch
+// ============================================================================
+
+typedef void (*sha256_compress_fn)(uint32_t state[8], const unsigned char* blocks, size_t block_count);
+
+static sha256_compress_fn sha256_kernel = sha256_compress_portable;
+static const char* sha256_kernel_name = "portable";
+static int sha256_lane_width = 0; // 0 = no multi-buffer kernel, lanes use sha256_kernel
+static pthread_once_t sha256_dispatch_once = PTHREAD_ONCE_INIT;
+
+static void select_sha256_kernel(void)
+{
+#ifdef CVC_SHA256_X86
+    if (cpu_has_shani())
+    {
+        sha256_kernel = sha256_compress_shani;
+        sha256_kernel_name = "sha-ni";
+    }
+    sha256_lane_width = cpu_multibuffer_lanes();
+
+    // One SHA-NI block per lane keeps up with the 8-way AVX2 kernel; only AVX-512 beats it
+    if (sha256_lane_width == 8 && sha256_kernel == sha256_compress_shani)
+    {
+        sha256_lane_width = 0;
+    }
+
+#ifdef CVC_LOW_STACK
+    // The 16-way kernel keeps a 4 KB message schedule on the stack
+    if (sha256_lane_width > CVC_BATCH_LANES)
+    {
+        sha256_lane_width = sha256_kernel == sha256_compress_shani ? 0 : CVC_BATCH_LANES;
+    }
+#endif
+#endif
+#ifdef CVC_SHA256_ARMV8
+    if (cpu_has_armv8_sha2())
+    {
+        sha256_kernel = sha256_compress_armv8;
+        sha256_kernel_name = "armv8-crypto";
+    }
+#endif
+}
+
+void cvc_sha256_compress(uint32_t state[8], const unsigned char* blocks, size_t block_count)
+{
+    pthread_once(&sha256_dispatch_once, select_sha256_kernel);
+    sha256_kernel(state, blocks, block_count);
+}
+
+const char* cvc_sha256_implementation(void)
+{
+    pthread_once(&sha256_dispatch_once, select_sha256_kernel);
+    return sha256_kernel_name;
+}
+
+// ============================================================================
+// Multi-buffer dispatch
+// ============================================================================
+
+static const unsigned char sha256_zero_block[CVC_SHA256_BLOCK_SIZE] = { 0 };
+
+// Run one full group of sha256_lane_width lanes, padding short groups with dummy lanes
+static void compress_lane_group(uint32_t* const* states, const unsigned char* const* blocks, int lanes)
+{
+#ifdef CVC_SHA256_X86
+    uint32_t* group_states[CVC_SHA256_MAX_LANES];
+    const unsigned char* group_blocks[CVC_SHA256_MAX_LANES];
+    uint32_t dummy_states[CVC_SHA256_MAX_LANES][8] = { { 0 } }; // Dummy lanes compress defined input; their output is discarded
+
+    for (int lane = 0; lane < sha256_lane_width; lane++)
+    {
+        group_states[lane] = lane < lanes ? states[lane] : dummy_states[lane];
+        group_blocks[lane] = lane < lanes ? blocks[lane] : sha256_zero_block;
+    }
+
+    if (sha256_lane_width == 16)
+    {
+        sha256_compress_lanes_avx512(group_states, group_blocks);
+    }
+    else
+    {
+        sha256_compress_lanes_avx2(group_states, group_blocks);
+    }
+#else
+    (void)states;
+    (void)blocks;
+    (void)lanes;
+#endif
+}
+
+void cvc_sha256_compress_lanes(uint32_t* const* states, const unsigned char* const* blocks, int lanes)
+{
+    pthread_once(&sha256_dispatch_once, select_sha256_kernel);
+
+    int done = 0;
+    if (sha256_lane_width > 0)
+    {
+        // A padded group is only worth it while at least half of its lanes carry data
+        while (lanes - done >= sha256_lane_width / 2)
+        {
+            const int group = lanes - done < sha256_lane_width ? lanes - done : sha256_lane_width;
+            compress_lane_group(states + done, blocks + done, group);
+            done += group;
+        }
+    }
+
+    for (; done < lanes; done++)
+    {
+        sha256_kernel(states[done], blocks[done], 1);
+    }
+}
+
+const char* cvc_sha256_lanes_implementation(void)
+{
+    pthread_once(&sha256_dispatch_once, select_sha256_kernel);
+    return sha256_lane_width == 16 ? "avx512-16way" : sha256_lane_width == 8 ? "avx2-8way" : sha256_kernel_name;
+}
+
+// ============================================================================
+// Incremental interface
+// ============================================================================
+
+void cvc_sha256_init(cvc_sha256_ctx* ctx)
+{
+    memcpy(ctx->state, sha256_iv, sizeof(sha256_iv));
+    ctx->length = 0;
+    ctx->buffer_len = 0;
+}
+
+void cvc_sha256_update(cvc_sha256_ctx* ctx, const unsigned char* data, size_t len)
+{
+    ctx->length += len;
+
+    if (ctx->buffer_len > 0)
+    {
+        const size_t take = len < CVC_SHA256_BLOCK_SIZE - ctx->buffer_len ? len : CVC_SHA256_BLOCK_SIZE - ctx->buffer_len;
+        memcpy(ctx->buffer + ctx->buffer_len, data, take);
+        ctx->buffer_len += take;
+        data += take;
+        len -= take;
+        if (ctx->buffer_len < CVC_SHA256_BLOCK_SIZE)
+        {
+            return;
+        }
+        cvc_sha256_compress(ctx->state, ctx->buffer, 1);
+        ctx->buffer_len = 0;
+    }
+
+    // Whole blocks go straight from the caller's buffer to the kernel
+    const size_t whole_blocks = len / CVC_SHA256_BLOCK_SIZE;
+    if (whole_blocks > 0)
+    {
+        cvc_sha256_compress(ctx->state, data, whole_blocks);
+        data += whole_blocks * CVC_SHA256_BLOCK_SIZE;
+        len -= whole_blocks * CVC_SHA256_BLOCK_SIZE;
+    }
+
+    if (len > 0)
+    {
+        memcpy(ctx->buffer, data, len);
+        ctx->buffer_len = len;
+    }
+}
+
+void cvc_sha256_final(cvc_sha256_ctx* ctx, unsigned char digest[CVC_SHA256_DIGEST_SIZE])
+{
+    const uint64_t bit_length = ctx->length * 8;
+
+    // Padding: 0x80, zeros, 64-bit big-endian bit length; one or two blocks
+    unsigned char tail[2 * CVC_SHA256_BLOCK_SIZE];
+    memset(tail, 0, sizeof(tail));
+    memcpy(tail, ctx->buffer, ctx->buffer_len);
+    tail[ctx->buffer_len] = 0x80;
+
+    const size_t tail_len = ctx->buffer_len < CVC_SHA256_BLOCK_SIZE - 8 ? CVC_SHA256_BLOCK_SIZE : 2 * CVC_SHA256_BLOCK_SIZE;
+    for (int i = 0; i < 8; i++)
+    {
+        tail[tail_len - 1 - i] = (unsigned char)(bit_length >> (8 * i));
+    }
+    cvc_sha256_compress(ctx->state, tail, tail_len / CVC_SHA256_BLOCK_SIZE);
+
+    for (int i = 0; i < 8; i++)
+    {
+        store_be32(digest + 4 * i, ctx->state[i]);
+    }
+
+    cvc_secure_zero(tail, sizeof(tail));
+    cvc_secure_zero(ctx, sizeof(cvc_sha256_ctx));
+}
+
+void cvc_sha256(const unsigned char* data, size_t len, unsigned char digest[CVC_SHA256_DIGEST_SIZE])
+{
+    cvc_sha256_ctx ctx;
+    cvc_sha256_init(&ctx);
+    cvc_sha256_update(&ctx, data, len);
+    cvc_sha256_final(&ctx, digest);
+}
+
+// ============================================================================
+// expand_message_xmd
+// ============================================================================
+
+// SHA-256 state after absorbing the 64-byte all-zero Z_pad block
+static cvc_sha256_ctx xmd_zpad_midstate;
+static pthread_once_t xmd_zpad_once = PTHREAD_ONCE_INIT;
+
+static void init_xmd_zpad_midstate(void)
+{
+    const unsigned char z_pad[CVC_SHA256_BLOCK_SIZE] = { 0 };
+    cvc_sha256_init(&xmd_zpad_midstate);
+    cvc_sha256_update(&xmd_zpad_midstate, z_pad, sizeof(z_pad));
+}
+
+int cvc_xmd_sha256_init(cvc_xmd_sha256_ctx* ctx, const unsigned char* dst, int dst_len, const unsigned char* prefix, int prefix_len, const unsigned char* message, int message_len, int output_len)
+{
+    // Basic parameter validation
+    if (!ctx || !dst || dst_len <= 0 || dst_len > 255 || (!prefix && prefix_len != 0) || prefix_len < 0 || (!message && message_len != 0) || message_len < 0 || output_len <= 0)
+    {
+        return CVC_SHA256_ERROR_INVALID_PARAMS;
+    }
+
+    if ((output_len + CVC_SHA256_DIGEST_SIZE - 1) / CVC_SHA256_DIGEST_SIZE > 255)
+    {
+        return CVC_SHA256_ERROR_OUTPUT_TOO_LARGE;
+    }
+
+    pthread_once(&xmd_zpad_once, init_xmd_zpad_midstate);
+
+    // DST_prime = DST || I2OSP(len(DST), 1)
+    const unsigned char dst_suffix = (unsigned char)dst_len;
+
+    // b_0 = H(Z_pad || msg || I2OSP(len_in_bytes, 2) || I2OSP(0, 1) || DST_prime)
+    const unsigned char length_block[3] = { (unsigned char)(output_len >> 8), (unsigned char)output_len, 0 };
+    cvc_sha256_ctx sha = xmd_zpad_midstate;
+    if (prefix_len > 0)
+    {
+        cvc_sha256_update(&sha, prefix, (size_t)prefix_len);
+    }
+    if (message_len > 0)
+    {
+        cvc_sha256_update(&sha, message, (size_t)message_len);
+    }
+    cvc_sha256_update(&sha, length_block, sizeof(length_block));
+    cvc_sha256_update(&sha, dst, (size_t)dst_len);
+    cvc_sha256_update(&sha, &dst_suffix, 1);
+    cvc_sha256_final(&sha, ctx->b0);
+
+    memset(ctx->b_current, 0, sizeof(ctx->b_current));
+    ctx->dst = dst;
+    ctx->dst_len = dst_len;
+    ctx->index = 0;
+    ctx->used = CVC_SHA256_DIGEST_SIZE;
+    ctx->remaining = output_len;
+
+    return CVC_SHA256_SUCCESS;
+}
+
+int cvc_xmd_sha256_read(cvc_xmd_sha256_ctx* ctx, unsigned char* output, int len)
+{
+    if (!ctx || (!output && len != 0) || len < 0 || len > ctx->remaining)
+    {
+        return CVC_SHA256_ERROR_INVALID_PARAMS;
+    }
+
+    const unsigned char dst_suffix = (unsigned char)ctx->dst_len;
+    ctx->remaining -= len;
+
+    while (len > 0)
+    {
+        if (ctx->used == CVC_SHA256_DIGEST_SIZE)
+        {
+            // b_i = H(strxor(b_0, b_(i-1)) || I2OSP(i, 1) || DST_prime), with b_1 = H(b_0 || 1 || DST_prime)
+            unsigned char chained[CVC_SHA256_DIGEST_SIZE + 1];
+            for (int j = 0; j < CVC_SHA256_DIGEST_SIZE; j++)
+            {
+                chained[j] = ctx->b0[j] ^ ctx->b_current[j];
+            }
+            chained[CVC_SHA256_DIGEST_SIZE] = (unsigned char)++ctx->index;
+
+            cvc_sha256_ctx sha;
+            cvc_sha256_init(&sha);
+            cvc_sha256_update(&sha, chained, sizeof(chained));
+            cvc_sha256_update(&sha, ctx->dst, (size_t)ctx->dst_len);
+            cvc_sha256_update(&sha, &dst_suffix, 1);
+            cvc_sha256_final(&sha, ctx->b_current);
+            ctx->used = 0;
+        }
+
+        const int take = len < CVC_SHA256_DIGEST_SIZE - ctx->used ? len : CVC_SHA256_DIGEST_SIZE - ctx->used;
+        memcpy(output, ctx->b_current + ctx->used, take);
+        ctx->used += take;
+        output += take;
+        len -= take;
+    }
+
+    return CVC_SHA256_SUCCESS;
+}
+
+void cvc_xmd_sha256_clear(cvc_xmd_sha256_ctx* ctx)
+{
+    if (ctx)
+    {
+        cvc_secure_zero(ctx, sizeof(cvc_xmd_sha256_ctx));
+    }
+}
+
+int cvc_expand_message_xmd_sha256(const unsigned char* dst, int dst_len, const unsigned char* message, int message_len, unsigned char* output, int output_len)
+{
+    // Basic parameter validation
+    if (!output)
+    {
+        return CVC_SHA256_ERROR_INVALID_PARAMS;
+    }
+
+    cvc_xmd_sha256_ctx ctx;
+    const int result = cvc_xmd_sha256_init(&ctx, dst, dst_len, NULL, 0, message, message_len, output_len);
+    if (result != CVC_SHA256_SUCCESS)
+    {
+        return result;
+    }
+
+    cvc_xmd_sha256_read(&ctx, output, output_len);
+    cvc_xmd_sha256_clear(&ctx);
+
+    return CVC_SHA256_SUCCESS;
+}
+
+// ============================================================================
+// Batched expand_message_xmd
+// ============================================================================
+
+// Longest per-lane tail: 63 leftover message bytes + 33 + 255 + 1 suffix bytes + 9 padding bytes
+#define SHA256_LANE_TAIL_BLOCKS 6
+
+// One message hashed in lockstep with others
+typedef struct
+{
+    uint32_t state[8];
+    const unsigned char* head; // Whole blocks read in place from the caller's buffer
+    size_t head_blocks;
+    unsigned char tail[SHA256_LANE_TAIL_BLOCKS * CVC_SHA256_BLOCK_SIZE]; // Remainder, suffix and padding
+    size_t tail_blocks;
+    size_t position; // Next block to compress
+} sha256_lane_job_t;
+
+// Prepare H(prefix || head || suffix) where prefix_len bytes are already absorbed into start_state
+static void lane_job_init(sha256_lane_job_t* job, const uint32_t start_state[8], size_t prefix_len, const unsigned char* head, size_t head_len, const unsigned char* suffix, size_t suffix_len)
+{
+    memcpy(job->state, start_state, sizeof(job->state));
+    job->head = head;
+    job->head_blocks = head_len / CVC_SHA256_BLOCK_SIZE;
+    job->position = 0;
+
+    const size_t remainder = head_len % CVC_SHA256_BLOCK_SIZE;
+    const size_t tail_len = remainder + suffix_len;
+    const size_t padded_len = (tail_len + 9 + CVC_SHA256_BLOCK_SIZE - 1) / CVC_SHA256_BLOCK_SIZE * CVC_SHA256_BLOCK_SIZE;
+    const uint64_t bit_length = (uint64_t)(prefix_len + head_len + suffix_len) * 8;
+
+    memset(job->tail, 0, padded_len);
+    if (remainder > 0)
+    {
+        memcpy(job->tail, head + job->head_blocks * CVC_SHA256_BLOCK_SIZE, remainder);
+    }
+    memcpy(job->tail + remainder, suffix, suffix_len);
+    job->tail[tail_len] = 0x80;
+    for (int i = 0; i < 8; i++)
+    {
+        job->tail[padded_len - 1 - i] = (unsigned char)(bit_length >> (8 * i));
+    }
+    job->tail_blocks = padded_len / CVC_SHA256_BLOCK_SIZE;
+}
+
+// Compress all jobs to completion, one block per job per lockstep pass
+static void run_lane_jobs(sha256_lane_job_t* jobs, int count)
+{
+    uint32_t* states[CVC_SHA256_MAX_LANES];
+    const unsigned char* blocks[CVC_SHA256_MAX_LANES];
+
+    for (;;)
+    {
+        int active = 0;
+        for (int i = 0; i < count; i++)
+        {
+            sha256_lane_job_t* job = &jobs[i];
+            if (job->position >= job->head_blocks + job->tail_blocks)
+            {
+                continue;
+            }
+            states[active] = job->state;
+            blocks[active] = job->position < job->head_blocks ? job->head + job->position * CVC_SHA256_BLOCK_SIZE : job->tail + (job->position - job->head_blocks) * CVC_SHA256_BLOCK_SIZE;
+            job->position++;
+            active++;
+        }
+
+        if (active == 0)
+        {
+            return;
+        }
+        cvc_sha256_compress_lanes(states, blocks, active);
+    }
+}
+
+static void lane_job_digest(const sha256_lane_job_t* job, unsigned char digest[CVC_SHA256_DIGEST_SIZE])
+{
+    for (int i = 0; i < 8; i++)
+    {
+        store_be32(digest + 4 * i, job->state[i]);
+    }
+}
+
+int cvc_expand_message_xmd_sha256_batch(const unsigned char* dst, int dst_len, const unsigned char* const* messages, const int* message_lens, int count, unsigned char* outputs, int output_len)
+{
+    // Basic parameter validation
+    if (!dst || dst_len <= 0 || dst_len > 255 || !messages || !message_lens || count <= 0 || !outputs || output_len <= 0)
+    {
+        return CVC_SHA256_ERROR_INVALID_PARAMS;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (message_lens[i] < 0 || (!messages[i] && message_lens[i] != 0))
+        {
+            return CVC_SHA256_ERROR_INVALID_PARAMS;
+        }
+    }
+
+    const int ell = (output_len + CVC_SHA256_DIGEST_SIZE - 1) / CVC_SHA256_DIGEST_SIZE;
+    if (ell > 255)
+    {
+        return CVC_SHA256_ERROR_OUTPUT_TOO_LARGE;
+    }
+
+    pthread_once(&xmd_zpad_once, init_xmd_zpad_midstate);
+
+    // Suffix of b_0: I2OSP(len_in_bytes, 2) || I2OSP(0, 1) || DST || I2OSP(len(DST), 1)
+    unsigned char b0_suffix[3 + 255 + 1];
+    b0_suffix[0] = (unsigned char)(output_len >> 8);
+    b0_suffix[1] = (unsigned char)output_len;
+    b0_suffix[2] = 0;
+    memcpy(b0_suffix + 3, dst, dst_len);
+    b0_suffix[3 + dst_len] = (unsigned char)dst_len;
+
+    // Suffix of b_i: strxor(b_0, b_(i-1)) || I2OSP(i, 1) || DST || I2OSP(len(DST), 1)
+    unsigned char bi_suffix[CVC_SHA256_DIGEST_SIZE + 1 + 255 + 1];
+    memcpy(bi_suffix + CVC_SHA256_DIGEST_SIZE + 1, dst, dst_len);
+    bi_suffix[CVC_SHA256_DIGEST_SIZE + 1 + dst_len] = (unsigned char)dst_len;
+    const size_t bi_suffix_len = CVC_SHA256_DIGEST_SIZE + 1 + dst_len + 1;
+
+    sha256_lane_job_t jobs[CVC_BATCH_LANES];
+    unsigned char b0[CVC_BATCH_LANES][CVC_SHA256_DIGEST_SIZE];
+    unsigned char b_prev[CVC_BATCH_LANES][CVC_SHA256_DIGEST_SIZE];
+
+    for (int start = 0; start < count; start += CVC_BATCH_LANES)
+    {
+        const int lanes = count - start < CVC_BATCH_LANES ? count - start : CVC_BATCH_LANES;
+
+        for (int k = 0; k < lanes; k++)
+        {
+            lane_job_init(&jobs[k], xmd_zpad_midstate.state, CVC_SHA256_BLOCK_SIZE, messages[start + k], (size_t)message_lens[start + k], b0_suffix, 3 + dst_len + 1);
+        }
+        run_lane_jobs(jobs, lanes);
+        for (int k = 0; k < lanes; k++)
+        {
+            lane_job_digest(&jobs[k], b0[k]);
+        }
+        memset(b_prev, 0, sizeof(b_prev));
+
+        int offset = 0;
+        for (int i = 1; i <= ell; i++)
+        {
+            for (int k = 0; k < lanes; k++)
+            {
+                for (int j = 0; j < CVC_SHA256_DIGEST_SIZE; j++)
+                {
+                    bi_suffix[j] = b0[k][j] ^ b_prev[k][j];
+                }
+                bi_suffix[CVC_SHA256_DIGEST_SIZE] = (unsigned char)i;
+                lane_job_init(&jobs[k], sha256_iv, 0, NULL, 0, bi_suffix, bi_suffix_len);
+            }
+            run_lane_jobs(jobs, lanes);
+
+            const int take = output_len - offset < CVC_SHA256_DIGEST_SIZE ? output_len - offset : CVC_SHA256_DIGEST_SIZE;
+            for (int k = 0; k < lanes; k++)
+            {
+                lane_job_digest(&jobs[k], b_prev[k]);
+                memcpy(outputs + (size_t)(start + k) * output_len + offset, b_prev[k], take);
+            }
+            offset += take;
+        }
+    }
+
+    cvc_secure_zero(jobs, sizeof(jobs));
+    cvc_secure_zero(b0, sizeof(b0));
+    cvc_secure_zero(b_prev, sizeof(b_prev));
+    cvc_secure_zero(bi_suffix, sizeof(bi_suffix));
+
+    return CVC_SHA256_SUCCESS;
+}
+
+int cvc_sha256_batch(const unsigned char* const* messages, const int* message_lens, int count, unsigned char* digests)
+{
+    // Basic parameter validation
+    if (!messages || !message_lens || count <= 0 || !digests)
+    {
+        return CVC_SHA256_ERROR_INVALID_PARAMS;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (message_lens[i] < 0 || (!messages[i] && message_lens[i] != 0))
+        {
+            return CVC_SHA256_ERROR_INVALID_PARAMS;
+        }
+    }
+
+    static const unsigned char no_suffix[1] = { 0 };
+    sha256_lane_job_t jobs[CVC_BATCH_LANES];
+    for (int start = 0; start < count; start += CVC_BATCH_LANES)
+    {
+        const int lanes = count - start < CVC_BATCH_LANES ? count - start : CVC_BATCH_LANES;
+
+        for (int k = 0; k < lanes; k++)
+        {
+            lane_job_init(&jobs[k], sha256_iv, 0, messages[start + k], (size_t)message_lens[start + k], no_suffix, 0);
+        }
+        run_lane_jobs(jobs, lanes);
+        for (int k = 0; k < lanes; k++)
+        {
+            lane_job_digest(&jobs[k], digests + (size_t)(start + k) * CVC_SHA256_DIGEST_SIZE);
+        }
+    }
+
+    cvc_secure_zero(jobs, sizeof(jobs));
+
+    return CVC_SHA256_SUCCESS;
+}
@@ -0,0 +1,229 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CVC_SHA256_DIGEST_SIZE 32
+#define CVC_SHA256_BLOCK_SIZE 64
+#define CVC_SHA256_MAX_LANES 16 // Widest multi-buffer kernel (AVX-512)
+
+/**
+ * @brief Result codes for SHA-256 based expansion
+ */
+typedef enum
+{
+    CVC_SHA256_SUCCESS = 0,                /**< Operation completed successfully */
+    CVC_SHA256_ERROR_INVALID_PARAMS = -1,  /**< Invalid input parameters */
+    CVC_SHA256_ERROR_OUTPUT_TOO_LARGE = -2 /**< Requested output exceeds 255 * 32 bytes */
+} cvc_sha256_result_t;
+
+/**
+ * @brief Incremental SHA-256 state
+ *
+ * The struct is plain data, so a context can be copied to snapshot a midstate
+ * (e.g. after an HMAC pad block) and resumed any number of times.
+ */
+typedef struct
+{
+    uint32_t state[8];
+    uint64_t length;                             // Total bytes absorbed
+    unsigned char buffer[CVC_SHA256_BLOCK_SIZE]; // Partial block
+    size_t buffer_len;
+} cvc_sha256_ctx;
+
+/**
+ * @brief Run the SHA-256 compression function over whole 64-byte blocks
+ *
+ * Dispatches once per process to the fastest kernel the CPU supports: x86 SHA-NI,
+ * ARMv8 SHA-2 crypto extensions, or a portable C implementation.
+ *
+ * @param state Chaining state (8 words)
+ * @param blocks Input blocks
+ * @param block_count Number of 64-byte blocks
+ */
+void cvc_sha256_compress(uint32_t state[8], const unsigned char* blocks, size_t block_count);
+
+/**
+ * @brief Name of the compression kernel selected for this CPU
+ *
+ * @return "sha-ni", "armv8-crypto" or "portable"
+ */
+const char* cvc_sha256_implementation(void);
+
+/**
+ * @brief Compress one block into each of several independent states
+ *
+ * Lanes are packed into the widest multi-buffer kernel available (16 lanes on
+ * AVX-512F, 8 on AVX2), one message word per SIMD lane. Groups that would be less
+ * than half full, and CPUs without a multi-buffer kernel, fall back to the
+ * single-stream kernel per lane. States must not alias each other.
+ *
+ * @param states Chaining state per lane
+ * @param blocks One 64-byte block per lane
+ * @param lanes Number of lanes (any count)
+ */
+void cvc_sha256_compress_lanes(uint32_t* const* states, const unsigned char* const* blocks, int lanes);
+
+/**
+ * @brief Name of the multi-buffer kernel selected for this CPU
+ *
+ * @return "avx512-16way", "avx2-8way", or the single-stream kernel name
+ */
+const char* cvc_sha256_lanes_implementation(void);
+
+/**
+ * @brief Start an incremental SHA-256 computation
+ *
+ * The context is a plain value owned by the caller (usually on the stack) and
+ * holds no other resources. A context that has absorbed a common prefix may be
+ * copied with memcpy and each copy continued independently.
+ *
+ * @param ctx Context to initialize
+ */
+void cvc_sha256_init(cvc_sha256_ctx* ctx);
+
+/**
+ * @brief Absorb more message bytes
+ *
+ * May be called any number of times between cvc_sha256_init and cvc_sha256_final;
+ * whole blocks go straight to the compression kernel and at most 63 bytes are
+ * buffered in the context.
+ *
+ * @param ctx Context initialized with cvc_sha256_init
+ * @param data Message bytes
+ * @param len Number of bytes
+ */
+void cvc_sha256_update(cvc_sha256_ctx* ctx, const unsigned char* data, size_t len);
+
+/**
+ * @brief Finish the computation and write the digest
+ *
+ * Call exactly once per computation. The context is wiped afterwards and must be
+ * initialized again with cvc_sha256_init before it is reused.
+ *
+ * @param ctx Context initialized with cvc_sha256_init
+ * @param digest Output buffer receiving the 32-byte digest
+ */
+void cvc_sha256_final(cvc_sha256_ctx* ctx, unsigned char digest[CVC_SHA256_DIGEST_SIZE]);
+
+/**
+ * @brief One-shot SHA-256
+ */
+void cvc_sha256(const unsigned char* data, size_t len, unsigned char digest[CVC_SHA256_DIGEST_SIZE]);
+
+/**
+ * @brief expand_message_xmd with SHA-256 (RFC 9380, Section 5.3.1)
+ *
+ * Produces the same output as MIRACL's XMD_Expand(MC_SHA2, SHA256, ...) but runs on
+ * the accelerated compression function. The all-zero Z_pad block is absorbed once
+ * per process and reused as a midstate.
+ *
+ * @param dst Domain Separation Tag (1..255 bytes)
+ * @param dst_len Length of DST
+ * @param message Input message (may be NULL if message_len is 0)
+ * @param message_len Length of message
+ * @param output Output buffer
+ * @param output_len Number of bytes to produce (1..8160)
+ * @return CVC_SHA256_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_expand_message_xmd_sha256(const unsigned char* dst, int dst_len, const unsigned char* message, int message_len, unsigned char* output, int output_len);
+
+/**
+ * @brief Incremental expand_message_xmd(SHA-256) output
+ *
+ * Yields the bytes of cvc_expand_message_xmd_sha256 on demand, computing one b_i
+ * at a time, so a caller can consume a long expansion through a small buffer.
+ */
+typedef struct
+{
+    unsigned char b0[CVC_SHA256_DIGEST_SIZE];
+    unsigned char b_current[CVC_SHA256_DIGEST_SIZE]; // Latest b_i
+    const unsigned char* dst;                        // Borrowed; must outlive the context
+    int dst_len;
+    int index;     // i of b_current (0 before the first read)
+    int used;      // Bytes of b_current already returned
+    int remaining; // Bytes left of len_in_bytes
+} cvc_xmd_sha256_ctx;
+
+/**
+ * @brief Start an expand_message_xmd(SHA-256) of prefix || message
+ *
+ * The two message parts are absorbed as if concatenated, so callers that derive
+ * from key || context never need to build the joined input. Only b_0 is computed
+ * here; output comes from cvc_xmd_sha256_read.
+ *
+ * @param ctx Context to initialize
+ * @param dst Domain Separation Tag (1..255 bytes), referenced until the last read
+ * @param dst_len Length of DST
+ * @param prefix First message part (may be NULL if prefix_len is 0)
+ * @param prefix_len Length of prefix
+ * @param message Second message part (may be NULL if message_len is 0)
+ * @param message_len Length of message
+ * @param output_len Total number of bytes that will be read (1..8160)
+ * @return CVC_SHA256_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_xmd_sha256_init(cvc_xmd_sha256_ctx* ctx, const unsigned char* dst, int dst_len, const unsigned char* prefix, int prefix_len, const unsigned char* message, int message_len, int output_len);
+
+/**
+ * @brief Read the next len bytes of the expansion
+ *
+ * @param ctx Context from cvc_xmd_sha256_init
+ * @param output Output buffer
+ * @param len Number of bytes to read (at most the bytes still remaining)
+ * @return CVC_SHA256_SUCCESS on success, or CVC_SHA256_ERROR_INVALID_PARAMS if len exceeds what is left
+ */
+int cvc_xmd_sha256_read(cvc_xmd_sha256_ctx* ctx, unsigned char* output, int len);
+
+/**
+ * @brief Zeroize a context once the expansion is no longer needed
+ */
+void cvc_xmd_sha256_clear(cvc_xmd_sha256_ctx* ctx);
+
+/**
+ * @brief expand_message_xmd with SHA-256 for many messages in lockstep
+ *
+ * Every message goes through the same b_0, b_1, ... b_ell schedule, so groups of
+ * up to CVC_SHA256_MAX_LANES messages are hashed side by side through
+ * cvc_sha256_compress_lanes. Whole message blocks are read in place; only the
+ * trailing bytes are copied. Output i is identical to
+ * cvc_expand_message_xmd_sha256 on message i.
+ *
+ * @param dst Domain Separation Tag shared by all messages (1..255 bytes)
+ * @param dst_len Length of DST
+ * @param messages Input messages (an entry may be NULL if its length is 0)
+ * @param message_lens Length of each message
+ * @param count Number of messages
+ * @param outputs Output buffer of count * output_len bytes; message i writes at i * output_len
+ * @param output_len Number of bytes to produce per message (1..8160)
+ * @return CVC_SHA256_SUCCESS on success, or a negative error code on failure
+ */
+int cvc_expand_message_xmd_sha256_batch(const unsigned char* dst, int dst_len, const unsigned char* const* messages, const int* message_lens, int count, unsigned char* outputs, int output_len);
+
+/**
+ * @brief SHA-256 of many independent messages in lockstep
+ *
+ * Messages are hashed side by side through cvc_sha256_compress_lanes, groups of
+ * CVC_BATCH_LANES at a time; messages of different lengths simply drop out of the
+ * lockstep as they finish. Digest i is identical to cvc_sha256 on message i.
+ *
+ * @param messages Input messages (an entry may be NULL if its length is 0)
+ * @param message_lens Length of each message
+ * @param count Number of messages
+ * @param digests Output buffer of count * 32 bytes
+ * @return CVC_SHA256_SUCCESS on success, or CVC_SHA256_ERROR_INVALID_PARAMS
+ */
+int cvc_sha256_batch(const unsigned char* const* messages, const int* message_lens, int count, unsigned char* digests);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SHA256_H
@@ -0,0 +1,9 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include "stack_budget.h"
+
+size_t cvc_stack_budget(void)
+{
+    return CVC_STACK_BUDGET;
+}
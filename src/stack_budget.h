@@ -0,0 +1,44 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#ifndef STACK_BUDGET_H
+#define STACK_BUDGET_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Stack budgets
+ *
+ * Every public function stays within CVC_STACK_BUDGET bytes of stack, MIRACL frames
+ * included. Building with CVC_LOW_STACK (CMake option of the same name) shrinks the
+ * on-stack chunks of the batch paths, at some cost in multi-buffer throughput, so
+ * the library fits the small stacks of cgo and mobile worker threads.
+ * tests/test_stack_usage.c measures each public function against the budget.
+ */
+#ifdef CVC_LOW_STACK
+#define CVC_STACK_BUDGET (16 * 1024)
+#define CVC_BATCH_LANES 8 // Messages per lockstep chunk in the batch paths
+#else
+#define CVC_STACK_BUDGET (32 * 1024)
+#define CVC_BATCH_LANES 16
+#endif
+
+/**
+ * @brief Stack budget the library was compiled with
+ *
+ * Lets code built without the library's compile definitions (tests, bindings)
+ * find out whether it is talking to a CVC_LOW_STACK build.
+ *
+ * @return CVC_STACK_BUDGET of the library build, in bytes
+ */
+size_t cvc_stack_budget(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STACK_BUDGET_H
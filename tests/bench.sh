@@ -0,0 +1,74 @@
+#!/bin/bash
+# bench.sh - Build the CVC library with optimizations and run the benchmarks
+# Usage: ./tests/bench.sh [bench_name ...]   (default: every tests/bench_*.c)
+
+set -e  # Exit on any error
+
+# Colors for output
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+BLUE='\033[0;34m'
+NC='\033[0m' # No Color
+
+print_info() {
+    echo -e "${BLUE}[INFO]${NC} $1"
+}
+
+print_success() {
+    echo -e "${GREEN}[SUCCESS]${NC} $1"
+}
+
+print_error() {
+    echo -e "${RED}[ERROR]${NC} $1"
+}
+
+# Check if we're in the right directory
+if [[ ! -f "CMakeLists.txt" ]]; then
+    print_error "CMakeLists.txt not found. Run this script from the project root directory."
+    exit 1
+fi
+
+BUILD_DIR="build_bench"
+print_info "Building CVC library (Release)..."
+cmake -S . -B "$BUILD_DIR" -DCMAKE_BUILD_TYPE=Release > /dev/null || {
+    print_error "CMake configuration failed"
+    exit 1
+}
+cmake --build "$BUILD_DIR" -j > /dev/null || {
+    print_error "Build failed"
+    exit 1
+}
+
+if [[ $# -gt 0 ]]; then
+    BENCHES=("$@")
+else
+    BENCHES=()
+    for source in tests/bench_*.c; do
+        BENCHES+=("$(basename "$source" .c | sed 's/^bench_//')")
+    done
+fi
+
+FAILED=0
+for name in "${BENCHES[@]}"; do
+    print_info "Compiling bench_${name}..."
+    clang -O2 -o "bench_${name}" "tests/bench_${name}.c" \
+        -I. \
+        -I./libs/miracl-core/c \
+        -I./libs/l8w8jwt/include \
+        -L./$BUILD_DIR \
+        -lcvc -lpthread || {
+        print_error "bench_${name} compilation failed"
+        FAILED=1
+        continue
+    }
+
+    echo
+    "./bench_${name}" || FAILED=1
+    rm -f "bench_${name}"
+done
+
+if [[ $FAILED -ne 0 ]]; then
+    print_error "Some benchmarks failed to build or run"
+    exit 1
+fi
+print_success "Benchmarks finished"
@@ -0,0 +1,86 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "src/ecdsa.h"
+#include "src/sha256.h"
+
+#define BENCH_ITERATIONS 2000
+
+// RFC 7515, Appendix A.3: ES256 key and signature over the JWS signing input
+static const char rfc7515_signing_input[] = "eyJhbGciOiJFUzI1NiJ9.eyJpc3MiOiJqb2UiLA0KICJleHAiOjEzMDA4MTkzODAsDQogImh0dHA6Ly9leGFtcGxlLmNvbS9pc19yb290Ijp0cnVlfQ";
+static const char rfc7515_public_key_hex[] = "047fcdce2770f6c45d4183cbee6fdb4b7b580733357be9ef13bacf6e3c7bd15445c7f144cd1bbd9b7e872cdfedb9eeb9f4b3695d6ea90b24ad8a4623288588e5ad";
+static const char rfc7515_signature_hex[] = "0ed1215379636c483c2f7f155807d402a3b228033af97c7e17819ac3169ea665c50a07d38c3c70e5d8f12daf084a5480a66590c5f293509a8f3f7f8a83a354d5";
+
+static double now_seconds_bench(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void hex_to_bytes_bench(const char* hex, unsigned char* bytes, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        sscanf(hex + 2 * i, "%2hhx", &bytes[i]);
+    }
+}
+
+static void report_bench(const char* label, double seconds, int operations)
+{
+    printf("   %-40s %8.2f us/op\n", label, seconds * 1e6 / operations);
+}
+
+int main()
+{
+    printf("=== ECDSA Benchmark ===\n\n");
+
+    unsigned char public_key[65], signature[64], digest[32];
+    hex_to_bytes_bench(rfc7515_public_key_hex, public_key, 65);
+    hex_to_bytes_bench(rfc7515_signature_hex, signature, 64);
+    cvc_sha256((const unsigned char*)rfc7515_signing_input, strlen(rfc7515_signing_input), digest);
+
+    unsigned char hash_seed[16] = { 0 };
+    cvc_public_key_set_config_t config = { 16, 4 };
+    cvc_public_key_set_t* key_set = NULL;
+    cvc_nist256_point_table_t* table = NULL;
+    if (cvc_public_key_set_create(&config, hash_seed, sizeof(hash_seed), &key_set) != CVC_PUBLIC_KEY_SET_SUCCESS || cvc_nist256_point_precompute(public_key, 65, &table) != CVC_POINT_TABLE_SUCCESS)
+    {
+        printf("   Setup failed\n");
+        return 1;
+    }
+
+    double start;
+
+    printf("ES256 signature verification\n");
+
+    start = now_seconds_bench();
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        cvc_ecdsa_nist256_verify(NULL, public_key, 65, digest, 32, signature, 64);
+    }
+    report_bench("interleaved (decode every call)", now_seconds_bench() - start, BENCH_ITERATIONS);
+
+    start = now_seconds_bench();
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        cvc_ecdsa_nist256_verify(key_set, public_key, 65, digest, 32, signature, 64);
+    }
+    report_bench("interleaved + validated key set", now_seconds_bench() - start, BENCH_ITERATIONS);
+
+    start = now_seconds_bench();
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        cvc_ecdsa_nist256_verify_table(table, digest, 32, signature, 64);
+    }
+    report_bench("precomputed key table", now_seconds_bench() - start, BENCH_ITERATIONS);
+
+    cvc_nist256_point_table_destroy(table);
+    cvc_public_key_set_destroy(key_set);
+
+    printf("\n");
+    return 0;
+}
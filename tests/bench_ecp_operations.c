@@ -0,0 +1,94 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "src/ecp_operations.h"
+#include "src/public_key_set.h"
+#include "src/nist256_key_material.h"
+
+#define BENCH_ITERATIONS 20000
+#define BENCH_KEYS 16
+
+static double now_seconds_bench(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// The two-key add path before the affine kernel: projective add, then toOctet's inversion
+static int projective_add_bench(const unsigned char* key1, const unsigned char* key2, unsigned char* result)
+{
+    octet key1_octet = { 65, 65, (char*)key1 };
+    octet key2_octet = { 65, 65, (char*)key2 };
+    ECP_NIST256 point1, point2;
+    if (!ECP_NIST256_fromOctet(&point1, &key1_octet) || !ECP_NIST256_fromOctet(&point2, &key2_octet))
+    {
+        return -1;
+    }
+    ECP_NIST256_add(&point1, &point2);
+
+    octet result_octet = { 0, 65, (char*)result };
+    ECP_NIST256_toOctet(&result_octet, &point1, false);
+    return 0;
+}
+
+static void report_bench(const char* label, double seconds, int operations)
+{
+    printf("   %-40s %8.2f us/op\n", label, seconds * 1e6 / operations);
+}
+
+int main()
+{
+    printf("=== ECP Operations Benchmark ===\n\n");
+
+    unsigned char keys[BENCH_KEYS][65];
+    for (int i = 0; i < BENCH_KEYS; i++)
+    {
+        unsigned char seed[32];
+        memset(seed, 0x41 + i, sizeof(seed));
+        nist256_key_material_t key_material;
+        nist256_generate_key_material(seed, sizeof(seed), &key_material);
+        keys[i][0] = 0x04;
+        memcpy(&keys[i][1], key_material.public_key_x_bytes, 32);
+        memcpy(&keys[i][33], key_material.public_key_y_bytes, 32);
+    }
+
+    unsigned char result[65];
+    int result_len = 0;
+    double start;
+
+    printf("Two-key public key addition\n");
+
+    start = now_seconds_bench();
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        projective_add_bench(keys[i % BENCH_KEYS], keys[(i + 1) % BENCH_KEYS], result);
+    }
+    report_bench("projective add + toOctet", now_seconds_bench() - start, BENCH_ITERATIONS);
+
+    start = now_seconds_bench();
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        cvc_add_nist256_public_keys(keys[i % BENCH_KEYS], 65, keys[(i + 1) % BENCH_KEYS], 65, result, sizeof(result), &result_len);
+    }
+    report_bench("cvc_add_nist256_public_keys (affine)", now_seconds_bench() - start, BENCH_ITERATIONS);
+
+    unsigned char hash_seed[16] = { 0 };
+    cvc_public_key_set_config_t config = { 256, 0 };
+    cvc_public_key_set_t* set = NULL;
+    cvc_public_key_set_create(&config, hash_seed, sizeof(hash_seed), &set);
+
+    start = now_seconds_bench();
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        cvc_add_nist256_public_keys_cached(set, keys[i % BENCH_KEYS], 65, keys[(i + 1) % BENCH_KEYS], 65, result, sizeof(result), &result_len);
+    }
+    report_bench("affine + validated key set", now_seconds_bench() - start, BENCH_ITERATIONS);
+    cvc_public_key_set_destroy(set);
+
+    printf("\n");
+    return 0;
+}
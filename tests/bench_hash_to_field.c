@@ -0,0 +1,105 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "src/hash_to_field.h"
+#include "core.h"
+
+#define BENCH_ITERATIONS 20000
+#define BENCH_BATCH 64
+
+// External ROM constants
+extern const BIG_256_56 CURVE_Order_NIST256;
+extern const BIG_256_56 Modulus_NIST256;
+
+static double now_seconds_bench(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// The generic path as it ran before specialization: ROM copies, nbits, scratch copy and dmod per element
+static void generic_hash_to_field_bench(const unsigned char* dst, int dst_len, const unsigned char* message, int message_len, int count, FP_NIST256* field_elements)
+{
+    BIG_256_56 field_modulus, curve_order;
+    BIG_256_56_rcopy(field_modulus, Modulus_NIST256);
+    BIG_256_56_rcopy(curve_order, CURVE_Order_NIST256);
+    const int k = BIG_256_56_nbits(field_modulus);
+    const int m = BIG_256_56_nbits(curve_order);
+    const int L = (k + (m + 1) / 2 + 7) / 8;
+
+    char okm_buffer[2048];
+    octet OKM = { 0, sizeof(okm_buffer), okm_buffer };
+    octet DST = { dst_len, dst_len, (char*)dst };
+    octet MESSAGE = { message_len, message_len, (char*)message };
+    XMD_Expand(MC_SHA2, SHA256, &OKM, L * count, &DST, &MESSAGE);
+
+    for (int i = 0; i < count; i++)
+    {
+        char fd[256];
+        memcpy(fd, okm_buffer + i * L, L);
+        DBIG_256_56 dx;
+        BIG_256_56 w;
+        BIG_256_56_dfromBytesLen(dx, fd, L);
+        BIG_256_56_dmod(w, dx, field_modulus);
+        FP_NIST256_nres(&field_elements[i], w);
+    }
+}
+
+static void report_bench(const char* label, double seconds, int operations)
+{
+    printf("   %-40s %8.2f us/op\n", label, seconds * 1e6 / operations);
+}
+
+int main()
+{
+    printf("=== Hash-to-Field Benchmark ===\n\n");
+
+    const unsigned char dst[] = "QUUX-V01-CS02-with-P256_XMD:SHA-256_SSWU_RO_";
+    const int dst_len = (int)sizeof(dst) - 1;
+
+    unsigned char storage[BENCH_BATCH][32];
+    const unsigned char* messages[BENCH_BATCH];
+    int message_lens[BENCH_BATCH];
+    for (int i = 0; i < BENCH_BATCH; i++)
+    {
+        memset(storage[i], 0x30 + i, sizeof(storage[i]));
+        messages[i] = storage[i];
+        message_lens[i] = sizeof(storage[i]);
+    }
+
+    FP_NIST256 elements[BENCH_BATCH * 2];
+    double start;
+
+    for (int count = 1; count <= 2; count++)
+    {
+        printf("count = %d (L * count = %d bytes)\n", count, 48 * count);
+
+        start = now_seconds_bench();
+        for (int i = 0; i < BENCH_ITERATIONS; i++)
+        {
+            generic_hash_to_field_bench(dst, dst_len, messages[i % BENCH_BATCH], message_lens[0], count, elements);
+        }
+        report_bench("generic (XMD_Expand + dmod)", now_seconds_bench() - start, BENCH_ITERATIONS);
+
+        start = now_seconds_bench();
+        for (int i = 0; i < BENCH_ITERATIONS; i++)
+        {
+            cvc_hash_to_field_nist256_sha256(dst, dst_len, messages[i % BENCH_BATCH], message_lens[0], count, elements);
+        }
+        report_bench("specialized P-256/SHA-256", now_seconds_bench() - start, BENCH_ITERATIONS);
+
+        start = now_seconds_bench();
+        for (int i = 0; i < BENCH_ITERATIONS / BENCH_BATCH; i++)
+        {
+            cvc_hash_to_field_nist256_batch(MC_SHA2, HASH_TYPE_NIST256, dst, dst_len, messages, message_lens, BENCH_BATCH, count, elements);
+        }
+        report_bench("batch (per message)", now_seconds_bench() - start, (BENCH_ITERATIONS / BENCH_BATCH) * BENCH_BATCH);
+        printf("\n");
+    }
+
+    return 0;
+}
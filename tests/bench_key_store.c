@@ -0,0 +1,97 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "src/key_store.h"
+#include "src/nist256_key_material.h"
+#include "src/public_derive.h"
+
+#define BENCH_KEYS 1000
+#define BENCH_LOOKUPS 100000
+#define BENCH_OPENS 1000
+
+static const char store_path_bench[] = "bench_key_store.cvks";
+static const unsigned char dst_bench[] = "CVC-KEY-STORE-BENCH-V01";
+
+static double now_seconds_bench(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void report_bench(const char* label, double seconds, int operations)
+{
+    printf("   %-40s %8.2f us/op\n", label, seconds * 1e6 / operations);
+}
+
+int main()
+{
+    printf("=== Key Store Benchmark ===\n\n");
+
+    unsigned char master_secret[32];
+    memset(master_secret, 0x2B, sizeof(master_secret));
+
+    static unsigned char contexts[BENCH_KEYS][24];
+    const unsigned char* context_ptrs[BENCH_KEYS];
+    int context_lens[BENCH_KEYS];
+    for (int i = 0; i < BENCH_KEYS; i++)
+    {
+        context_lens[i] = snprintf((char*)contexts[i], sizeof(contexts[i]), "holder/%d", i);
+        context_ptrs[i] = contexts[i];
+    }
+
+    static nist256_key_material_t key_materials[BENCH_KEYS];
+    if (cvc_derive_additive_secret_keys_nist256_batch(master_secret, 32, context_ptrs, context_lens, BENCH_KEYS, dst_bench, sizeof(dst_bench) - 1, key_materials) != CVC_PUBLIC_DERIVE_SUCCESS)
+    {
+        printf("Failed to derive the benchmark keys\n");
+        return 1;
+    }
+
+    printf("Store of %d keys\n", BENCH_KEYS);
+
+    double start = now_seconds_bench();
+    if (cvc_key_store_write(store_path_bench, context_ptrs, context_lens, key_materials, BENCH_KEYS) != CVC_KEY_STORE_SUCCESS)
+    {
+        printf("Failed to write the benchmark store\n");
+        return 1;
+    }
+    report_bench("cvc_key_store_write (whole store)", now_seconds_bench() - start, 1);
+
+    cvc_key_store_t* store = NULL;
+    start = now_seconds_bench();
+    for (int i = 0; i < BENCH_OPENS; i++)
+    {
+        cvc_key_store_open(store_path_bench, &store);
+        cvc_key_store_close(store);
+    }
+    report_bench("cvc_key_store_open + close", now_seconds_bench() - start, BENCH_OPENS);
+
+    unsigned char found[65];
+    unsigned char stranger[24];
+    const int stranger_len = snprintf((char*)stranger, sizeof(stranger), "stranger/0");
+    cvc_key_store_open(store_path_bench, &store);
+
+    start = now_seconds_bench();
+    for (int i = 0; i < BENCH_LOOKUPS; i++)
+    {
+        const int k = i % BENCH_KEYS;
+        cvc_key_store_lookup(store, contexts[k], context_lens[k], found, sizeof(found));
+    }
+    report_bench("cvc_key_store_lookup (hit)", now_seconds_bench() - start, BENCH_LOOKUPS);
+
+    start = now_seconds_bench();
+    for (int i = 0; i < BENCH_LOOKUPS; i++)
+    {
+        cvc_key_store_lookup(store, stranger, stranger_len, found, sizeof(found));
+    }
+    report_bench("cvc_key_store_lookup (miss)", now_seconds_bench() - start, BENCH_LOOKUPS);
+
+    cvc_key_store_close(store);
+    remove(store_path_bench);
+
+    printf("\n");
+    return 0;
+}
@@ -0,0 +1,94 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "src/point_table.h"
+#include "src/nist256_key_material.h"
+
+#define BENCH_ITERATIONS 2000
+#define BENCH_SCALARS 32
+
+static double now_seconds_bench(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// The variable-base path the table replaces: MIRACL's ECP_NIST256_mul
+static void reference_multiply_bench(const unsigned char* public_key, const unsigned char* scalar, unsigned char* result)
+{
+    ECP_NIST256 P;
+    octet key_octet = { 65, 65, (char*)public_key };
+    ECP_NIST256_fromOctet(&P, &key_octet);
+
+    BIG_256_56 d;
+    BIG_256_56_fromBytes(d, (char*)scalar);
+    ECP_NIST256_mul(&P, d);
+
+    octet result_octet = { 0, 65, (char*)result };
+    ECP_NIST256_toOctet(&result_octet, &P, false);
+}
+
+static void report_bench(const char* label, double seconds, int operations)
+{
+    printf("   %-40s %8.2f us/op\n", label, seconds * 1e6 / operations);
+}
+
+int main()
+{
+    printf("=== Point Table Benchmark ===\n\n");
+
+    unsigned char seed[32];
+    memset(seed, 0x5A, sizeof(seed));
+    nist256_key_material_t issuer;
+    nist256_generate_key_material(seed, sizeof(seed), &issuer);
+    unsigned char issuer_public[65];
+    issuer_public[0] = 0x04;
+    memcpy(issuer_public + 1, issuer.public_key_x_bytes, 32);
+    memcpy(issuer_public + 33, issuer.public_key_y_bytes, 32);
+
+    unsigned char scalars[BENCH_SCALARS][32];
+    for (int i = 0; i < BENCH_SCALARS; i++)
+    {
+        nist256_key_material_t scalar_key;
+        memset(seed, 0x61 + i, sizeof(seed));
+        nist256_generate_key_material(seed, sizeof(seed), &scalar_key);
+        memcpy(scalars[i], scalar_key.private_key_bytes, 32);
+    }
+
+    unsigned char result[65];
+    double start;
+
+    printf("Scalar multiplication of a fixed public key\n");
+
+    start = now_seconds_bench();
+    cvc_nist256_point_table_t* table = NULL;
+    if (cvc_nist256_point_precompute(issuer_public, 65, &table) != CVC_POINT_TABLE_SUCCESS)
+    {
+        printf("   Precomputation failed\n");
+        return 1;
+    }
+    report_bench("cvc_nist256_point_precompute", now_seconds_bench() - start, 1);
+
+    start = now_seconds_bench();
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        reference_multiply_bench(issuer_public, scalars[i % BENCH_SCALARS], result);
+    }
+    report_bench("ECP_NIST256_mul (variable base)", now_seconds_bench() - start, BENCH_ITERATIONS);
+
+    start = now_seconds_bench();
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        cvc_nist256_point_table_multiply(table, scalars[i % BENCH_SCALARS], 32, result, sizeof(result));
+    }
+    report_bench("cvc_nist256_point_table_multiply", now_seconds_bench() - start, BENCH_ITERATIONS);
+
+    cvc_nist256_point_table_destroy(table);
+
+    printf("\n");
+    return 0;
+}
@@ -0,0 +1,80 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "src/nist256_key_material.h"
+#include "src/public_derive.h"
+
+#define BENCH_KEYS 256
+
+static const unsigned char dst_bench[] = "CVC-ADDITIVE-DERIVE-BENCH-V01";
+
+static double now_seconds_bench(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void report_bench(const char* label, double seconds, int operations)
+{
+    printf("   %-40s %8.2f us/op\n", label, seconds * 1e6 / operations);
+}
+
+int main()
+{
+    printf("=== Additive Key Derivation Benchmark ===\n\n");
+
+    unsigned char seed[32];
+    memset(seed, 0x4D, sizeof(seed));
+    nist256_key_material_t master;
+    nist256_generate_key_material(seed, sizeof(seed), &master);
+    unsigned char master_public[65];
+    master_public[0] = 0x04;
+    memcpy(master_public + 1, master.public_key_x_bytes, 32);
+    memcpy(master_public + 33, master.public_key_y_bytes, 32);
+
+    static unsigned char contexts[BENCH_KEYS][24];
+    const unsigned char* context_ptrs[BENCH_KEYS];
+    int context_lens[BENCH_KEYS];
+    for (int i = 0; i < BENCH_KEYS; i++)
+    {
+        context_lens[i] = snprintf((char*)contexts[i], sizeof(contexts[i]), "holder/%d", i);
+        context_ptrs[i] = contexts[i];
+    }
+
+    unsigned char hash_seed[16] = { 0 };
+    const cvc_public_key_set_config_t config = { 16, 0 };
+    cvc_public_key_set_t* key_set = NULL;
+    cvc_public_key_set_create(&config, hash_seed, sizeof(hash_seed), &key_set);
+
+    static unsigned char derived_public[BENCH_KEYS * 65];
+    static nist256_key_material_t derived_secret[BENCH_KEYS];
+    double start;
+
+    printf("Public key derivation from a master public key (%d contexts)\n", BENCH_KEYS);
+
+    start = now_seconds_bench();
+    for (int i = 0; i < BENCH_KEYS; i++)
+    {
+        cvc_derive_public_key_nist256(key_set, master_public, 65, contexts[i], context_lens[i], dst_bench, sizeof(dst_bench) - 1, derived_public + i * 65, 65);
+    }
+    report_bench("cvc_derive_public_key_nist256", now_seconds_bench() - start, BENCH_KEYS);
+
+    start = now_seconds_bench();
+    cvc_derive_public_keys_nist256_batch(key_set, master_public, 65, context_ptrs, context_lens, BENCH_KEYS, dst_bench, sizeof(dst_bench) - 1, derived_public);
+    report_bench("cvc_derive_public_keys_nist256_batch", now_seconds_bench() - start, BENCH_KEYS);
+
+    printf("\nKey pair derivation from a master secret key (%d contexts)\n", BENCH_KEYS);
+
+    start = now_seconds_bench();
+    cvc_derive_additive_secret_keys_nist256_batch(master.private_key_bytes, 32, context_ptrs, context_lens, BENCH_KEYS, dst_bench, sizeof(dst_bench) - 1, derived_secret);
+    report_bench("cvc_derive_additive_secret_keys_..._batch", now_seconds_bench() - start, BENCH_KEYS);
+
+    cvc_public_key_set_destroy(key_set);
+
+    printf("\n");
+    return 0;
+}
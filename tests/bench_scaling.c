@@ -0,0 +1,479 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+// Thread scaling benchmark: runs each API from 1..N threads and reports throughput,
+// speedup over one thread and per-call tail latency.
+//
+// Usage: bench_scaling [--threads N] [--batch B] [--seconds S] [--pin] [--op NAME]
+//
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // pthread_setaffinity_np
+#endif
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "src/add_secret_keys.h"
+#include "src/ecdh.h"
+#include "src/ecp_operations.h"
+#include "src/ed25519_operations.h"
+#include "src/hash_to_curve.h"
+#include "src/hash_to_field.h"
+#include "src/key_cache.h"
+#include "src/key_pool.h"
+#include "src/public_key_set.h"
+#include "src/sha256.h"
+
+#define SCALING_MAX_THREADS 256
+#define SCALING_MAX_BATCH 1024
+#define SCALING_MAX_SAMPLES (1 << 16)
+#define SCALING_KEYS 64
+
+typedef struct
+{
+    int max_threads;
+    int batch;
+    double seconds;
+    int pin;
+    const char* only_op;
+} scaling_options_t;
+
+// Inputs shared read-only by all threads, plus the shared caches under test
+typedef struct
+{
+    unsigned char secret_keys[SCALING_KEYS][32];
+    unsigned char public_keys[SCALING_KEYS][65];
+    const unsigned char* public_key_ptrs[SCALING_KEYS];
+    unsigned char contexts[SCALING_MAX_BATCH][16];
+    const unsigned char* context_ptrs[SCALING_MAX_BATCH];
+    int context_lens[SCALING_MAX_BATCH];
+    cvc_key_cache_t* key_cache;
+    cvc_public_key_set_t* key_set;
+    cvc_key_pool_t* key_pool;
+} scaling_inputs_t;
+
+// One benchmarked API; run performs `batch` operations starting at `index`
+typedef struct
+{
+    const char* name;
+    void (*run)(int index, int batch);
+} scaling_op_t;
+
+typedef struct
+{
+    int thread_index;
+    int cpu;
+    const scaling_op_t* op;
+    int batch;
+    uint64_t operations;
+    uint64_t* samples; // Per-call latency in ns
+    int sample_count;
+} scaling_thread_t;
+
+static scaling_inputs_t inputs;
+static const unsigned char master_key_scaling[32] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32 };
+static const unsigned char dst_scaling[] = "CVC_DERIVE_KEY";
+static atomic_int start_flag;
+static atomic_int stop_flag;
+static atomic_int ready_count;
+
+static uint64_t now_ns_scaling(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// ============================================================================
+// Operations
+// ============================================================================
+
+static void op_derive(int index, int batch)
+{
+    for (int i = 0; i < batch; i++)
+    {
+        nist256_key_material_t key;
+        const int slot = (index + i) % SCALING_MAX_BATCH;
+        cvc_derive_secret_key_nist256(master_key_scaling, 32, inputs.context_ptrs[slot], inputs.context_lens[slot], dst_scaling, sizeof(dst_scaling) - 1, &key);
+    }
+}
+
+static void op_derive_cached(int index, int batch)
+{
+    for (int i = 0; i < batch; i++)
+    {
+        nist256_key_material_t key;
+        const int slot = (index + i) % SCALING_KEYS; // Small working set: mostly hits on one shared cache
+        cvc_derive_secret_key_nist256_cached(inputs.key_cache, master_key_scaling, 32, inputs.context_ptrs[slot], inputs.context_lens[slot], dst_scaling, sizeof(dst_scaling) - 1, &key);
+    }
+}
+
+static void op_add_secret(int index, int batch)
+{
+    for (int i = 0; i < batch; i++)
+    {
+        nist256_key_material_t key;
+        cvc_add_nist256_secret_keys(inputs.secret_keys[(index + i) % SCALING_KEYS], 32, inputs.secret_keys[(index + i + 1) % SCALING_KEYS], 32, &key);
+    }
+}
+
+static void op_add_public(int index, int batch)
+{
+    for (int i = 0; i < batch; i++)
+    {
+        unsigned char result[65];
+        int result_len;
+        cvc_add_nist256_public_keys(inputs.public_keys[(index + i) % SCALING_KEYS], 65, inputs.public_keys[(index + i + 1) % SCALING_KEYS], 65, result, sizeof(result), &result_len);
+    }
+}
+
+static void op_add_public_cached(int index, int batch)
+{
+    for (int i = 0; i < batch; i++)
+    {
+        unsigned char result[65];
+        int result_len;
+        cvc_add_nist256_public_keys_cached(inputs.key_set, inputs.public_keys[(index + i) % SCALING_KEYS], 65, inputs.public_keys[(index + i + 1) % SCALING_KEYS], 65, result, sizeof(result), &result_len);
+    }
+}
+
+static void op_sum_public(int index, int batch)
+{
+    (void)index;
+    unsigned char result[65];
+    int result_len;
+    cvc_sum_nist256_public_keys(inputs.key_set, inputs.public_key_ptrs, batch < SCALING_KEYS ? batch : SCALING_KEYS, result, sizeof(result), &result_len);
+}
+
+static void op_hash_to_curve_batch(int index, int batch)
+{
+    static _Thread_local ECP_NIST256 points[SCALING_MAX_BATCH];
+    (void)index;
+    cvc_hash_to_curve_nist256_batch(dst_scaling, sizeof(dst_scaling) - 1, inputs.context_ptrs, inputs.context_lens, batch, points);
+}
+
+static void op_xmd_batch(int index, int batch)
+{
+    static _Thread_local unsigned char okm[SCALING_MAX_BATCH * 48];
+    (void)index;
+    cvc_expand_message_xmd_sha256_batch(dst_scaling, sizeof(dst_scaling) - 1, inputs.context_ptrs, inputs.context_lens, batch, okm, 48);
+}
+
+static void op_derive_ed25519(int index, int batch)
+{
+    for (int i = 0; i < batch; i++)
+    {
+        ed25519_key_material_t key;
+        const int slot = (index + i) % SCALING_MAX_BATCH;
+        cvc_derive_secret_key_ed25519(master_key_scaling, 32, inputs.context_ptrs[slot], inputs.context_lens[slot], dst_scaling, sizeof(dst_scaling) - 1, &key);
+    }
+}
+
+static void op_key_pool(int index, int batch)
+{
+    (void)index;
+    nist256_key_material_t* held[SCALING_MAX_BATCH];
+    for (int i = 0; i < batch; i++)
+    {
+        held[i] = cvc_key_pool_alloc(inputs.key_pool);
+    }
+    for (int i = 0; i < batch; i++)
+    {
+        if (held[i])
+        {
+            cvc_key_pool_free(inputs.key_pool, held[i]);
+        }
+    }
+}
+
+static void op_ecdh_batch(int index, int batch)
+{
+    static _Thread_local unsigned char shared[SCALING_KEYS * 32];
+    cvc_ecdh_nist256_batch(inputs.secret_keys[index % SCALING_KEYS], 32, inputs.key_set, inputs.public_key_ptrs, batch < SCALING_KEYS ? batch : SCALING_KEYS, 1, shared, NULL);
+}
+
+static const scaling_op_t scaling_ops[] = {
+    { "derive_nist256", op_derive },
+    { "derive_nist256_cached", op_derive_cached },
+    { "add_secret_keys", op_add_secret },
+    { "add_public_keys", op_add_public },
+    { "add_public_keys_cached", op_add_public_cached },
+    { "sum_public_keys", op_sum_public },
+    { "hash_to_curve_batch", op_hash_to_curve_batch },
+    { "xmd_sha256_batch", op_xmd_batch },
+    { "derive_ed25519", op_derive_ed25519 },
+    { "key_pool_alloc_free", op_key_pool },
+    { "ecdh_batch", op_ecdh_batch },
+};
+
+// ============================================================================
+// Runner
+// ============================================================================
+
+static void pin_to_cpu(int cpu)
+{
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+static void* scaling_worker(void* arg)
+{
+    scaling_thread_t* thread = (scaling_thread_t*)arg;
+    if (thread->cpu >= 0)
+    {
+        pin_to_cpu(thread->cpu);
+    }
+
+    // Warm up thread-local state before the clock starts
+    thread->op->run(thread->thread_index, 1);
+
+    atomic_fetch_add(&ready_count, 1);
+    while (!atomic_load(&start_flag))
+    {
+        sched_yield();
+    }
+
+    int index = thread->thread_index * 7919;
+    while (!atomic_load_explicit(&stop_flag, memory_order_relaxed))
+    {
+        const uint64_t begin = now_ns_scaling();
+        thread->op->run(index, thread->batch);
+        const uint64_t elapsed = now_ns_scaling() - begin;
+
+        if (thread->sample_count < SCALING_MAX_SAMPLES)
+        {
+            thread->samples[thread->sample_count++] = elapsed;
+        }
+        thread->operations += (uint64_t)thread->batch;
+        index += thread->batch;
+    }
+    return NULL;
+}
+
+static int compare_u64(const void* a, const void* b)
+{
+    const uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t percentile(const uint64_t* sorted, int count, double fraction)
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    int position = (int)(fraction * (count - 1) + 0.5);
+    return sorted[position];
+}
+
+// Runs one op with thread_count threads; returns operations per second
+static double run_point(const scaling_op_t* op, int thread_count, const scaling_options_t* options, int cpu_count, uint64_t* merged)
+{
+    pthread_t threads[SCALING_MAX_THREADS];
+    scaling_thread_t state[SCALING_MAX_THREADS];
+
+    atomic_store(&start_flag, 0);
+    atomic_store(&stop_flag, 0);
+    atomic_store(&ready_count, 0);
+
+    for (int t = 0; t < thread_count; t++)
+    {
+        memset(&state[t], 0, sizeof(state[t]));
+        state[t].thread_index = t;
+        state[t].cpu = options->pin ? t % cpu_count : -1;
+        state[t].op = op;
+        state[t].batch = options->batch;
+        state[t].samples = malloc(SCALING_MAX_SAMPLES * sizeof(uint64_t));
+        pthread_create(&threads[t], NULL, scaling_worker, &state[t]);
+    }
+
+    while (atomic_load(&ready_count) < thread_count)
+    {
+        sched_yield();
+    }
+
+    const uint64_t begin = now_ns_scaling();
+    atomic_store(&start_flag, 1);
+    struct timespec duration = { (time_t)options->seconds, (long)((options->seconds - (double)(time_t)options->seconds) * 1e9) };
+    nanosleep(&duration, NULL);
+    atomic_store(&stop_flag, 1);
+
+    uint64_t operations = 0;
+    uint64_t worst_thread_p99 = 0;
+    int merged_count = 0;
+    for (int t = 0; t < thread_count; t++)
+    {
+        pthread_join(threads[t], NULL);
+        operations += state[t].operations;
+
+        qsort(state[t].samples, (size_t)state[t].sample_count, sizeof(uint64_t), compare_u64);
+        const uint64_t thread_p99 = percentile(state[t].samples, state[t].sample_count, 0.99);
+        worst_thread_p99 = thread_p99 > worst_thread_p99 ? thread_p99 : worst_thread_p99;
+
+        // Keep an even share of every thread's samples for the merged distribution
+        const int share = SCALING_MAX_SAMPLES / thread_count;
+        const int take = state[t].sample_count < share ? state[t].sample_count : share;
+        const int stride = take > 0 ? state[t].sample_count / take : 1;
+        for (int i = 0; i < take; i++)
+        {
+            merged[merged_count++] = state[t].samples[i * stride];
+        }
+        free(state[t].samples);
+    }
+    const double elapsed = (double)(now_ns_scaling() - begin) * 1e-9;
+
+    qsort(merged, (size_t)merged_count, sizeof(uint64_t), compare_u64);
+    const double throughput = (double)operations / elapsed;
+    printf("   %3d threads %12.0f ops/s   p50 %9.1f us   p99 %9.1f us   p99.9 %9.1f us   worst thread p99 %9.1f us\n", thread_count, throughput, percentile(merged, merged_count, 0.50) / 1e3,
+        percentile(merged, merged_count, 0.99) / 1e3, percentile(merged, merged_count, 0.999) / 1e3, worst_thread_p99 / 1e3);
+    return throughput;
+}
+
+static void setup_inputs(void)
+{
+    for (int i = 0; i < SCALING_KEYS; i++)
+    {
+        unsigned char seed[32];
+        memset(seed, 0x20 + i, sizeof(seed));
+        nist256_key_material_t key;
+        nist256_generate_key_material(seed, sizeof(seed), &key);
+        memcpy(inputs.secret_keys[i], key.private_key_bytes, 32);
+        inputs.public_keys[i][0] = 0x04;
+        memcpy(&inputs.public_keys[i][1], key.public_key_x_bytes, 32);
+        memcpy(&inputs.public_keys[i][33], key.public_key_y_bytes, 32);
+        inputs.public_key_ptrs[i] = inputs.public_keys[i];
+    }
+
+    for (int i = 0; i < SCALING_MAX_BATCH; i++)
+    {
+        inputs.context_lens[i] = snprintf((char*)inputs.contexts[i], sizeof(inputs.contexts[i]), "ctx-%d", i);
+        inputs.context_ptrs[i] = inputs.contexts[i];
+    }
+
+    unsigned char hash_key[32];
+    memset(hash_key, 0x5a, sizeof(hash_key));
+    cvc_key_cache_config_t cache_config = { 4096, 0, 0, 1 };
+    cvc_key_cache_create(&cache_config, hash_key, sizeof(hash_key), &inputs.key_cache);
+
+    cvc_public_key_set_config_t set_config = { 1024, 0 };
+    cvc_public_key_set_create(&set_config, hash_key, sizeof(hash_key), &inputs.key_set);
+
+    // Enough slots for every thread to hold a full batch
+    cvc_key_pool_config_t pool_config = { SCALING_MAX_THREADS * 64, 1 };
+    cvc_key_pool_create(&pool_config, &inputs.key_pool);
+}
+
+static void parse_options(int argc, char** argv, scaling_options_t* options, int cpu_count)
+{
+    options->max_threads = cpu_count < 16 ? cpu_count : 16;
+    options->batch = 16;
+    options->seconds = 0.5;
+    options->pin = 0;
+    options->only_op = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            options->max_threads = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc)
+        {
+            options->batch = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+        {
+            options->seconds = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--pin") == 0)
+        {
+            options->pin = 1;
+        }
+        else if (strcmp(argv[i], "--op") == 0 && i + 1 < argc)
+        {
+            options->only_op = argv[++i];
+        }
+    }
+
+    if (options->max_threads < 1)
+    {
+        options->max_threads = 1;
+    }
+    if (options->max_threads > SCALING_MAX_THREADS)
+    {
+        options->max_threads = SCALING_MAX_THREADS;
+    }
+    if (options->batch < 1)
+    {
+        options->batch = 1;
+    }
+    if (options->batch > SCALING_MAX_BATCH)
+    {
+        options->batch = SCALING_MAX_BATCH;
+    }
+    if (options->seconds <= 0)
+    {
+        options->seconds = 0.5;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    const int cpu_count = online > 0 ? (int)online : 1;
+
+    scaling_options_t options;
+    parse_options(argc, argv, &options, cpu_count);
+
+    printf("=== Thread Scaling Benchmark ===\n");
+    printf("CPUs: %d, max threads: %d, batch: %d, %.2f s per point, pinning: %s\n", cpu_count, options.max_threads, options.batch, options.seconds, options.pin ? "on" : "off");
+    printf("Latency is per call of `batch` operations\n\n");
+
+    setup_inputs();
+    uint64_t* merged = malloc(SCALING_MAX_SAMPLES * sizeof(uint64_t));
+
+    for (size_t o = 0; o < sizeof(scaling_ops) / sizeof(scaling_ops[0]); o++)
+    {
+        const scaling_op_t* op = &scaling_ops[o];
+        if (options.only_op && strcmp(options.only_op, op->name) != 0)
+        {
+            continue;
+        }
+
+        printf("%s\n", op->name);
+        double single = 0;
+        for (int threads = 1; threads <= options.max_threads; threads = threads < options.max_threads && threads * 2 > options.max_threads ? options.max_threads : threads * 2)
+        {
+            const double throughput = run_point(op, threads, &options, cpu_count, merged);
+            if (threads == 1)
+            {
+                single = throughput;
+            }
+            else if (single > 0)
+            {
+                printf("               speedup %5.2fx   efficiency %5.1f%%\n", throughput / single, 100.0 * throughput / (single * threads));
+            }
+            if (threads == options.max_threads)
+            {
+                break;
+            }
+        }
+        printf("\n");
+    }
+
+    free(merged);
+    cvc_key_cache_destroy(inputs.key_cache);
+    cvc_public_key_set_destroy(inputs.key_set);
+    cvc_key_pool_destroy(inputs.key_pool);
+    return 0;
+}
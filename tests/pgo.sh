@@ -0,0 +1,114 @@
+#!/bin/bash
+# pgo.sh - Build libcvc.a with LTO and profile-guided optimization
+# Usage: ./tests/pgo.sh [training_rounds]
+#
+# 1. Instrumented LTO build (-DCVC_PGO=GENERATE) of MIRACL, l8w8jwt and cvc
+# 2. tests/pgo_train.c runs the derive/add/sign workload and writes the profiles
+# 3. Same build directory reconfigured with -DCVC_PGO=USE and rebuilt
+#
+# Both phases must use the same build directory: GCC finds each object's profile
+# by the object's path. Link the result with -Wl,--gc-sections (-Wl,-dead_strip on
+# Apple) and, where the toolchain allows, -flto to get the cross-module inlining.
+
+set -e  # Exit on any error
+
+# Colors for output
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+BLUE='\033[0;34m'
+NC='\033[0m' # No Color
+
+print_info() {
+    echo -e "${BLUE}[INFO]${NC} $1"
+}
+
+print_success() {
+    echo -e "${GREEN}[SUCCESS]${NC} $1"
+}
+
+print_error() {
+    echo -e "${RED}[ERROR]${NC} $1"
+}
+
+# Check if we're in the right directory
+if [[ ! -f "CMakeLists.txt" ]]; then
+    print_error "CMakeLists.txt not found. Run this script from the project root directory."
+    exit 1
+fi
+
+ROUNDS="${1:-20}"
+BUILD_DIR="build_pgo"
+PROFILE_DIR="$(pwd)/$BUILD_DIR/pgo-profiles"
+
+if [[ "$(uname)" == "Darwin" ]]; then
+    GC_FLAGS="-Wl,-dead_strip"
+else
+    GC_FLAGS="-Wl,--gc-sections"
+fi
+
+build_phase() {
+    cmake -S . -B "$BUILD_DIR" -DCMAKE_BUILD_TYPE=Release -DCVC_ENABLE_LTO=ON -DCVC_PGO="$1" -DCVC_PGO_DIR="$PROFILE_DIR" > /dev/null || {
+        print_error "CMake configuration failed (CVC_PGO=$1)"
+        exit 1
+    }
+    cmake --build "$BUILD_DIR" -j > /dev/null || {
+        print_error "Build failed (CVC_PGO=$1)"
+        exit 1
+    }
+}
+
+# Link the training program with the compiler that built the library, so the
+# instrumentation runtime matches
+link_train() {
+    "$CC" -O2 "$@" -o pgo_train tests/pgo_train.c \
+        -I. \
+        -I./libs/miracl-core/c \
+        -I./libs/l8w8jwt/include \
+        -L./$BUILD_DIR \
+        -lcvc -lpthread || {
+        print_error "pgo_train compilation failed"
+        exit 1
+    }
+}
+
+print_info "Phase 1: instrumented build..."
+rm -rf "$PROFILE_DIR"
+build_phase GENERATE
+
+CC="$(sed -n 's/^CMAKE_C_COMPILER:[A-Z]*=//p' "$BUILD_DIR/CMakeCache.txt")"
+COMPILER_ID="$(sed -n 's/^set(CMAKE_C_COMPILER_ID "\(.*\)")$/\1/p' "$BUILD_DIR/CMakeFiles/"*/CMakeCCompiler.cmake | head -n 1)"
+
+print_info "Phase 2: training with $ROUNDS rounds of derive/add/sign..."
+link_train -fprofile-generate="$PROFILE_DIR"
+./pgo_train "$ROUNDS" || {
+    print_error "Training run failed"
+    rm -f pgo_train
+    exit 1
+}
+
+if [[ "$COMPILER_ID" == *Clang* ]]; then
+    PROFDATA="$(command -v llvm-profdata || true)"
+    if [[ -z "$PROFDATA" && "$(uname)" == "Darwin" ]]; then
+        PROFDATA="xcrun llvm-profdata"
+    fi
+    if [[ -z "$PROFDATA" ]]; then
+        print_error "llvm-profdata not found; it is needed to merge Clang profiles"
+        exit 1
+    fi
+    $PROFDATA merge -o "$PROFILE_DIR/cvc.profdata" "$PROFILE_DIR"/*.profraw
+fi
+
+print_info "Phase 3: optimized build from the profiles..."
+build_phase USE
+
+# Smoke-test the optimized library the way a consumer links it
+link_train -flto "$GC_FLAGS"
+./pgo_train 1 > /dev/null || {
+    print_error "Optimized library failed the training workload"
+    rm -f pgo_train
+    exit 1
+}
+print_info "Linked training binary: $(wc -c < pgo_train) bytes"
+rm -f pgo_train
+
+print_success "Optimized library: $BUILD_DIR/libcvc.a ($(wc -c < "$BUILD_DIR/libcvc.a") bytes)"
@@ -0,0 +1,168 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+// Profile training workload for the PGO build (tests/pgo.sh): the derive, add and
+// sign calls our Go and mobile callers make, in roughly their production mix.
+// It checks results only loosely; correctness is the test suite's job.
+//
+// Usage: pgo_train [rounds]
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "src/add_secret_keys.h"
+#include "src/ecdsa.h"
+#include "src/ecp_operations.h"
+#include "src/ed25519_operations.h"
+#include "src/hash_to_field.h"
+#include "src/jwt.h"
+#include "src/keypair.h"
+#include "src/public_key_set.h"
+
+#define TRAIN_KEYS 64
+#define TRAIN_TOKENS 32
+#define TRAIN_DEFAULT_ROUNDS 20
+
+static const unsigned char train_dst[] = "CVC-PGO-TRAIN-V01";
+static const char train_header[] = "{\"alg\":\"ES256\",\"typ\":\"JWT\"}";
+
+static void to_public_key_train(const nist256_key_material_t* key_material, unsigned char* public_key)
+{
+    public_key[0] = 0x04;
+    memcpy(public_key + 1, key_material->public_key_x_bytes, 32);
+    memcpy(public_key + 33, key_material->public_key_y_bytes, 32);
+}
+
+// Context-based derivation on both curves, the way per-credential keys are made
+static int train_derive(const unsigned char* master, int round, nist256_key_material_t* keys, unsigned char public_keys[][65])
+{
+    int failures = 0;
+    for (int i = 0; i < TRAIN_KEYS; i++)
+    {
+        char context[48];
+        const int context_len = snprintf(context, sizeof(context), "credential/%d/%d", round, i);
+
+        failures += cvc_derive_secret_key_nist256(master, 32, (const unsigned char*)context, context_len, train_dst, sizeof(train_dst) - 1, &keys[i]) != CVC_DERIVE_KEY_SUCCESS;
+        to_public_key_train(&keys[i], public_keys[i]);
+
+        ed25519_key_material_t ed_key;
+        failures += cvc_derive_secret_key_ed25519(master, 32, (const unsigned char*)context, context_len, train_dst, sizeof(train_dst) - 1, &ed_key) != CVC_DERIVE_KEY_SUCCESS;
+    }
+    return failures;
+}
+
+// Pairwise and N-way key addition, secret and public side
+static int train_add(const nist256_key_material_t* keys, unsigned char public_keys[][65], cvc_public_key_set_t* key_set)
+{
+    int failures = 0;
+    for (int i = 0; i + 1 < TRAIN_KEYS; i += 2)
+    {
+        nist256_key_material_t sum;
+        failures += cvc_add_nist256_secret_keys(keys[i].private_key_bytes, 32, keys[i + 1].private_key_bytes, 32, &sum) != CVC_ADD_SECRET_KEYS_SUCCESS;
+
+        unsigned char public_sum[65];
+        int public_sum_len = 0;
+        failures += cvc_add_nist256_public_keys(public_keys[i], 65, public_keys[i + 1], 65, public_sum, sizeof(public_sum), &public_sum_len) != CVC_ECP_SUCCESS;
+        failures += cvc_add_nist256_public_keys_cached(key_set, public_keys[i], 65, public_keys[i + 1], 65, public_sum, sizeof(public_sum), &public_sum_len) != CVC_ECP_SUCCESS;
+    }
+
+    const unsigned char* key_ptrs[TRAIN_KEYS];
+    for (int i = 0; i < TRAIN_KEYS; i++)
+    {
+        key_ptrs[i] = public_keys[i];
+    }
+    unsigned char public_sum[65];
+    int public_sum_len = 0;
+    failures += cvc_sum_nist256_public_keys(key_set, key_ptrs, TRAIN_KEYS, public_sum, sizeof(public_sum), &public_sum_len) != CVC_ECP_SUCCESS;
+    return failures;
+}
+
+// Key pair handles: derive, add, sign digests and issue token batches
+static int train_sign(const unsigned char* master, int round, char* arena, int arena_size)
+{
+    int failures = 0;
+    cvc_nist256_keypair_t* issuer = NULL;
+    cvc_nist256_keypair_t* holder = NULL;
+    cvc_nist256_keypair_t* combined = NULL;
+    char context[32];
+    const int context_len = snprintf(context, sizeof(context), "issuer/%d", round);
+    if (cvc_nist256_keypair_derive(master, 32, (const unsigned char*)context, context_len, train_dst, sizeof(train_dst) - 1, 0, &issuer) != CVC_KEYPAIR_SUCCESS ||
+        cvc_nist256_keypair_derive_child(issuer, (const unsigned char*)"holder", 6, train_dst, sizeof(train_dst) - 1, 0, &holder) != CVC_KEYPAIR_SUCCESS ||
+        cvc_nist256_keypair_add(issuer, holder, 0, &combined) != CVC_KEYPAIR_SUCCESS)
+    {
+        cvc_nist256_keypair_destroy(issuer);
+        cvc_nist256_keypair_destroy(holder);
+        return 1;
+    }
+
+    unsigned char digest[CVC_ECDSA_DIGEST_LENGTH];
+    unsigned char signature[CVC_ECDSA_SIGNATURE_LENGTH];
+    for (int i = 0; i < TRAIN_TOKENS; i++)
+    {
+        memset(digest, round + i, sizeof(digest));
+        failures += cvc_nist256_keypair_sign(combined, digest, sizeof(digest), signature, sizeof(signature)) != CVC_KEYPAIR_SUCCESS;
+        failures += cvc_nist256_keypair_verify(combined, digest, sizeof(digest), signature, sizeof(signature)) != CVC_KEYPAIR_SUCCESS;
+    }
+
+    char claims[TRAIN_TOKENS][96];
+    const char* claim_ptrs[TRAIN_TOKENS];
+    int claim_lens[TRAIN_TOKENS];
+    int offsets[TRAIN_TOKENS], lens[TRAIN_TOKENS];
+    for (int i = 0; i < TRAIN_TOKENS; i++)
+    {
+        claim_lens[i] = snprintf(claims[i], sizeof(claims[i]), "{\"sub\":\"user-%d\",\"iat\":%d,\"exp\":%d}", i, 1700000000 + round, 1700003600 + round);
+        claim_ptrs[i] = claims[i];
+    }
+    failures += cvc_jwt_sign_es256_batch(issuer, train_header, sizeof(train_header) - 1, claim_ptrs, claim_lens, TRAIN_TOKENS, 1, arena, arena_size, offsets, lens, NULL) != CVC_JWT_SUCCESS;
+
+    unsigned char issuer_public[65];
+    failures += cvc_nist256_keypair_public_key(issuer, issuer_public, sizeof(issuer_public)) != CVC_KEYPAIR_SUCCESS;
+    for (int i = 0; i < TRAIN_TOKENS && failures == 0; i += 4)
+    {
+        failures += cvc_jwt_verify_es256(arena + offsets[i], lens[i], NULL, issuer_public, sizeof(issuer_public)) != CVC_JWT_SUCCESS;
+    }
+
+    cvc_nist256_keypair_destroy(issuer);
+    cvc_nist256_keypair_destroy(holder);
+    cvc_nist256_keypair_destroy(combined);
+    return failures;
+}
+
+int main(int argc, char** argv)
+{
+    const int rounds = argc > 1 ? atoi(argv[1]) : TRAIN_DEFAULT_ROUNDS;
+    if (rounds <= 0)
+    {
+        fprintf(stderr, "usage: pgo_train [rounds]\n");
+        return 2;
+    }
+
+    static nist256_key_material_t keys[TRAIN_KEYS];
+    static unsigned char public_keys[TRAIN_KEYS][65];
+    static char arena[TRAIN_TOKENS * 256];
+    unsigned char master[32];
+    for (int i = 0; i < 32; i++)
+    {
+        master[i] = (unsigned char)(0x5A ^ (i * 37));
+    }
+
+    // The seed only has to be fixed so that profile runs are repeatable
+    const cvc_public_key_set_config_t set_config = { TRAIN_KEYS * 2, 0 };
+    cvc_public_key_set_t* key_set = NULL;
+    if (cvc_public_key_set_create(&set_config, master, 16, &key_set) != CVC_PUBLIC_KEY_SET_SUCCESS)
+    {
+        return 1;
+    }
+
+    int failures = 0;
+    for (int round = 0; round < rounds; round++)
+    {
+        failures += train_derive(master, round, keys, public_keys);
+        failures += train_add(keys, public_keys, key_set);
+        failures += train_sign(master, round, arena, sizeof(arena));
+    }
+    cvc_public_key_set_destroy(key_set);
+
+    printf("PGO training: %d rounds, %d failures\n", rounds, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -136,6 +136,272 @@ clang -o test_add_secret_keys tests/test_add_secret_keys.c \
 
 print_success "Add secret keys test program compiled successfully"
 
+# Compile derived key cache test program
+print_info "Compiling derived key cache test program..."
+clang -o test_key_cache tests/test_key_cache.c \
+    -I. \
+    -I./libs/miracl-core/c \
+    -I./libs/l8w8jwt/include \
+    -L./$BUILD_DIR \
+    -lcvc -lpthread || {
+    print_error "Derived key cache test compilation failed"
+    exit 1
+}
+
+print_success "Derived key cache test program compiled successfully"
+
+# Compile submission queue test program
+print_info "Compiling submission queue test program..."
+clang -o test_queue tests/test_queue.c \
+    -I. \
+    -I./libs/miracl-core/c \
+    -I./libs/l8w8jwt/include \
+    -L./$BUILD_DIR \
+    -lcvc -lpthread || {
+    print_error "Submission queue test compilation failed"
+    exit 1
+}
+
+print_success "Submission queue test program compiled successfully"
+
+# Compile packed batch test program
+print_info "Compiling packed batch test program..."
+clang -o test_batch tests/test_batch.c \
+    -I. \
+    -I./libs/miracl-core/c \
+    -I./libs/l8w8jwt/include \
+    -L./$BUILD_DIR \
+    -lcvc || {
+    print_error "Packed batch test compilation failed"
+    exit 1
+}
+
+print_success "Packed batch test program compiled successfully"
+
+# Compile ed25519 operations test program
+print_info "Compiling ed25519 operations test program..."
+clang -o test_ed25519 tests/test_ed25519.c \
+    -I. \
+    -I./libs/miracl-core/c \
+    -I./libs/l8w8jwt/include \
+    -L./$BUILD_DIR \
+    -lcvc -lpthread || {
+    print_error "Ed25519 operations test compilation failed"
+    exit 1
+}
+
+print_success "Ed25519 operations test program compiled successfully"
+
+# Compile hash to curve test program
+print_info "Compiling hash to curve test program..."
+clang -o test_hash_to_curve tests/test_hash_to_curve.c \
+    -I. \
+    -I./libs/miracl-core/c \
+    -I./libs/l8w8jwt/include \
+    -L./$BUILD_DIR \
+    -lcvc -lpthread || {
+    print_error "Hash to curve test compilation failed"
+    exit 1
+}
+
+print_success "Hash to curve test program compiled successfully"
+
+# Compile SHA-256 test program
+print_info "Compiling SHA-256 test program..."
+clang -o test_sha256 tests/test_sha256.c \
+    -I. \
+    -I./libs/miracl-core/c \
+    -I./libs/l8w8jwt/include \
+    -L./$BUILD_DIR \
+    -lcvc -lpthread || {
+    print_error "SHA-256 test compilation failed"
+    exit 1
+}
+
+print_success "SHA-256 test program compiled successfully"
+
+# Compile validated public key set test program
+print_info "Compiling validated public key set test program..."
+clang -o test_public_key_set tests/test_public_key_set.c \
+    -I. \
+    -I./libs/miracl-core/c \
+    -I./libs/l8w8jwt/include \
+    -L./$BUILD_DIR \
+    -lcvc -lpthread || {
+    print_error "Validated public key set test compilation failed"
+    exit 1
+}
+
+print_success "Validated public key set test program compiled successfully"
+
+# Compile concurrency stress test program
+print_info "Compiling concurrency stress test program..."
+clang -o test_concurrency tests/test_concurrency.c \
+    -I. \
+    -I./libs/miracl-core/c \
+    -I./libs/l8w8jwt/include \
+    -L./$BUILD_DIR \
+    -lcvc -lpthread || {
+    print_error "Concurrency stress test compilation failed"
+    exit 1
+}
+
+print_success "Concurrency stress test program compiled successfully"
+
+# Compile stack usage test program
+print_info "Compiling stack usage test program..."
+clang -o test_stack_usage tests/test_stack_usage.c \
+    -I. \
+    -I./libs/miracl-core/c \
+    -I./libs/l8w8jwt/include \
+    -L./$BUILD_DIR \
+    -lcvc -lpthread || {
+    print_error "Stack usage test compilation failed"
+    exit 1
+}
+
+print_success "Stack usage test program compiled successfully"
+
+# Compile key pool test program
+print_info "Compiling key pool test program..."
+clang -o test_key_pool tests/test_key_pool.c \
+    -I. \
+    -I./libs/miracl-core/c \
+    -I./libs/l8w8jwt/include \
+    -L./$BUILD_DIR \
+    -lcvc -lpthread || {
+    print_error "Key pool test compilation failed"
+    exit 1
+}
+
+print_success "Key pool test program compiled successfully"
+
+# Compile key pair handle test program
+print_info "Compiling key pair handle test program..."
+clang -o test_keypair tests/test_keypair.c \
+    -I. \
+    -I./libs/miracl-core/c \
+    -I./libs/l8w8jwt/include \
+    -L./$BUILD_DIR \
+    -lcvc -lpthread || {
+    print_error "Key pair handle test compilation failed"
+    exit 1
+}
+
+print_success "Key pair handle test program compiled successfully"
+
+# Compile ECDH test program
+print_info "Compiling ECDH test program..."
+clang -o test_ecdh tests/test_ecdh.c \
+    -I. \
+    -I./libs/miracl-core/c \
+    -I./libs/l8w8jwt/include \
+    -L./$BUILD_DIR \
+    -lcvc -lpthread || {
+    print_error "ECDH test compilation failed"
+    exit 1
+}
+
+print_success "ECDH test program compiled successfully"
+
+# Compile point table test program
+print_info "Compiling point table test program..."
+clang -o test_point_table tests/test_point_table.c \
+    -I. \
+    -I./libs/miracl-core/c \
+    -I./libs/l8w8jwt/include \
+    -L./$BUILD_DIR \
+    -lcvc -lpthread || {
+    print_error "Point table test compilation failed"
+    exit 1
+}
+
+print_success "Point table test program compiled successfully"
+
+# Compile ECDSA test program
+print_info "Compiling ECDSA test program..."
+clang -o test_ecdsa tests/test_ecdsa.c \
+    -I. \
+    -I./libs/miracl-core/c \
+    -I./libs/l8w8jwt/include \
+    -L./$BUILD_DIR \
+    -lcvc -lpthread || {
+    print_error "ECDSA test compilation failed"
+    exit 1
+}
+
+print_success "ECDSA test program compiled successfully"
+
+# Compile JWT test program
+print_info "Compiling JWT test program..."
+clang -o test_jwt tests/test_jwt.c \
+    -I. \
+    -I./libs/miracl-core/c \
+    -I./libs/l8w8jwt/include \
+    -L./$BUILD_DIR \
+    -lcvc -lpthread || {
+    print_error "JWT test compilation failed"
+    exit 1
+}
+
+print_success "JWT test program compiled successfully"
+
+# Compile SD-JWT test program
+print_info "Compiling SD-JWT test program..."
+clang -o test_sd_jwt tests/test_sd_jwt.c \
+    -I. \
+    -I./libs/miracl-core/c \
+    -I./libs/l8w8jwt/include \
+    -L./$BUILD_DIR \
+    -lcvc -lpthread || {
+    print_error "SD-JWT test compilation failed"
+    exit 1
+}
+
+print_success "SD-JWT test program compiled successfully"
+
+# Compile additive key derivation test program
+print_info "Compiling additive key derivation test program..."
+clang -o test_public_derive tests/test_public_derive.c \
+    -I. \
+    -I./libs/miracl-core/c \
+    -I./libs/l8w8jwt/include \
+    -L./$BUILD_DIR \
+    -lcvc || {
+    print_error "Additive key derivation test compilation failed"
+    exit 1
+}
+
+print_success "Additive key derivation test program compiled successfully"
+
+# Compile generated base tables test program
+print_info "Compiling generated base tables test program..."
+clang -o test_base_tables tests/test_base_tables.c \
+    -I. \
+    -I./libs/miracl-core/c \
+    -I./libs/l8w8jwt/include \
+    -L./$BUILD_DIR \
+    -lcvc -lpthread || {
+    print_error "Generated base tables test compilation failed"
+    exit 1
+}
+
+print_success "Generated base tables test program compiled successfully"
+
+# Compile key store test program
+print_info "Compiling key store test program..."
+clang -o test_key_store tests/test_key_store.c \
+    -I. \
+    -I./libs/miracl-core/c \
+    -I./libs/l8w8jwt/include \
+    -L./$BUILD_DIR \
+    -lcvc || {
+    print_error "Key store test compilation failed"
+    exit 1
+}
+
+print_success "Key store test program compiled successfully"
+
 # Run main tests
 print_info "Running main tests..."
 echo
@@ -160,17 +426,150 @@ echo
 ./test_add_secret_keys
 ASK_TEST_RESULT=$?
 
+echo
+print_info "Running derived key cache tests..."
+echo
+./test_key_cache
+KC_TEST_RESULT=$?
+
+echo
+print_info "Running submission queue tests..."
+echo
+./test_queue
+QUEUE_TEST_RESULT=$?
+
+echo
+print_info "Running packed batch tests..."
+echo
+./test_batch
+BATCH_TEST_RESULT=$?
+
+echo
+print_info "Running ed25519 operations tests..."
+echo
+./test_ed25519
+ED25519_TEST_RESULT=$?
+
+echo
+print_info "Running hash to curve tests..."
+echo
+./test_hash_to_curve
+HTC_TEST_RESULT=$?
+
+echo
+print_info "Running SHA-256 tests..."
+echo
+./test_sha256
+SHA256_TEST_RESULT=$?
+
+echo
+print_info "Running validated public key set tests..."
+echo
+./test_public_key_set
+PKS_TEST_RESULT=$?
+
+echo
+print_info "Running concurrency stress tests..."
+echo
+./test_concurrency
+CONC_TEST_RESULT=$?
+
+echo
+print_info "Running stack usage tests..."
+echo
+./test_stack_usage
+STACK_TEST_RESULT=$?
+
+echo
+print_info "Running key pool tests..."
+echo
+./test_key_pool
+KP_TEST_RESULT=$?
+
+echo
+print_info "Running key pair handle tests..."
+echo
+./test_keypair
+KPR_TEST_RESULT=$?
+
+echo
+print_info "Running ECDH tests..."
+echo
+./test_ecdh
+ECDH_TEST_RESULT=$?
+
+echo
+print_info "Running point table tests..."
+echo
+./test_point_table
+PT_TEST_RESULT=$?
+
+echo
+print_info "Running ECDSA tests..."
+echo
+./test_ecdsa
+ECDSA_TEST_RESULT=$?
+
+echo
+print_info "Running JWT tests..."
+echo
+./test_jwt
+JWT_TEST_RESULT=$?
+
+echo
+print_info "Running SD-JWT tests..."
+echo
+./test_sd_jwt
+SD_JWT_TEST_RESULT=$?
+
+echo
+print_info "Running additive key derivation tests..."
+echo
+./test_public_derive
+PUBLIC_DERIVE_TEST_RESULT=$?
+
+echo
+print_info "Running generated base tables tests..."
+echo
+./test_base_tables
+BASE_TABLES_TEST_RESULT=$?
+
+echo
+print_info "Running key store tests..."
+echo
+./test_key_store
+KEY_STORE_TEST_RESULT=$?
+
 # Cleanup
-rm -f test_cvc test_ecp_operations test_hash_to_field test_add_secret_keys
+rm -f test_cvc test_ecp_operations test_hash_to_field test_add_secret_keys test_key_cache test_queue test_batch test_ed25519 test_hash_to_curve test_sha256 test_public_key_set test_concurrency test_stack_usage test_key_pool test_keypair test_ecdh test_point_table test_ecdsa test_jwt test_sd_jwt test_public_derive test_base_tables test_key_store
 
 # Evaluate results
-if [[ $MAIN_TEST_RESULT -eq 0 && $ECP_TEST_RESULT -eq 0 && $HTF_TEST_RESULT -eq 0 && $ASK_TEST_RESULT -eq 0 ]]; then
+if [[ $MAIN_TEST_RESULT -eq 0 && $ECP_TEST_RESULT -eq 0 && $HTF_TEST_RESULT -eq 0 && $ASK_TEST_RESULT -eq 0 && $KC_TEST_RESULT -eq 0 && $QUEUE_TEST_RESULT -eq 0 && $BATCH_TEST_RESULT -eq 0 && $ED25519_TEST_RESULT -eq 0 && $HTC_TEST_RESULT -eq 0 && $SHA256_TEST_RESULT -eq 0 && $PKS_TEST_RESULT -eq 0 && $CONC_TEST_RESULT -eq 0 && $STACK_TEST_RESULT -eq 0 && $KP_TEST_RESULT -eq 0 && $KPR_TEST_RESULT -eq 0 && $ECDH_TEST_RESULT -eq 0 && $PT_TEST_RESULT -eq 0 && $ECDSA_TEST_RESULT -eq 0 && $JWT_TEST_RESULT -eq 0 && $SD_JWT_TEST_RESULT -eq 0 && $PUBLIC_DERIVE_TEST_RESULT -eq 0 && $BASE_TABLES_TEST_RESULT -eq 0 && $KEY_STORE_TEST_RESULT -eq 0 ]]; then
     print_success "All tests passed! 🎉"
     print_info "Your library is ready for Go integration"
     print_info "✅ Main CVC library functions: PASSED"
     print_info "✅ ECP operations (public key addition): PASSED"
     print_info "✅ Hash-to-field operations: PASSED"
     print_info "✅ Add secret keys operations: PASSED"
+    print_info "✅ Derived key cache operations: PASSED"
+    print_info "✅ Submission queue operations: PASSED"
+    print_info "✅ Packed batch operations: PASSED"
+    print_info "✅ Ed25519 operations operations: PASSED"
+    print_info "✅ Hash to curve operations: PASSED"
+    print_info "✅ SHA-256 operations: PASSED"
+    print_info "✅ Validated public key set operations: PASSED"
+    print_info "✅ Concurrency stress tests: PASSED"
+    print_info "✅ Stack usage tests: PASSED"
+    print_info "✅ Key pool operations: PASSED"
+    print_info "✅ Key pair handle operations: PASSED"
+    print_info "✅ ECDH operations: PASSED"
+    print_info "✅ Point table operations: PASSED"
+    print_info "✅ ECDSA operations: PASSED"
+    print_info "✅ JWT operations: PASSED"
+    print_info "✅ SD-JWT operations: PASSED"
+    print_info "✅ Additive key derivation operations: PASSED"
+    print_info "✅ Generated base tables operations: PASSED"
+    print_info "✅ Key store operations: PASSED"
 else
     print_error "Some tests failed!"
     if [[ $MAIN_TEST_RESULT -ne 0 ]]; then
@@ -196,6 +595,120 @@ else
     else
         print_success "✅ Add secret keys tests: PASSED"
     fi
+
+    if [[ $KC_TEST_RESULT -ne 0 ]]; then
+        print_error "❌ Derived key cache tests: FAILED"
+    else
+        print_success "✅ Derived key cache tests: PASSED"
+    fi
+
+    if [[ $QUEUE_TEST_RESULT -ne 0 ]]; then
+        print_error "❌ Submission queue tests: FAILED"
+    else
+        print_success "✅ Submission queue tests: PASSED"
+    fi
+
+    if [[ $BATCH_TEST_RESULT -ne 0 ]]; then
+        print_error "❌ Packed batch tests: FAILED"
+    else
+        print_success "✅ Packed batch tests: PASSED"
+    fi
+
+    if [[ $ED25519_TEST_RESULT -ne 0 ]]; then
+        print_error "❌ Ed25519 operations tests: FAILED"
+    else
+        print_success "✅ Ed25519 operations tests: PASSED"
+    fi
+
+    if [[ $HTC_TEST_RESULT -ne 0 ]]; then
+        print_error "❌ Hash to curve tests: FAILED"
+    else
+        print_success "✅ Hash to curve tests: PASSED"
+    fi
+
+    if [[ $SHA256_TEST_RESULT -ne 0 ]]; then
+        print_error "❌ SHA-256 tests: FAILED"
+    else
+        print_success "✅ SHA-256 tests: PASSED"
+    fi
+
+    if [[ $PKS_TEST_RESULT -ne 0 ]]; then
+        print_error "❌ Validated public key set tests: FAILED"
+    else
+        print_success "✅ Validated public key set tests: PASSED"
+    fi
+
+    if [[ $CONC_TEST_RESULT -ne 0 ]]; then
+        print_error "❌ Concurrency stress tests: FAILED"
+    else
+        print_success "✅ Concurrency stress tests: PASSED"
+    fi
+
+    if [[ $STACK_TEST_RESULT -ne 0 ]]; then
+        print_error "❌ Stack usage tests: FAILED"
+    else
+        print_success "✅ Stack usage tests: PASSED"
+    fi
+
+    if [[ $KP_TEST_RESULT -ne 0 ]]; then
+        print_error "❌ Key pool tests: FAILED"
+    else
+        print_success "✅ Key pool tests: PASSED"
+    fi
+
+    if [[ $KPR_TEST_RESULT -ne 0 ]]; then
+        print_error "❌ Key pair handle tests: FAILED"
+    else
+        print_success "✅ Key pair handle tests: PASSED"
+    fi
+
+    if [[ $ECDH_TEST_RESULT -ne 0 ]]; then
+        print_error "❌ ECDH tests: FAILED"
+    else
+        print_success "✅ ECDH tests: PASSED"
+    fi
+
+    if [[ $PT_TEST_RESULT -ne 0 ]]; then
+        print_error "❌ Point table tests: FAILED"
+    else
+        print_success "✅ Point table tests: PASSED"
+    fi
+
+    if [[ $ECDSA_TEST_RESULT -ne 0 ]]; then
+        print_error "❌ ECDSA tests: FAILED"
+    else
+        print_success "✅ ECDSA tests: PASSED"
+    fi
+
+    if [[ $JWT_TEST_RESULT -ne 0 ]]; then
+        print_error "❌ JWT tests: FAILED"
+    else
+        print_success "✅ JWT tests: PASSED"
+    fi
+
+    if [[ $SD_JWT_TEST_RESULT -ne 0 ]]; then
+        print_error "❌ SD-JWT tests: FAILED"
+    else
+        print_success "✅ SD-JWT tests: PASSED"
+    fi
+
+    if [[ $PUBLIC_DERIVE_TEST_RESULT -ne 0 ]]; then
+        print_error "❌ Additive key derivation tests: FAILED"
+    else
+        print_success "✅ Additive key derivation tests: PASSED"
+    fi
+
+    if [[ $BASE_TABLES_TEST_RESULT -ne 0 ]]; then
+        print_error "❌ Generated base tables tests: FAILED"
+    else
+        print_success "✅ Generated base tables tests: PASSED"
+    fi
+
+    if [[ $KEY_STORE_TEST_RESULT -ne 0 ]]; then
+        print_error "❌ Key store tests: FAILED"
+    else
+        print_success "✅ Key store tests: PASSED"
+    fi
     
     print_info "Check the output above for details"
     exit 1
@@ -8,6 +8,8 @@
 #include "src/nist256_key_material.h"
 #include "core.h"
 
+#define ASK_SHARE_COUNT 24
+
 // Helper function to print hex bytes
 void print_hex_ask(const char* label, const unsigned char* data, int len)
 {
@@ -321,9 +323,73 @@ int main()
     }
     printf("   Status: %s\n\n", test8_success ? "✅ PASSED" : "❌ FAILED");
 
+    // Test 9: N-way sum matches chained pairwise addition
+    printf("9. Testing N-way secret key sum...\n");
+
+    unsigned char share_storage[ASK_SHARE_COUNT][32];
+    const unsigned char* share_ptrs[ASK_SHARE_COUNT];
+    for (int i = 0; i < ASK_SHARE_COUNT; i++)
+    {
+        unsigned char share_seed[32];
+        generate_random_seed_ask(share_seed, 32);
+        generate_valid_private_key(share_storage[i], share_seed, 32);
+        share_ptrs[i] = share_storage[i];
+    }
+
+    nist256_key_material_t chained, summed;
+    int test9_success = cvc_add_nist256_secret_keys(share_storage[0], 32, share_storage[1], 32, &chained) == CVC_ADD_SECRET_KEYS_SUCCESS;
+    for (int i = 2; i < ASK_SHARE_COUNT && test9_success; i++)
+    {
+        unsigned char running[32];
+        memcpy(running, chained.private_key_bytes, 32);
+        test9_success = cvc_add_nist256_secret_keys(running, 32, share_storage[i], 32, &chained) == CVC_ADD_SECRET_KEYS_SUCCESS;
+    }
+
+    const int test9a_result = cvc_sum_nist256_secret_keys(share_ptrs, ASK_SHARE_COUNT, &summed);
+    printf("   Sum result: %d\n", test9a_result);
+    test9_success = test9_success && (test9a_result == CVC_ADD_SECRET_KEYS_SUCCESS) && bytes_equal_ask(chained.private_key_bytes, summed.private_key_bytes, 32) &&
+                    bytes_equal_ask(chained.public_key_x_bytes, summed.public_key_x_bytes, 32) && bytes_equal_ask(chained.public_key_y_bytes, summed.public_key_y_bytes, 32);
+
+    // A zero share anywhere in the set is rejected
+    unsigned char zero_share[32] = { 0 };
+    share_ptrs[ASK_SHARE_COUNT / 2] = zero_share;
+    const int test9b_result = cvc_sum_nist256_secret_keys(share_ptrs, ASK_SHARE_COUNT, &summed);
+    share_ptrs[ASK_SHARE_COUNT / 2] = share_storage[ASK_SHARE_COUNT / 2];
+    const int test9c_result = cvc_sum_nist256_secret_keys(share_ptrs, 0, &summed);
+
+    printf("   Zero share result: %d\n", test9b_result);
+    test9_success = test9_success && (test9b_result == CVC_ADD_SECRET_KEYS_ERROR_INVALID_SHARE) && (test9c_result == CVC_ADD_SECRET_KEYS_ERROR_INVALID_PARAMS);
+    printf("   Status: %s\n\n", test9_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 10: Splitting a key and summing the shares returns the key
+    printf("10. Testing split and recombine...\n");
+
+    unsigned char split_seed[32];
+    unsigned char split_shares[ASK_SHARE_COUNT * 32];
+    generate_random_seed_ask(split_seed, 32);
+
+    const int test10a_result = cvc_split_nist256_secret_key(key1, 32, split_seed, 32, ASK_SHARE_COUNT, split_shares);
+    printf("   Split result: %d\n", test10a_result);
+
+    int test10_success = (test10a_result == CVC_ADD_SECRET_KEYS_SUCCESS);
+    if (test10_success)
+    {
+        for (int i = 0; i < ASK_SHARE_COUNT; i++)
+        {
+            share_ptrs[i] = split_shares + 32 * i;
+        }
+        nist256_key_material_t recombined;
+        test10_success = cvc_sum_nist256_secret_keys(share_ptrs, ASK_SHARE_COUNT, &recombined) == CVC_ADD_SECRET_KEYS_SUCCESS && bytes_equal_ask(recombined.private_key_bytes, key1, 32);
+    }
+
+    const int test10b_result = cvc_split_nist256_secret_key(key1, 32, split_seed, 32, 1, split_shares);
+    const int test10c_result = cvc_split_nist256_secret_key(zero_share, 32, split_seed, 32, 4, split_shares);
+    test10_success = test10_success && (test10b_result == CVC_ADD_SECRET_KEYS_ERROR_INVALID_PARAMS) && (test10c_result == CVC_ADD_SECRET_KEYS_ERROR_INVALID_KEY1);
+    printf("   Status: %s\n\n", test10_success ? "✅ PASSED" : "❌ FAILED");
+
     // Summary
     printf("=== Add Secret Keys Test Summary ===\n");
-    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success && test5_success && test6_success && test7_success && test8_success;
+    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success && test5_success && test6_success && test7_success && test8_success && test9_success && test10_success;
 
     if (all_tests_passed)
     {
@@ -336,6 +402,8 @@ int main()
         printf("✅ Commutative property: PASSED\n");
         printf("✅ Self-addition: PASSED\n");
         printf("✅ Different inputs produce different outputs: PASSED\n");
+        printf("✅ N-way secret key sum: PASSED\n");
+        printf("✅ Split and recombine: PASSED\n");
         return 0;
     }
     else
@@ -349,6 +417,8 @@ int main()
         printf("%s Commutative property: %s\n", test6_success ? "✅" : "❌", test6_success ? "PASSED" : "FAILED");
         printf("%s Self-addition: %s\n", test7_success ? "✅" : "❌", test7_success ? "PASSED" : "FAILED");
         printf("%s Different inputs produce different outputs: %s\n", test8_success ? "✅" : "❌", test8_success ? "PASSED" : "FAILED");
+        printf("%s N-way secret key sum: %s\n", test9_success ? "✅" : "❌", test9_success ? "PASSED" : "FAILED");
+        printf("%s Split and recombine: %s\n", test10_success ? "✅" : "❌", test10_success ? "PASSED" : "FAILED");
         return 1;
     }
 }
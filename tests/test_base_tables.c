@@ -0,0 +1,146 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/nist256_base_tables.h"
+#include "src/point_table.h"
+
+// External ROM constants
+extern const BIG_256_56 CURVE_Order_NIST256;
+
+#define BASE_TABLE_SCALARS 64
+
+// Generate some random seed data
+void generate_random_seed_bt(unsigned char* seed, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        seed[i] = (unsigned char)(rand() & 0xFF);
+    }
+}
+
+// Same point, and stored the way the tables promise: affine and fully reduced
+int matches_entry_bt(const ECP_NIST256* entry, ECP_NIST256* expected)
+{
+    ECP_NIST256 copy;
+    ECP_NIST256_copy(&copy, (ECP_NIST256*)entry);
+
+    FP_NIST256 one;
+    FP_NIST256_one(&one);
+    return ECP_NIST256_equals(&copy, expected) && FP_NIST256_equals(&copy.z, &one) && entry->x.XES == 1 && entry->y.XES == 1 && entry->z.XES == 1;
+}
+
+int main()
+{
+    printf("=== Generated Base Tables Test ===\n\n");
+    srand((unsigned int)time(NULL));
+
+    ECP_NIST256 generator;
+    ECP_NIST256_generator(&generator);
+
+    // Test 1: Comb rows match MIRACL's arithmetic
+    printf("1. Testing the signed-window rows...\n");
+
+    int test1_success = 1;
+    ECP_NIST256 base, expected;
+    ECP_NIST256_copy(&base, &generator);
+    for (int i = 0; i < NIST256_SIGNED_WINDOWS && test1_success; i++)
+    {
+        ECP_NIST256_copy(&expected, &base);
+        for (int j = 0; j < NIST256_WINDOW_ENTRIES && test1_success; j++)
+        {
+            if (j > 0)
+            {
+                ECP_NIST256_add(&expected, &base);
+            }
+            test1_success = matches_entry_bt(&nist256_base_rows[i][j], &expected);
+            if (!test1_success)
+            {
+                printf("   Mismatch at row %d, entry %d\n", i, j);
+            }
+        }
+
+        for (int k = 0; k < 4; k++)
+        {
+            ECP_NIST256_dbl(&base);
+        }
+    }
+    printf("   Table size: %zu bytes\n", sizeof(nist256_base_rows));
+    printf("   Status: %s\n\n", test1_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 2: ECDSA odd multiples match MIRACL's arithmetic
+    printf("2. Testing the odd multiples of G...\n");
+
+    int test2_success = 1;
+    ECP_NIST256 twice;
+    ECP_NIST256_copy(&twice, &generator);
+    ECP_NIST256_dbl(&twice);
+    ECP_NIST256_copy(&expected, &generator);
+    for (int i = 0; i < NIST256_GENERATOR_ODD_MULTIPLES && test2_success; i++)
+    {
+        if (i > 0)
+        {
+            ECP_NIST256_add(&expected, &twice);
+        }
+        test2_success = matches_entry_bt(&nist256_generator_odd_multiples[i], &expected);
+        if (!test2_success)
+        {
+            printf("   Mismatch at %d * G\n", 2 * i + 1);
+        }
+    }
+    printf("   Table size: %zu bytes\n", sizeof(nist256_generator_odd_multiples));
+    printf("   Status: %s\n\n", test2_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 3: Fixed-base multiplication through the tables matches variable-base multiplication
+    printf("3. Testing nist256_mul_base against ECP_NIST256_mul...\n");
+
+    int test3_success = 1;
+    BIG_256_56 curve_order;
+    BIG_256_56_rcopy(curve_order, CURVE_Order_NIST256);
+    for (int i = 0; i < BASE_TABLE_SCALARS + 2 && test3_success; i++)
+    {
+        BIG_256_56 d;
+        if (i == 0)
+        {
+            BIG_256_56_one(d);
+        }
+        else if (i == 1)
+        {
+            // n - 1 exercises the top windows and gives -G
+            BIG_256_56_copy(d, curve_order);
+            BIG_256_56_dec(d, 1);
+        }
+        else
+        {
+            unsigned char seed[32];
+            generate_random_seed_bt(seed, sizeof(seed));
+            BIG_256_56_fromBytes(d, (char*)seed);
+            BIG_256_56_mod(d, curve_order);
+        }
+
+        ECP_NIST256 actual;
+        nist256_mul_base(&actual, d);
+        ECP_NIST256_copy(&expected, &generator);
+        ECP_NIST256_mul(&expected, d);
+        test3_success = ECP_NIST256_equals(&actual, &expected);
+    }
+    printf("   Status: %s\n\n", test3_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Summary
+    printf("=== Generated Base Tables Test Summary ===\n");
+    const int all_tests_passed = test1_success && test2_success && test3_success;
+
+    if (all_tests_passed)
+    {
+        printf("🎉 All generated base table tests PASSED!\n");
+        return 0;
+    }
+    else
+    {
+        printf("💥 Some generated base table tests FAILED! Check the output above for details.\n");
+        return 1;
+    }
+}
@@ -0,0 +1,203 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/batch.h"
+#include "src/add_secret_keys.h"
+#include "src/ecp_operations.h"
+#include "src/hash_to_field.h"
+#include "src/nist256_key_material.h"
+
+#define BATCH_TEST_RECORDS 6
+
+// Generate some random seed data
+void generate_random_seed_b(unsigned char* seed, int len)
+{
+    // Simple pseudo-random for testing (not cryptographically secure for production)
+    static int seeded = 0;
+    if (!seeded)
+    {
+        srand((unsigned int)time(NULL));
+        seeded = 1;
+    }
+    for (int i = 0; i < len; i++)
+    {
+        seed[i] = (unsigned char)(rand() & 0xFF);
+    }
+}
+
+// Fill one request record
+void pack_request_b(unsigned char* record, int opcode, const unsigned char* a, int len_a, const unsigned char* b, int len_b)
+{
+    memset(record, 0, CVC_BATCH_REQUEST_SIZE);
+    record[CVC_BATCH_REQUEST_OPCODE] = (unsigned char)opcode;
+    record[CVC_BATCH_REQUEST_LEN_A] = (unsigned char)len_a;
+    record[CVC_BATCH_REQUEST_LEN_B] = (unsigned char)len_b;
+    if (len_a > 0)
+    {
+        memcpy(record + CVC_BATCH_REQUEST_OPERAND_A, a, len_a);
+    }
+    if (len_b > 0)
+    {
+        memcpy(record + CVC_BATCH_REQUEST_OPERAND_B, b, len_b);
+    }
+}
+
+// Check that a response record carries the given key material
+int response_has_key_material_b(const unsigned char* response, const nist256_key_material_t* key_material)
+{
+    const unsigned char* output = response + CVC_BATCH_RESPONSE_OUTPUT;
+    return response[CVC_BATCH_RESPONSE_STATUS] == 0 && response[CVC_BATCH_RESPONSE_LENGTH] == 96 && memcmp(output, key_material->private_key_bytes, 32) == 0 && memcmp(output + 32, key_material->public_key_x_bytes, 32) == 0
+        && memcmp(output + 64, key_material->public_key_y_bytes, 32) == 0;
+}
+
+int main()
+{
+    printf("=== Packed Batch ABI Test ===\n\n");
+
+    unsigned char master_key[32];
+    unsigned char seed1[32], seed2[32];
+    generate_random_seed_b(master_key, 32);
+    generate_random_seed_b(seed1, 32);
+    generate_random_seed_b(seed2, 32);
+    seed2[0] = ~seed1[0];
+    const unsigned char context[] = "batch_context";
+    const unsigned char dst[] = "CVC_DERIVE_KEY";
+
+    nist256_key_material_t key1, key2;
+    nist256_generate_key_material(seed1, 32, &key1);
+    nist256_generate_key_material(seed2, 32, &key2);
+
+    unsigned char public1[65], public2[65];
+    public1[0] = public2[0] = 0x04;
+    memcpy(public1 + 1, key1.public_key_x_bytes, 32);
+    memcpy(public1 + 33, key1.public_key_y_bytes, 32);
+    memcpy(public2 + 1, key2.public_key_x_bytes, 32);
+    memcpy(public2 + 33, key2.public_key_y_bytes, 32);
+
+    // One record of every opcode plus two invalid ones
+    unsigned char requests[BATCH_TEST_RECORDS * CVC_BATCH_REQUEST_SIZE];
+    pack_request_b(requests + 0 * CVC_BATCH_REQUEST_SIZE, CVC_BATCH_OP_DERIVE, master_key, 32, context, sizeof(context) - 1);
+    pack_request_b(requests + 1 * CVC_BATCH_REQUEST_SIZE, CVC_BATCH_OP_ADD_PUBLIC, public1, 65, public2, 65);
+    pack_request_b(requests + 2 * CVC_BATCH_REQUEST_SIZE, CVC_BATCH_OP_ADD_SECRET, key1.private_key_bytes, 32, key2.private_key_bytes, 32);
+    pack_request_b(requests + 3 * CVC_BATCH_REQUEST_SIZE, CVC_BATCH_OP_KEYGEN, seed1, 32, NULL, 0);
+    pack_request_b(requests + 4 * CVC_BATCH_REQUEST_SIZE, 0x7F, NULL, 0, NULL, 0);
+    pack_request_b(requests + 5 * CVC_BATCH_REQUEST_SIZE, CVC_BATCH_OP_ADD_SECRET, key1.private_key_bytes, 31, key2.private_key_bytes, 32);
+
+    unsigned char responses[BATCH_TEST_RECORDS * CVC_BATCH_RESPONSE_SIZE];
+
+    // Test 1: Invalid parameters
+    printf("1. Testing invalid parameters...\n");
+
+    const int test1a_result = cvc_batch_execute(NULL, 1, dst, sizeof(dst) - 1, responses, sizeof(responses));
+    const int test1b_result = cvc_batch_execute(requests, 0, dst, sizeof(dst) - 1, responses, sizeof(responses));
+    const int test1c_result = cvc_batch_execute(requests, BATCH_TEST_RECORDS, dst, sizeof(dst) - 1, responses, sizeof(responses) - 1);
+
+    printf("   NULL requests result: %d\n", test1a_result);
+    printf("   Zero count result: %d\n", test1b_result);
+    printf("   Short response buffer result: %d\n", test1c_result);
+
+    const int test1_success = (test1a_result == CVC_BATCH_ERROR_INVALID_PARAMS) && (test1b_result == CVC_BATCH_ERROR_INVALID_PARAMS) && (test1c_result == CVC_BATCH_ERROR_BUFFER_TOO_SMALL);
+    printf("   Status: %s\n\n", test1_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 2: Mixed batch in a single call
+    printf("2. Testing mixed batch execution...\n");
+
+    const int batch_result = cvc_batch_execute(requests, BATCH_TEST_RECORDS, dst, sizeof(dst) - 1, responses, sizeof(responses));
+    printf("   Successful records: %d of %d\n", batch_result, BATCH_TEST_RECORDS);
+
+    const int test2_success = (batch_result == 4);
+    printf("   Status: %s\n\n", test2_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 3: Each successful record matches the single-item API
+    printf("3. Testing records match single-item calls...\n");
+
+    nist256_key_material_t expected_derive, expected_secret, expected_keygen;
+    unsigned char expected_public[65];
+    int expected_public_len = 0;
+    cvc_derive_secret_key_nist256(master_key, 32, context, sizeof(context) - 1, dst, sizeof(dst) - 1, &expected_derive);
+    cvc_add_nist256_public_keys(public1, 65, public2, 65, expected_public, 65, &expected_public_len);
+    cvc_add_nist256_secret_keys(key1.private_key_bytes, 32, key2.private_key_bytes, 32, &expected_secret);
+    nist256_generate_key_material(seed1, 32, &expected_keygen);
+
+    const unsigned char* public_response = responses + 1 * CVC_BATCH_RESPONSE_SIZE;
+    const int derive_ok = response_has_key_material_b(responses + 0 * CVC_BATCH_RESPONSE_SIZE, &expected_derive);
+    const int public_ok = public_response[CVC_BATCH_RESPONSE_STATUS] == 0 && public_response[CVC_BATCH_RESPONSE_LENGTH] == 65 && memcmp(public_response + CVC_BATCH_RESPONSE_OUTPUT, expected_public, 65) == 0;
+    const int secret_ok = response_has_key_material_b(responses + 2 * CVC_BATCH_RESPONSE_SIZE, &expected_secret);
+    const int keygen_ok = response_has_key_material_b(responses + 3 * CVC_BATCH_RESPONSE_SIZE, &expected_keygen);
+
+    printf("   Derive: %s, add public: %s, add secret: %s, keygen: %s\n", derive_ok ? "OK" : "MISMATCH", public_ok ? "OK" : "MISMATCH", secret_ok ? "OK" : "MISMATCH", keygen_ok ? "OK" : "MISMATCH");
+
+    const int test3_success = derive_ok && public_ok && secret_ok && keygen_ok;
+    printf("   Status: %s\n\n", test3_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 4: Failing records report per-record status and carry no output
+    printf("4. Testing per-record error status...\n");
+
+    const unsigned char* opcode_response = responses + 4 * CVC_BATCH_RESPONSE_SIZE;
+    const unsigned char* length_response = responses + 5 * CVC_BATCH_RESPONSE_SIZE;
+    const int opcode_status = (signed char)opcode_response[CVC_BATCH_RESPONSE_STATUS];
+    const int length_status = (signed char)length_response[CVC_BATCH_RESPONSE_STATUS];
+    printf("   Unknown opcode status: %d\n", opcode_status);
+    printf("   Short secret key status: %d\n", length_status);
+
+    unsigned char zero_output[CVC_BATCH_OUTPUT_SIZE] = { 0 };
+    const int test4_success = (opcode_status == CVC_BATCH_ERROR_INVALID_OPCODE) && (length_status == CVC_ADD_SECRET_KEYS_ERROR_INVALID_PARAMS) && opcode_response[CVC_BATCH_RESPONSE_OPCODE] == 0x7F
+        && memcmp(length_response + CVC_BATCH_RESPONSE_OUTPUT, zero_output, sizeof(zero_output)) == 0 && length_response[CVC_BATCH_RESPONSE_LENGTH] == 0;
+    printf("   Status: %s\n\n", test4_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 5: Batch-level operand errors are distinct from per-operation results
+    printf("5. Testing batch and operation status codes are distinct...\n");
+
+    // 1 + (n - 1) = 0 mod n is a well-formed record whose operation fails
+    unsigned char one[32] = { 0 };
+    one[31] = 1;
+    static const unsigned char order_minus_one[32] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x50 };
+
+    unsigned char status_requests[5 * CVC_BATCH_REQUEST_SIZE];
+    unsigned char status_responses[5 * CVC_BATCH_RESPONSE_SIZE];
+    for (int i = 0; i < 5; i++)
+    {
+        pack_request_b(status_requests + i * CVC_BATCH_REQUEST_SIZE, CVC_BATCH_OP_ADD_SECRET, one, 32, order_minus_one, 32);
+    }
+    status_requests[1 * CVC_BATCH_REQUEST_SIZE + CVC_BATCH_REQUEST_LEN_A] = CVC_BATCH_OPERAND_SIZE + 1;
+
+    // Reserved byte, padding and a byte past len_b must all be zero
+    status_requests[2 * CVC_BATCH_REQUEST_SIZE + CVC_BATCH_REQUEST_RESERVED] = 0x01;
+    status_requests[3 * CVC_BATCH_REQUEST_SIZE + CVC_BATCH_REQUEST_SIZE - 1] = 0x01;
+    status_requests[4 * CVC_BATCH_REQUEST_SIZE + CVC_BATCH_REQUEST_OPERAND_B + 32] = 0x01;
+
+    const int status_batch_result = cvc_batch_execute(status_requests, 5, dst, sizeof(dst) - 1, status_responses, sizeof(status_responses));
+    const int zero_sum_status = (signed char)status_responses[CVC_BATCH_RESPONSE_STATUS];
+    const int operand_status = (signed char)status_responses[CVC_BATCH_RESPONSE_SIZE + CVC_BATCH_RESPONSE_STATUS];
+    printf("   Zero sum status: %d\n", zero_sum_status);
+    printf("   Oversized operand status: %d\n", operand_status);
+
+    int reserved_rejected = 1;
+    for (int i = 2; i < 5; i++)
+    {
+        reserved_rejected = reserved_rejected && (signed char)status_responses[i * CVC_BATCH_RESPONSE_SIZE + CVC_BATCH_RESPONSE_STATUS] == CVC_BATCH_ERROR_NONZERO_RESERVED;
+    }
+    printf("   Non-zero reserved bytes rejected: %s\n", reserved_rejected ? "YES" : "NO");
+
+    const int test5_success = status_batch_result == 0 && zero_sum_status == CVC_ADD_SECRET_KEYS_ERROR_RESULT_ZERO && operand_status == CVC_BATCH_ERROR_INVALID_OPERAND && zero_sum_status != operand_status && reserved_rejected;
+    printf("   Status: %s\n\n", test5_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Summary
+    printf("=== Packed Batch ABI Test Summary ===\n");
+    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success && test5_success;
+
+    if (all_tests_passed)
+    {
+        printf("🎉 All packed batch tests PASSED!\n");
+        return 0;
+    }
+    else
+    {
+        printf("💥 Some packed batch tests FAILED! Check the output above for details.\n");
+        return 1;
+    }
+}
@@ -0,0 +1,291 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+// Stress test: many threads drive the shared caches and batch paths at once and every
+// result is compared against one computed single-threaded up front.
+//
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/add_secret_keys.h"
+#include "src/ecp_operations.h"
+#include "src/hash_to_curve.h"
+#include "src/hash_to_field.h"
+#include "src/key_cache.h"
+#include "src/public_key_set.h"
+#include "src/sha256.h"
+
+#define CONC_THREADS 8
+#define CONC_ROUNDS 40
+#define CONC_CONTEXTS 48
+#define CONC_KEYS 16
+
+static const unsigned char master_key_conc[32] = { 0xc0, 0xff, 0xee, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29 };
+static const unsigned char dst_conc[] = "CVC_CONCURRENCY_TEST";
+
+static unsigned char contexts_conc[CONC_CONTEXTS][16];
+static const unsigned char* context_ptrs_conc[CONC_CONTEXTS];
+static int context_lens_conc[CONC_CONTEXTS];
+static unsigned char public_keys_conc[CONC_KEYS][65];
+static const unsigned char* public_key_ptrs_conc[CONC_KEYS];
+
+// Expected results, computed before any thread starts
+static unsigned char expected_private_conc[CONC_CONTEXTS][32];
+static unsigned char expected_pair_sum_conc[CONC_KEYS][65];
+static unsigned char expected_total_conc[65];
+static unsigned char expected_points_conc[CONC_CONTEXTS][65];
+static unsigned char expected_xmd_conc[CONC_CONTEXTS][48];
+
+static cvc_key_cache_t* shared_cache_conc;
+static cvc_public_key_set_t* shared_set_conc;
+static atomic_int start_flag_conc;
+
+typedef struct
+{
+    int thread_index;
+    int derive_failures;
+    int add_failures;
+    int sum_failures;
+    int curve_failures;
+    int xmd_failures;
+} conc_worker_t;
+
+// Generate some random seed data
+void generate_random_seed_conc(unsigned char* seed, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        seed[i] = (unsigned char)(rand() & 0xFF);
+    }
+}
+
+void point_to_bytes_conc(ECP_NIST256* point, unsigned char* bytes)
+{
+    octet out = { 0, 65, (char*)bytes };
+    ECP_NIST256_toOctet(&out, point, false);
+}
+
+int setup_conc(void)
+{
+    for (int i = 0; i < CONC_CONTEXTS; i++)
+    {
+        context_lens_conc[i] = snprintf((char*)contexts_conc[i], sizeof(contexts_conc[i]), "user-%d", i * 37);
+        context_ptrs_conc[i] = contexts_conc[i];
+
+        nist256_key_material_t key;
+        if (cvc_derive_secret_key_nist256(master_key_conc, 32, contexts_conc[i], context_lens_conc[i], dst_conc, sizeof(dst_conc) - 1, &key) != 0)
+        {
+            return -1;
+        }
+        memcpy(expected_private_conc[i], key.private_key_bytes, 32);
+
+        ECP_NIST256 point;
+        if (cvc_hash_to_curve_nist256(dst_conc, sizeof(dst_conc) - 1, contexts_conc[i], context_lens_conc[i], &point) != 0)
+        {
+            return -1;
+        }
+        point_to_bytes_conc(&point, expected_points_conc[i]);
+
+        if (cvc_expand_message_xmd_sha256_batch(dst_conc, sizeof(dst_conc) - 1, &context_ptrs_conc[i], &context_lens_conc[i], 1, expected_xmd_conc[i], 48) != 0)
+        {
+            return -1;
+        }
+    }
+
+    for (int i = 0; i < CONC_KEYS; i++)
+    {
+        unsigned char seed[32];
+        generate_random_seed_conc(seed, sizeof(seed));
+        nist256_key_material_t key;
+        if (nist256_generate_key_material(seed, sizeof(seed), &key) != 0)
+        {
+            return -1;
+        }
+        public_keys_conc[i][0] = 0x04;
+        memcpy(&public_keys_conc[i][1], key.public_key_x_bytes, 32);
+        memcpy(&public_keys_conc[i][33], key.public_key_y_bytes, 32);
+        public_key_ptrs_conc[i] = public_keys_conc[i];
+    }
+
+    int result_len = 0;
+    for (int i = 0; i < CONC_KEYS; i++)
+    {
+        if (cvc_add_nist256_public_keys(public_keys_conc[i], 65, public_keys_conc[(i + 1) % CONC_KEYS], 65, expected_pair_sum_conc[i], 65, &result_len) != CVC_ECP_SUCCESS)
+        {
+            return -1;
+        }
+    }
+    if (cvc_sum_nist256_public_keys(NULL, public_key_ptrs_conc, CONC_KEYS, expected_total_conc, 65, &result_len) != CVC_ECP_SUCCESS)
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+// Each thread walks the inputs in its own order so threads collide on different entries
+void* stress_worker_conc(void* arg)
+{
+    conc_worker_t* worker = (conc_worker_t*)arg;
+    ECP_NIST256 points[CONC_CONTEXTS];
+    unsigned char okm[CONC_CONTEXTS * 48];
+
+    while (!atomic_load(&start_flag_conc))
+    {
+    }
+
+    for (int round = 0; round < CONC_ROUNDS; round++)
+    {
+        const int offset = (worker->thread_index * 7 + round * 13) % CONC_CONTEXTS;
+        unsigned char result[65];
+        int result_len = 0;
+
+        // Derivation through the shared cache, alternating with the uncached path
+        for (int i = 0; i < CONC_CONTEXTS; i += 3)
+        {
+            const int slot = (offset + i) % CONC_CONTEXTS;
+            nist256_key_material_t key;
+            int rc = (round + i) & 1 ? cvc_derive_secret_key_nist256_cached(shared_cache_conc, master_key_conc, 32, contexts_conc[slot], context_lens_conc[slot], dst_conc, sizeof(dst_conc) - 1, &key)
+                                     : cvc_derive_secret_key_nist256(master_key_conc, 32, contexts_conc[slot], context_lens_conc[slot], dst_conc, sizeof(dst_conc) - 1, &key);
+            if (rc != 0 || memcmp(key.private_key_bytes, expected_private_conc[slot], 32) != 0)
+            {
+                worker->derive_failures++;
+            }
+        }
+
+        // Pairwise additions and the full sum through the shared public key set
+        const int pair = (offset + round) % CONC_KEYS;
+        if (cvc_add_nist256_public_keys_cached(shared_set_conc, public_keys_conc[pair], 65, public_keys_conc[(pair + 1) % CONC_KEYS], 65, result, sizeof(result), &result_len) != CVC_ECP_SUCCESS ||
+            memcmp(result, expected_pair_sum_conc[pair], 65) != 0)
+        {
+            worker->add_failures++;
+        }
+        if (cvc_sum_nist256_public_keys(shared_set_conc, public_key_ptrs_conc, CONC_KEYS, result, sizeof(result), &result_len) != CVC_ECP_SUCCESS || memcmp(result, expected_total_conc, 65) != 0)
+        {
+            worker->sum_failures++;
+        }
+
+        // Batch paths, which use the multi-buffer SHA-256 kernels, on a rotated window
+        const int count = CONC_CONTEXTS - offset;
+        if (cvc_hash_to_curve_nist256_batch(dst_conc, sizeof(dst_conc) - 1, &context_ptrs_conc[offset], &context_lens_conc[offset], count, points) != 0)
+        {
+            worker->curve_failures++;
+        }
+        else
+        {
+            for (int i = 0; i < count; i++)
+            {
+                point_to_bytes_conc(&points[i], result);
+                if (memcmp(result, expected_points_conc[offset + i], 65) != 0)
+                {
+                    worker->curve_failures++;
+                    break;
+                }
+            }
+        }
+
+        if (cvc_expand_message_xmd_sha256_batch(dst_conc, sizeof(dst_conc) - 1, &context_ptrs_conc[offset], &context_lens_conc[offset], count, okm, 48) != 0)
+        {
+            worker->xmd_failures++;
+        }
+        else
+        {
+            for (int i = 0; i < count; i++)
+            {
+                if (memcmp(okm + i * 48, expected_xmd_conc[offset + i], 48) != 0)
+                {
+                    worker->xmd_failures++;
+                    break;
+                }
+            }
+        }
+    }
+    return NULL;
+}
+
+int main()
+{
+    printf("=== Concurrency Stress Test ===\n\n");
+    srand((unsigned int)time(NULL));
+
+    // Test 1: Expected results and shared state
+    printf("1. Testing single-threaded setup...\n");
+
+    unsigned char hash_key[32];
+    generate_random_seed_conc(hash_key, sizeof(hash_key));
+
+    // Small capacities so threads also race on evictions, not only on lookups
+    cvc_key_cache_config_t cache_config = { CONC_CONTEXTS / 4, 0, 2, 1 };
+    cvc_public_key_set_config_t set_config = { CONC_KEYS / 2, 2 };
+
+    const int test1_success = setup_conc() == 0 && cvc_key_cache_create(&cache_config, hash_key, sizeof(hash_key), &shared_cache_conc) == CVC_KEY_CACHE_SUCCESS &&
+                              cvc_public_key_set_create(&set_config, hash_key, sizeof(hash_key), &shared_set_conc) == CVC_PUBLIC_KEY_SET_SUCCESS;
+    printf("   Status: %s\n\n", test1_success ? "✅ PASSED" : "❌ FAILED");
+    if (!test1_success)
+    {
+        return 1;
+    }
+
+    // Test 2: All threads start together and check every result
+    printf("2. Testing %d threads x %d rounds of mixed operations...\n", CONC_THREADS, CONC_ROUNDS);
+
+    pthread_t threads[CONC_THREADS];
+    conc_worker_t workers[CONC_THREADS];
+    atomic_store(&start_flag_conc, 0);
+    for (int i = 0; i < CONC_THREADS; i++)
+    {
+        memset(&workers[i], 0, sizeof(workers[i]));
+        workers[i].thread_index = i;
+        pthread_create(&threads[i], NULL, stress_worker_conc, &workers[i]);
+    }
+    atomic_store(&start_flag_conc, 1);
+
+    conc_worker_t total = { 0 };
+    for (int i = 0; i < CONC_THREADS; i++)
+    {
+        pthread_join(threads[i], NULL);
+        total.derive_failures += workers[i].derive_failures;
+        total.add_failures += workers[i].add_failures;
+        total.sum_failures += workers[i].sum_failures;
+        total.curve_failures += workers[i].curve_failures;
+        total.xmd_failures += workers[i].xmd_failures;
+    }
+
+    printf("   Failures - derive: %d, add: %d, sum: %d, hash_to_curve: %d, xmd: %d\n", total.derive_failures, total.add_failures, total.sum_failures, total.curve_failures, total.xmd_failures);
+    const int test2_success = total.derive_failures == 0 && total.add_failures == 0 && total.sum_failures == 0 && total.curve_failures == 0 && total.xmd_failures == 0;
+    printf("   Status: %s\n\n", test2_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 3: Shared caches were actually contended and stayed within bounds
+    printf("3. Testing shared cache bookkeeping...\n");
+
+    cvc_key_cache_stats_t cache_stats;
+    cvc_public_key_set_stats_t set_stats;
+    cvc_key_cache_get_stats(shared_cache_conc, &cache_stats);
+    cvc_public_key_set_get_stats(shared_set_conc, &set_stats);
+    printf("   Key cache hits: %llu, misses: %llu, evictions: %llu\n", (unsigned long long)cache_stats.hits, (unsigned long long)cache_stats.misses, (unsigned long long)cache_stats.evictions);
+    printf("   Key set hits: %llu, misses: %llu, entries: %llu / %llu\n", (unsigned long long)set_stats.hits, (unsigned long long)set_stats.misses, (unsigned long long)set_stats.entries, (unsigned long long)set_stats.capacity);
+
+    const int test3_success = cache_stats.hits + cache_stats.misses > 0 && cache_stats.evictions > 0 && set_stats.entries <= set_stats.capacity && set_stats.hits + set_stats.misses > 0;
+    printf("   Status: %s\n\n", test3_success ? "✅ PASSED" : "❌ FAILED");
+
+    cvc_key_cache_destroy(shared_cache_conc);
+    cvc_public_key_set_destroy(shared_set_conc);
+
+    // Summary
+    printf("=== Concurrency Stress Test Summary ===\n");
+    const int all_tests_passed = test1_success && test2_success && test3_success;
+
+    if (all_tests_passed)
+    {
+        printf("🎉 All concurrency stress tests PASSED!\n");
+        return 0;
+    }
+    else
+    {
+        printf("💥 Some concurrency stress tests FAILED! Check the output above for details.\n");
+        return 1;
+    }
+}
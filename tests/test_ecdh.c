@@ -0,0 +1,183 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/ecdh.h"
+#include "src/keypair.h"
+#include "src/nist256_key_material.h"
+
+#define ECDH_PEERS 100
+
+static nist256_key_material_t peers_ecdh[ECDH_PEERS];
+static unsigned char peer_keys_ecdh[ECDH_PEERS][65];
+static const unsigned char* peer_ptrs_ecdh[ECDH_PEERS];
+static unsigned char expected_ecdh[ECDH_PEERS][32];
+static unsigned char batch_out_ecdh[ECDH_PEERS][32];
+static int results_ecdh[ECDH_PEERS];
+
+// Generate some random seed data
+void generate_random_seed_ecdh(unsigned char* seed, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        seed[i] = (unsigned char)(rand() & 0xFF);
+    }
+}
+
+// Print hex bytes for debugging
+void print_hex_ecdh(const char* label, const unsigned char* data, int len)
+{
+    printf("   %s: ", label);
+    for (int i = 0; i < len; i++)
+    {
+        printf("%02x", data[i]);
+    }
+    printf("\n");
+}
+
+int main()
+{
+    printf("=== ECDH Test ===\n\n");
+    srand((unsigned int)time(NULL));
+
+    unsigned char seed[32];
+    nist256_key_material_t server;
+    generate_random_seed_ecdh(seed, sizeof(seed));
+    nist256_generate_key_material(seed, sizeof(seed), &server);
+    unsigned char server_public[65];
+    server_public[0] = 0x04;
+    memcpy(server_public + 1, server.public_key_x_bytes, 32);
+    memcpy(server_public + 33, server.public_key_y_bytes, 32);
+
+    for (int i = 0; i < ECDH_PEERS; i++)
+    {
+        generate_random_seed_ecdh(seed, sizeof(seed));
+        nist256_generate_key_material(seed, sizeof(seed), &peers_ecdh[i]);
+        peer_keys_ecdh[i][0] = 0x04;
+        memcpy(peer_keys_ecdh[i] + 1, peers_ecdh[i].public_key_x_bytes, 32);
+        memcpy(peer_keys_ecdh[i] + 33, peers_ecdh[i].public_key_y_bytes, 32);
+        peer_ptrs_ecdh[i] = peer_keys_ecdh[i];
+    }
+
+    // Test 1: Single ECDH agrees from both sides and with the key pair handle
+    printf("1. Testing single ECDH...\n");
+
+    unsigned char shared_server[32], shared_peer[32], shared_handle[32];
+    int test1_success = cvc_ecdh_nist256(server.private_key_bytes, 32, NULL, peer_keys_ecdh[0], 65, shared_server, sizeof(shared_server)) == CVC_ECDH_SUCCESS;
+    test1_success = test1_success && cvc_ecdh_nist256(peers_ecdh[0].private_key_bytes, 32, NULL, server_public, 65, shared_peer, sizeof(shared_peer)) == CVC_ECDH_SUCCESS;
+    test1_success = test1_success && memcmp(shared_server, shared_peer, 32) == 0;
+
+    cvc_nist256_keypair_t* handle = NULL;
+    test1_success = test1_success && cvc_nist256_keypair_from_secret(server.private_key_bytes, 32, 0, &handle) == CVC_KEYPAIR_SUCCESS;
+    test1_success = test1_success && cvc_nist256_keypair_ecdh(handle, NULL, peer_keys_ecdh[0], 65, shared_handle, sizeof(shared_handle)) == CVC_KEYPAIR_SUCCESS;
+    test1_success = test1_success && memcmp(shared_server, shared_handle, 32) == 0;
+    cvc_nist256_keypair_destroy(handle);
+
+    print_hex_ecdh("Shared secret", shared_server, 32);
+    printf("   Status: %s\n\n", test1_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 2: Batch results match the peer side of each agreement, on one and several threads
+    printf("2. Testing batch ECDH against %d peers...\n", ECDH_PEERS);
+
+    int test2_success = 1;
+    for (int i = 0; i < ECDH_PEERS && test2_success; i++)
+    {
+        test2_success = cvc_ecdh_nist256(peers_ecdh[i].private_key_bytes, 32, NULL, server_public, 65, expected_ecdh[i], 32) == CVC_ECDH_SUCCESS;
+    }
+
+    const int thread_counts[] = { 1, 3, 8 };
+    for (int t = 0; t < 3 && test2_success; t++)
+    {
+        memset(batch_out_ecdh, 0xEE, sizeof(batch_out_ecdh));
+        const clock_t start = clock();
+        const int result = cvc_ecdh_nist256_batch(server.private_key_bytes, 32, NULL, peer_ptrs_ecdh, ECDH_PEERS, thread_counts[t], &batch_out_ecdh[0][0], results_ecdh);
+        const double ms = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+        test2_success = result == CVC_ECDH_SUCCESS && memcmp(batch_out_ecdh, expected_ecdh, sizeof(expected_ecdh)) == 0;
+        for (int i = 0; i < ECDH_PEERS && test2_success; i++)
+        {
+            test2_success = results_ecdh[i] == CVC_ECDH_SUCCESS;
+        }
+        printf("   %d thread(s): %.1f ms CPU\n", thread_counts[t], ms);
+    }
+    printf("   Status: %s\n\n", test2_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 3: Bad peers are reported individually without disturbing their neighbours
+    printf("3. Testing invalid peers inside a batch...\n");
+
+    unsigned char off_curve[65];
+    memcpy(off_curve, peer_keys_ecdh[5], 65);
+    off_curve[64] ^= 1;
+    unsigned char compressed[65];
+    memcpy(compressed, peer_keys_ecdh[6], 65);
+    compressed[0] = 0x02;
+
+    peer_ptrs_ecdh[5] = off_curve;
+    peer_ptrs_ecdh[6] = compressed;
+    peer_ptrs_ecdh[40] = NULL;
+    memset(batch_out_ecdh, 0xEE, sizeof(batch_out_ecdh));
+    const int test3a_result = cvc_ecdh_nist256_batch(server.private_key_bytes, 32, NULL, peer_ptrs_ecdh, ECDH_PEERS, 2, &batch_out_ecdh[0][0], results_ecdh);
+
+    int test3_success = test3a_result == CVC_ECDH_ERROR_INVALID_PEER_KEY;
+    const unsigned char zeros[32] = { 0 };
+    for (int i = 0; i < ECDH_PEERS && test3_success; i++)
+    {
+        if (i == 5 || i == 6 || i == 40)
+        {
+            test3_success = results_ecdh[i] == CVC_ECDH_ERROR_INVALID_PEER_KEY && memcmp(batch_out_ecdh[i], zeros, 32) == 0;
+        }
+        else
+        {
+            test3_success = results_ecdh[i] == CVC_ECDH_SUCCESS && memcmp(batch_out_ecdh[i], expected_ecdh[i], 32) == 0;
+        }
+    }
+    peer_ptrs_ecdh[5] = peer_keys_ecdh[5];
+    peer_ptrs_ecdh[6] = peer_keys_ecdh[6];
+    peer_ptrs_ecdh[40] = peer_keys_ecdh[40];
+    printf("   Status: %s\n\n", test3_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 4: Parameter and secret key validation
+    printf("4. Testing parameter validation...\n");
+
+    const unsigned char zero_key[32] = { 0 };
+    int test4_success = cvc_ecdh_nist256_batch(zero_key, 32, NULL, peer_ptrs_ecdh, ECDH_PEERS, 1, &batch_out_ecdh[0][0], NULL) == CVC_ECDH_ERROR_INVALID_SECRET_KEY;
+    test4_success = test4_success && cvc_ecdh_nist256_batch(server.private_key_bytes, 31, NULL, peer_ptrs_ecdh, ECDH_PEERS, 1, &batch_out_ecdh[0][0], NULL) == CVC_ECDH_ERROR_INVALID_PARAMS;
+    test4_success = test4_success && cvc_ecdh_nist256_batch(server.private_key_bytes, 32, NULL, peer_ptrs_ecdh, 0, 1, &batch_out_ecdh[0][0], NULL) == CVC_ECDH_ERROR_INVALID_PARAMS;
+    test4_success = test4_success && cvc_ecdh_nist256(server.private_key_bytes, 32, NULL, peer_keys_ecdh[0], 65, shared_server, 31) == CVC_ECDH_ERROR_INSUFFICIENT_BUFFER;
+    test4_success = test4_success && cvc_ecdh_nist256(server.private_key_bytes, 32, NULL, peer_keys_ecdh[0], 64, shared_server, 32) == CVC_ECDH_ERROR_INVALID_PEER_KEY;
+    printf("   Status: %s\n\n", test4_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 5: Peers validated through a public key set give the same results
+    printf("5. Testing batch ECDH with a public key set...\n");
+
+    unsigned char hash_seed[16];
+    generate_random_seed_ecdh(hash_seed, sizeof(hash_seed));
+    cvc_public_key_set_config_t set_config = { 64, 4 };
+    cvc_public_key_set_t* key_set = NULL;
+    int test5_success = cvc_public_key_set_create(&set_config, hash_seed, sizeof(hash_seed), &key_set) == CVC_PUBLIC_KEY_SET_SUCCESS;
+    for (int round = 0; round < 2 && test5_success; round++)
+    {
+        memset(batch_out_ecdh, 0xEE, sizeof(batch_out_ecdh));
+        test5_success = cvc_ecdh_nist256_batch(server.private_key_bytes, 32, key_set, peer_ptrs_ecdh, ECDH_PEERS, 4, &batch_out_ecdh[0][0], NULL) == CVC_ECDH_SUCCESS &&
+                        memcmp(batch_out_ecdh, expected_ecdh, sizeof(expected_ecdh)) == 0;
+    }
+    cvc_public_key_set_destroy(key_set);
+    printf("   Status: %s\n\n", test5_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Summary
+    printf("=== ECDH Test Summary ===\n");
+    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success && test5_success;
+
+    if (all_tests_passed)
+    {
+        printf("🎉 All ECDH tests PASSED!\n");
+        return 0;
+    }
+    else
+    {
+        printf("💥 Some ECDH tests FAILED! Check the output above for details.\n");
+        return 1;
+    }
+}
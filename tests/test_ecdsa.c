@@ -0,0 +1,150 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/ecdsa.h"
+#include "src/keypair.h"
+#include "src/sha256.h"
+
+#define ECDSA_KEYS 16
+
+// RFC 7515, Appendix A.3: ES256 key and signature over the JWS signing input
+static const char rfc7515_signing_input[] = "eyJhbGciOiJFUzI1NiJ9.eyJpc3MiOiJqb2UiLA0KICJleHAiOjEzMDA4MTkzODAsDQogImh0dHA6Ly9leGFtcGxlLmNvbS9pc19yb290Ijp0cnVlfQ";
+static const char rfc7515_public_key_hex[] = "047fcdce2770f6c45d4183cbee6fdb4b7b580733357be9ef13bacf6e3c7bd15445c7f144cd1bbd9b7e872cdfedb9eeb9f4b3695d6ea90b24ad8a4623288588e5ad";
+static const char rfc7515_signature_hex[] = "0ed1215379636c483c2f7f155807d402a3b228033af97c7e17819ac3169ea665c50a07d38c3c70e5d8f12daf084a5480a66590c5f293509a8f3f7f8a83a354d5";
+
+// Generate some random seed data
+void generate_random_seed_ecdsa(unsigned char* seed, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        seed[i] = (unsigned char)(rand() & 0xFF);
+    }
+}
+
+// Convert a hex string to bytes
+void hex_to_bytes_ecdsa(const char* hex, unsigned char* bytes, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        sscanf(hex + 2 * i, "%2hhx", &bytes[i]);
+    }
+}
+
+int main()
+{
+    printf("=== ECDSA Test ===\n\n");
+    srand((unsigned int)time(NULL));
+
+    // Test 1: Published ES256 vector
+    printf("1. Testing RFC 7515 ES256 vector...\n");
+
+    unsigned char vector_key[65], vector_signature[64], vector_digest[32];
+    hex_to_bytes_ecdsa(rfc7515_public_key_hex, vector_key, 65);
+    hex_to_bytes_ecdsa(rfc7515_signature_hex, vector_signature, 64);
+    cvc_sha256((const unsigned char*)rfc7515_signing_input, strlen(rfc7515_signing_input), vector_digest);
+
+    cvc_nist256_point_table_t* vector_table = NULL;
+    int test1_success = cvc_ecdsa_nist256_verify(NULL, vector_key, 65, vector_digest, 32, vector_signature, 64) == CVC_ECDSA_SUCCESS;
+    test1_success = test1_success && cvc_nist256_point_precompute(vector_key, 65, &vector_table) == CVC_POINT_TABLE_SUCCESS;
+    test1_success = test1_success && cvc_ecdsa_nist256_verify_table(vector_table, vector_digest, 32, vector_signature, 64) == CVC_ECDSA_SUCCESS;
+    vector_digest[0] ^= 1;
+    test1_success = test1_success && cvc_ecdsa_nist256_verify(NULL, vector_key, 65, vector_digest, 32, vector_signature, 64) == CVC_ECDSA_ERROR_INVALID_SIGNATURE;
+    test1_success = test1_success && cvc_ecdsa_nist256_verify_table(vector_table, vector_digest, 32, vector_signature, 64) == CVC_ECDSA_ERROR_INVALID_SIGNATURE;
+    vector_digest[0] ^= 1;
+    printf("   Status: %s\n\n", test1_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 2: Signatures from key pairs verify on every path, tampered ones on none
+    printf("2. Testing sign / verify round trips...\n");
+
+    int test2_success = 1;
+    for (int i = 0; i < ECDSA_KEYS && test2_success; i++)
+    {
+        unsigned char seed[32], digest[32], signature[64], public_key[65];
+        cvc_nist256_keypair_t* keypair = NULL;
+        generate_random_seed_ecdsa(seed, sizeof(seed));
+        generate_random_seed_ecdsa(digest, sizeof(digest));
+        test2_success = cvc_nist256_keypair_generate(seed, sizeof(seed), CVC_KEYPAIR_PRECOMPUTE, &keypair) == CVC_KEYPAIR_SUCCESS;
+        test2_success = test2_success && cvc_nist256_keypair_sign(keypair, digest, 32, signature, 64) == CVC_KEYPAIR_SUCCESS;
+        test2_success = test2_success && cvc_nist256_keypair_public_key(keypair, public_key, 65) == CVC_KEYPAIR_SUCCESS;
+
+        test2_success = test2_success && cvc_ecdsa_nist256_verify(NULL, public_key, 65, digest, 32, signature, 64) == CVC_ECDSA_SUCCESS;
+        test2_success = test2_success && cvc_ecdsa_nist256_verify_table(cvc_nist256_keypair_table(keypair), digest, 32, signature, 64) == CVC_ECDSA_SUCCESS;
+        test2_success = test2_success && cvc_nist256_keypair_verify(keypair, digest, 32, signature, 64) == CVC_KEYPAIR_SUCCESS;
+
+        // Flip one bit of r, of s and of the digest in turn
+        const int flips[3] = { i % 32, 32 + i % 32, -1 };
+        for (int f = 0; f < 3 && test2_success; f++)
+        {
+            unsigned char* target = flips[f] < 0 ? &digest[i % 32] : &signature[flips[f]];
+            *target ^= 0x10;
+            test2_success = cvc_ecdsa_nist256_verify(NULL, public_key, 65, digest, 32, signature, 64) == CVC_ECDSA_ERROR_INVALID_SIGNATURE &&
+                            cvc_ecdsa_nist256_verify_table(cvc_nist256_keypair_table(keypair), digest, 32, signature, 64) == CVC_ECDSA_ERROR_INVALID_SIGNATURE;
+            *target ^= 0x10;
+        }
+        cvc_nist256_keypair_destroy(keypair);
+    }
+    printf("   Status: %s\n\n", test2_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 3: Out-of-range signatures, bad keys and bad lengths
+    printf("3. Testing input validation...\n");
+
+    const unsigned char order[32] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                                      0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x51 };
+    unsigned char bad_signature[64];
+    memcpy(bad_signature, vector_signature, 64);
+    memset(bad_signature, 0, 32);
+    int test3_success = cvc_ecdsa_nist256_verify(NULL, vector_key, 65, vector_digest, 32, bad_signature, 64) == CVC_ECDSA_ERROR_INVALID_SIGNATURE;
+    memcpy(bad_signature, vector_signature, 64);
+    memcpy(bad_signature + 32, order, 32);
+    test3_success = test3_success && cvc_ecdsa_nist256_verify(NULL, vector_key, 65, vector_digest, 32, bad_signature, 64) == CVC_ECDSA_ERROR_INVALID_SIGNATURE;
+    test3_success = test3_success && cvc_ecdsa_nist256_verify_table(vector_table, vector_digest, 32, bad_signature, 64) == CVC_ECDSA_ERROR_INVALID_SIGNATURE;
+
+    unsigned char off_curve[65];
+    memcpy(off_curve, vector_key, 65);
+    off_curve[64] ^= 1;
+    test3_success = test3_success && cvc_ecdsa_nist256_verify(NULL, off_curve, 65, vector_digest, 32, vector_signature, 64) == CVC_ECDSA_ERROR_INVALID_PUBLIC_KEY;
+    test3_success = test3_success && cvc_ecdsa_nist256_verify(NULL, vector_key, 64, vector_digest, 32, vector_signature, 64) == CVC_ECDSA_ERROR_INVALID_PUBLIC_KEY;
+    test3_success = test3_success && cvc_ecdsa_nist256_verify(NULL, vector_key, 65, vector_digest, 31, vector_signature, 64) == CVC_ECDSA_ERROR_INVALID_PARAMS;
+    test3_success = test3_success && cvc_ecdsa_nist256_verify(NULL, vector_key, 65, vector_digest, 32, vector_signature, 63) == CVC_ECDSA_ERROR_INVALID_PARAMS;
+    test3_success = test3_success && cvc_ecdsa_nist256_verify_table(NULL, vector_digest, 32, vector_signature, 64) == CVC_ECDSA_ERROR_INVALID_PARAMS;
+    printf("   Status: %s\n\n", test3_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 4: Verification through a public key set, on the first (decoding) and a cached lookup
+    printf("4. Testing verification through a public key set...\n");
+
+    unsigned char hash_seed[16];
+    generate_random_seed_ecdsa(hash_seed, sizeof(hash_seed));
+    cvc_public_key_set_config_t set_config = { 16, 4 };
+    cvc_public_key_set_t* key_set = NULL;
+    int test4_success = cvc_public_key_set_create(&set_config, hash_seed, sizeof(hash_seed), &key_set) == CVC_PUBLIC_KEY_SET_SUCCESS;
+    for (int i = 0; i < 2 && test4_success; i++)
+    {
+        test4_success = cvc_ecdsa_nist256_verify(key_set, vector_key, 65, vector_digest, 32, vector_signature, 64) == CVC_ECDSA_SUCCESS;
+    }
+    vector_signature[63] ^= 1;
+    test4_success = test4_success && cvc_ecdsa_nist256_verify(key_set, vector_key, 65, vector_digest, 32, vector_signature, 64) == CVC_ECDSA_ERROR_INVALID_SIGNATURE;
+    vector_signature[63] ^= 1;
+
+    cvc_public_key_set_destroy(key_set);
+    cvc_nist256_point_table_destroy(vector_table);
+    printf("   Status: %s\n\n", test4_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Summary
+    printf("=== ECDSA Test Summary ===\n");
+    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success;
+
+    if (all_tests_passed)
+    {
+        printf("🎉 All ECDSA tests PASSED!\n");
+        return 0;
+    }
+    else
+    {
+        printf("💥 Some ECDSA tests FAILED! Check the output above for details.\n");
+        return 1;
+    }
+}
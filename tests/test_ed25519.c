@@ -0,0 +1,237 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/ed25519_operations.h"
+#include "src/ed25519_key_material.h"
+#include "core.h"
+
+extern const BIG_256_56 CURVE_Order_Ed25519;
+
+// Generate some random seed data
+void generate_random_seed_ed(unsigned char* seed, int len)
+{
+    // Simple pseudo-random for testing (not cryptographically secure for production)
+    static int seeded = 0;
+    if (!seeded)
+    {
+        srand((unsigned int)time(NULL));
+        seeded = 1;
+    }
+    for (int i = 0; i < len; i++)
+    {
+        seed[i] = (unsigned char)(rand() & 0xFF);
+    }
+}
+
+// Compare the fixed-base multiplication against MIRACL's generic ECP_Ed25519_mul
+int fixed_base_matches_generic_ed(BIG_256_56 d)
+{
+    ECP_Ed25519 expected, actual;
+    ECP_Ed25519_generator(&expected);
+    ECP_Ed25519_mul(&expected, d);
+    ed25519_mul_base(&actual, d);
+    return ECP_Ed25519_equals(&expected, &actual);
+}
+
+// Format key material as an uncompressed public key: 0x04 || X || Y
+void to_uncompressed_ed(const ed25519_key_material_t* key_material, unsigned char* out)
+{
+    out[0] = 0x04;
+    memcpy(&out[1], key_material->public_key_x_bytes, 32);
+    memcpy(&out[33], key_material->public_key_y_bytes, 32);
+}
+
+int main()
+{
+    printf("=== Ed25519 Operations Test ===\n\n");
+
+    // Test 1: Fixed-base table matches generic scalar multiplication
+    printf("1. Testing fixed-base multiplication against generic multiplication...\n");
+
+    BIG_256_56 curve_order;
+    BIG_256_56_rcopy(curve_order, CURVE_Order_Ed25519);
+
+    int test1_success = 1;
+    const int small_scalars[] = { 1, 2, 7, 8, 9, 15, 16, 17, 255, 256 };
+    for (int i = 0; i < (int)(sizeof(small_scalars) / sizeof(small_scalars[0])); i++)
+    {
+        BIG_256_56 d;
+        BIG_256_56_zero(d);
+        BIG_256_56_inc(d, small_scalars[i]);
+        BIG_256_56_norm(d);
+        test1_success = test1_success && fixed_base_matches_generic_ed(d);
+    }
+
+    BIG_256_56 order_minus_one;
+    BIG_256_56_copy(order_minus_one, curve_order);
+    BIG_256_56_dec(order_minus_one, 1);
+    BIG_256_56_norm(order_minus_one);
+    test1_success = test1_success && fixed_base_matches_generic_ed(order_minus_one);
+
+    for (int i = 0; i < 16; i++)
+    {
+        unsigned char seed[32];
+        generate_random_seed_ed(seed, 32);
+        BIG_256_56 d;
+        ed25519_generate_secret_key(d, seed, 32);
+        test1_success = test1_success && fixed_base_matches_generic_ed(d);
+    }
+    printf("   Status: %s\n\n", test1_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 2: Derivation is deterministic and context dependent
+    printf("2. Testing secret key derivation...\n");
+
+    unsigned char master_key[32];
+    generate_random_seed_ed(master_key, 32);
+    const unsigned char context[] = "test_context";
+    const unsigned char other_context[] = "other_context";
+    const unsigned char dst[] = "CVC_DERIVE_KEY_ED25519";
+
+    ed25519_key_material_t derived1, derived2, derived_other;
+    const int derive1_result = cvc_derive_secret_key_ed25519(master_key, 32, context, sizeof(context) - 1, dst, sizeof(dst) - 1, &derived1);
+    const int derive2_result = cvc_derive_secret_key_ed25519(master_key, 32, context, sizeof(context) - 1, dst, sizeof(dst) - 1, &derived2);
+    const int derive3_result = cvc_derive_secret_key_ed25519(master_key, 32, other_context, sizeof(other_context) - 1, dst, sizeof(dst) - 1, &derived_other);
+
+    BIG_256_56 derived_scalar;
+    BIG_256_56_fromBytes(derived_scalar, (char*)derived1.private_key_bytes);
+
+    const int test2_success = (derive1_result == CVC_DERIVE_KEY_SUCCESS) && (derive2_result == CVC_DERIVE_KEY_SUCCESS) && (derive3_result == CVC_DERIVE_KEY_SUCCESS) && memcmp(&derived1, &derived2, sizeof(derived1)) == 0
+        && memcmp(&derived1, &derived_other, sizeof(derived1)) != 0 && BIG_256_56_comp(derived_scalar, curve_order) < 0;
+    printf("   Status: %s\n\n", test2_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 3: pub(d1 + d2) == pub(d1) + pub(d2)
+    printf("3. Testing secret and public key addition consistency...\n");
+
+    ed25519_key_material_t key1, key2, sum;
+    unsigned char seed1[32], seed2[32];
+    generate_random_seed_ed(seed1, 32);
+    generate_random_seed_ed(seed2, 32);
+    seed2[0] = ~seed1[0];
+    ed25519_generate_key_material(seed1, 32, &key1);
+    ed25519_generate_key_material(seed2, 32, &key2);
+
+    const int add_secret_result = cvc_add_ed25519_secret_keys(key1.private_key_bytes, 32, key2.private_key_bytes, 32, &sum);
+
+    unsigned char public1[65], public2[65], expected_public[65], public_sum[65];
+    int public_sum_len = 0;
+    to_uncompressed_ed(&key1, public1);
+    to_uncompressed_ed(&key2, public2);
+    to_uncompressed_ed(&sum, expected_public);
+    const int add_public_result = cvc_add_ed25519_public_keys(public1, 65, public2, 65, public_sum, sizeof(public_sum), &public_sum_len);
+
+    printf("   Add secret result: %d, add public result: %d\n", add_secret_result, add_public_result);
+
+    const int test3_success = (add_secret_result == CVC_ADD_SECRET_KEYS_SUCCESS) && (add_public_result == CVC_ECP_SUCCESS) && public_sum_len == 65 && memcmp(public_sum, expected_public, 65) == 0;
+    printf("   Status: %s\n\n", test3_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 4: Invalid inputs are rejected
+    printf("4. Testing invalid inputs...\n");
+
+    unsigned char order_bytes[32];
+    BIG_256_56_toBytes((char*)order_bytes, curve_order);
+
+    // The identity (0, 1) is on the curve but must be rejected
+    unsigned char identity[65] = { 0 };
+    identity[0] = 0x04;
+    identity[64] = 0x01;
+
+    // (0, -1) has order 2
+    static const unsigned char order_two[65] = { 0x04, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEC };
+
+    ed25519_key_material_t scratch;
+    const int test4a_result = cvc_add_ed25519_secret_keys(order_bytes, 32, key2.private_key_bytes, 32, &scratch);
+    const int test4b_result = cvc_add_ed25519_public_keys(identity, 65, public2, 65, public_sum, sizeof(public_sum), &public_sum_len);
+    const int test4c_result = cvc_add_ed25519_public_keys(public1, 64, public2, 65, public_sum, sizeof(public_sum), &public_sum_len);
+    const int test4d_result = cvc_derive_secret_key_ed25519(master_key, 32, context, sizeof(context) - 1, dst, 0, &scratch);
+    const int test4e_result = cvc_add_ed25519_public_keys(public1, 65, order_two, 65, public_sum, sizeof(public_sum), &public_sum_len);
+
+    // key1 + (0, -1) is a valid curve point with a torsion component
+    unsigned char mixed_order[65];
+    ECP_Ed25519 mixed_point, torsion_point;
+    octet public1_octet = { 65, 65, (char*)public1 };
+    octet torsion_octet = { 65, 65, (char*)order_two };
+    octet mixed_octet = { 0, 65, (char*)mixed_order };
+    ECP_Ed25519_fromOctet(&mixed_point, &public1_octet);
+    ECP_Ed25519_fromOctet(&torsion_point, &torsion_octet);
+    ECP_Ed25519_add(&mixed_point, &torsion_point);
+    ECP_Ed25519_toOctet(&mixed_octet, &mixed_point, false);
+    const int test4f_result = cvc_add_ed25519_public_keys(mixed_order, 65, public2, 65, public_sum, sizeof(public_sum), &public_sum_len);
+
+    printf("   Key equal to order result: %d\n", test4a_result);
+    printf("   Identity public key result: %d\n", test4b_result);
+    printf("   Short public key result: %d\n", test4c_result);
+    printf("   Empty DST result: %d\n", test4d_result);
+    printf("   Order-two public key result: %d\n", test4e_result);
+    printf("   Mixed-order public key result: %d\n", test4f_result);
+
+    const int test4_success = (test4a_result == CVC_ADD_SECRET_KEYS_ERROR_INVALID_KEY1) && (test4b_result == CVC_ECP_ERROR_POINT_1_AT_INFINITY) && (test4c_result == CVC_ECP_ERROR_INVALID_KEY1_LENGTH) && (test4d_result == CVC_DERIVE_KEY_ERROR_INVALID_PARAMS) && (test4e_result == CVC_ECP_ERROR_SMALL_ORDER_POINT_2) && (test4f_result == CVC_ECP_ERROR_SMALL_ORDER_POINT_1);
+    printf("   Status: %s\n\n", test4_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 5: RFC 8032 encoding matches the standard (RFC 8032 section 7.1, TEST 1)
+    printf("5. Testing RFC 8032 encoding...\n");
+
+    static const unsigned char rfc_seed[32] = { 0x9d, 0x61, 0xb1, 0x9d, 0xef, 0xfd, 0x5a, 0x60, 0xba, 0x84, 0x4a, 0xf4, 0x92, 0xec, 0x2c, 0xc4, 0x44, 0x49, 0xc5, 0x69, 0x7b, 0x32, 0x69, 0x19, 0x70, 0x3b, 0xac, 0x03, 0x1c, 0xae, 0x7f, 0x60 };
+    static const unsigned char rfc_public[32] = { 0xd7, 0x5a, 0x98, 0x01, 0x82, 0xb1, 0x0a, 0xb7, 0xd5, 0x4b, 0xfe, 0xd3, 0xc9, 0x64, 0x07, 0x3a, 0x0e, 0xe1, 0x72, 0xf3, 0xda, 0xa6, 0x23, 0x25, 0xaf, 0x02, 0x1a, 0x68, 0xf7, 0x07, 0x51, 0x1a };
+
+    // s = clamp(SHA-512(seed)[0..31]) as a little-endian integer, reduced mod l
+    hash512 h;
+    char digest[64];
+    HASH512_init(&h);
+    for (int i = 0; i < 32; i++)
+    {
+        HASH512_process(&h, rfc_seed[i]);
+    }
+    HASH512_hash(&h, digest);
+    digest[0] &= (char)248;
+    digest[31] &= 127;
+    digest[31] |= 64;
+
+    unsigned char s_bytes[32];
+    for (int i = 0; i < 32; i++)
+    {
+        s_bytes[i] = (unsigned char)digest[31 - i];
+    }
+    BIG_256_56 s;
+    BIG_256_56_fromBytes(s, (char*)s_bytes);
+    BIG_256_56_mod(s, curve_order);
+
+    ed25519_key_material_t rfc_key;
+    unsigned char encoded[32], scalar[32], uncompressed[65], from_uncompressed[32];
+    int test5_success = ed25519_big_to_key_material(s, &rfc_key) == 0;
+    test5_success = test5_success && cvc_ed25519_key_material_to_rfc8032(&rfc_key, encoded, sizeof(encoded), scalar, sizeof(scalar)) == CVC_ECP_SUCCESS;
+    test5_success = test5_success && memcmp(encoded, rfc_public, 32) == 0;
+
+    // The scalar is the private key reversed
+    for (int i = 0; i < 32 && test5_success; i++)
+    {
+        test5_success = scalar[i] == rfc_key.private_key_bytes[31 - i];
+    }
+
+    // The 65-byte public key converts to the same encoding; the order-two point is refused
+    to_uncompressed_ed(&rfc_key, uncompressed);
+    test5_success = test5_success && cvc_ed25519_public_key_to_rfc8032(uncompressed, 65, from_uncompressed, sizeof(from_uncompressed)) == CVC_ECP_SUCCESS;
+    test5_success = test5_success && memcmp(from_uncompressed, rfc_public, 32) == 0;
+    test5_success = test5_success && cvc_ed25519_public_key_to_rfc8032(order_two, 65, from_uncompressed, sizeof(from_uncompressed)) == CVC_ECP_ERROR_SMALL_ORDER_POINT_1;
+    test5_success = test5_success && cvc_ed25519_key_material_to_rfc8032(&rfc_key, encoded, 31, NULL, 0) == CVC_ECP_ERROR_INSUFFICIENT_BUFFER;
+    printf("   Status: %s\n\n", test5_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Summary
+    printf("=== Ed25519 Operations Test Summary ===\n");
+    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success && test5_success;
+
+    if (all_tests_passed)
+    {
+        printf("🎉 All Ed25519 tests PASSED!\n");
+        return 0;
+    }
+    else
+    {
+        printf("💥 Some Ed25519 tests FAILED! Check the output above for details.\n");
+        return 1;
+    }
+}
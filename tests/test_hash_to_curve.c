@@ -0,0 +1,144 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/hash_to_curve.h"
+#include "src/hash_to_field.h"
+#include "core.h"
+
+#define HTC_BATCH_COUNT 70
+
+// Helper function to convert hex string to bytes
+int hex_to_bytes_htc(const char* hex, unsigned char* bytes, int max_len)
+{
+    int len = (int)strlen(hex) / 2;
+    if (len > max_len)
+    {
+        return -1;
+    }
+    for (int i = 0; i < len; i++)
+    {
+        sscanf(hex + 2 * i, "%2hhx", &bytes[i]);
+    }
+    return len;
+}
+
+// Check an affine point against expected hex coordinates
+int point_equals_hex_htc(ECP_NIST256* point, const char* x_hex, const char* y_hex)
+{
+    unsigned char expected_x[32], expected_y[32];
+    char actual_x[32], actual_y[32];
+    BIG_256_56 x, y;
+
+    hex_to_bytes_htc(x_hex, expected_x, 32);
+    hex_to_bytes_htc(y_hex, expected_y, 32);
+    ECP_NIST256_get(x, y, point);
+    BIG_256_56_toBytes(actual_x, x);
+    BIG_256_56_toBytes(actual_y, y);
+
+    return memcmp(actual_x, expected_x, 32) == 0 && memcmp(actual_y, expected_y, 32) == 0;
+}
+
+int main()
+{
+    printf("=== Hash to Curve Test ===\n\n");
+
+    const char* dst = "QUUX-V01-CS02-with-P256_XMD:SHA-256_SSWU_RO_";
+    const int dst_len = (int)strlen(dst);
+
+    // Test 1: RFC 9380 Appendix J.1.1 test vectors
+    printf("1. Testing RFC 9380 P256_XMD:SHA-256_SSWU_RO_ vectors...\n");
+
+    const char* messages[] = { "abc", "abcdef0123456789" };
+    const char* expected_x[] = { "0bb8b87485551aa43ed54f009230450b492fead5f1cc91658775dac4a3388a0f", "65038ac8f2b1def042a5df0b33b1f4eca6bff7cb0f9c6c1526811864e544ed80" };
+    const char* expected_y[] = { "5c41b3d0731a27a7b14bc0bf0ccded2d8751f83493404c84a88e71ffd424212e", "cad44d40a656e7aff4002a8de287abc8ae0482b5ae825822bb870d6df9b56ca3" };
+
+    int test1_success = 1;
+    for (int i = 0; i < 2; i++)
+    {
+        ECP_NIST256 point;
+        const int result = cvc_hash_to_curve_nist256((const unsigned char*)dst, dst_len, (const unsigned char*)messages[i], (int)strlen(messages[i]), &point);
+        const int match = (result == CVC_HASH_TO_CURVE_SUCCESS) && point_equals_hex_htc(&point, expected_x[i], expected_y[i]);
+        printf("   msg=\"%s\": %s\n", messages[i], match ? "MATCH" : "MISMATCH");
+        test1_success = test1_success && match;
+    }
+    printf("   Status: %s\n\n", test1_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 2: map_to_curve matches MIRACL's ECP_NIST256_map2point
+    printf("2. Testing simplified SWU map against MIRACL map2point...\n");
+
+    srand((unsigned int)time(NULL));
+    int test2_success = 1;
+    for (int i = 0; i < 32; i++)
+    {
+        unsigned char message[16];
+        for (int j = 0; j < 16; j++)
+        {
+            message[j] = (unsigned char)(rand() & 0xFF);
+        }
+
+        FP_NIST256 u;
+        cvc_hash_to_field_nist256(MC_SHA2, HASH_TYPE_NIST256, (const unsigned char*)dst, dst_len, message, sizeof(message), 1, &u);
+
+        ECP_NIST256 expected, actual;
+        ECP_NIST256_map2point(&expected, &u);
+        cvc_map_to_curve_nist256(&actual, &u);
+        test2_success = test2_success && ECP_NIST256_equals(&expected, &actual);
+    }
+    printf("   Status: %s\n\n", test2_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 3: Batch variant matches per-message calls (crosses a normalization chunk)
+    printf("3. Testing batch hash to curve...\n");
+
+    unsigned char batch_storage[HTC_BATCH_COUNT][12];
+    const unsigned char* batch_messages[HTC_BATCH_COUNT];
+    int batch_lens[HTC_BATCH_COUNT];
+    for (int i = 0; i < HTC_BATCH_COUNT; i++)
+    {
+        batch_lens[i] = snprintf((char*)batch_storage[i], sizeof(batch_storage[i]), "id-%d", i);
+        batch_messages[i] = batch_storage[i];
+    }
+
+    ECP_NIST256 batch_points[HTC_BATCH_COUNT];
+    const int batch_result = cvc_hash_to_curve_nist256_batch((const unsigned char*)dst, dst_len, batch_messages, batch_lens, HTC_BATCH_COUNT, batch_points);
+
+    int test3_success = (batch_result == CVC_HASH_TO_CURVE_SUCCESS);
+    for (int i = 0; i < HTC_BATCH_COUNT && test3_success; i++)
+    {
+        ECP_NIST256 single;
+        cvc_hash_to_curve_nist256((const unsigned char*)dst, dst_len, batch_messages[i], batch_lens[i], &single);
+        test3_success = ECP_NIST256_equals(&single, &batch_points[i]);
+    }
+    printf("   Batch result: %d\n", batch_result);
+    printf("   Status: %s\n\n", test3_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 4: Invalid parameters
+    printf("4. Testing invalid parameters...\n");
+
+    ECP_NIST256 point;
+    const int test4a_result = cvc_hash_to_curve_nist256(NULL, 0, (const unsigned char*)"abc", 3, &point);
+    const int test4b_result = cvc_hash_to_curve_nist256((const unsigned char*)dst, dst_len, (const unsigned char*)"abc", 3, NULL);
+    batch_lens[5] = 0;
+    const int test4c_result = cvc_hash_to_curve_nist256_batch((const unsigned char*)dst, dst_len, batch_messages, batch_lens, HTC_BATCH_COUNT, batch_points);
+
+    const int test4_success = (test4a_result == CVC_HASH_TO_CURVE_ERROR_INVALID_PARAMS) && (test4b_result == CVC_HASH_TO_CURVE_ERROR_INVALID_PARAMS) && (test4c_result == CVC_HASH_TO_CURVE_ERROR_INVALID_PARAMS);
+    printf("   Status: %s\n\n", test4_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Summary
+    printf("=== Hash to Curve Test Summary ===\n");
+    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success;
+
+    if (all_tests_passed)
+    {
+        printf("🎉 All hash to curve tests PASSED!\n");
+        return 0;
+    }
+    else
+    {
+        printf("💥 Some hash to curve tests FAILED! Check the output above for details.\n");
+        return 1;
+    }
+}
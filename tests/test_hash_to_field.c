@@ -8,6 +8,11 @@
 #include "src/nist256_key_material.h"
 #include "core.h"
 
+#define HTF_BATCH_COUNT 37
+
+// External ROM constants
+extern const BIG_256_56 Modulus_NIST256;
+
 // Helper function to print hex bytes
 void print_hex_htf(const char* label, const unsigned char* data, int len)
 {
@@ -276,9 +281,72 @@ int main()
     }
     printf("   Status: %s\n\n", test7_success ? "✅ PASSED" : "❌ FAILED");
 
+    // Test 8: Batch hash-to-field matches per-message calls
+    printf("8. Testing batch hash-to-field...\n");
+
+    unsigned char batch_storage[HTF_BATCH_COUNT][80];
+    const unsigned char* batch_messages[HTF_BATCH_COUNT];
+    int batch_lens[HTF_BATCH_COUNT];
+    for (int i = 0; i < HTF_BATCH_COUNT; i++)
+    {
+        // Lengths from 1 to 79 bytes so the lanes finish at different blocks
+        batch_lens[i] = 1 + (i * 29) % 79;
+        generate_random_seed_htf(batch_storage[i], batch_lens[i]);
+        batch_messages[i] = batch_storage[i];
+    }
+
+    FP_NIST256 batch_elements[HTF_BATCH_COUNT * 2];
+    const int test8_result = cvc_hash_to_field_nist256_batch(MC_SHA2, HASH_TYPE_NIST256, dst, sizeof(dst) - 1, batch_messages, batch_lens, HTF_BATCH_COUNT, 2, batch_elements);
+    printf("   Batch result: %d\n", test8_result);
+
+    int test8_success = (test8_result == CVC_HASH_TO_FIELD_SUCCESS);
+    for (int i = 0; i < HTF_BATCH_COUNT && test8_success; i++)
+    {
+        FP_NIST256 single[2];
+        cvc_hash_to_field_nist256(MC_SHA2, HASH_TYPE_NIST256, dst, sizeof(dst) - 1, batch_messages[i], batch_lens[i], 2, single);
+        test8_success = FP_NIST256_equals(&single[0], &batch_elements[2 * i]) && FP_NIST256_equals(&single[1], &batch_elements[2 * i + 1]);
+    }
+    printf("   Status: %s\n\n", test8_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 9: Specialized P-256/SHA-256 path matches MIRACL's generic reduction
+    printf("9. Testing specialized P-256/SHA-256 path against generic reduction...\n");
+
+    int test9_success = 1;
+    for (int i = 0; i < 64 && test9_success; i++)
+    {
+        unsigned char sample[40];
+        generate_random_seed_htf(sample, sizeof(sample));
+
+        FP_NIST256 fast[3];
+        test9_success = cvc_hash_to_field_nist256_sha256(dst, sizeof(dst) - 1, sample, 1 + i % 40, 3, fast) == CVC_HASH_TO_FIELD_SUCCESS;
+
+        char okm[3 * 48];
+        octet OKM = { 0, sizeof(okm), okm };
+        octet DST = { sizeof(dst) - 1, sizeof(dst) - 1, (char*)dst };
+        octet MESSAGE = { 1 + i % 40, 1 + i % 40, (char*)sample };
+        XMD_Expand(MC_SHA2, SHA256, &OKM, sizeof(okm), &DST, &MESSAGE);
+
+        BIG_256_56 modulus;
+        BIG_256_56_rcopy(modulus, Modulus_NIST256);
+        for (int j = 0; j < 3 && test9_success; j++)
+        {
+            DBIG_256_56 dx;
+            BIG_256_56 expected, actual;
+            BIG_256_56_dfromBytesLen(dx, okm + 48 * j, 48);
+            BIG_256_56_dmod(expected, dx, modulus);
+            FP_NIST256_redc(actual, &fast[j]);
+            test9_success = BIG_256_56_comp(expected, actual) == 0;
+        }
+    }
+
+    // 43 elements would need 2064 bytes of expansion, over the 2048-byte limit
+    const int test9b_result = cvc_hash_to_field_nist256_sha256(dst, sizeof(dst) - 1, message, sizeof(message) - 1, 43, batch_elements);
+    test9_success = test9_success && (test9b_result == CVC_HASH_TO_FIELD_ERROR_EXPANSION_TOO_LARGE);
+    printf("   Status: %s\n\n", test9_success ? "✅ PASSED" : "❌ FAILED");
+
     // Summary
     printf("=== Hash-to-Field Test Summary ===\n");
-    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success && test5_success && test6_success && test7_success;
+    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success && test5_success && test6_success && test7_success && test8_success && test9_success;
 
     if (all_tests_passed)
     {
@@ -290,6 +358,8 @@ int main()
         printf("✅ Key derivation parameter validation: PASSED\n");
         printf("✅ Key derivation deterministic behavior: PASSED\n");
         printf("✅ Different inputs produce different outputs: PASSED\n");
+        printf("✅ Batch hash-to-field: PASSED\n");
+        printf("✅ Specialized P-256/SHA-256 path: PASSED\n");
         return 0;
     }
     else
@@ -0,0 +1,304 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/jwt.h"
+#include "src/keypair.h"
+#include "src/sha256.h"
+
+// RFC 7515, Appendix A.3: ES256 JWS and the issuer key from its JWK
+static const char rfc7515_token[] = "eyJhbGciOiJFUzI1NiJ9.eyJpc3MiOiJqb2UiLA0KICJleHAiOjEzMDA4MTkzODAsDQogImh0dHA6Ly9leGFtcGxlLmNvbS9pc19yb290Ijp0cnVlfQ."
+                                    "DtEhU3ljbEg8L38VWAfUAqOyKAM6-Xx-F4GawxaepmXFCgfTjDxw5djxLa8ISlSApmWQxfKTUJqPP3-Kg6NU1Q";
+static const char rfc7515_public_key_hex[] = "047fcdce2770f6c45d4183cbee6fdb4b7b580733357be9ef13bacf6e3c7bd15445c7f144cd1bbd9b7e872cdfedb9eeb9f4b3695d6ea90b24ad8a4623288588e5ad";
+
+#define JWT_BATCH 200
+
+static char claims_jwt[JWT_BATCH][96];
+static const char* claims_ptrs_jwt[JWT_BATCH];
+static int claims_lens_jwt[JWT_BATCH];
+static char arena_jwt[2][JWT_BATCH * 320];
+static int results_jwt[JWT_BATCH];
+static int offsets_jwt[2][JWT_BATCH];
+static int lens_jwt[2][JWT_BATCH];
+
+// Generate some random seed data
+void generate_random_seed_jwt(unsigned char* seed, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        seed[i] = (unsigned char)(rand() & 0xFF);
+    }
+}
+
+// Convert a hex string to bytes
+void hex_to_bytes_jwt(const char* hex, unsigned char* bytes, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        sscanf(hex + 2 * i, "%2hhx", &bytes[i]);
+    }
+}
+
+// Unpadded base64url encoding; returns the number of characters written
+int base64url_encode_jwt(const unsigned char* data, int len, char* out)
+{
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    int written = 0;
+    unsigned int accumulator = 0;
+    int bits = 0;
+    for (int i = 0; i < len; i++)
+    {
+        accumulator = (accumulator << 8) | data[i];
+        bits += 8;
+        while (bits >= 6)
+        {
+            bits -= 6;
+            out[written++] = alphabet[(accumulator >> bits) & 63];
+        }
+    }
+    if (bits > 0)
+    {
+        out[written++] = alphabet[(accumulator << (6 - bits)) & 63];
+    }
+    out[written] = '\0';
+    return written;
+}
+
+// Build and sign header.payload.signature with a key pair
+int make_token_jwt(const cvc_nist256_keypair_t* keypair, const char* header, const char* payload, char* token)
+{
+    int len = base64url_encode_jwt((const unsigned char*)header, (int)strlen(header), token);
+    token[len++] = '.';
+    len += base64url_encode_jwt((const unsigned char*)payload, (int)strlen(payload), token + len);
+
+    unsigned char digest[32], signature[64];
+    cvc_sha256((const unsigned char*)token, (size_t)len, digest);
+    if (cvc_nist256_keypair_sign(keypair, digest, 32, signature, 64) != CVC_KEYPAIR_SUCCESS)
+    {
+        return 0;
+    }
+
+    token[len++] = '.';
+    len += base64url_encode_jwt(signature, 64, token + len);
+    return len;
+}
+
+int main()
+{
+    printf("=== JWT Test ===\n\n");
+    srand((unsigned int)time(NULL));
+
+    // Test 1: base64url decoding, including the strictness rules
+    printf("1. Testing base64url decoding...\n");
+
+    unsigned char decoded[64];
+    int decoded_len = 0;
+    int test1_success = cvc_base64url_decode("Zm9vYmFy", 8, decoded, sizeof(decoded), &decoded_len) == CVC_JWT_SUCCESS && decoded_len == 6 && memcmp(decoded, "foobar", 6) == 0;
+    test1_success = test1_success && cvc_base64url_decode("Zm9vYg", 6, decoded, sizeof(decoded), &decoded_len) == CVC_JWT_SUCCESS && decoded_len == 4 && memcmp(decoded, "foob", 4) == 0;
+    test1_success = test1_success && cvc_base64url_decode("Zm8", 3, decoded, sizeof(decoded), &decoded_len) == CVC_JWT_SUCCESS && decoded_len == 2 && memcmp(decoded, "fo", 2) == 0;
+    test1_success = test1_success && cvc_base64url_decode("-_8", 3, decoded, sizeof(decoded), &decoded_len) == CVC_JWT_SUCCESS && decoded_len == 2 && decoded[0] == 0xFB && decoded[1] == 0xFF;
+    test1_success = test1_success && cvc_base64url_decode("", 0, decoded, sizeof(decoded), &decoded_len) == CVC_JWT_SUCCESS && decoded_len == 0;
+    test1_success = test1_success && cvc_base64url_decode("Zg==", 4, decoded, sizeof(decoded), &decoded_len) == CVC_JWT_ERROR_MALFORMED_TOKEN;
+    test1_success = test1_success && cvc_base64url_decode("Zm9vY", 5, decoded, sizeof(decoded), &decoded_len) == CVC_JWT_ERROR_MALFORMED_TOKEN;
+    test1_success = test1_success && cvc_base64url_decode("Zh", 2, decoded, sizeof(decoded), &decoded_len) == CVC_JWT_ERROR_MALFORMED_TOKEN;
+    test1_success = test1_success && cvc_base64url_decode("Zm+v", 4, decoded, sizeof(decoded), &decoded_len) == CVC_JWT_ERROR_MALFORMED_TOKEN;
+    test1_success = test1_success && cvc_base64url_decode("Zm9vYmFy", 8, decoded, 5, &decoded_len) == CVC_JWT_ERROR_INSUFFICIENT_BUFFER;
+
+    // The encoder agrees with a bit-at-a-time reference for every tail length
+    unsigned char random_bytes[48];
+    generate_random_seed_jwt(random_bytes, sizeof(random_bytes));
+    for (int len = 0; len <= (int)sizeof(random_bytes) && test1_success; len++)
+    {
+        char expected[80], encoded[80];
+        int encoded_len = 0;
+        const int expected_len = base64url_encode_jwt(random_bytes, len, expected);
+        test1_success = cvc_base64url_encode(random_bytes, len, encoded, sizeof(encoded), &encoded_len) == CVC_JWT_SUCCESS && encoded_len == expected_len && memcmp(encoded, expected, (size_t)encoded_len) == 0;
+        test1_success = test1_success && cvc_base64url_decode(encoded, encoded_len, decoded, sizeof(decoded), &decoded_len) == CVC_JWT_SUCCESS && decoded_len == len && memcmp(decoded, random_bytes, (size_t)len) == 0;
+    }
+    char short_output[4];
+    test1_success = test1_success && cvc_base64url_encode((const unsigned char*)"foob", 4, short_output, sizeof(short_output), &decoded_len) == CVC_JWT_ERROR_INSUFFICIENT_BUFFER;
+    printf("   Status: %s\n\n", test1_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 2: Published ES256 token
+    printf("2. Testing RFC 7515 ES256 token...\n");
+
+    unsigned char vector_key[65];
+    hex_to_bytes_jwt(rfc7515_public_key_hex, vector_key, 65);
+    const int vector_len = (int)strlen(rfc7515_token);
+
+    cvc_nist256_point_table_t* vector_table = NULL;
+    int test2_success = cvc_jwt_verify_es256(rfc7515_token, vector_len, NULL, vector_key, 65) == CVC_JWT_SUCCESS;
+    test2_success = test2_success && cvc_nist256_point_precompute(vector_key, 65, &vector_table) == CVC_POINT_TABLE_SUCCESS;
+    test2_success = test2_success && cvc_jwt_verify_es256_table(rfc7515_token, vector_len, vector_table) == CVC_JWT_SUCCESS;
+
+    char tampered[512];
+    memcpy(tampered, rfc7515_token, (size_t)vector_len);
+    tampered[30] = tampered[30] == 'A' ? 'B' : 'A';
+    test2_success = test2_success && cvc_jwt_verify_es256(tampered, vector_len, NULL, vector_key, 65) == CVC_JWT_ERROR_INVALID_SIGNATURE;
+    test2_success = test2_success && cvc_jwt_verify_es256_table(tampered, vector_len, vector_table) == CVC_JWT_ERROR_INVALID_SIGNATURE;
+    cvc_nist256_point_table_destroy(vector_table);
+    printf("   Status: %s\n\n", test2_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 3: Tokens signed by key pairs verify against their own key only
+    printf("3. Testing signed tokens...\n");
+
+    unsigned char seed[32], issuer_key[65], other_key[65];
+    cvc_nist256_keypair_t* issuer = NULL;
+    cvc_nist256_keypair_t* other = NULL;
+    generate_random_seed_jwt(seed, sizeof(seed));
+    int test3_success = cvc_nist256_keypair_generate(seed, sizeof(seed), 0, &issuer) == CVC_KEYPAIR_SUCCESS;
+    generate_random_seed_jwt(seed, sizeof(seed));
+    test3_success = test3_success && cvc_nist256_keypair_generate(seed, sizeof(seed), 0, &other) == CVC_KEYPAIR_SUCCESS;
+    test3_success = test3_success && cvc_nist256_keypair_public_key(issuer, issuer_key, 65) == CVC_KEYPAIR_SUCCESS;
+    test3_success = test3_success && cvc_nist256_keypair_public_key(other, other_key, 65) == CVC_KEYPAIR_SUCCESS;
+
+    char token[1024];
+    int token_len = test3_success ? make_token_jwt(issuer, "{\"typ\":\"JWT\", \"jwk\": {\"alg\": \"none\", \"k\": [1, 2]}, \"alg\" : \"ES256\"}", "{\"sub\":\"user-1\",\"exp\":4102444800}", token) : 0;
+    test3_success = test3_success && token_len > 0 && cvc_jwt_verify_es256(token, token_len, NULL, issuer_key, 65) == CVC_JWT_SUCCESS;
+    test3_success = test3_success && cvc_jwt_verify_es256(token, token_len, NULL, other_key, 65) == CVC_JWT_ERROR_INVALID_SIGNATURE;
+    test3_success = test3_success && cvc_jwt_verify_es256(token, token_len - 1, NULL, issuer_key, 65) == CVC_JWT_ERROR_MALFORMED_TOKEN;
+    issuer_key[64] ^= 1;
+    test3_success = test3_success && cvc_jwt_verify_es256(token, token_len, NULL, issuer_key, 65) == CVC_JWT_ERROR_INVALID_PUBLIC_KEY;
+    issuer_key[64] ^= 1;
+    printf("   Status: %s\n\n", test3_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 4: Headers that must not be accepted, even with a valid signature
+    printf("4. Testing header and structure checks...\n");
+
+    static const struct
+    {
+        const char* header;
+        int expected;
+    } headers[] = {
+        { "{\"alg\":\"none\"}", CVC_JWT_ERROR_UNSUPPORTED_ALGORITHM },
+        { "{\"alg\":\"HS256\"}", CVC_JWT_ERROR_UNSUPPORTED_ALGORITHM },
+        { "{\"alg\":\"ES2560\"}", CVC_JWT_ERROR_UNSUPPORTED_ALGORITHM },
+        { "{\"typ\":\"JWT\"}", CVC_JWT_ERROR_UNSUPPORTED_ALGORITHM },
+        { "{\"x\":\"\\\"alg\\\":\\\"ES256\\\"\"}", CVC_JWT_ERROR_UNSUPPORTED_ALGORITHM },
+        { "{\"alg\":\"ES256\",\"alg\":\"none\"}", CVC_JWT_ERROR_MALFORMED_TOKEN },
+        { "{\"alg\":\"ES256\"", CVC_JWT_ERROR_MALFORMED_TOKEN },
+        { "{\"alg\":\"ES256\"} x", CVC_JWT_ERROR_MALFORMED_TOKEN },
+        { "[\"alg\",\"ES256\"]", CVC_JWT_ERROR_MALFORMED_TOKEN },
+    };
+
+    int test4_success = 1;
+    for (size_t i = 0; i < sizeof(headers) / sizeof(headers[0]) && test4_success; i++)
+    {
+        token_len = make_token_jwt(issuer, headers[i].header, "{}", token);
+        test4_success = token_len > 0 && cvc_jwt_verify_es256(token, token_len, NULL, issuer_key, 65) == headers[i].expected;
+        if (!test4_success)
+        {
+            printf("   Unexpected result for header %s\n", headers[i].header);
+        }
+    }
+
+    // Missing and extra segments
+    test4_success = test4_success && cvc_jwt_verify_es256("eyJhbGciOiJFUzI1NiJ9.e30", 24, NULL, issuer_key, 65) == CVC_JWT_ERROR_MALFORMED_TOKEN;
+    token_len = make_token_jwt(issuer, "{\"alg\":\"ES256\"}", "{}", token);
+    memcpy(token + token_len, ".e30", 5);
+    test4_success = test4_success && cvc_jwt_verify_es256(token, token_len + 4, NULL, issuer_key, 65) == CVC_JWT_ERROR_MALFORMED_TOKEN;
+    test4_success = test4_success && cvc_jwt_verify_es256(token, token_len, NULL, NULL, 65) == CVC_JWT_ERROR_INVALID_PARAMS;
+    test4_success = test4_success && cvc_jwt_verify_es256_table(token, token_len, NULL) == CVC_JWT_ERROR_INVALID_PARAMS;
+
+    // Lengths whose token would not fit in an int; nothing is read past the layout check
+    int overflow_len = 0;
+    test4_success = test4_success && cvc_jwt_es256_token_length(16, INT_MAX) == -1;
+    test4_success = test4_success && cvc_jwt_es256_token_length(16, INT_MAX / 4 * 3) == -1;
+    test4_success = test4_success && cvc_jwt_es256_token_length(16, INT_MAX / 4 * 3 - 200) > 0;
+    test4_success = test4_success && cvc_jwt_sign_es256(issuer, "{\"alg\":\"ES256\"}", 15, "{}", INT_MAX / 4 * 3, token, sizeof(token), &overflow_len) == CVC_JWT_ERROR_INVALID_PARAMS;
+    test4_success = test4_success && cvc_base64url_encode((const unsigned char*)token, INT_MAX, token, INT_MAX, &overflow_len) == CVC_JWT_ERROR_INVALID_PARAMS;
+    printf("   Status: %s\n\n", test4_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 5: Segment offsets and lazy claim lookup on a verified token
+    printf("5. Testing token view and claim lookup...\n");
+
+    const char* claims = "{\"iss\":\"cvc\", \"sub\":\"user-7\",\"exp\":4102444800,\"cnf\":{\"jwk\":{\"kty\":\"EC\"}},\"tags\":[\"a\",\"b\"]}";
+    token_len = make_token_jwt(issuer, "{\"alg\":\"ES256\",\"typ\":\"JWT\"}", claims, token);
+
+    cvc_jws_view_t view;
+    memset(&view, 0xFF, sizeof(view));
+    int test5_success = token_len > 0 && cvc_jwt_verify_es256_view(token, token_len, NULL, issuer_key, 65, &view) == CVC_JWT_SUCCESS;
+    test5_success = test5_success && view.header_offset == 0 && token[view.payload_offset - 1] == '.' && token[view.signature_offset - 1] == '.' && view.signature_len == 86;
+    test5_success = test5_success && view.signature_offset + view.signature_len == token_len;
+
+    unsigned char payload[256];
+    int payload_len = 0;
+    int value_offset = 0, value_len = 0;
+    test5_success = test5_success && cvc_base64url_decode(token + view.payload_offset, view.payload_len, payload, sizeof(payload), &payload_len) == CVC_JWT_SUCCESS;
+    test5_success = test5_success && payload_len == (int)strlen(claims) && memcmp(payload, claims, (size_t)payload_len) == 0;
+    test5_success = test5_success && cvc_jwt_find_claim(payload, payload_len, "sub", &value_offset, &value_len) == CVC_JWT_SUCCESS && value_len == 8 && memcmp(payload + value_offset, "\"user-7\"", 8) == 0;
+    test5_success = test5_success && cvc_jwt_find_claim(payload, payload_len, "exp", &value_offset, &value_len) == CVC_JWT_SUCCESS && value_len == 10 && memcmp(payload + value_offset, "4102444800", 10) == 0;
+    test5_success = test5_success && cvc_jwt_find_claim(payload, payload_len, "cnf", &value_offset, &value_len) == CVC_JWT_SUCCESS && payload[value_offset] == '{' && payload[value_offset + value_len - 1] == '}';
+    test5_success = test5_success && cvc_jwt_find_claim(payload, payload_len, "kty", &value_offset, &value_len) == CVC_JWT_ERROR_CLAIM_NOT_FOUND;
+    test5_success = test5_success && cvc_jwt_find_claim((const unsigned char*)"{\"a\":1,\"a\":2}", 13, "a", &value_offset, &value_len) == CVC_JWT_ERROR_MALFORMED_TOKEN;
+
+    // Parsing alone only splits on the dots
+    cvc_jws_view_t parsed;
+    test5_success = test5_success && cvc_jws_parse(token, token_len, &parsed) == CVC_JWT_SUCCESS && memcmp(&parsed, &view, sizeof(view)) == 0;
+    test5_success = test5_success && cvc_jws_parse("a.b", 3, &parsed) == CVC_JWT_ERROR_MALFORMED_TOKEN;
+    test5_success = test5_success && cvc_jws_parse("..", 2, &parsed) == CVC_JWT_SUCCESS && parsed.header_len == 0 && parsed.payload_len == 0 && parsed.signature_len == 0;
+    printf("   Status: %s\n\n", test5_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 6: Batch issuance matches single issuance and every token verifies
+    printf("6. Testing batch issuance of %d tokens...\n", JWT_BATCH);
+
+    static const char batch_header[] = "{\"alg\":\"ES256\",\"typ\":\"vc+sd-jwt\",\"kid\":\"issuer-1\"}";
+    const int batch_header_len = (int)strlen(batch_header);
+    int arena_size = 0;
+    for (int i = 0; i < JWT_BATCH; i++)
+    {
+        claims_lens_jwt[i] = snprintf(claims_jwt[i], sizeof(claims_jwt[i]), "{\"sub\":\"holder-%d\",\"iat\":%d,\"pad\":\"%.*s\"}", i, 1700000000 + i, i % 7, "xxxxxxx");
+        claims_ptrs_jwt[i] = claims_jwt[i];
+        arena_size += cvc_jwt_es256_token_length(batch_header_len, claims_lens_jwt[i]);
+    }
+
+    int test6_success = arena_size < (int)sizeof(arena_jwt[0]);
+    const int batch_threads[2] = { 1, 4 };
+    memset(results_jwt, 0xFF, sizeof(results_jwt));
+    for (int t = 0; t < 2 && test6_success; t++)
+    {
+        const clock_t start = clock();
+        test6_success = cvc_jwt_sign_es256_batch(issuer, batch_header, batch_header_len, claims_ptrs_jwt, claims_lens_jwt, JWT_BATCH, batch_threads[t], arena_jwt[t], arena_size, offsets_jwt[t], lens_jwt[t], t == 1 ? results_jwt : NULL) == CVC_JWT_SUCCESS;
+        printf("   %d thread(s): %.1f ms CPU\n", batch_threads[t], (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC);
+    }
+
+    // Deterministic signatures make the two runs and the single-token path byte-identical
+    test6_success = test6_success && memcmp(arena_jwt[0], arena_jwt[1], (size_t)arena_size) == 0 && memcmp(offsets_jwt[0], offsets_jwt[1], sizeof(offsets_jwt[0])) == 0;
+    for (int i = 0; i < JWT_BATCH && test6_success; i++)
+    {
+        const char* issued = arena_jwt[0] + offsets_jwt[0][i];
+        test6_success = results_jwt[i] == CVC_JWT_SUCCESS && (i == 0 || offsets_jwt[0][i] == offsets_jwt[0][i - 1] + lens_jwt[0][i - 1]) && cvc_jwt_verify_es256(issued, lens_jwt[0][i], NULL, issuer_key, 65) == CVC_JWT_SUCCESS;
+        if (test6_success && i % 50 == 0)
+        {
+            int single_len = 0;
+            test6_success = cvc_jwt_sign_es256(issuer, batch_header, batch_header_len, claims_jwt[i], claims_lens_jwt[i], token, sizeof(token), &single_len) == CVC_JWT_SUCCESS && single_len == lens_jwt[0][i] &&
+                            memcmp(token, issued, (size_t)single_len) == 0;
+        }
+    }
+
+    test6_success = test6_success && cvc_jwt_sign_es256_batch(issuer, batch_header, batch_header_len, claims_ptrs_jwt, claims_lens_jwt, JWT_BATCH, 2, arena_jwt[1], arena_size - 1, offsets_jwt[1], lens_jwt[1], NULL) == CVC_JWT_ERROR_INSUFFICIENT_BUFFER;
+    test6_success = test6_success && cvc_jwt_sign_es256_batch(issuer, "{\"alg\":\"none\"}", 14, claims_ptrs_jwt, claims_lens_jwt, JWT_BATCH, 2, arena_jwt[1], arena_size, offsets_jwt[1], lens_jwt[1], NULL) == CVC_JWT_ERROR_UNSUPPORTED_ALGORITHM;
+    printf("   Status: %s\n\n", test6_success ? "✅ PASSED" : "❌ FAILED");
+
+    cvc_nist256_keypair_destroy(issuer);
+    cvc_nist256_keypair_destroy(other);
+
+    // Summary
+    printf("=== JWT Test Summary ===\n");
+    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success && test5_success && test6_success;
+
+    if (all_tests_passed)
+    {
+        printf("🎉 All JWT tests PASSED!\n");
+        return 0;
+    }
+    else
+    {
+        printf("💥 Some JWT tests FAILED! Check the output above for details.\n");
+        return 1;
+    }
+}
@@ -0,0 +1,179 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/key_cache.h"
+#include "src/hash_to_field.h"
+#include "src/nist256_key_material.h"
+#include "src/secure_memory.h"
+
+// Helper function to compare two key materials
+int key_materials_equal_kc(const nist256_key_material_t* a, const nist256_key_material_t* b)
+{
+    return memcmp(a, b, sizeof(nist256_key_material_t)) == 0;
+}
+
+// Generate some random seed data
+void generate_random_seed_kc(unsigned char* seed, int len)
+{
+    // Simple pseudo-random for testing (not cryptographically secure for production)
+    static int seeded = 0;
+    if (!seeded)
+    {
+        srand((unsigned int)time(NULL));
+        seeded = 1;
+    }
+    for (int i = 0; i < len; i++)
+    {
+        seed[i] = (unsigned char)(rand() & 0xFF);
+    }
+}
+
+int main()
+{
+    printf("=== Derived Key Cache Test ===\n\n");
+
+    unsigned char hash_key[32];
+    unsigned char master_key[32];
+    generate_random_seed_kc(hash_key, 32);
+    generate_random_seed_kc(master_key, 32);
+    const unsigned char context[] = "test_context";
+    const unsigned char dst[] = "CVC_DERIVE_KEY";
+
+    // Test 1: Invalid parameters
+    printf("1. Testing invalid cache parameters...\n");
+
+    cvc_key_cache_t* cache = NULL;
+    cvc_key_cache_config_t config = { 64, 0, 4, 1 };
+    cvc_key_cache_config_t zero_config = { 0, 0, 4, 1 };
+
+    const int test1a_result = cvc_key_cache_create(NULL, hash_key, 32, &cache);
+    const int test1b_result = cvc_key_cache_create(&zero_config, hash_key, 32, &cache);
+    const int test1c_result = cvc_key_cache_create(&config, hash_key, 8, &cache); // Hash key too short
+    const int test1d_result = cvc_key_cache_create(&config, hash_key, 32, NULL);
+
+    printf("   NULL config result: %d\n", test1a_result);
+    printf("   Zero entries result: %d\n", test1b_result);
+    printf("   Short hash key result: %d\n", test1c_result);
+    printf("   NULL output result: %d\n", test1d_result);
+
+    const int test1_success = (test1a_result == CVC_KEY_CACHE_ERROR_INVALID_PARAMS) && (test1b_result == CVC_KEY_CACHE_ERROR_INVALID_PARAMS) && (test1c_result == CVC_KEY_CACHE_ERROR_INVALID_PARAMS) && (test1d_result == CVC_KEY_CACHE_ERROR_INVALID_PARAMS);
+    printf("   Status: %s\n\n", test1_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 2: Cached derivation matches uncached derivation, second call is a hit
+    printf("2. Testing cached derivation matches uncached derivation...\n");
+
+    const int create_result = cvc_key_cache_create(&config, hash_key, 32, &cache);
+    printf("   Cache creation result: %d\n", create_result);
+    if (create_result != CVC_KEY_CACHE_SUCCESS)
+    {
+        printf("   ❌ FAILED to create cache\n");
+        return 1;
+    }
+
+    nist256_key_material_t expected, first, second;
+    const int direct_result = cvc_derive_secret_key_nist256(master_key, 32, context, sizeof(context) - 1, dst, sizeof(dst) - 1, &expected);
+    const int first_result = cvc_derive_secret_key_nist256_cached(cache, master_key, 32, context, sizeof(context) - 1, dst, sizeof(dst) - 1, &first);
+    const int second_result = cvc_derive_secret_key_nist256_cached(cache, master_key, 32, context, sizeof(context) - 1, dst, sizeof(dst) - 1, &second);
+
+    cvc_key_cache_stats_t stats;
+    cvc_key_cache_get_stats(cache, &stats);
+
+    printf("   Direct / miss / hit results: %d / %d / %d\n", direct_result, first_result, second_result);
+    printf("   Hits: %llu, misses: %llu, entries: %llu\n", (unsigned long long)stats.hits, (unsigned long long)stats.misses, (unsigned long long)stats.entries);
+    printf("   Memory locked: %s\n", stats.memory_locked ? "YES" : "NO (allow_unlocked fallback)");
+
+    const int test2_success = (direct_result == CVC_DERIVE_KEY_SUCCESS) && (first_result == CVC_DERIVE_KEY_SUCCESS) && (second_result == CVC_DERIVE_KEY_SUCCESS) && key_materials_equal_kc(&expected, &first) && key_materials_equal_kc(&expected, &second)
+        && stats.hits == 1 && stats.misses == 1 && stats.entries == 1;
+    printf("   Status: %s\n\n", test2_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 3: Different DST is a different cache entry
+    printf("3. Testing inputs are fully part of the cache key...\n");
+
+    const unsigned char other_dst[] = "CVC_DERIVE_KEY_OTHER";
+    nist256_key_material_t other_expected, other_cached;
+    cvc_derive_secret_key_nist256(master_key, 32, context, sizeof(context) - 1, other_dst, sizeof(other_dst) - 1, &other_expected);
+    const int test3_result = cvc_derive_secret_key_nist256_cached(cache, master_key, 32, context, sizeof(context) - 1, other_dst, sizeof(other_dst) - 1, &other_cached);
+
+    cvc_key_cache_get_stats(cache, &stats);
+    const int test3_success = (test3_result == CVC_DERIVE_KEY_SUCCESS) && key_materials_equal_kc(&other_expected, &other_cached) && !key_materials_equal_kc(&expected, &other_cached) && stats.misses == 2;
+    printf("   Status: %s\n\n", test3_success ? "✅ PASSED" : "❌ FAILED");
+    cvc_key_cache_destroy(cache);
+
+    // Test 4: Entry bound and eviction counting
+    printf("4. Testing entry bound and eviction...\n");
+
+    cvc_key_cache_config_t small_config = { 8, 0, 1, 1 };
+    cvc_key_cache_create(&small_config, hash_key, 32, &cache);
+
+    int test4_success = 1;
+    for (int i = 0; i < 20; i++)
+    {
+        unsigned char numbered_context[16];
+        const int numbered_len = snprintf((char*)numbered_context, sizeof(numbered_context), "context-%d", i);
+        nist256_key_material_t key_material;
+        if (cvc_derive_secret_key_nist256_cached(cache, master_key, 32, numbered_context, numbered_len, dst, sizeof(dst) - 1, &key_material) != CVC_DERIVE_KEY_SUCCESS)
+        {
+            test4_success = 0;
+        }
+    }
+
+    cvc_key_cache_get_stats(cache, &stats);
+    printf("   Capacity: %llu, entries: %llu, evictions: %llu\n", (unsigned long long)stats.capacity, (unsigned long long)stats.entries, (unsigned long long)stats.evictions);
+    test4_success = test4_success && stats.capacity == 8 && stats.entries == 8 && stats.evictions == 12 && stats.misses == 20;
+    printf("   Status: %s\n\n", test4_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 5: Clear drops all entries
+    printf("5. Testing clear...\n");
+
+    cvc_key_cache_clear(cache);
+    cvc_key_cache_get_stats(cache, &stats);
+    const int test5_success = stats.entries == 0 && stats.bytes == 0;
+    printf("   Status: %s\n\n", test5_success ? "✅ PASSED" : "❌ FAILED");
+    cvc_key_cache_destroy(cache);
+
+    // Test 6: Byte bound limits capacity
+    printf("6. Testing byte bound...\n");
+
+    // The budget covers the HMAC state and page rounding, so less than a page holds nothing
+    const size_t page = cvc_secure_page_size();
+    cvc_key_cache_config_t byte_config = { 1000, page - 1, 0, 1 };
+    int test6_success = cvc_key_cache_create(&byte_config, hash_key, 32, &cache) == CVC_KEY_CACHE_ERROR_INVALID_PARAMS && cache == NULL;
+
+    byte_config.max_bytes = 2 * page;
+    test6_success = test6_success && cvc_key_cache_create(&byte_config, hash_key, 32, &cache) == CVC_KEY_CACHE_SUCCESS;
+    if (test6_success)
+    {
+        cvc_key_cache_get_stats(cache, &stats);
+        printf("   Capacity within %zu bytes: %llu entries\n", byte_config.max_bytes, (unsigned long long)stats.capacity);
+        test6_success = stats.capacity > 0 && stats.capacity < 1000;
+        cvc_key_cache_destroy(cache);
+    }
+    printf("   Status: %s\n\n", test6_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 7: NULL cache falls back to uncached derivation
+    printf("7. Testing NULL cache fallback...\n");
+
+    nist256_key_material_t uncached;
+    const int test7_result = cvc_derive_secret_key_nist256_cached(NULL, master_key, 32, context, sizeof(context) - 1, dst, sizeof(dst) - 1, &uncached);
+    const int test7_success = (test7_result == CVC_DERIVE_KEY_SUCCESS) && key_materials_equal_kc(&expected, &uncached);
+    printf("   Status: %s\n\n", test7_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Summary
+    printf("=== Derived Key Cache Test Summary ===\n");
+    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success && test5_success && test6_success && test7_success;
+
+    if (all_tests_passed)
+    {
+        printf("🎉 All derived key cache tests PASSED!\n");
+        return 0;
+    }
+    else
+    {
+        printf("💥 Some derived key cache tests FAILED! Check the output above for details.\n");
+        return 1;
+    }
+}
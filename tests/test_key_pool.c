@@ -0,0 +1,212 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/key_pool.h"
+#include "src/add_secret_keys.h"
+#include "src/hash_to_field.h"
+
+#define POOL_SLOTS 64
+#define POOL_THREADS 8
+#define POOL_ROUNDS 20000
+
+static cvc_key_pool_t* shared_pool_kp;
+
+// Generate some random seed data
+void generate_random_seed_kp(unsigned char* seed, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        seed[i] = (unsigned char)(rand() & 0xFF);
+    }
+}
+
+int is_zero_kp(const void* data, size_t len)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    unsigned char accumulator = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        accumulator |= bytes[i];
+    }
+    return accumulator == 0;
+}
+
+// Each thread holds a few slots at a time, stamps them with its id and checks nobody else wrote to them
+void* churn_worker_kp(void* arg)
+{
+    const unsigned char id = (unsigned char)(uintptr_t)arg;
+    int failures = 0;
+    nist256_key_material_t* held[4] = { NULL };
+
+    for (int round = 0; round < POOL_ROUNDS; round++)
+    {
+        const int slot = round % 4;
+        if (held[slot])
+        {
+            unsigned char expected[32];
+            memset(expected, id, sizeof(expected));
+            if (memcmp(held[slot]->private_key_bytes, expected, 32) != 0 || cvc_key_pool_free(shared_pool_kp, held[slot]) != CVC_KEY_POOL_SUCCESS)
+            {
+                failures++;
+            }
+            held[slot] = NULL;
+        }
+
+        held[slot] = cvc_key_pool_alloc(shared_pool_kp);
+        if (held[slot])
+        {
+            if (!is_zero_kp(held[slot], sizeof(nist256_key_material_t)))
+            {
+                failures++;
+            }
+            memset(held[slot]->private_key_bytes, id, 32);
+        }
+    }
+
+    for (int slot = 0; slot < 4; slot++)
+    {
+        if (held[slot] && cvc_key_pool_free(shared_pool_kp, held[slot]) != CVC_KEY_POOL_SUCCESS)
+        {
+            failures++;
+        }
+    }
+    return (void*)(uintptr_t)failures;
+}
+
+int main()
+{
+    printf("=== Key Pool Test ===\n\n");
+    srand((unsigned int)time(NULL));
+
+    // Test 1: Create with valid and invalid parameters
+    printf("1. Testing pool creation...\n");
+
+    cvc_key_pool_config_t config = { POOL_SLOTS, 1 };
+    cvc_key_pool_t* pool = NULL;
+    const int test1a_result = cvc_key_pool_create(&config, &pool);
+    cvc_key_pool_config_t bad_config = { 0, 1 };
+    cvc_key_pool_t* rejected = NULL;
+    const int test1b_result = cvc_key_pool_create(&bad_config, &rejected);
+
+    cvc_key_pool_stats_t stats;
+    cvc_key_pool_get_stats(pool, &stats);
+    printf("   Capacity: %llu, memory locked: %s\n", (unsigned long long)stats.capacity, stats.memory_locked ? "yes" : "no");
+
+    const int test1_success = (test1a_result == CVC_KEY_POOL_SUCCESS) && pool && (test1b_result == CVC_KEY_POOL_ERROR_INVALID_PARAMS) && !rejected && stats.capacity == POOL_SLOTS;
+    printf("   Status: %s\n\n", test1_success ? "✅ PASSED" : "❌ FAILED");
+    if (!pool)
+    {
+        return 1;
+    }
+
+    // Test 2: Slots are usable as outputs of derive, add and generate
+    printf("2. Testing slots as key material outputs...\n");
+
+    const unsigned char master_key[32] = { 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7 };
+    const unsigned char context[] = "pool-context";
+    const unsigned char dst[] = "CVC_KEY_POOL_TEST";
+    unsigned char seed[32];
+    generate_random_seed_kp(seed, sizeof(seed));
+
+    nist256_key_material_t* derived = cvc_key_pool_alloc(pool);
+    nist256_key_material_t* generated = cvc_key_pool_alloc(pool);
+    nist256_key_material_t* sum = cvc_key_pool_alloc(pool);
+    nist256_key_material_t expected_derived, expected_generated, expected_sum;
+
+    int test2_success = derived && generated && sum;
+    test2_success = test2_success && cvc_derive_secret_key_nist256(master_key, 32, context, sizeof(context) - 1, dst, sizeof(dst) - 1, derived) == CVC_DERIVE_KEY_SUCCESS;
+    test2_success = test2_success && nist256_generate_key_material(seed, sizeof(seed), generated) == 0;
+    test2_success = test2_success && cvc_add_nist256_secret_keys(derived->private_key_bytes, 32, generated->private_key_bytes, 32, sum) == CVC_ADD_SECRET_KEYS_SUCCESS;
+
+    cvc_derive_secret_key_nist256(master_key, 32, context, sizeof(context) - 1, dst, sizeof(dst) - 1, &expected_derived);
+    nist256_generate_key_material(seed, sizeof(seed), &expected_generated);
+    cvc_add_nist256_secret_keys(expected_derived.private_key_bytes, 32, expected_generated.private_key_bytes, 32, &expected_sum);
+
+    test2_success = test2_success && memcmp(derived, &expected_derived, sizeof(expected_derived)) == 0 && memcmp(generated, &expected_generated, sizeof(expected_generated)) == 0 &&
+                    memcmp(sum, &expected_sum, sizeof(expected_sum)) == 0;
+    printf("   Status: %s\n\n", test2_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 3: Free zeroizes, and double or foreign frees are rejected
+    printf("3. Testing zeroize on free and free validation...\n");
+
+    const int test3a_result = cvc_key_pool_free(pool, derived);
+    const int zeroed = is_zero_kp(derived, sizeof(nist256_key_material_t)); // Slot memory stays mapped while the pool lives
+    const int test3b_result = cvc_key_pool_free(pool, derived);
+    const int test3c_result = cvc_key_pool_free(pool, &expected_derived);
+    const int test3d_result = cvc_key_pool_free(pool, (nist256_key_material_t*)((unsigned char*)generated + 8));
+
+    printf("   Slot zeroed after free: %s\n", zeroed ? "yes" : "no");
+    const int test3_success = (test3a_result == CVC_KEY_POOL_SUCCESS) && zeroed && (test3b_result == CVC_KEY_POOL_ERROR_NOT_ALLOCATED) && (test3c_result == CVC_KEY_POOL_ERROR_NOT_ALLOCATED) &&
+                              (test3d_result == CVC_KEY_POOL_ERROR_NOT_ALLOCATED);
+    cvc_key_pool_free(pool, generated);
+    cvc_key_pool_free(pool, sum);
+    printf("   Status: %s\n\n", test3_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 4: Exhaustion returns NULL and the pool recovers once slots come back
+    printf("4. Testing exhaustion...\n");
+
+    nist256_key_material_t* all[POOL_SLOTS];
+    int test4_success = 1;
+    for (int i = 0; i < POOL_SLOTS; i++)
+    {
+        all[i] = cvc_key_pool_alloc(pool);
+        test4_success = test4_success && all[i] != NULL;
+    }
+    test4_success = test4_success && cvc_key_pool_alloc(pool) == NULL;
+    cvc_key_pool_get_stats(pool, &stats);
+    test4_success = test4_success && stats.in_use == POOL_SLOTS && stats.exhausted == 1;
+
+    for (int i = 0; i < POOL_SLOTS; i++)
+    {
+        test4_success = test4_success && cvc_key_pool_free(pool, all[i]) == CVC_KEY_POOL_SUCCESS;
+    }
+    nist256_key_material_t* again = cvc_key_pool_alloc(pool);
+    test4_success = test4_success && again != NULL && cvc_key_pool_free(pool, again) == CVC_KEY_POOL_SUCCESS;
+    cvc_key_pool_get_stats(pool, &stats);
+    test4_success = test4_success && stats.in_use == 0;
+    printf("   Status: %s\n\n", test4_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 5: Concurrent allocate and free never hand one slot to two threads
+    printf("5. Testing concurrent allocate and free...\n");
+
+    shared_pool_kp = pool;
+    pthread_t threads[POOL_THREADS];
+    for (int i = 0; i < POOL_THREADS; i++)
+    {
+        pthread_create(&threads[i], NULL, churn_worker_kp, (void*)(uintptr_t)(i + 1));
+    }
+    int total_failures = 0;
+    for (int i = 0; i < POOL_THREADS; i++)
+    {
+        void* failures = NULL;
+        pthread_join(threads[i], &failures);
+        total_failures += (int)(uintptr_t)failures;
+    }
+
+    cvc_key_pool_get_stats(pool, &stats);
+    printf("   Failures: %d, in use afterwards: %llu\n", total_failures, (unsigned long long)stats.in_use);
+    const int test5_success = total_failures == 0 && stats.in_use == 0;
+    printf("   Status: %s\n\n", test5_success ? "✅ PASSED" : "❌ FAILED");
+
+    cvc_key_pool_destroy(pool);
+
+    // Summary
+    printf("=== Key Pool Test Summary ===\n");
+    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success && test5_success;
+
+    if (all_tests_passed)
+    {
+        printf("🎉 All key pool tests PASSED!\n");
+        return 0;
+    }
+    else
+    {
+        printf("💥 Some key pool tests FAILED! Check the output above for details.\n");
+        return 1;
+    }
+}
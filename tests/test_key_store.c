@@ -0,0 +1,219 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/key_store.h"
+#include "src/nist256_key_material.h"
+#include "src/public_derive.h"
+
+#define STORE_KEYS 1000
+
+static const char store_path_ks[] = "test_key_store.cvks";
+static const unsigned char dst_ks[] = "CVC-KEY-STORE-TEST-V01";
+
+// Generate some random seed data
+void generate_random_seed_ks(unsigned char* seed, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        seed[i] = (unsigned char)(rand() & 0xFF);
+    }
+}
+
+void key_material_to_public_ks(const nist256_key_material_t* key_material, unsigned char* public_key)
+{
+    public_key[0] = 0x04;
+    memcpy(public_key + 1, key_material->public_key_x_bytes, 32);
+    memcpy(public_key + 33, key_material->public_key_y_bytes, 32);
+}
+
+// Read the whole store file; the caller frees the buffer
+unsigned char* read_file_ks(const char* path, long* size)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file)
+    {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    *size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char* data = malloc((size_t)*size);
+    if (data && fread(data, 1, (size_t)*size, file) != (size_t)*size)
+    {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    return data;
+}
+
+int write_file_ks(const char* path, const unsigned char* data, long size)
+{
+    FILE* file = fopen(path, "wb");
+    if (!file)
+    {
+        return 0;
+    }
+    const int written = fwrite(data, 1, (size_t)size, file) == (size_t)size;
+    return fclose(file) == 0 && written;
+}
+
+int contains_ks(const unsigned char* haystack, long haystack_len, const unsigned char* needle, int needle_len)
+{
+    for (long i = 0; i + needle_len <= haystack_len; i++)
+    {
+        if (memcmp(haystack + i, needle, (size_t)needle_len) == 0)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main()
+{
+    printf("=== Key Store Test ===\n\n");
+    srand((unsigned int)time(NULL));
+
+    unsigned char master_secret[32];
+    generate_random_seed_ks(master_secret, sizeof(master_secret));
+    master_secret[0] &= 0x7F;
+
+    static unsigned char contexts[STORE_KEYS][24];
+    const unsigned char* context_ptrs[STORE_KEYS];
+    int context_lens[STORE_KEYS];
+    for (int i = 0; i < STORE_KEYS; i++)
+    {
+        context_lens[i] = snprintf((char*)contexts[i], sizeof(contexts[i]), "holder/%d", i);
+        context_ptrs[i] = contexts[i];
+    }
+
+    static nist256_key_material_t key_materials[STORE_KEYS];
+    if (cvc_derive_additive_secret_keys_nist256_batch(master_secret, 32, context_ptrs, context_lens, STORE_KEYS, dst_ks, sizeof(dst_ks) - 1, key_materials) != CVC_PUBLIC_DERIVE_SUCCESS)
+    {
+        printf("💥 Failed to derive the test keys\n");
+        return 1;
+    }
+
+    // Test 1: Every written key comes back from the mapped file
+    printf("1. Testing write and lookup of %d keys...\n", STORE_KEYS);
+
+    int test1_success = cvc_key_store_write(store_path_ks, context_ptrs, context_lens, key_materials, STORE_KEYS) == CVC_KEY_STORE_SUCCESS;
+    cvc_key_store_t* store = NULL;
+    test1_success = test1_success && cvc_key_store_open(store_path_ks, &store) == CVC_KEY_STORE_SUCCESS;
+    test1_success = test1_success && cvc_key_store_count(store) == STORE_KEYS;
+    for (int i = 0; i < STORE_KEYS && test1_success; i++)
+    {
+        unsigned char found[65], expected[65];
+        key_material_to_public_ks(&key_materials[i], expected);
+        test1_success = cvc_key_store_lookup(store, contexts[i], context_lens[i], found, sizeof(found)) == CVC_KEY_STORE_SUCCESS && memcmp(found, expected, 65) == 0;
+        if (!test1_success)
+        {
+            printf("   Lookup failed for context %d\n", i);
+        }
+    }
+    printf("   Status: %s\n\n", test1_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 2: Absent contexts miss, and only public halves reach the disk
+    printf("2. Testing misses and the file contents...\n");
+
+    int test2_success = store != NULL;
+    for (int i = 0; i < 200 && test2_success; i++)
+    {
+        unsigned char context[24], found[65];
+        const int context_len = snprintf((char*)context, sizeof(context), "stranger/%d", i);
+        test2_success = cvc_key_store_lookup(store, context, context_len, found, sizeof(found)) == CVC_KEY_STORE_ERROR_NOT_FOUND;
+    }
+
+    long file_size = 0;
+    unsigned char* file_data = read_file_ks(store_path_ks, &file_size);
+    test2_success = test2_success && file_data && memcmp(file_data, "CVKS", 4) == 0;
+    test2_success = test2_success && file_size == CVC_KEY_STORE_HEADER_SIZE + 2048L * CVC_KEY_STORE_SLOT_SIZE;
+    for (int i = 0; i < 16 && test2_success; i++)
+    {
+        test2_success = !contains_ks(file_data, file_size, key_materials[i].private_key_bytes, 32);
+    }
+    printf("   File size: %ld bytes for %d keys\n", file_size, STORE_KEYS);
+    printf("   Status: %s\n\n", test2_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 3: Replacing the file leaves existing mappings on the old contents
+    printf("3. Testing replacement while a store is open...\n");
+
+    int test3_success = store != NULL;
+    const int half = STORE_KEYS / 2;
+    test3_success = test3_success && cvc_key_store_write(store_path_ks, context_ptrs + half, context_lens + half, key_materials + half, STORE_KEYS - half) == CVC_KEY_STORE_SUCCESS;
+
+    cvc_key_store_t* replaced = NULL;
+    test3_success = test3_success && cvc_key_store_open(store_path_ks, &replaced) == CVC_KEY_STORE_SUCCESS;
+    test3_success = test3_success && cvc_key_store_count(replaced) == STORE_KEYS - half;
+
+    unsigned char found[65], expected[65];
+    key_material_to_public_ks(&key_materials[0], expected);
+    test3_success = test3_success && cvc_key_store_lookup(store, contexts[0], context_lens[0], found, sizeof(found)) == CVC_KEY_STORE_SUCCESS && memcmp(found, expected, 65) == 0;
+    test3_success = test3_success && cvc_key_store_lookup(replaced, contexts[0], context_lens[0], found, sizeof(found)) == CVC_KEY_STORE_ERROR_NOT_FOUND;
+    key_material_to_public_ks(&key_materials[STORE_KEYS - 1], expected);
+    test3_success = test3_success && cvc_key_store_lookup(replaced, contexts[STORE_KEYS - 1], context_lens[STORE_KEYS - 1], found, sizeof(found)) == CVC_KEY_STORE_SUCCESS && memcmp(found, expected, 65) == 0;
+    cvc_key_store_close(replaced);
+    printf("   Status: %s\n\n", test3_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 4: Error handling
+    printf("4. Testing error handling...\n");
+
+    int test4_success = 1;
+    cvc_key_store_t* bad = NULL;
+    test4_success = test4_success && cvc_key_store_write(NULL, context_ptrs, context_lens, key_materials, 4) == CVC_KEY_STORE_ERROR_INVALID_PARAMS;
+    test4_success = test4_success && cvc_key_store_write(store_path_ks, context_ptrs, context_lens, key_materials, 0) == CVC_KEY_STORE_ERROR_INVALID_PARAMS;
+    test4_success = test4_success && cvc_key_store_open("does-not-exist.cvks", &bad) == CVC_KEY_STORE_ERROR_IO_FAILED && bad == NULL;
+    test4_success = test4_success && cvc_key_store_lookup(store, contexts[0], context_lens[0], found, 64) == CVC_KEY_STORE_ERROR_INSUFFICIENT_BUFFER;
+    test4_success = test4_success && cvc_key_store_lookup(NULL, contexts[0], context_lens[0], found, sizeof(found)) == CVC_KEY_STORE_ERROR_INVALID_PARAMS;
+
+    // The same context twice
+    const unsigned char* duplicate_ptrs[3] = { contexts[0], contexts[1], contexts[0] };
+    const int duplicate_lens[3] = { context_lens[0], context_lens[1], context_lens[0] };
+    test4_success = test4_success && cvc_key_store_write(store_path_ks, duplicate_ptrs, duplicate_lens, key_materials, 3) == CVC_KEY_STORE_ERROR_DUPLICATE_CONTEXT;
+
+    // Truncated and relabelled files; file_data still holds the first store
+    test4_success = test4_success && file_data && write_file_ks(store_path_ks, file_data, file_size - CVC_KEY_STORE_SLOT_SIZE);
+    test4_success = test4_success && cvc_key_store_open(store_path_ks, &bad) == CVC_KEY_STORE_ERROR_INVALID_FORMAT;
+    test4_success = test4_success && write_file_ks(store_path_ks, file_data, 8);
+    test4_success = test4_success && cvc_key_store_open(store_path_ks, &bad) == CVC_KEY_STORE_ERROR_INVALID_FORMAT;
+
+    // A set reserved header byte is a layout this version does not know
+    if (file_data)
+    {
+        file_data[CVC_KEY_STORE_HEADER_SIZE - 1] = 0x01;
+    }
+    test4_success = test4_success && write_file_ks(store_path_ks, file_data, file_size);
+    test4_success = test4_success && cvc_key_store_open(store_path_ks, &bad) == CVC_KEY_STORE_ERROR_INVALID_FORMAT;
+    if (file_data)
+    {
+        file_data[CVC_KEY_STORE_HEADER_SIZE - 1] = 0x00;
+        file_data[0] ^= 0xFF;
+    }
+    test4_success = test4_success && write_file_ks(store_path_ks, file_data, file_size);
+    test4_success = test4_success && cvc_key_store_open(store_path_ks, &bad) == CVC_KEY_STORE_ERROR_INVALID_FORMAT;
+    printf("   Status: %s\n\n", test4_success ? "✅ PASSED" : "❌ FAILED");
+
+    cvc_key_store_close(store);
+    free(file_data);
+    remove(store_path_ks);
+
+    // Summary
+    printf("=== Key Store Test Summary ===\n");
+    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success;
+
+    if (all_tests_passed)
+    {
+        printf("🎉 All key store tests PASSED!\n");
+        return 0;
+    }
+    else
+    {
+        printf("💥 Some key store tests FAILED! Check the output above for details.\n");
+        return 1;
+    }
+}
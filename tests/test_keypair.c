@@ -0,0 +1,242 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/keypair.h"
+#include "src/add_secret_keys.h"
+#include "src/hash_to_field.h"
+#include "src/sha256.h"
+
+#define SIGN_THREADS 4
+
+// RFC 6979, Appendix A.2.5: P-256 key and the SHA-256 signature of "sample"
+static const unsigned char rfc6979_private_key[32] = { 0xC9, 0xAF, 0xA9, 0xD8, 0x45, 0xBA, 0x75, 0x16, 0x6B, 0x5C, 0x21, 0x57, 0x67, 0xB1, 0xD6, 0x93,
+                                                       0x4E, 0x50, 0xC3, 0xDB, 0x36, 0xE8, 0x9B, 0x12, 0x7B, 0x8A, 0x62, 0x2B, 0x12, 0x0F, 0x67, 0x21 };
+static const unsigned char rfc6979_signature[64] = { 0xEF, 0xD4, 0x8B, 0x2A, 0xAC, 0xB6, 0xA8, 0xFD, 0x11, 0x40, 0xDD, 0x9C, 0xD4, 0x5E, 0x81, 0xD6, 0x9D, 0x2C, 0x87, 0x7B, 0x56, 0xAA,
+                                                     0xF9, 0x91, 0xC3, 0x4D, 0x0E, 0xA8, 0x4E, 0xAF, 0x37, 0x16, 0xF7, 0xCB, 0x1C, 0x94, 0x2D, 0x65, 0x7C, 0x41, 0xD4, 0x36, 0xC7, 0xA1,
+                                                     0xB6, 0xE2, 0x9F, 0x65, 0xF3, 0xE9, 0x00, 0xDB, 0xB9, 0xAF, 0xF4, 0x06, 0x4D, 0xC4, 0xAB, 0x2F, 0x84, 0x3A, 0xCD, 0xA8 };
+
+static cvc_nist256_keypair_t* shared_keypair_kpr;
+static unsigned char shared_digest_kpr[32];
+
+// Generate some random seed data
+void generate_random_seed_kpr(unsigned char* seed, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        seed[i] = (unsigned char)(rand() & 0xFF);
+    }
+}
+
+// Print hex bytes for debugging
+void print_hex_kpr(const char* label, const unsigned char* data, int len)
+{
+    printf("   %s: ", label);
+    for (int i = 0; i < len; i++)
+    {
+        printf("%02x", data[i]);
+    }
+    printf("\n");
+}
+
+// Each thread signs the shared digest with the shared key pair and returns the signature
+void* sign_worker_kpr(void* arg)
+{
+    unsigned char* signature = (unsigned char*)arg;
+    for (int i = 0; i < 50; i++)
+    {
+        if (cvc_nist256_keypair_sign(shared_keypair_kpr, shared_digest_kpr, 32, signature, 64) != CVC_KEYPAIR_SUCCESS)
+        {
+            memset(signature, 0, 64);
+            break;
+        }
+    }
+    return NULL;
+}
+
+int main()
+{
+    printf("=== Key Pair Handle Test ===\n\n");
+    srand((unsigned int)time(NULL));
+
+    // Test 1: Import from secret bytes and export
+    printf("1. Testing import and export...\n");
+
+    unsigned char seed[32];
+    generate_random_seed_kpr(seed, sizeof(seed));
+    nist256_key_material_t expected_material, exported_material;
+    nist256_generate_key_material(seed, sizeof(seed), &expected_material);
+
+    cvc_nist256_keypair_t* imported = NULL;
+    cvc_nist256_keypair_t* generated = NULL;
+    const int test1a_result = cvc_nist256_keypair_from_secret(expected_material.private_key_bytes, 32, 0, &imported);
+    const int test1b_result = cvc_nist256_keypair_generate(seed, sizeof(seed), 0, &generated);
+
+    unsigned char public_key[65], generated_public_key[65];
+    int test1_success = (test1a_result == CVC_KEYPAIR_SUCCESS) && (test1b_result == CVC_KEYPAIR_SUCCESS);
+    test1_success = test1_success && cvc_nist256_keypair_export(imported, &exported_material) == CVC_KEYPAIR_SUCCESS && memcmp(&exported_material, &expected_material, sizeof(expected_material)) == 0;
+    test1_success = test1_success && cvc_nist256_keypair_public_key(imported, public_key, sizeof(public_key)) == CVC_KEYPAIR_SUCCESS && public_key[0] == 0x04 &&
+                    memcmp(public_key + 1, expected_material.public_key_x_bytes, 32) == 0 && memcmp(public_key + 33, expected_material.public_key_y_bytes, 32) == 0;
+    test1_success = test1_success && cvc_nist256_keypair_public_key(generated, generated_public_key, sizeof(generated_public_key)) == CVC_KEYPAIR_SUCCESS &&
+                    memcmp(public_key, generated_public_key, 65) == 0;
+
+    // Zero and the curve order itself are not valid secrets
+    const unsigned char zero_key[32] = { 0 };
+    const unsigned char order_key[32] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                                          0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x51 };
+    cvc_nist256_keypair_t* rejected = NULL;
+    test1_success = test1_success && cvc_nist256_keypair_from_secret(zero_key, 32, 0, &rejected) == CVC_KEYPAIR_ERROR_INVALID_KEY && !rejected;
+    test1_success = test1_success && cvc_nist256_keypair_from_secret(order_key, 32, 0, &rejected) == CVC_KEYPAIR_ERROR_INVALID_KEY && !rejected;
+    test1_success = test1_success && cvc_nist256_keypair_from_secret(order_key, 31, 0, &rejected) == CVC_KEYPAIR_ERROR_INVALID_PARAMS;
+
+    print_hex_kpr("Public key", public_key, 65);
+    printf("   Status: %s\n\n", test1_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 2: Derivation matches the byte-oriented API
+    printf("2. Testing derive and derive_child...\n");
+
+    const unsigned char master_key[32] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32 };
+    const unsigned char context[] = "keypair-context";
+    const unsigned char child_context[] = "keypair-child";
+    const unsigned char dst[] = "CVC_KEYPAIR_TEST";
+
+    nist256_key_material_t expected_derived, expected_child;
+    cvc_derive_secret_key_nist256(master_key, 32, context, sizeof(context) - 1, dst, sizeof(dst) - 1, &expected_derived);
+    cvc_derive_secret_key_nist256(expected_derived.private_key_bytes, 32, child_context, sizeof(child_context) - 1, dst, sizeof(dst) - 1, &expected_child);
+
+    cvc_nist256_keypair_t* derived = NULL;
+    cvc_nist256_keypair_t* child = NULL;
+    int test2_success = cvc_nist256_keypair_derive(master_key, 32, context, sizeof(context) - 1, dst, sizeof(dst) - 1, 0, &derived) == CVC_KEYPAIR_SUCCESS;
+    test2_success = test2_success && cvc_nist256_keypair_derive_child(derived, child_context, sizeof(child_context) - 1, dst, sizeof(dst) - 1, CVC_KEYPAIR_PRECOMPUTE, &child) == CVC_KEYPAIR_SUCCESS;
+    test2_success = test2_success && cvc_nist256_keypair_export(derived, &exported_material) == CVC_KEYPAIR_SUCCESS && memcmp(&exported_material, &expected_derived, sizeof(expected_derived)) == 0;
+    test2_success = test2_success && cvc_nist256_keypair_export(child, &exported_material) == CVC_KEYPAIR_SUCCESS && memcmp(&exported_material, &expected_child, sizeof(expected_child)) == 0;
+    printf("   Status: %s\n\n", test2_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 3: Addition matches cvc_add_nist256_secret_keys, and d + (n - d) is rejected
+    printf("3. Testing add...\n");
+
+    nist256_key_material_t expected_sum;
+    cvc_add_nist256_secret_keys(expected_derived.private_key_bytes, 32, expected_material.private_key_bytes, 32, &expected_sum);
+
+    cvc_nist256_keypair_t* sum = NULL;
+    int test3_success = cvc_nist256_keypair_add(derived, imported, 0, &sum) == CVC_KEYPAIR_SUCCESS;
+    test3_success = test3_success && cvc_nist256_keypair_export(sum, &exported_material) == CVC_KEYPAIR_SUCCESS && memcmp(&exported_material, &expected_sum, sizeof(expected_sum)) == 0;
+
+    // n - d by schoolbook subtraction on the big-endian bytes
+    unsigned char negated_key[32];
+    int borrow = 0;
+    for (int i = 31; i >= 0; i--)
+    {
+        const int difference = order_key[i] - expected_derived.private_key_bytes[i] - borrow;
+        negated_key[i] = (unsigned char)difference;
+        borrow = difference < 0;
+    }
+    cvc_nist256_keypair_t* negated = NULL;
+    cvc_nist256_keypair_t* zero_sum = NULL;
+    test3_success = test3_success && cvc_nist256_keypair_from_secret(negated_key, 32, 0, &negated) == CVC_KEYPAIR_SUCCESS;
+    test3_success = test3_success && cvc_nist256_keypair_add(derived, negated, 0, &zero_sum) == CVC_KEYPAIR_ERROR_RESULT_ZERO && !zero_sum;
+    printf("   Status: %s\n\n", test3_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 4: Both sides of ECDH agree, and bad peer keys are rejected
+    printf("4. Testing ECDH...\n");
+
+    unsigned char derived_public_key[65];
+    unsigned char shared_ab[32], shared_ba[32];
+    cvc_nist256_keypair_public_key(derived, derived_public_key, sizeof(derived_public_key));
+
+    int test4_success = cvc_nist256_keypair_ecdh(imported, NULL, derived_public_key, 65, shared_ab, sizeof(shared_ab)) == CVC_KEYPAIR_SUCCESS;
+    test4_success = test4_success && cvc_nist256_keypair_ecdh(derived, NULL, public_key, 65, shared_ba, sizeof(shared_ba)) == CVC_KEYPAIR_SUCCESS;
+    test4_success = test4_success && memcmp(shared_ab, shared_ba, 32) == 0;
+
+    unsigned char off_curve[65];
+    memcpy(off_curve, derived_public_key, 65);
+    off_curve[64] ^= 1;
+    test4_success = test4_success && cvc_nist256_keypair_ecdh(imported, NULL, off_curve, 65, shared_ab, sizeof(shared_ab)) == CVC_KEYPAIR_ERROR_INVALID_PEER_KEY;
+    test4_success = test4_success && cvc_nist256_keypair_ecdh(imported, NULL, derived_public_key, 64, shared_ab, sizeof(shared_ab)) == CVC_KEYPAIR_ERROR_INVALID_PEER_KEY;
+    test4_success = test4_success && cvc_nist256_keypair_ecdh(imported, NULL, derived_public_key, 65, shared_ab, 31) == CVC_KEYPAIR_ERROR_INSUFFICIENT_BUFFER;
+
+    print_hex_kpr("Shared secret", shared_ba, 32);
+    printf("   Status: %s\n\n", test4_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 5: RFC 6979 test vector, and verification with and without the per-key table
+    printf("5. Testing deterministic ECDSA sign and verify...\n");
+
+    unsigned char digest[32];
+    cvc_sha256((const unsigned char*)"sample", 6, digest);
+
+    cvc_nist256_keypair_t* rfc_key = NULL;
+    cvc_nist256_keypair_t* rfc_key_precomputed = NULL;
+    unsigned char signature[64];
+    int test5_success = cvc_nist256_keypair_from_secret(rfc6979_private_key, 32, 0, &rfc_key) == CVC_KEYPAIR_SUCCESS;
+    test5_success = test5_success && cvc_nist256_keypair_from_secret(rfc6979_private_key, 32, CVC_KEYPAIR_PRECOMPUTE, &rfc_key_precomputed) == CVC_KEYPAIR_SUCCESS;
+    test5_success = test5_success && cvc_nist256_keypair_sign(rfc_key, digest, 32, signature, sizeof(signature)) == CVC_KEYPAIR_SUCCESS;
+    test5_success = test5_success && memcmp(signature, rfc6979_signature, 64) == 0;
+    test5_success = test5_success && cvc_nist256_keypair_verify(rfc_key, digest, 32, signature, 64) == CVC_KEYPAIR_SUCCESS;
+    test5_success = test5_success && cvc_nist256_keypair_verify(rfc_key_precomputed, digest, 32, signature, 64) == CVC_KEYPAIR_SUCCESS;
+
+    signature[10] ^= 0x40;
+    test5_success = test5_success && cvc_nist256_keypair_verify(rfc_key, digest, 32, signature, 64) == CVC_KEYPAIR_ERROR_INVALID_SIGNATURE;
+    test5_success = test5_success && cvc_nist256_keypair_verify(rfc_key_precomputed, digest, 32, signature, 64) == CVC_KEYPAIR_ERROR_INVALID_SIGNATURE;
+    signature[10] ^= 0x40;
+    test5_success = test5_success && cvc_nist256_keypair_verify(imported, digest, 32, signature, 64) == CVC_KEYPAIR_ERROR_INVALID_SIGNATURE;
+
+    print_hex_kpr("Signature", signature, 64);
+    printf("   Status: %s\n\n", test5_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 6: A derive -> add -> sign chain verifies, and a shared key signs identically from several threads
+    printf("6. Testing chained operations and concurrent signing...\n");
+
+    cvc_nist256_keypair_t* chained = NULL;
+    int test6_success = cvc_nist256_keypair_add(child, sum, CVC_KEYPAIR_PRECOMPUTE, &chained) == CVC_KEYPAIR_SUCCESS;
+
+    shared_keypair_kpr = chained;
+    generate_random_seed_kpr(shared_digest_kpr, sizeof(shared_digest_kpr));
+    unsigned char reference_signature[64];
+    test6_success = test6_success && cvc_nist256_keypair_sign(chained, shared_digest_kpr, 32, reference_signature, sizeof(reference_signature)) == CVC_KEYPAIR_SUCCESS;
+    test6_success = test6_success && cvc_nist256_keypair_verify(chained, shared_digest_kpr, 32, reference_signature, 64) == CVC_KEYPAIR_SUCCESS;
+
+    pthread_t threads[SIGN_THREADS];
+    unsigned char thread_signatures[SIGN_THREADS][64];
+    for (int i = 0; i < SIGN_THREADS && test6_success; i++)
+    {
+        pthread_create(&threads[i], NULL, sign_worker_kpr, thread_signatures[i]);
+    }
+    for (int i = 0; i < SIGN_THREADS && test6_success; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    for (int i = 0; i < SIGN_THREADS && test6_success; i++)
+    {
+        test6_success = memcmp(thread_signatures[i], reference_signature, 64) == 0;
+    }
+    printf("   Status: %s\n\n", test6_success ? "✅ PASSED" : "❌ FAILED");
+
+    cvc_nist256_keypair_destroy(imported);
+    cvc_nist256_keypair_destroy(generated);
+    cvc_nist256_keypair_destroy(derived);
+    cvc_nist256_keypair_destroy(child);
+    cvc_nist256_keypair_destroy(sum);
+    cvc_nist256_keypair_destroy(negated);
+    cvc_nist256_keypair_destroy(rfc_key);
+    cvc_nist256_keypair_destroy(rfc_key_precomputed);
+    cvc_nist256_keypair_destroy(chained);
+
+    // Summary
+    printf("=== Key Pair Handle Test Summary ===\n");
+    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success && test5_success && test6_success;
+
+    if (all_tests_passed)
+    {
+        printf("🎉 All key pair tests PASSED!\n");
+        return 0;
+    }
+    else
+    {
+        printf("💥 Some key pair tests FAILED! Check the output above for details.\n");
+        return 1;
+    }
+}
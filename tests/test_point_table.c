@@ -0,0 +1,216 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/point_table.h"
+#include "src/ecdh.h"
+#include "src/keypair.h"
+#include "src/nist256_key_material.h"
+#include "src/sha256.h"
+
+#define TABLE_SCALARS 32
+
+static unsigned char serialized_pt[CVC_POINT_TABLE_SERIALIZED_SIZE];
+
+// (5, y) is on P-256, and 5 + p still fits in 32 bytes
+static const unsigned char small_x_public_pt[65] = { 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05,
+                                                     0x45, 0x92, 0x43, 0xB9, 0xAA, 0x58, 0x18, 0x06, 0xFE, 0x91, 0x3B, 0xCE, 0x99, 0x81, 0x7A, 0xDE, 0x11, 0xCA, 0x50, 0x3C, 0x64, 0xD9, 0xA3, 0xC5, 0x33, 0x41, 0x5C, 0x08, 0x32, 0x48, 0xFB, 0xCC };
+static const unsigned char small_x_plus_p_pt[32] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04 };
+
+// Recompute the trailing SHA-256 after editing a serialized table
+void reseal_pt(unsigned char* serialized)
+{
+    const size_t body_len = CVC_POINT_TABLE_SERIALIZED_SIZE - CVC_SHA256_DIGEST_SIZE;
+    cvc_sha256(serialized, body_len, serialized + body_len);
+}
+
+// Generate some random seed data
+void generate_random_seed_pt(unsigned char* seed, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        seed[i] = (unsigned char)(rand() & 0xFF);
+    }
+}
+
+// Reference result: scalar * P through MIRACL's variable-base multiplication
+int reference_multiply_pt(const unsigned char* public_key, const unsigned char* scalar, unsigned char* result)
+{
+    ECP_NIST256 P;
+    octet key_octet = { 65, 65, (char*)public_key };
+    if (!ECP_NIST256_fromOctet(&P, &key_octet))
+    {
+        return 0;
+    }
+
+    BIG_256_56 d;
+    BIG_256_56_fromBytes(d, (char*)scalar);
+    ECP_NIST256_mul(&P, d);
+
+    octet result_octet = { 0, 65, (char*)result };
+    ECP_NIST256_toOctet(&result_octet, &P, false);
+    return result_octet.len == 65;
+}
+
+int main()
+{
+    printf("=== Point Table Test ===\n\n");
+    srand((unsigned int)time(NULL));
+
+    unsigned char seed[32];
+    nist256_key_material_t issuer;
+    generate_random_seed_pt(seed, sizeof(seed));
+    nist256_generate_key_material(seed, sizeof(seed), &issuer);
+    unsigned char issuer_public[65];
+    issuer_public[0] = 0x04;
+    memcpy(issuer_public + 1, issuer.public_key_x_bytes, 32);
+    memcpy(issuer_public + 33, issuer.public_key_y_bytes, 32);
+
+    // Test 1: Precompute a valid key and reject invalid ones
+    printf("1. Testing precomputation...\n");
+
+    cvc_nist256_point_table_t* table = NULL;
+    const clock_t build_start = clock();
+    const int test1a_result = cvc_nist256_point_precompute(issuer_public, 65, &table);
+    const double build_ms = (double)(clock() - build_start) * 1000.0 / CLOCKS_PER_SEC;
+
+    unsigned char off_curve[65];
+    memcpy(off_curve, issuer_public, 65);
+    off_curve[64] ^= 1;
+    cvc_nist256_point_table_t* rejected = NULL;
+    const int test1b_result = cvc_nist256_point_precompute(off_curve, 65, &rejected);
+    const int test1c_result = cvc_nist256_point_precompute(issuer_public, 64, &rejected);
+
+    unsigned char table_public[65];
+    int test1_success = (test1a_result == CVC_POINT_TABLE_SUCCESS) && (test1b_result == CVC_POINT_TABLE_ERROR_INVALID_POINT) && (test1c_result == CVC_POINT_TABLE_ERROR_INVALID_POINT) && !rejected;
+    test1_success = test1_success && cvc_nist256_point_table_public_key(table, table_public, sizeof(table_public)) == CVC_POINT_TABLE_SUCCESS && memcmp(table_public, issuer_public, 65) == 0;
+    printf("   Build time: %.2f ms\n", build_ms);
+    printf("   Status: %s\n\n", test1_success ? "✅ PASSED" : "❌ FAILED");
+    if (!table)
+    {
+        return 1;
+    }
+
+    // Test 2: Table multiplication matches variable-base multiplication
+    printf("2. Testing multiplication against the reference...\n");
+
+    unsigned char scalars[TABLE_SCALARS][32];
+    int test2_success = 1;
+    for (int i = 0; i < TABLE_SCALARS && test2_success; i++)
+    {
+        nist256_key_material_t scalar_key;
+        generate_random_seed_pt(seed, sizeof(seed));
+        nist256_generate_key_material(seed, sizeof(seed), &scalar_key);
+        memcpy(scalars[i], scalar_key.private_key_bytes, 32);
+
+        unsigned char expected[65], actual[65];
+        test2_success = reference_multiply_pt(issuer_public, scalars[i], expected) && cvc_nist256_point_table_multiply(table, scalars[i], 32, actual, sizeof(actual)) == CVC_POINT_TABLE_SUCCESS &&
+                        memcmp(expected, actual, 65) == 0;
+    }
+
+    // Scalar 1 gives the point back; 0 and the order are rejected
+    unsigned char one[32] = { 0 };
+    one[31] = 1;
+    const unsigned char zero[32] = { 0 };
+    const unsigned char order[32] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                                      0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x51 };
+    unsigned char product[65];
+    test2_success = test2_success && cvc_nist256_point_table_multiply(table, one, 32, product, sizeof(product)) == CVC_POINT_TABLE_SUCCESS && memcmp(product, issuer_public, 65) == 0;
+    test2_success = test2_success && cvc_nist256_point_table_multiply(table, zero, 32, product, sizeof(product)) == CVC_POINT_TABLE_ERROR_INVALID_SCALAR;
+    test2_success = test2_success && cvc_nist256_point_table_multiply(table, order, 32, product, sizeof(product)) == CVC_POINT_TABLE_ERROR_INVALID_SCALAR;
+    test2_success = test2_success && cvc_nist256_point_table_multiply(table, one, 32, product, 64) == CVC_POINT_TABLE_ERROR_INSUFFICIENT_BUFFER;
+    printf("   Status: %s\n\n", test2_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 3: ECDH entry points accept the table in place of the peer key
+    printf("3. Testing ECDH with a precomputed peer...\n");
+
+    int test3_success = 1;
+    for (int i = 0; i < 8 && test3_success; i++)
+    {
+        unsigned char expected[32], with_table[32], with_handle[32];
+        cvc_nist256_keypair_t* holder = NULL;
+        test3_success = cvc_ecdh_nist256(scalars[i], 32, NULL, issuer_public, 65, expected, sizeof(expected)) == CVC_ECDH_SUCCESS;
+        test3_success = test3_success && cvc_ecdh_nist256_table(scalars[i], 32, table, with_table, sizeof(with_table)) == CVC_ECDH_SUCCESS;
+        test3_success = test3_success && cvc_nist256_keypair_from_secret(scalars[i], 32, 0, &holder) == CVC_KEYPAIR_SUCCESS;
+        test3_success = test3_success && cvc_nist256_keypair_ecdh_table(holder, table, with_handle, sizeof(with_handle)) == CVC_KEYPAIR_SUCCESS;
+        test3_success = test3_success && memcmp(expected, with_table, 32) == 0 && memcmp(expected, with_handle, 32) == 0;
+        cvc_nist256_keypair_destroy(holder);
+    }
+
+    // A key pair's own table works as a peer table too
+    cvc_nist256_keypair_t* issuer_handle = NULL;
+    test3_success = test3_success && cvc_nist256_keypair_from_secret(issuer.private_key_bytes, 32, CVC_KEYPAIR_PRECOMPUTE, &issuer_handle) == CVC_KEYPAIR_SUCCESS;
+    test3_success = test3_success && cvc_nist256_keypair_table(issuer_handle) != NULL;
+    if (test3_success)
+    {
+        unsigned char via_handle_table[32], via_table[32];
+        test3_success = cvc_ecdh_nist256_table(scalars[0], 32, cvc_nist256_keypair_table(issuer_handle), via_handle_table, 32) == CVC_ECDH_SUCCESS &&
+                        cvc_ecdh_nist256_table(scalars[0], 32, table, via_table, 32) == CVC_ECDH_SUCCESS && memcmp(via_handle_table, via_table, 32) == 0;
+    }
+    cvc_nist256_keypair_destroy(issuer_handle);
+    printf("   Status: %s\n\n", test3_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 4: Serialization round trip, and corrupted input is refused
+    printf("4. Testing serialization...\n");
+
+    cvc_nist256_point_table_t* loaded = NULL;
+    int test4_success = cvc_nist256_point_table_serialize(table, serialized_pt, sizeof(serialized_pt)) == CVC_POINT_TABLE_SUCCESS;
+    test4_success = test4_success && cvc_nist256_point_table_serialize(table, serialized_pt, sizeof(serialized_pt) - 1) == CVC_POINT_TABLE_ERROR_INSUFFICIENT_BUFFER;
+    test4_success = test4_success && cvc_nist256_point_table_deserialize(serialized_pt, sizeof(serialized_pt), &loaded) == CVC_POINT_TABLE_SUCCESS;
+    for (int i = 0; i < TABLE_SCALARS && test4_success; i++)
+    {
+        unsigned char original[65], reloaded[65];
+        test4_success = cvc_nist256_point_table_multiply(table, scalars[i], 32, original, sizeof(original)) == CVC_POINT_TABLE_SUCCESS &&
+                        cvc_nist256_point_table_multiply(loaded, scalars[i], 32, reloaded, sizeof(reloaded)) == CVC_POINT_TABLE_SUCCESS && memcmp(original, reloaded, 65) == 0;
+    }
+    test4_success = test4_success && cvc_nist256_point_table_public_key(loaded, table_public, sizeof(table_public)) == CVC_POINT_TABLE_SUCCESS && memcmp(table_public, issuer_public, 65) == 0;
+    cvc_nist256_point_table_destroy(loaded);
+
+    cvc_nist256_point_table_t* corrupt = NULL;
+    serialized_pt[1000] ^= 0x01;
+    test4_success = test4_success && cvc_nist256_point_table_deserialize(serialized_pt, sizeof(serialized_pt), &corrupt) == CVC_POINT_TABLE_ERROR_INVALID_ENCODING && !corrupt;
+    serialized_pt[1000] ^= 0x01;
+    serialized_pt[0] = 'X';
+    test4_success = test4_success && cvc_nist256_point_table_deserialize(serialized_pt, sizeof(serialized_pt), &corrupt) == CVC_POINT_TABLE_ERROR_INVALID_ENCODING && !corrupt;
+    test4_success = test4_success && cvc_nist256_point_table_deserialize(serialized_pt, sizeof(serialized_pt) - 1, &corrupt) == CVC_POINT_TABLE_ERROR_INVALID_ENCODING && !corrupt;
+
+    // A correctly sealed table whose first row 1 entry is off the curve
+    serialized_pt[0] = 'C';
+    serialized_pt[CVC_POINT_TABLE_MAGIC_LENGTH + 8 * 64 + 63] ^= 0x01;
+    reseal_pt(serialized_pt);
+    test4_success = test4_success && cvc_nist256_point_table_deserialize(serialized_pt, sizeof(serialized_pt), &corrupt) == CVC_POINT_TABLE_ERROR_INVALID_ENCODING && !corrupt;
+
+    // The same point with x written as x + p is the right point in a non-canonical encoding
+    cvc_nist256_point_table_t* small_x = NULL;
+    test4_success = test4_success && cvc_nist256_point_precompute(small_x_public_pt, 65, &small_x) == CVC_POINT_TABLE_SUCCESS;
+    test4_success = test4_success && cvc_nist256_point_table_serialize(small_x, serialized_pt, sizeof(serialized_pt)) == CVC_POINT_TABLE_SUCCESS;
+    cvc_nist256_point_table_destroy(small_x);
+    test4_success = test4_success && cvc_nist256_point_table_deserialize(serialized_pt, sizeof(serialized_pt), &corrupt) == CVC_POINT_TABLE_SUCCESS;
+    cvc_nist256_point_table_destroy(corrupt);
+    corrupt = NULL;
+    memcpy(serialized_pt + CVC_POINT_TABLE_MAGIC_LENGTH, small_x_plus_p_pt, 32);
+    reseal_pt(serialized_pt);
+    test4_success = test4_success && cvc_nist256_point_table_deserialize(serialized_pt, sizeof(serialized_pt), &corrupt) == CVC_POINT_TABLE_ERROR_INVALID_ENCODING && !corrupt;
+    printf("   Serialized size: %d bytes\n", CVC_POINT_TABLE_SERIALIZED_SIZE);
+    printf("   Status: %s\n\n", test4_success ? "✅ PASSED" : "❌ FAILED");
+
+    cvc_nist256_point_table_destroy(table);
+
+    // Summary
+    printf("=== Point Table Test Summary ===\n");
+    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success;
+
+    if (all_tests_passed)
+    {
+        printf("🎉 All point table tests PASSED!\n");
+        return 0;
+    }
+    else
+    {
+        printf("💥 Some point table tests FAILED! Check the output above for details.\n");
+        return 1;
+    }
+}
@@ -0,0 +1,199 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/add_secret_keys.h"
+#include "src/ecp_operations.h"
+#include "src/hash_to_field.h"
+#include "src/nist256_key_material.h"
+#include "src/public_derive.h"
+
+#define DERIVE_CONTEXTS 40
+// Not a multiple of CVC_BATCH_LANES, so the last lane group is partial
+#define DERIVE_LARGE_COUNT 250
+
+static const unsigned char dst_pd[] = "CVC-ADDITIVE-DERIVE-TEST-V01";
+
+// Generate some random seed data
+void generate_random_seed_pd(unsigned char* seed, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        seed[i] = (unsigned char)(rand() & 0xFF);
+    }
+}
+
+void key_material_to_public_pd(const nist256_key_material_t* key_material, unsigned char* public_key)
+{
+    public_key[0] = 0x04;
+    memcpy(public_key + 1, key_material->public_key_x_bytes, 32);
+    memcpy(public_key + 33, key_material->public_key_y_bytes, 32);
+}
+
+int main()
+{
+    printf("=== Additive Key Derivation Test ===\n\n");
+    srand((unsigned int)time(NULL));
+
+    unsigned char seed[32];
+    nist256_key_material_t master;
+    generate_random_seed_pd(seed, sizeof(seed));
+    nist256_generate_key_material(seed, sizeof(seed), &master);
+    unsigned char master_public[65];
+    key_material_to_public_pd(&master, master_public);
+
+    static unsigned char contexts[DERIVE_LARGE_COUNT][24];
+    const unsigned char* context_ptrs[DERIVE_LARGE_COUNT];
+    int context_lens[DERIVE_LARGE_COUNT];
+    for (int i = 0; i < DERIVE_LARGE_COUNT; i++)
+    {
+        context_lens[i] = snprintf((char*)contexts[i], sizeof(contexts[i]), "holder/%d", i);
+        context_ptrs[i] = contexts[i];
+    }
+
+    // Test 1: The public side gives the public half of the secret side
+    printf("1. Testing public derivation against secret derivation...\n");
+
+    int test1_success = 1;
+    for (int i = 0; i < 8 && test1_success; i++)
+    {
+        unsigned char derived_public[65], expected_public[65];
+        nist256_key_material_t derived;
+        test1_success = cvc_derive_public_key_nist256(NULL, master_public, 65, contexts[i], context_lens[i], dst_pd, sizeof(dst_pd) - 1, derived_public, sizeof(derived_public)) == CVC_PUBLIC_DERIVE_SUCCESS;
+        test1_success = test1_success && cvc_derive_additive_secret_key_nist256(master.private_key_bytes, 32, contexts[i], context_lens[i], dst_pd, sizeof(dst_pd) - 1, &derived) == CVC_PUBLIC_DERIVE_SUCCESS;
+        key_material_to_public_pd(&derived, expected_public);
+        test1_success = test1_success && memcmp(derived_public, expected_public, 65) == 0;
+    }
+
+    // Different contexts give different keys
+    unsigned char first[65], second[65];
+    test1_success = test1_success && cvc_derive_public_key_nist256(NULL, master_public, 65, contexts[0], context_lens[0], dst_pd, sizeof(dst_pd) - 1, first, 65) == CVC_PUBLIC_DERIVE_SUCCESS;
+    test1_success = test1_success && cvc_derive_public_key_nist256(NULL, master_public, 65, contexts[1], context_lens[1], dst_pd, sizeof(dst_pd) - 1, second, 65) == CVC_PUBLIC_DERIVE_SUCCESS;
+    test1_success = test1_success && memcmp(first, second, 65) != 0 && memcmp(first, master_public, 65) != 0;
+    printf("   Status: %s\n\n", test1_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 2: The result is m + t and M + t * G with t the existing derivation over M
+    printf("2. Testing the definition through the existing primitives...\n");
+
+    int test2_success = 1;
+    for (int i = 0; i < 8 && test2_success; i++)
+    {
+        BIG_256_56 t;
+        test2_success = cvc_derive_secret_scalar_nist256(master_public, 65, contexts[i], context_lens[i], dst_pd, sizeof(dst_pd) - 1, t) == CVC_DERIVE_KEY_SUCCESS;
+        unsigned char t_bytes[32];
+        BIG_256_56_toBytes((char*)t_bytes, t);
+
+        // Secret side: m + t through the key addition API
+        nist256_key_material_t expected, derived;
+        test2_success = test2_success && cvc_add_nist256_secret_keys(master.private_key_bytes, 32, t_bytes, 32, &expected) == CVC_ADD_SECRET_KEYS_SUCCESS;
+        test2_success = test2_success && cvc_derive_additive_secret_key_nist256(master.private_key_bytes, 32, contexts[i], context_lens[i], dst_pd, sizeof(dst_pd) - 1, &derived) == CVC_PUBLIC_DERIVE_SUCCESS;
+        test2_success = test2_success && memcmp(&expected, &derived, sizeof(expected)) == 0;
+
+        // Public side: M + t * G through the public key addition API
+        nist256_key_material_t tweak_key;
+        unsigned char tweak_public[65], sum[65], derived_public[65];
+        int sum_len = 0;
+        test2_success = test2_success && nist256_big_to_key_material(t, &tweak_key) == 0;
+        key_material_to_public_pd(&tweak_key, tweak_public);
+        test2_success = test2_success && cvc_add_nist256_public_keys(master_public, 65, tweak_public, 65, sum, sizeof(sum), &sum_len) == CVC_ECP_SUCCESS;
+        test2_success = test2_success && cvc_derive_public_key_nist256(NULL, master_public, 65, contexts[i], context_lens[i], dst_pd, sizeof(dst_pd) - 1, derived_public, 65) == CVC_PUBLIC_DERIVE_SUCCESS;
+        test2_success = test2_success && memcmp(sum, derived_public, 65) == 0;
+    }
+    printf("   Status: %s\n\n", test2_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 3: Batch variants match the single-key calls, across several lane groups
+    printf("3. Testing batch derivation...\n");
+
+    static unsigned char batch_public[DERIVE_CONTEXTS * 65];
+    static nist256_key_material_t batch_secret[DERIVE_CONTEXTS];
+    cvc_public_key_set_t* key_set = NULL;
+    const cvc_public_key_set_config_t set_config = { 16, 0 };
+    generate_random_seed_pd(seed, sizeof(seed));
+    int test3_success = cvc_public_key_set_create(&set_config, seed, 16, &key_set) == CVC_PUBLIC_KEY_SET_SUCCESS;
+    test3_success = test3_success && cvc_derive_public_keys_nist256_batch(key_set, master_public, 65, context_ptrs, context_lens, DERIVE_CONTEXTS, dst_pd, sizeof(dst_pd) - 1, batch_public) == CVC_PUBLIC_DERIVE_SUCCESS;
+    test3_success = test3_success && cvc_derive_additive_secret_keys_nist256_batch(master.private_key_bytes, 32, context_ptrs, context_lens, DERIVE_CONTEXTS, dst_pd, sizeof(dst_pd) - 1, batch_secret) == CVC_PUBLIC_DERIVE_SUCCESS;
+    for (int i = 0; i < DERIVE_CONTEXTS && test3_success; i++)
+    {
+        unsigned char single_public[65], secret_public[65];
+        nist256_key_material_t single_secret;
+        test3_success = cvc_derive_public_key_nist256(key_set, master_public, 65, contexts[i], context_lens[i], dst_pd, sizeof(dst_pd) - 1, single_public, 65) == CVC_PUBLIC_DERIVE_SUCCESS;
+        test3_success = test3_success && cvc_derive_additive_secret_key_nist256(master.private_key_bytes, 32, contexts[i], context_lens[i], dst_pd, sizeof(dst_pd) - 1, &single_secret) == CVC_PUBLIC_DERIVE_SUCCESS;
+        key_material_to_public_pd(&batch_secret[i], secret_public);
+        test3_success = test3_success && memcmp(batch_public + i * 65, single_public, 65) == 0 && memcmp(&batch_secret[i], &single_secret, sizeof(single_secret)) == 0 && memcmp(secret_public, single_public, 65) == 0;
+    }
+
+    // A long DST takes the generic hash_to_field path in both variants
+    unsigned char long_dst[300];
+    memset(long_dst, 'D', sizeof(long_dst));
+    test3_success = test3_success && cvc_derive_public_keys_nist256_batch(NULL, master_public, 65, context_ptrs, context_lens, 3, long_dst, sizeof(long_dst), batch_public) == CVC_PUBLIC_DERIVE_SUCCESS;
+    for (int i = 0; i < 3 && test3_success; i++)
+    {
+        nist256_key_material_t single_secret;
+        unsigned char secret_public[65];
+        test3_success = cvc_derive_additive_secret_key_nist256(master.private_key_bytes, 32, contexts[i], context_lens[i], long_dst, sizeof(long_dst), &single_secret) == CVC_PUBLIC_DERIVE_SUCCESS;
+        key_material_to_public_pd(&single_secret, secret_public);
+        test3_success = test3_success && memcmp(batch_public + i * 65, secret_public, 65) == 0;
+    }
+    printf("   Status: %s\n\n", test3_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 4: Invalid inputs are rejected
+    printf("4. Testing parameter validation...\n");
+
+    unsigned char off_curve[65], out[65];
+    memcpy(off_curve, master_public, 65);
+    off_curve[64] ^= 1;
+    const unsigned char zero[32] = { 0 };
+    const unsigned char order[32] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                                      0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x51 };
+    nist256_key_material_t rejected;
+    int test4_success = cvc_derive_public_key_nist256(NULL, off_curve, 65, contexts[0], context_lens[0], dst_pd, sizeof(dst_pd) - 1, out, 65) == CVC_PUBLIC_DERIVE_ERROR_INVALID_PUBLIC_KEY;
+    test4_success = test4_success && cvc_derive_public_key_nist256(NULL, master_public, 64, contexts[0], context_lens[0], dst_pd, sizeof(dst_pd) - 1, out, 65) == CVC_PUBLIC_DERIVE_ERROR_INVALID_PUBLIC_KEY;
+    test4_success = test4_success && cvc_derive_public_key_nist256(NULL, master_public, 65, contexts[0], context_lens[0], dst_pd, sizeof(dst_pd) - 1, out, 64) == CVC_PUBLIC_DERIVE_ERROR_INSUFFICIENT_BUFFER;
+    test4_success = test4_success && cvc_derive_public_key_nist256(NULL, master_public, 65, contexts[0], 0, dst_pd, sizeof(dst_pd) - 1, out, 65) == CVC_PUBLIC_DERIVE_ERROR_INVALID_PARAMS;
+    test4_success = test4_success && cvc_derive_public_key_nist256(NULL, master_public, 65, contexts[0], context_lens[0], NULL, 0, out, 65) == CVC_PUBLIC_DERIVE_ERROR_INVALID_PARAMS;
+    test4_success = test4_success && cvc_derive_additive_secret_key_nist256(zero, 32, contexts[0], context_lens[0], dst_pd, sizeof(dst_pd) - 1, &rejected) == CVC_PUBLIC_DERIVE_ERROR_INVALID_SECRET_KEY;
+    test4_success = test4_success && cvc_derive_additive_secret_key_nist256(order, 32, contexts[0], context_lens[0], dst_pd, sizeof(dst_pd) - 1, &rejected) == CVC_PUBLIC_DERIVE_ERROR_INVALID_SECRET_KEY;
+    test4_success = test4_success && cvc_derive_additive_secret_key_nist256(master.private_key_bytes, 31, contexts[0], context_lens[0], dst_pd, sizeof(dst_pd) - 1, &rejected) == CVC_PUBLIC_DERIVE_ERROR_INVALID_PARAMS;
+
+    // One bad context fails the whole batch before anything is derived
+    const unsigned char* with_null[3] = { contexts[0], NULL, contexts[2] };
+    test4_success = test4_success && cvc_derive_public_keys_nist256_batch(NULL, master_public, 65, with_null, context_lens, 3, dst_pd, sizeof(dst_pd) - 1, batch_public) == CVC_PUBLIC_DERIVE_ERROR_INVALID_PARAMS;
+    printf("   Status: %s\n\n", test4_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 5: A large batch (several lane groups plus a partial one) equals one call per context
+    printf("5. Testing a large batch against single derivations...\n");
+
+    static unsigned char large_batch[DERIVE_LARGE_COUNT * 65];
+    int test5_success = cvc_derive_public_keys_nist256_batch(key_set, master_public, 65, context_ptrs, context_lens, DERIVE_LARGE_COUNT, dst_pd, sizeof(dst_pd) - 1, large_batch) == CVC_PUBLIC_DERIVE_SUCCESS;
+    for (int i = 0; i < DERIVE_LARGE_COUNT && test5_success; i++)
+    {
+        unsigned char single_public[65];
+        test5_success = cvc_derive_public_key_nist256(key_set, master_public, 65, contexts[i], context_lens[i], dst_pd, sizeof(dst_pd) - 1, single_public, 65) == CVC_PUBLIC_DERIVE_SUCCESS;
+        test5_success = test5_success && memcmp(single_public, large_batch + i * 65, 65) == 0;
+        if (!test5_success)
+        {
+            printf("   Mismatch at context %d\n", i);
+        }
+    }
+    printf("   Status: %s\n\n", test5_success ? "✅ PASSED" : "❌ FAILED");
+
+    cvc_public_key_set_destroy(key_set);
+
+    // Summary
+    printf("=== Additive Key Derivation Test Summary ===\n");
+    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success && test5_success;
+
+    if (all_tests_passed)
+    {
+        printf("🎉 All additive key derivation tests PASSED!\n");
+        return 0;
+    }
+    else
+    {
+        printf("💥 Some additive key derivation tests FAILED! Check the output above for details.\n");
+        return 1;
+    }
+}
@@ -0,0 +1,234 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/public_key_set.h"
+#include "src/ecp_operations.h"
+#include "src/nist256_key_material.h"
+
+#define PKS_KEY_COUNT 32
+#define PKS_THREADS 4
+#define PKS_ROUNDS 200
+
+static unsigned char test_keys_pks[PKS_KEY_COUNT][65];
+static cvc_public_key_set_t* shared_set_pks;
+static unsigned char expected_sum_pks[65];
+
+// Generate some random seed data
+void generate_random_seed_pks(unsigned char* seed, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        seed[i] = (unsigned char)(rand() & 0xFF);
+    }
+}
+
+// Helper function to generate a valid uncompressed NIST P-256 public key
+int generate_valid_key_pks(unsigned char* key_bytes)
+{
+    unsigned char seed[32];
+    generate_random_seed_pks(seed, sizeof(seed));
+
+    nist256_key_material_t key_material;
+    if (nist256_generate_key_material(seed, sizeof(seed), &key_material) != 0)
+    {
+        return -1;
+    }
+
+    key_bytes[0] = 0x04;
+    memcpy(&key_bytes[1], key_material.public_key_x_bytes, 32);
+    memcpy(&key_bytes[33], key_material.public_key_y_bytes, 32);
+    return 0;
+}
+
+// Each thread sums the key set repeatedly through the shared set
+void* sum_worker_pks(void* arg)
+{
+    int* failures = (int*)arg;
+    const unsigned char* key_ptrs[PKS_KEY_COUNT];
+    for (int i = 0; i < PKS_KEY_COUNT; i++)
+    {
+        key_ptrs[i] = test_keys_pks[i];
+    }
+
+    for (int round = 0; round < PKS_ROUNDS; round++)
+    {
+        unsigned char result[65];
+        int result_len = 0;
+        if (cvc_sum_nist256_public_keys(shared_set_pks, key_ptrs, PKS_KEY_COUNT, result, sizeof(result), &result_len) != CVC_ECP_SUCCESS || memcmp(result, expected_sum_pks, 65) != 0)
+        {
+            (*failures)++;
+        }
+    }
+    return NULL;
+}
+
+int main()
+{
+    printf("=== Validated Public Key Set Test ===\n\n");
+    srand((unsigned int)time(NULL));
+
+    for (int i = 0; i < PKS_KEY_COUNT; i++)
+    {
+        if (generate_valid_key_pks(test_keys_pks[i]) != 0)
+        {
+            printf("❌ FAILED to generate test key %d\n", i);
+            return 1;
+        }
+    }
+
+    unsigned char hash_seed[32];
+    generate_random_seed_pks(hash_seed, sizeof(hash_seed));
+
+    // Test 1: Create with valid and invalid parameters
+    printf("1. Testing set creation...\n");
+
+    cvc_public_key_set_config_t config = { 64, 0 };
+    cvc_public_key_set_t* set = NULL;
+    const int test1a_result = cvc_public_key_set_create(&config, hash_seed, sizeof(hash_seed), &set);
+    cvc_public_key_set_t* rejected = NULL;
+    const int test1b_result = cvc_public_key_set_create(&config, hash_seed, 8, &rejected);
+
+    const int test1_success = (test1a_result == CVC_PUBLIC_KEY_SET_SUCCESS) && set && (test1b_result == CVC_PUBLIC_KEY_SET_ERROR_INVALID_PARAMS) && !rejected;
+    printf("   Status: %s\n\n", test1_success ? "✅ PASSED" : "❌ FAILED");
+    if (!set)
+    {
+        return 1;
+    }
+
+    // Test 2: Cached addition matches uncached addition, and repeats hit the set
+    printf("2. Testing cached public key addition...\n");
+
+    unsigned char plain[65], cached[65];
+    int plain_len = 0, cached_len = 0;
+    int test2_success = 1;
+    for (int round = 0; round < 3; round++)
+    {
+        test2_success = test2_success && cvc_add_nist256_public_keys(test_keys_pks[0], 65, test_keys_pks[1], 65, plain, sizeof(plain), &plain_len) == CVC_ECP_SUCCESS;
+        test2_success = test2_success && cvc_add_nist256_public_keys_cached(set, test_keys_pks[0], 65, test_keys_pks[1], 65, cached, sizeof(cached), &cached_len) == CVC_ECP_SUCCESS;
+        test2_success = test2_success && cached_len == 65 && memcmp(plain, cached, 65) == 0;
+    }
+
+    cvc_public_key_set_stats_t stats;
+    cvc_public_key_set_get_stats(set, &stats);
+    printf("   Hits: %llu, misses: %llu, entries: %llu\n", (unsigned long long)stats.hits, (unsigned long long)stats.misses, (unsigned long long)stats.entries);
+    test2_success = test2_success && stats.misses == 2 && stats.hits == 4 && stats.entries == 2;
+    printf("   Status: %s\n\n", test2_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 3: Invalid keys are rejected every time and never remembered
+    printf("3. Testing invalid keys are not cached...\n");
+
+    unsigned char bad_key[65];
+    memcpy(bad_key, test_keys_pks[2], 65);
+    bad_key[64] ^= 0x01;
+
+    const int test3a_result = cvc_add_nist256_public_keys_cached(set, bad_key, 65, test_keys_pks[1], 65, cached, sizeof(cached), &cached_len);
+    const int test3b_result = cvc_add_nist256_public_keys_cached(set, test_keys_pks[1], 65, bad_key, 65, cached, sizeof(cached), &cached_len);
+
+    unsigned char wrong_prefix[65];
+    memcpy(wrong_prefix, test_keys_pks[2], 65);
+    wrong_prefix[0] = 0x02;
+    ECP_NIST256 point;
+    const int test3c_result = cvc_public_key_set_decode(set, wrong_prefix, &point);
+
+    cvc_public_key_set_get_stats(set, &stats);
+    const int test3_success = (test3a_result == CVC_ECP_ERROR_INVALID_POINT_1) && (test3b_result == CVC_ECP_ERROR_INVALID_POINT_2) && (test3c_result == 0) && stats.entries == 2;
+    printf("   Status: %s\n\n", test3_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 4: N-way sum matches chained addition, with and without a set
+    printf("4. Testing public key sum...\n");
+
+    const unsigned char* key_ptrs[PKS_KEY_COUNT];
+    for (int i = 0; i < PKS_KEY_COUNT; i++)
+    {
+        key_ptrs[i] = test_keys_pks[i];
+    }
+
+    unsigned char chained[65];
+    memcpy(chained, test_keys_pks[0], 65);
+    int test4_success = 1;
+    for (int i = 1; i < PKS_KEY_COUNT && test4_success; i++)
+    {
+        unsigned char next[65];
+        int next_len = 0;
+        test4_success = cvc_add_nist256_public_keys(chained, 65, test_keys_pks[i], 65, next, sizeof(next), &next_len) == CVC_ECP_SUCCESS;
+        memcpy(chained, next, 65);
+    }
+
+    unsigned char summed[65];
+    int summed_len = 0;
+    test4_success = test4_success && cvc_sum_nist256_public_keys(NULL, key_ptrs, PKS_KEY_COUNT, summed, sizeof(summed), &summed_len) == CVC_ECP_SUCCESS && memcmp(summed, chained, 65) == 0;
+    test4_success = test4_success && cvc_sum_nist256_public_keys(set, key_ptrs, PKS_KEY_COUNT, summed, sizeof(summed), &summed_len) == CVC_ECP_SUCCESS && memcmp(summed, chained, 65) == 0;
+
+    key_ptrs[7] = bad_key;
+    const int test4a_result = cvc_sum_nist256_public_keys(set, key_ptrs, PKS_KEY_COUNT, summed, sizeof(summed), &summed_len);
+    key_ptrs[7] = test_keys_pks[7];
+    const int test4b_result = cvc_sum_nist256_public_keys(set, key_ptrs, 0, summed, sizeof(summed), &summed_len);
+
+    test4_success = test4_success && (test4a_result == CVC_ECP_ERROR_INVALID_POINT_N) && (test4b_result == CVC_ECP_ERROR_INVALID_PARAMS);
+    memcpy(expected_sum_pks, chained, 65);
+    printf("   Status: %s\n\n", test4_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 5: The set stays within its bound when the working set is larger
+    printf("5. Testing bounded capacity...\n");
+
+    cvc_public_key_set_config_t small_config = { 8, 1 };
+    cvc_public_key_set_t* small_set = NULL;
+    cvc_public_key_set_create(&small_config, hash_seed, sizeof(hash_seed), &small_set);
+
+    int test5_success = small_set != NULL;
+    for (int i = 0; i < PKS_KEY_COUNT && test5_success; i++)
+    {
+        test5_success = cvc_public_key_set_decode(small_set, test_keys_pks[i], &point);
+    }
+    cvc_public_key_set_stats_t small_stats;
+    cvc_public_key_set_get_stats(small_set, &small_stats);
+    printf("   Entries: %llu / %llu, evictions: %llu\n", (unsigned long long)small_stats.entries, (unsigned long long)small_stats.capacity, (unsigned long long)small_stats.evictions);
+    test5_success = test5_success && small_stats.entries <= small_stats.capacity && small_stats.capacity <= 8 && small_stats.evictions == PKS_KEY_COUNT - small_stats.entries;
+    cvc_public_key_set_destroy(small_set);
+    printf("   Status: %s\n\n", test5_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 6: Concurrent sums through one shared set
+    printf("6. Testing concurrent use...\n");
+
+    cvc_public_key_set_clear(set);
+    shared_set_pks = set;
+    pthread_t threads[PKS_THREADS];
+    int failures[PKS_THREADS] = { 0 };
+    for (int i = 0; i < PKS_THREADS; i++)
+    {
+        pthread_create(&threads[i], NULL, sum_worker_pks, &failures[i]);
+    }
+    int total_failures = 0;
+    for (int i = 0; i < PKS_THREADS; i++)
+    {
+        pthread_join(threads[i], NULL);
+        total_failures += failures[i];
+    }
+
+    cvc_public_key_set_get_stats(set, &stats);
+    printf("   Failures: %d, hits: %llu, misses: %llu\n", total_failures, (unsigned long long)stats.hits, (unsigned long long)stats.misses);
+    const int test6_success = total_failures == 0 && stats.hits > stats.misses;
+    printf("   Status: %s\n\n", test6_success ? "✅ PASSED" : "❌ FAILED");
+
+    cvc_public_key_set_destroy(set);
+
+    // Summary
+    printf("=== Validated Public Key Set Test Summary ===\n");
+    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success && test5_success && test6_success;
+
+    if (all_tests_passed)
+    {
+        printf("🎉 All validated public key set tests PASSED!\n");
+        return 0;
+    }
+    else
+    {
+        printf("💥 Some validated public key set tests FAILED! Check the output above for details.\n");
+        return 1;
+    }
+}
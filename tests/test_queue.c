@@ -0,0 +1,214 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/queue.h"
+#include "src/add_secret_keys.h"
+#include "src/ecp_operations.h"
+#include "src/hash_to_field.h"
+#include "src/nist256_key_material.h"
+
+#define QUEUE_TEST_JOBS 64
+
+// Generate some random seed data
+void generate_random_seed_q(unsigned char* seed, int len)
+{
+    // Simple pseudo-random for testing (not cryptographically secure for production)
+    static int seeded = 0;
+    if (!seeded)
+    {
+        srand((unsigned int)time(NULL));
+        seeded = 1;
+    }
+    for (int i = 0; i < len; i++)
+    {
+        seed[i] = (unsigned char)(rand() & 0xFF);
+    }
+}
+
+// Format key material as an uncompressed public key: 0x04 || X || Y
+void to_uncompressed_q(const nist256_key_material_t* key_material, unsigned char* out)
+{
+    out[0] = 0x04;
+    memcpy(&out[1], key_material->public_key_x_bytes, 32);
+    memcpy(&out[33], key_material->public_key_y_bytes, 32);
+}
+
+// Compute the expected completion for a job by calling the library directly
+int expected_completion_q(const cvc_queue_job_t* job, cvc_queue_completion_t* expected)
+{
+    memset(expected, 0, sizeof(cvc_queue_completion_t));
+    int result_len;
+    switch (job->op)
+    {
+        case CVC_QUEUE_OP_DERIVE:
+            return cvc_derive_secret_key_nist256(job->master_key, job->master_key_len, job->context, job->context_len, job->dst, job->dst_len, &expected->key_material);
+        case CVC_QUEUE_OP_ADD_PUBLIC:
+            return cvc_add_nist256_public_keys(job->key1, 65, job->key2, 65, expected->public_key, 65, &result_len);
+        case CVC_QUEUE_OP_ADD_SECRET:
+            return cvc_add_nist256_secret_keys(job->key1, 32, job->key2, 32, &expected->key_material);
+        default:
+            return nist256_generate_key_material((unsigned char*)job->seed, 32, &expected->key_material);
+    }
+}
+
+int main()
+{
+    printf("=== Submission/Completion Queue Test ===\n\n");
+
+    // Test 1: Invalid parameters
+    printf("1. Testing invalid parameters...\n");
+
+    cvc_queue_t* queue = NULL;
+    const int test1a_result = cvc_queue_create(0, 16, &queue);
+    const int test1b_result = cvc_queue_create(2, 0, &queue);
+    const int test1c_result = cvc_queue_create(2, 16, NULL);
+    const int test1d_result = cvc_queue_submit(NULL, NULL, 1);
+    const int test1e_result = cvc_queue_poll(NULL, NULL, 1);
+
+    const int test1_success = (test1a_result == CVC_QUEUE_ERROR_INVALID_PARAMS) && (test1b_result == CVC_QUEUE_ERROR_INVALID_PARAMS) && (test1c_result == CVC_QUEUE_ERROR_INVALID_PARAMS) && (test1d_result == CVC_QUEUE_ERROR_INVALID_PARAMS)
+        && (test1e_result == CVC_QUEUE_ERROR_INVALID_PARAMS);
+    printf("   Status: %s\n\n", test1_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Build a mixed batch of jobs
+    unsigned char master_key[32];
+    generate_random_seed_q(master_key, 32);
+    const unsigned char context[] = "queue_context";
+    const unsigned char dst[] = "CVC_DERIVE_KEY";
+
+    nist256_key_material_t base1, base2;
+    unsigned char seed1[32], seed2[32];
+    generate_random_seed_q(seed1, 32);
+    generate_random_seed_q(seed2, 32);
+    seed2[0] = ~seed1[0];
+    nist256_generate_key_material(seed1, 32, &base1);
+    nist256_generate_key_material(seed2, 32, &base2);
+
+    cvc_queue_job_t jobs[QUEUE_TEST_JOBS];
+    memset(jobs, 0, sizeof(jobs));
+    for (int i = 0; i < QUEUE_TEST_JOBS; i++)
+    {
+        jobs[i].user_data = 1000 + i;
+        jobs[i].op = CVC_QUEUE_OP_DERIVE + (i % 4);
+        jobs[i].master_key = master_key;
+        jobs[i].master_key_len = 32;
+        jobs[i].context = context;
+        jobs[i].context_len = sizeof(context) - 1;
+        jobs[i].dst = dst;
+        jobs[i].dst_len = sizeof(dst) - 1;
+        if (jobs[i].op == CVC_QUEUE_OP_ADD_PUBLIC)
+        {
+            to_uncompressed_q(&base1, jobs[i].key1);
+            to_uncompressed_q(&base2, jobs[i].key2);
+        }
+        else
+        {
+            memcpy(jobs[i].key1, base1.private_key_bytes, 32);
+            memcpy(jobs[i].key2, base2.private_key_bytes, 32);
+        }
+        generate_random_seed_q(jobs[i].seed, 32);
+    }
+
+    // Test 2: Submit a batch and drain all completions
+    printf("2. Testing batch submission and bulk completion...\n");
+
+    const int create_result = cvc_queue_create(4, QUEUE_TEST_JOBS, &queue);
+    if (create_result != CVC_QUEUE_SUCCESS)
+    {
+        printf("   ❌ FAILED to create queue: %d\n", create_result);
+        return 1;
+    }
+
+    const int accepted = cvc_queue_submit(queue, jobs, QUEUE_TEST_JOBS);
+    printf("   Accepted jobs: %d\n", accepted);
+
+    cvc_queue_completion_t completions[QUEUE_TEST_JOBS];
+    int completed = 0;
+    const time_t deadline = time(NULL) + 30;
+    while (completed < accepted && time(NULL) < deadline)
+    {
+        completed += cvc_queue_poll(queue, completions + completed, QUEUE_TEST_JOBS - completed);
+    }
+    printf("   Completed jobs: %d\n", completed);
+
+    int test2_success = (accepted == QUEUE_TEST_JOBS) && (completed == QUEUE_TEST_JOBS) && (cvc_queue_in_flight(queue) == 0);
+    printf("   Status: %s\n\n", test2_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 3: Every completion matches the direct library call
+    printf("3. Testing completions match direct calls...\n");
+
+    int seen[QUEUE_TEST_JOBS] = { 0 };
+    int test3_success = test2_success;
+    for (int i = 0; i < completed && test3_success; i++)
+    {
+        const int index = (int)(completions[i].user_data - 1000);
+        if (index < 0 || index >= QUEUE_TEST_JOBS || seen[index])
+        {
+            test3_success = 0;
+            break;
+        }
+        seen[index] = 1;
+
+        cvc_queue_completion_t expected;
+        const int expected_status = expected_completion_q(&jobs[index], &expected);
+        const int status_ok = completions[i].status == expected_status && completions[i].op == jobs[index].op;
+        const int output_ok = (jobs[index].op == CVC_QUEUE_OP_ADD_PUBLIC) ? memcmp(completions[i].public_key, expected.public_key, 65) == 0 : memcmp(&completions[i].key_material, &expected.key_material, sizeof(nist256_key_material_t)) == 0;
+        test3_success = status_ok && output_ok;
+    }
+    printf("   Status: %s\n\n", test3_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 4: In-flight limit is enforced until completions are polled
+    printf("4. Testing in-flight limit...\n");
+
+    const int first = cvc_queue_submit(queue, jobs, QUEUE_TEST_JOBS);
+    const int overflow = cvc_queue_submit(queue, jobs, 1);
+    printf("   First submit accepted: %d, overflow submit accepted: %d\n", first, overflow);
+
+    completed = 0;
+    while (completed < first && time(NULL) < deadline + 30)
+    {
+        completed += cvc_queue_poll(queue, completions, QUEUE_TEST_JOBS);
+    }
+
+    const int test4_success = (first == QUEUE_TEST_JOBS) && (overflow == 0) && (completed == first);
+    printf("   Status: %s\n\n", test4_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 5: Unknown operations complete with an error status
+    printf("5. Testing unknown operation code...\n");
+
+    cvc_queue_job_t bad_job;
+    memset(&bad_job, 0, sizeof(bad_job));
+    bad_job.user_data = 42;
+    bad_job.op = 99;
+    cvc_queue_submit(queue, &bad_job, 1);
+
+    cvc_queue_completion_t bad_completion;
+    int bad_completed = 0;
+    while (bad_completed == 0 && time(NULL) < deadline + 60)
+    {
+        bad_completed = cvc_queue_poll(queue, &bad_completion, 1);
+    }
+
+    const int test5_success = (bad_completed == 1) && (bad_completion.user_data == 42) && (bad_completion.status == CVC_QUEUE_ERROR_INVALID_OPERATION);
+    printf("   Status: %s\n\n", test5_success ? "✅ PASSED" : "❌ FAILED");
+
+    cvc_queue_destroy(queue);
+
+    // Summary
+    printf("=== Submission/Completion Queue Test Summary ===\n");
+    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success && test5_success;
+
+    if (all_tests_passed)
+    {
+        printf("🎉 All queue tests PASSED!\n");
+        return 0;
+    }
+    else
+    {
+        printf("💥 Some queue tests FAILED! Check the output above for details.\n");
+        return 1;
+    }
+}
@@ -0,0 +1,163 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/jwt.h"
+#include "src/sd_jwt.h"
+#include "src/sha256.h"
+
+#define SD_JWT_CLAIMS 150
+
+static cvc_sd_jwt_disclosure_input_t inputs_sd[SD_JWT_CLAIMS];
+static char salts_sd[SD_JWT_CLAIMS][24];
+static char names_sd[SD_JWT_CLAIMS][24];
+static char values_sd[SD_JWT_CLAIMS][200];
+static char arena_sd[SD_JWT_CLAIMS * 400];
+static int offsets_sd[SD_JWT_CLAIMS];
+static int lens_sd[SD_JWT_CLAIMS];
+static char digests_sd[SD_JWT_CLAIMS * CVC_SD_JWT_DIGEST_LENGTH];
+
+// Generate some random seed data
+void generate_random_seed_sd(unsigned char* seed, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        seed[i] = (unsigned char)(rand() & 0xFF);
+    }
+}
+
+int main()
+{
+    printf("=== SD-JWT Test ===\n\n");
+    srand((unsigned int)time(NULL));
+
+    // Test 1: Known disclosures (object property, array element, escaped name)
+    printf("1. Testing known disclosures...\n");
+
+    const cvc_sd_jwt_disclosure_input_t known[3] = {
+        { "_26bc4LT-ac6q2KI6cBW5es", 23, "family_name", 11, "\"M\xc3\xb6" "bius\"", 9 },
+        { "lklxF5jMYlGTPUovMNIvCA", 22, NULL, 0, "\"FR\"", 4 },
+        { "eluV5Og3gSNII8EYnsxA_A", 22, "q\"b\\s\n", 6, "{\"a\":[1,2]}", 11 },
+    };
+    static const char* expected_disclosures[3] = {
+        "WyJfMjZiYzRMVC1hYzZxMktJNmNCVzVlcyIsImZhbWlseV9uYW1lIiwiTcO2Yml1cyJd",
+        "WyJsa2x4RjVqTVlsR1RQVW92TU5JdkNBIiwiRlIiXQ",
+        "WyJlbHVWNU9nM2dTTklJOEVZbnN4QV9BIiwicVwiYlxcc1x1MDAwYSIseyJhIjpbMSwyXX1d",
+    };
+    static const char* expected_digests[3] = {
+        "TZjouOTrBKEwUNjNDs9yeMzBoQn8FFLPaJjRRmAtwrM",
+        "qswwxPH-MjwEMOgKBBv2x2CF7lufmWFrWvVq7pj7YJE",
+        "7yz37Lzx-USNkDXN0JJFH_-5_B-oayGySmohI4M-Eho",
+    };
+
+    int test1_success = cvc_sd_jwt_disclosures(known, 3, arena_sd, sizeof(arena_sd), offsets_sd, lens_sd, digests_sd) == CVC_SD_JWT_SUCCESS;
+    for (int i = 0; i < 3 && test1_success; i++)
+    {
+        test1_success = lens_sd[i] == (int)strlen(expected_disclosures[i]) && memcmp(arena_sd + offsets_sd[i], expected_disclosures[i], (size_t)lens_sd[i]) == 0;
+        test1_success = test1_success && memcmp(digests_sd + i * CVC_SD_JWT_DIGEST_LENGTH, expected_digests[i], CVC_SD_JWT_DIGEST_LENGTH) == 0;
+        test1_success = test1_success && cvc_sd_jwt_disclosure_length(&known[i]) == lens_sd[i];
+        if (!test1_success)
+        {
+            printf("   Mismatch in disclosure %d: %.*s\n", i, lens_sd[i], arena_sd + offsets_sd[i]);
+        }
+    }
+    printf("   Status: %s\n\n", test1_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 2: A large batch agrees with one-at-a-time SHA-256 and decodes back to its JSON
+    printf("2. Testing a batch of %d disclosures...\n", SD_JWT_CLAIMS);
+
+    int arena_size = 0;
+    for (int i = 0; i < SD_JWT_CLAIMS; i++)
+    {
+        unsigned char salt_bytes[16];
+        int salt_len = 0;
+        generate_random_seed_sd(salt_bytes, sizeof(salt_bytes));
+        cvc_base64url_encode(salt_bytes, sizeof(salt_bytes), salts_sd[i], sizeof(salts_sd[i]), &salt_len);
+
+        const int name_len = snprintf(names_sd[i], sizeof(names_sd[i]), "claim_%d", i);
+        const int value_len = snprintf(values_sd[i], sizeof(values_sd[i]), "\"%.*s\"", i % 150, "abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmn");
+        inputs_sd[i].salt = salts_sd[i];
+        inputs_sd[i].salt_len = salt_len;
+        inputs_sd[i].name = i % 5 == 4 ? NULL : names_sd[i];
+        inputs_sd[i].name_len = name_len;
+        inputs_sd[i].value = values_sd[i];
+        inputs_sd[i].value_len = value_len;
+        arena_size += cvc_sd_jwt_disclosure_length(&inputs_sd[i]);
+    }
+
+    const clock_t start = clock();
+    int test2_success = cvc_sd_jwt_disclosures(inputs_sd, SD_JWT_CLAIMS, arena_sd, arena_size, offsets_sd, lens_sd, digests_sd) == CVC_SD_JWT_SUCCESS;
+    const double batch_ms = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+
+    for (int i = 0; i < SD_JWT_CLAIMS && test2_success; i++)
+    {
+        unsigned char digest[32];
+        char encoded_digest[CVC_SD_JWT_DIGEST_LENGTH];
+        int encoded_len = 0;
+        cvc_sha256((const unsigned char*)arena_sd + offsets_sd[i], (size_t)lens_sd[i], digest);
+        cvc_base64url_encode(digest, sizeof(digest), encoded_digest, sizeof(encoded_digest), &encoded_len);
+        test2_success = encoded_len == CVC_SD_JWT_DIGEST_LENGTH && memcmp(encoded_digest, digests_sd + i * CVC_SD_JWT_DIGEST_LENGTH, CVC_SD_JWT_DIGEST_LENGTH) == 0;
+
+        char json[400], expected[400];
+        int json_len = 0;
+        const int expected_len = inputs_sd[i].name ? snprintf(expected, sizeof(expected), "[\"%s\",\"%s\",%s]", salts_sd[i], names_sd[i], values_sd[i]) : snprintf(expected, sizeof(expected), "[\"%s\",%s]", salts_sd[i], values_sd[i]);
+        test2_success = test2_success && cvc_base64url_decode(arena_sd + offsets_sd[i], lens_sd[i], (unsigned char*)json, sizeof(json), &json_len) == CVC_JWT_SUCCESS;
+        test2_success = test2_success && json_len == expected_len && memcmp(json, expected, (size_t)json_len) == 0;
+        test2_success = test2_success && (i == 0 || offsets_sd[i] == offsets_sd[i - 1] + lens_sd[i - 1]);
+    }
+    printf("   Batch time: %.3f ms (%s)\n", batch_ms, cvc_sha256_lanes_implementation());
+    printf("   Status: %s\n\n", test2_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 3: Arena sizing and parameter validation
+    printf("3. Testing validation...\n");
+
+    int test3_success = cvc_sd_jwt_disclosures(inputs_sd, SD_JWT_CLAIMS, arena_sd, arena_size - 1, offsets_sd, lens_sd, digests_sd) == CVC_SD_JWT_ERROR_INSUFFICIENT_BUFFER;
+    cvc_sd_jwt_disclosure_input_t bad = inputs_sd[0];
+    bad.value = NULL;
+    test3_success = test3_success && cvc_sd_jwt_disclosure_length(&bad) == -1;
+    test3_success = test3_success && cvc_sd_jwt_disclosures(&bad, 1, arena_sd, sizeof(arena_sd), offsets_sd, lens_sd, digests_sd) == CVC_SD_JWT_ERROR_INVALID_PARAMS;
+    test3_success = test3_success && cvc_sd_jwt_disclosures(inputs_sd, 0, arena_sd, sizeof(arena_sd), offsets_sd, lens_sd, digests_sd) == CVC_SD_JWT_ERROR_INVALID_PARAMS;
+    printf("   Status: %s\n\n", test3_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 4: Escapes that land on the staging buffer's flush point, for every alignment
+    printf("4. Testing escapes at the staging boundary...\n");
+
+    int test4_success = 1;
+    for (int prefix = 0; prefix <= 140 && test4_success; prefix++)
+    {
+        char name[160], expected[200], json[200];
+        memset(name, 'a', (size_t)prefix);
+        name[prefix] = '\n';
+
+        cvc_sd_jwt_disclosure_input_t edge = { "salt", 4, name, prefix + 1, "1", 1 };
+        test4_success = cvc_sd_jwt_disclosures(&edge, 1, arena_sd, sizeof(arena_sd), offsets_sd, lens_sd, digests_sd) == CVC_SD_JWT_SUCCESS;
+
+        int json_len = 0;
+        const int expected_len = snprintf(expected, sizeof(expected), "[\"salt\",\"%.*s\\u000a\",1]", prefix, name);
+        test4_success = test4_success && cvc_base64url_decode(arena_sd + offsets_sd[0], lens_sd[0], (unsigned char*)json, sizeof(json), &json_len) == CVC_JWT_SUCCESS;
+        test4_success = test4_success && json_len == expected_len && memcmp(json, expected, (size_t)json_len) == 0;
+        if (!test4_success)
+        {
+            printf("   Mismatch with %d characters before the escape\n", prefix);
+        }
+    }
+    printf("   Status: %s\n\n", test4_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Summary
+    printf("=== SD-JWT Test Summary ===\n");
+    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success;
+
+    if (all_tests_passed)
+    {
+        printf("🎉 All SD-JWT tests PASSED!\n");
+        return 0;
+    }
+    else
+    {
+        printf("💥 Some SD-JWT tests FAILED! Check the output above for details.\n");
+        return 1;
+    }
+}
@@ -0,0 +1,260 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/sha256.h"
+#include "core.h"
+
+#define SHA_MAX_TEST_LANES 37
+#define SHA_XMD_BATCH_COUNT 41
+
+// Helper function to convert hex string to bytes
+int hex_to_bytes_sha(const char* hex, unsigned char* bytes, int max_len)
+{
+    int len = (int)strlen(hex) / 2;
+    if (len > max_len)
+    {
+        return -1;
+    }
+    for (int i = 0; i < len; i++)
+    {
+        sscanf(hex + 2 * i, "%2hhx", &bytes[i]);
+    }
+    return len;
+}
+
+// Hash with MIRACL's portable SHA-256 for cross-checking
+void miracl_sha256_sha(const unsigned char* data, int len, unsigned char* digest)
+{
+    hash256 sh;
+    HASH256_init(&sh);
+    for (int i = 0; i < len; i++)
+    {
+        HASH256_process(&sh, data[i]);
+    }
+    HASH256_hash(&sh, (char*)digest);
+}
+
+int main()
+{
+    printf("=== SHA-256 Test ===\n\n");
+    printf("Selected kernel: %s\n\n", cvc_sha256_implementation());
+
+    // Test 1: FIPS 180-2 test vectors
+    printf("1. Testing FIPS 180-2 vectors...\n");
+
+    unsigned char digest[32], expected[32];
+    int test1_success = 1;
+
+    cvc_sha256((const unsigned char*)"abc", 3, digest);
+    hex_to_bytes_sha("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", expected, 32);
+    test1_success = test1_success && memcmp(digest, expected, 32) == 0;
+
+    const char* two_block = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    cvc_sha256((const unsigned char*)two_block, strlen(two_block), digest);
+    hex_to_bytes_sha("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", expected, 32);
+    test1_success = test1_success && memcmp(digest, expected, 32) == 0;
+
+    // One million 'a' fed in uneven chunks
+    unsigned char chunk[997];
+    memset(chunk, 'a', sizeof(chunk));
+    cvc_sha256_ctx ctx;
+    cvc_sha256_init(&ctx);
+    int remaining = 1000000;
+    while (remaining > 0)
+    {
+        const int take = remaining < (int)sizeof(chunk) ? remaining : (int)sizeof(chunk);
+        cvc_sha256_update(&ctx, chunk, take);
+        remaining -= take;
+    }
+    cvc_sha256_final(&ctx, digest);
+    hex_to_bytes_sha("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0", expected, 32);
+    test1_success = test1_success && memcmp(digest, expected, 32) == 0;
+
+    printf("   Status: %s\n\n", test1_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 2: Every length around the block boundaries matches MIRACL
+    printf("2. Testing against MIRACL HASH256 for lengths 0..300...\n");
+
+    unsigned char data[300];
+    srand((unsigned int)time(NULL));
+    for (int i = 0; i < (int)sizeof(data); i++)
+    {
+        data[i] = (unsigned char)(rand() & 0xFF);
+    }
+
+    int test2_success = 1;
+    for (int len = 0; len <= (int)sizeof(data); len++)
+    {
+        miracl_sha256_sha(data, len, expected);
+
+        // Split the input in two to exercise the partial-block buffer
+        cvc_sha256_init(&ctx);
+        cvc_sha256_update(&ctx, data, len / 3);
+        cvc_sha256_update(&ctx, data + len / 3, len - len / 3);
+        cvc_sha256_final(&ctx, digest);
+        test2_success = test2_success && memcmp(digest, expected, 32) == 0;
+    }
+    printf("   Status: %s\n\n", test2_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 3: expand_message_xmd RFC 9380 Appendix K.1 vectors
+    printf("3. Testing expand_message_xmd RFC 9380 vectors...\n");
+
+    const char* xmd_dst = "QUUX-V01-CS02-with-expander-SHA256-128";
+    unsigned char okm[128], expected_okm[128];
+
+    int test3_success = cvc_expand_message_xmd_sha256((const unsigned char*)xmd_dst, (int)strlen(xmd_dst), NULL, 0, okm, 0x20) == CVC_SHA256_SUCCESS;
+    hex_to_bytes_sha("68a985b87eb6b46952128911f2a4412bbc302a9d759667f87f7a21d803f07235", expected_okm, 32);
+    test3_success = test3_success && memcmp(okm, expected_okm, 32) == 0;
+
+    test3_success = test3_success && cvc_expand_message_xmd_sha256((const unsigned char*)xmd_dst, (int)strlen(xmd_dst), (const unsigned char*)"abc", 3, okm, 0x20) == CVC_SHA256_SUCCESS;
+    hex_to_bytes_sha("d8ccab23b5985ccea865c6c97b6e5b8350e794e603b4b97902f53a8a0d605615", expected_okm, 32);
+    test3_success = test3_success && memcmp(okm, expected_okm, 32) == 0;
+
+    test3_success = test3_success && cvc_expand_message_xmd_sha256((const unsigned char*)xmd_dst, (int)strlen(xmd_dst), (const unsigned char*)"abc", 3, okm, 0x80) == CVC_SHA256_SUCCESS;
+    hex_to_bytes_sha("abba86a6129e366fc877aab32fc4ffc70120d8996c88aee2fe4b32d6c7b6437a647e6c3163d40b76a73cf6a5674ef1d890f95b664ee0afa5359a5c4e07985635bbecbac65d747d3d2da7ec2b8221b17b0ca9dc8a1ac1c07ea6a1e60583e2cb00058e77b7b72a298425cd1b941ad4ec65e8afc50303a22c0f99b0509b4c895f40",
+        expected_okm, 128);
+    test3_success = test3_success && memcmp(okm, expected_okm, 128) == 0;
+
+    printf("   Status: %s\n\n", test3_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 4: expand_message_xmd matches MIRACL's XMD_Expand
+    printf("4. Testing expand_message_xmd against MIRACL XMD_Expand...\n");
+
+    int test4_success = 1;
+    for (int len = 1; len <= 100; len += 33)
+    {
+        char miracl_okm[96];
+        octet OKM = { 0, sizeof(miracl_okm), miracl_okm };
+        octet DST = { 14, 14, "CVC_DERIVE_KEY" };
+        octet MESSAGE = { len, len, (char*)data };
+        XMD_Expand(MC_SHA2, SHA256, &OKM, 48, &DST, &MESSAGE);
+
+        cvc_expand_message_xmd_sha256((const unsigned char*)"CVC_DERIVE_KEY", 14, data, len, okm, 48);
+        test4_success = test4_success && OKM.len == 48 && memcmp(okm, miracl_okm, 48) == 0;
+    }
+    printf("   Status: %s\n\n", test4_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 5: Invalid parameters
+    printf("5. Testing invalid parameters...\n");
+
+    unsigned char long_dst[256];
+    memset(long_dst, 'd', sizeof(long_dst));
+    const int test5a_result = cvc_expand_message_xmd_sha256(long_dst, 256, data, 10, okm, 32);
+    const int test5b_result = cvc_expand_message_xmd_sha256((const unsigned char*)"DST", 3, data, 10, okm, 0);
+    const int test5c_result = cvc_expand_message_xmd_sha256((const unsigned char*)"DST", 3, data, 10, okm, 255 * 32 + 1);
+
+    const int test5_success = (test5a_result == CVC_SHA256_ERROR_INVALID_PARAMS) && (test5b_result == CVC_SHA256_ERROR_INVALID_PARAMS) && (test5c_result == CVC_SHA256_ERROR_OUTPUT_TOO_LARGE);
+    printf("   Status: %s\n\n", test5_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 6: Multi-buffer compression matches the single-stream kernel for every lane count
+    printf("6. Testing multi-buffer compression (%s)...\n", cvc_sha256_lanes_implementation());
+
+    int test6_success = 1;
+    for (int lanes = 1; lanes <= SHA_MAX_TEST_LANES; lanes++)
+    {
+        uint32_t states[SHA_MAX_TEST_LANES][8], expected_states[SHA_MAX_TEST_LANES][8];
+        uint32_t* state_ptrs[SHA_MAX_TEST_LANES];
+        const unsigned char* block_ptrs[SHA_MAX_TEST_LANES];
+        for (int lane = 0; lane < lanes; lane++)
+        {
+            for (int j = 0; j < 8; j++)
+            {
+                states[lane][j] = expected_states[lane][j] = (uint32_t)rand();
+            }
+            state_ptrs[lane] = states[lane];
+            block_ptrs[lane] = data + (lane * 7) % (sizeof(data) - CVC_SHA256_BLOCK_SIZE);
+            cvc_sha256_compress(expected_states[lane], block_ptrs[lane], 1);
+        }
+        cvc_sha256_compress_lanes(state_ptrs, block_ptrs, lanes);
+        test6_success = test6_success && memcmp(states, expected_states, (size_t)lanes * sizeof(states[0])) == 0;
+    }
+    printf("   Status: %s\n\n", test6_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 7: Batched expand_message_xmd matches per-message expansion
+    printf("7. Testing batched expand_message_xmd...\n");
+
+    const unsigned char* batch_messages[SHA_XMD_BATCH_COUNT];
+    int batch_lens[SHA_XMD_BATCH_COUNT];
+    for (int i = 0; i < SHA_XMD_BATCH_COUNT; i++)
+    {
+        batch_lens[i] = (i * 23) % (int)sizeof(data);
+        batch_messages[i] = data;
+    }
+    batch_lens[3] = 0;
+    batch_messages[3] = NULL;
+
+    static unsigned char batch_okm[SHA_XMD_BATCH_COUNT * 128];
+    int test7_success = 1;
+    const int output_lens[] = { 32, 48, 96, 128 };
+    for (int k = 0; k < 4; k++)
+    {
+        test7_success = test7_success && cvc_expand_message_xmd_sha256_batch((const unsigned char*)xmd_dst, (int)strlen(xmd_dst), batch_messages, batch_lens, SHA_XMD_BATCH_COUNT, batch_okm, output_lens[k]) == CVC_SHA256_SUCCESS;
+        for (int i = 0; i < SHA_XMD_BATCH_COUNT && test7_success; i++)
+        {
+            cvc_expand_message_xmd_sha256((const unsigned char*)xmd_dst, (int)strlen(xmd_dst), batch_messages[i], batch_lens[i], okm, output_lens[k]);
+            test7_success = memcmp(okm, batch_okm + i * output_lens[k], output_lens[k]) == 0;
+        }
+    }
+    printf("   Status: %s\n\n", test7_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 8: Streaming expansion of a split message matches the one-shot call
+    printf("8. Testing streaming expand_message_xmd...\n");
+
+    int test8_success = 1;
+    for (int split = 0; split <= 150 && test8_success; split += 25)
+    {
+        static unsigned char stream_okm[300];
+        cvc_expand_message_xmd_sha256((const unsigned char*)xmd_dst, (int)strlen(xmd_dst), data, 150, batch_okm, sizeof(stream_okm));
+
+        cvc_xmd_sha256_ctx xmd;
+        test8_success = cvc_xmd_sha256_init(&xmd, (const unsigned char*)xmd_dst, (int)strlen(xmd_dst), data, split, data + split, 150 - split, sizeof(stream_okm)) == CVC_SHA256_SUCCESS;
+
+        // Uneven reads cross b_i boundaries at different offsets
+        int offset = 0;
+        for (int step = 1; offset < (int)sizeof(stream_okm) && test8_success; step += 7)
+        {
+            const int take = (int)sizeof(stream_okm) - offset < step ? (int)sizeof(stream_okm) - offset : step;
+            test8_success = cvc_xmd_sha256_read(&xmd, stream_okm + offset, take) == CVC_SHA256_SUCCESS;
+            offset += take;
+        }
+
+        // Reading past len_in_bytes is refused
+        test8_success = test8_success && cvc_xmd_sha256_read(&xmd, stream_okm, 1) == CVC_SHA256_ERROR_INVALID_PARAMS;
+        test8_success = test8_success && memcmp(stream_okm, batch_okm, sizeof(stream_okm)) == 0;
+        cvc_xmd_sha256_clear(&xmd);
+    }
+    printf("   Status: %s\n\n", test8_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 9: Multi-buffer hashing of messages with different lengths
+    printf("9. Testing batched SHA-256...\n");
+
+    static unsigned char batch_digests[SHA_XMD_BATCH_COUNT * 32];
+    int test9_success = cvc_sha256_batch(batch_messages, batch_lens, SHA_XMD_BATCH_COUNT, batch_digests) == CVC_SHA256_SUCCESS;
+    for (int i = 0; i < SHA_XMD_BATCH_COUNT && test9_success; i++)
+    {
+        unsigned char expected_digest[32];
+        cvc_sha256(batch_messages[i], (size_t)batch_lens[i], expected_digest);
+        test9_success = memcmp(expected_digest, batch_digests + i * 32, 32) == 0;
+    }
+    test9_success = test9_success && cvc_sha256_batch(batch_messages, batch_lens, 0, batch_digests) == CVC_SHA256_ERROR_INVALID_PARAMS;
+    printf("   Status: %s\n\n", test9_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Summary
+    printf("=== SHA-256 Test Summary ===\n");
+    const int all_tests_passed = test1_success && test2_success && test3_success && test4_success && test5_success && test6_success && test7_success && test8_success && test9_success;
+
+    if (all_tests_passed)
+    {
+        printf("🎉 All SHA-256 tests PASSED!\n");
+        return 0;
+    }
+    else
+    {
+        printf("💥 Some SHA-256 tests FAILED! Check the output above for details.\n");
+        return 1;
+    }
+}
@@ -0,0 +1,442 @@
+//
+// Created by Peter Paravinja on 18. 10. 26.
+//
+// Measures the peak stack of each public function by running it on a thread whose
+// stack was painted with a known byte, then finding the deepest overwritten byte.
+// Nothing is warmed up beforehand, so one-time table builds count against whichever
+// function triggers them first, as they would on a small worker thread.
+//
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/add_secret_keys.h"
+#include "src/batch.h"
+#include "src/ecdsa.h"
+#include "src/ecp_operations.h"
+#include "src/ed25519_operations.h"
+#include "src/hash_to_curve.h"
+#include "src/hash_to_field.h"
+#include "src/key_cache.h"
+#include "src/keypair.h"
+#include "src/public_derive.h"
+#include "src/sha256.h"
+#include "src/stack_budget.h"
+
+// External ROM constants
+extern const BIG_256_56 CURVE_Order_NIST256;
+
+#define STACK_TEST_SIZE (256 * 1024)
+#define STACK_PAINT 0xA5
+#define STACK_BATCH_COUNT 40
+#define STACK_KEY_COUNT 16
+
+typedef struct
+{
+    const char* name;
+    int (*run)(void);
+} stack_probe_t;
+
+static const unsigned char dst_stack[] = "CVC_STACK_USAGE_TEST";
+static unsigned char master_key_stack[32];
+static unsigned char contexts_stack[STACK_BATCH_COUNT][12];
+static const unsigned char* context_ptrs_stack[STACK_BATCH_COUNT];
+static int context_lens_stack[STACK_BATCH_COUNT];
+static nist256_key_material_t keys_stack[STACK_KEY_COUNT];
+static const unsigned char* secret_ptrs_stack[STACK_KEY_COUNT];
+static unsigned char public_keys_stack[STACK_KEY_COUNT][65];
+static const unsigned char* public_ptrs_stack[STACK_KEY_COUNT];
+static ed25519_key_material_t ed_keys_stack[2];
+static unsigned char ed_public_stack[2][65];
+static cvc_key_cache_t* cache_stack;
+static cvc_nist256_keypair_t* keypair_stack;
+static unsigned char keypair_public_stack[65];
+static unsigned char signature_stack[64];
+
+// Outputs live in static storage so they do not count as stack
+static nist256_key_material_t key_out_stack;
+static ed25519_key_material_t ed_key_out_stack;
+static unsigned char bytes_out_stack[STACK_BATCH_COUNT * 128];
+static FP_NIST256 fields_out_stack[STACK_BATCH_COUNT * 2];
+static ECP_NIST256 points_out_stack[STACK_BATCH_COUNT];
+static unsigned char requests_stack[4 * CVC_BATCH_REQUEST_SIZE];
+static unsigned char responses_stack[4 * CVC_BATCH_RESPONSE_SIZE];
+static int out_len_stack;
+
+// Generate some random seed data
+void generate_random_seed_stack(unsigned char* seed, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        seed[i] = (unsigned char)(rand() & 0xFF);
+    }
+}
+
+// ============================================================================
+// Probes: each returns 0 if the call succeeded
+// ============================================================================
+
+int probe_nothing(void)
+{
+    return 0;
+}
+
+int probe_derive_nist256(void)
+{
+    return cvc_derive_secret_key_nist256(master_key_stack, 32, contexts_stack[0], context_lens_stack[0], dst_stack, sizeof(dst_stack) - 1, &key_out_stack);
+}
+
+int probe_derive_nist256_cached(void)
+{
+    return cvc_derive_secret_key_nist256_cached(cache_stack, master_key_stack, 32, contexts_stack[1], context_lens_stack[1], dst_stack, sizeof(dst_stack) - 1, &key_out_stack);
+}
+
+int probe_derive_ed25519(void)
+{
+    return cvc_derive_secret_key_ed25519(master_key_stack, 32, contexts_stack[2], context_lens_stack[2], dst_stack, sizeof(dst_stack) - 1, &ed_key_out_stack);
+}
+
+int probe_hash_to_field_sha256(void)
+{
+    return cvc_hash_to_field_nist256(MC_SHA2, SHA256, dst_stack, sizeof(dst_stack) - 1, contexts_stack[3], context_lens_stack[3], 2, fields_out_stack);
+}
+
+int probe_hash_to_field_sha512(void)
+{
+    return cvc_hash_to_field_nist256(MC_SHA2, SHA512, dst_stack, sizeof(dst_stack) - 1, contexts_stack[4], context_lens_stack[4], 2, fields_out_stack);
+}
+
+int probe_hash_to_field_batch(void)
+{
+    return cvc_hash_to_field_nist256_batch(MC_SHA2, SHA256, dst_stack, sizeof(dst_stack) - 1, context_ptrs_stack, context_lens_stack, STACK_BATCH_COUNT, 2, fields_out_stack);
+}
+
+int probe_expand_message_xmd(void)
+{
+    return cvc_expand_message_xmd_sha256(dst_stack, sizeof(dst_stack) - 1, contexts_stack[5], context_lens_stack[5], bytes_out_stack, 128);
+}
+
+int probe_expand_message_xmd_batch(void)
+{
+    return cvc_expand_message_xmd_sha256_batch(dst_stack, sizeof(dst_stack) - 1, context_ptrs_stack, context_lens_stack, STACK_BATCH_COUNT, bytes_out_stack, 128);
+}
+
+int probe_hash_to_curve(void)
+{
+    return cvc_hash_to_curve_nist256(dst_stack, sizeof(dst_stack) - 1, contexts_stack[6], context_lens_stack[6], &points_out_stack[0]);
+}
+
+int probe_hash_to_curve_batch(void)
+{
+    return cvc_hash_to_curve_nist256_batch(dst_stack, sizeof(dst_stack) - 1, context_ptrs_stack, context_lens_stack, STACK_BATCH_COUNT, points_out_stack);
+}
+
+int probe_add_secret_keys(void)
+{
+    return cvc_add_nist256_secret_keys(keys_stack[0].private_key_bytes, 32, keys_stack[1].private_key_bytes, 32, &key_out_stack);
+}
+
+int probe_sum_secret_keys(void)
+{
+    return cvc_sum_nist256_secret_keys(secret_ptrs_stack, STACK_KEY_COUNT, &key_out_stack);
+}
+
+int probe_split_secret_key(void)
+{
+    unsigned char seed[32];
+    memset(seed, 0x42, sizeof(seed));
+    return cvc_split_nist256_secret_key(keys_stack[0].private_key_bytes, 32, seed, sizeof(seed), 4, bytes_out_stack);
+}
+
+int probe_add_public_keys(void)
+{
+    return cvc_add_nist256_public_keys(public_keys_stack[0], 65, public_keys_stack[1], 65, bytes_out_stack, 65, &out_len_stack);
+}
+
+int probe_sum_public_keys(void)
+{
+    return cvc_sum_nist256_public_keys(NULL, public_ptrs_stack, STACK_KEY_COUNT, bytes_out_stack, 65, &out_len_stack);
+}
+
+int probe_add_ed25519_secret_keys(void)
+{
+    return cvc_add_ed25519_secret_keys(ed_keys_stack[0].private_key_bytes, 32, ed_keys_stack[1].private_key_bytes, 32, &ed_key_out_stack);
+}
+
+int probe_add_ed25519_public_keys(void)
+{
+    return cvc_add_ed25519_public_keys(ed_public_stack[0], 65, ed_public_stack[1], 65, bytes_out_stack, 65, &out_len_stack);
+}
+
+int probe_keypair_derive(void)
+{
+    cvc_nist256_keypair_t* keypair = NULL;
+    const int result = cvc_nist256_keypair_derive(master_key_stack, 32, contexts_stack[4], context_lens_stack[4], dst_stack, sizeof(dst_stack) - 1, 0, &keypair);
+    cvc_nist256_keypair_destroy(keypair);
+    return result;
+}
+
+int probe_keypair_ecdh(void)
+{
+    return cvc_nist256_keypair_ecdh(keypair_stack, NULL, public_keys_stack[1], 65, bytes_out_stack, 32);
+}
+
+int probe_keypair_sign(void)
+{
+    return cvc_nist256_keypair_sign(keypair_stack, master_key_stack, 32, bytes_out_stack, 64);
+}
+
+int probe_ecdsa_verify(void)
+{
+    return cvc_ecdsa_nist256_verify(NULL, keypair_public_stack, 65, master_key_stack, 32, signature_stack, 64);
+}
+
+int probe_derive_public_keys_batch(void)
+{
+    return cvc_derive_public_keys_nist256_batch(NULL, public_keys_stack[0], 65, context_ptrs_stack, context_lens_stack, STACK_BATCH_COUNT, dst_stack, sizeof(dst_stack) - 1, bytes_out_stack);
+}
+
+int probe_batch_execute(void)
+{
+    return cvc_batch_execute(requests_stack, 4, dst_stack, sizeof(dst_stack) - 1, responses_stack, sizeof(responses_stack)) == 4 ? 0 : -1;
+}
+
+// ============================================================================
+// Measurement
+// ============================================================================
+
+typedef struct
+{
+    const stack_probe_t* probe;
+    int result;
+} stack_run_t;
+
+void* stack_thread(void* arg)
+{
+    stack_run_t* run = (stack_run_t*)arg;
+    run->result = run->probe->run();
+    return NULL;
+}
+
+// Bytes of the painted stack that the probe touched, or 0 on failure; *result gets the probe's return code
+size_t measure_stack(const stack_probe_t* probe, int* result)
+{
+    unsigned char* stack = NULL;
+    if (posix_memalign((void**)&stack, 4096, STACK_TEST_SIZE) != 0)
+    {
+        return 0;
+    }
+    memset(stack, STACK_PAINT, STACK_TEST_SIZE);
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr, stack, STACK_TEST_SIZE);
+
+    stack_run_t run = { probe, -1 };
+    pthread_t thread;
+    size_t used = 0;
+    if (pthread_create(&thread, &attr, stack_thread, &run) == 0)
+    {
+        pthread_join(thread, NULL);
+
+        // The stack grows down, so the lowest overwritten byte marks the peak
+        size_t untouched = 0;
+        while (untouched < STACK_TEST_SIZE && stack[untouched] == STACK_PAINT)
+        {
+            untouched++;
+        }
+        used = STACK_TEST_SIZE - untouched;
+    }
+
+    pthread_attr_destroy(&attr);
+    free(stack);
+    *result = run.result;
+    return used;
+}
+
+int setup_stack(void)
+{
+    generate_random_seed_stack(master_key_stack, sizeof(master_key_stack));
+
+    for (int i = 0; i < STACK_BATCH_COUNT; i++)
+    {
+        context_lens_stack[i] = snprintf((char*)contexts_stack[i], sizeof(contexts_stack[i]), "ctx-%d", i);
+        context_ptrs_stack[i] = contexts_stack[i];
+    }
+
+    for (int i = 0; i < STACK_KEY_COUNT; i++)
+    {
+        unsigned char seed[32];
+        generate_random_seed_stack(seed, sizeof(seed));
+        if (nist256_generate_key_material(seed, sizeof(seed), &keys_stack[i]) != 0)
+        {
+            return -1;
+        }
+        secret_ptrs_stack[i] = keys_stack[i].private_key_bytes;
+        public_keys_stack[i][0] = 0x04;
+        memcpy(&public_keys_stack[i][1], keys_stack[i].public_key_x_bytes, 32);
+        memcpy(&public_keys_stack[i][33], keys_stack[i].public_key_y_bytes, 32);
+        public_ptrs_stack[i] = public_keys_stack[i];
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        unsigned char seed[32];
+        generate_random_seed_stack(seed, sizeof(seed));
+        if (ed25519_generate_key_material(seed, sizeof(seed), &ed_keys_stack[i]) != 0)
+        {
+            return -1;
+        }
+        ed_public_stack[i][0] = 0x04;
+        memcpy(&ed_public_stack[i][1], ed_keys_stack[i].public_key_x_bytes, 32);
+        memcpy(&ed_public_stack[i][33], ed_keys_stack[i].public_key_y_bytes, 32);
+    }
+
+    // One record of each opcode
+    memset(requests_stack, 0, sizeof(requests_stack));
+    unsigned char* record = requests_stack;
+    record[CVC_BATCH_REQUEST_OPCODE] = CVC_BATCH_OP_DERIVE;
+    record[CVC_BATCH_REQUEST_LEN_A] = 32;
+    record[CVC_BATCH_REQUEST_LEN_B] = (unsigned char)context_lens_stack[7];
+    memcpy(record + CVC_BATCH_REQUEST_OPERAND_A, master_key_stack, 32);
+    memcpy(record + CVC_BATCH_REQUEST_OPERAND_B, contexts_stack[7], context_lens_stack[7]);
+
+    record += CVC_BATCH_REQUEST_SIZE;
+    record[CVC_BATCH_REQUEST_OPCODE] = CVC_BATCH_OP_ADD_PUBLIC;
+    record[CVC_BATCH_REQUEST_LEN_A] = 65;
+    record[CVC_BATCH_REQUEST_LEN_B] = 65;
+    memcpy(record + CVC_BATCH_REQUEST_OPERAND_A, public_keys_stack[2], 65);
+    memcpy(record + CVC_BATCH_REQUEST_OPERAND_B, public_keys_stack[3], 65);
+
+    record += CVC_BATCH_REQUEST_SIZE;
+    record[CVC_BATCH_REQUEST_OPCODE] = CVC_BATCH_OP_ADD_SECRET;
+    record[CVC_BATCH_REQUEST_LEN_A] = 32;
+    record[CVC_BATCH_REQUEST_LEN_B] = 32;
+    memcpy(record + CVC_BATCH_REQUEST_OPERAND_A, keys_stack[2].private_key_bytes, 32);
+    memcpy(record + CVC_BATCH_REQUEST_OPERAND_B, keys_stack[3].private_key_bytes, 32);
+
+    record += CVC_BATCH_REQUEST_SIZE;
+    record[CVC_BATCH_REQUEST_OPCODE] = CVC_BATCH_OP_KEYGEN;
+    record[CVC_BATCH_REQUEST_LEN_A] = 32;
+    generate_random_seed_stack(record + CVC_BATCH_REQUEST_OPERAND_A, 32);
+
+    if (cvc_nist256_keypair_from_secret(keys_stack[0].private_key_bytes, 32, 0, &keypair_stack) != CVC_KEYPAIR_SUCCESS ||
+        cvc_nist256_keypair_public_key(keypair_stack, keypair_public_stack, sizeof(keypair_public_stack)) != CVC_KEYPAIR_SUCCESS ||
+        cvc_nist256_keypair_sign(keypair_stack, master_key_stack, 32, signature_stack, sizeof(signature_stack)) != CVC_KEYPAIR_SUCCESS)
+    {
+        return -1;
+    }
+
+    unsigned char hash_key[32];
+    generate_random_seed_stack(hash_key, sizeof(hash_key));
+    cvc_key_cache_config_t cache_config = { 64, 0, 0, 1 };
+    return cvc_key_cache_create(&cache_config, hash_key, sizeof(hash_key), &cache_stack) == CVC_KEY_CACHE_SUCCESS ? 0 : -1;
+}
+
+static const stack_probe_t probes_stack[] = {
+    { "cvc_derive_secret_key_nist256", probe_derive_nist256 },
+    { "cvc_derive_secret_key_nist256_cached", probe_derive_nist256_cached },
+    { "cvc_derive_secret_key_ed25519", probe_derive_ed25519 },
+    { "cvc_hash_to_field_nist256 (SHA-256)", probe_hash_to_field_sha256 },
+    { "cvc_hash_to_field_nist256 (SHA-512)", probe_hash_to_field_sha512 },
+    { "cvc_hash_to_field_nist256_batch", probe_hash_to_field_batch },
+    { "cvc_expand_message_xmd_sha256", probe_expand_message_xmd },
+    { "cvc_expand_message_xmd_sha256_batch", probe_expand_message_xmd_batch },
+    { "cvc_hash_to_curve_nist256", probe_hash_to_curve },
+    { "cvc_hash_to_curve_nist256_batch", probe_hash_to_curve_batch },
+    { "cvc_add_nist256_secret_keys", probe_add_secret_keys },
+    { "cvc_sum_nist256_secret_keys", probe_sum_secret_keys },
+    { "cvc_split_nist256_secret_key", probe_split_secret_key },
+    { "cvc_add_nist256_public_keys", probe_add_public_keys },
+    { "cvc_sum_nist256_public_keys", probe_sum_public_keys },
+    { "cvc_add_ed25519_secret_keys", probe_add_ed25519_secret_keys },
+    { "cvc_add_ed25519_public_keys", probe_add_ed25519_public_keys },
+    { "cvc_nist256_keypair_derive", probe_keypair_derive },
+    { "cvc_nist256_keypair_ecdh", probe_keypair_ecdh },
+    { "cvc_nist256_keypair_sign", probe_keypair_sign },
+    { "cvc_ecdsa_nist256_verify", probe_ecdsa_verify },
+    { "cvc_derive_public_keys_nist256_batch", probe_derive_public_keys_batch },
+    { "cvc_batch_execute", probe_batch_execute },
+};
+
+int main()
+{
+    printf("=== Stack Usage Test ===\n\n");
+    srand((unsigned int)time(NULL));
+
+    // Test 1: Inputs and the empty-thread baseline
+    printf("1. Testing measurement setup...\n");
+
+    const size_t budget = cvc_stack_budget();
+    const stack_probe_t empty_probe = { "empty thread", probe_nothing };
+    int baseline_result = -1;
+    const size_t baseline = measure_stack(&empty_probe, &baseline_result);
+
+    printf("   Library stack budget: %zu bytes%s\n", budget, budget < CVC_STACK_BUDGET ? " (CVC_LOW_STACK build)" : "");
+    printf("   Empty thread baseline: %zu bytes\n", baseline);
+    const int test1_success = setup_stack() == 0 && baseline > 0 && baseline_result == 0;
+    printf("   Status: %s\n\n", test1_success ? "✅ PASSED" : "❌ FAILED");
+    if (!test1_success)
+    {
+        return 1;
+    }
+
+    // Test 2: Every public function stays within the budget
+    printf("2. Testing peak stack of each public function...\n");
+
+    int test2_success = 1;
+    size_t deepest = 0;
+    for (size_t i = 0; i < sizeof(probes_stack) / sizeof(probes_stack[0]); i++)
+    {
+        int result = -1;
+        const size_t used = measure_stack(&probes_stack[i], &result);
+        const size_t own = used > baseline ? used - baseline : 0;
+        const int ok = used > 0 && result == 0 && own <= budget;
+
+        printf("   %-40s %7zu bytes %s\n", probes_stack[i].name, own, ok ? "" : result != 0 ? "(call failed)" : "(over budget)");
+        deepest = own > deepest ? own : deepest;
+        test2_success = test2_success && ok;
+    }
+    printf("   Deepest: %zu of %zu bytes\n", deepest, budget);
+    printf("   Status: %s\n\n", test2_success ? "✅ PASSED" : "❌ FAILED");
+
+    // Test 3: Derivation that streams master key and context matches hashing the joined input
+    printf("3. Testing streamed derivation matches joined input...\n");
+
+    unsigned char joined[32 + sizeof(contexts_stack[0])];
+    memcpy(joined, master_key_stack, 32);
+    memcpy(joined + 32, contexts_stack[0], context_lens_stack[0]);
+
+    FP_NIST256 field_element;
+    BIG_256_56 x, order;
+    char expected[32];
+    cvc_hash_to_field_nist256(MC_SHA2, SHA256, dst_stack, sizeof(dst_stack) - 1, joined, 32 + context_lens_stack[0], 1, &field_element);
+    FP_NIST256_redc(x, &field_element);
+    BIG_256_56_rcopy(order, CURVE_Order_NIST256);
+    BIG_256_56_mod(x, order);
+    BIG_256_56_toBytes(expected, x);
+
+    nist256_key_material_t derived;
+    const int test3_success = cvc_derive_secret_key_nist256(master_key_stack, 32, contexts_stack[0], context_lens_stack[0], dst_stack, sizeof(dst_stack) - 1, &derived) == CVC_DERIVE_KEY_SUCCESS &&
+                              memcmp(derived.private_key_bytes, expected, 32) == 0;
+    printf("   Status: %s\n\n", test3_success ? "✅ PASSED" : "❌ FAILED");
+
+    cvc_key_cache_destroy(cache_stack);
+    cvc_nist256_keypair_destroy(keypair_stack);
+
+    // Summary
+    printf("=== Stack Usage Test Summary ===\n");
+    const int all_tests_passed = test1_success && test2_success && test3_success;
+
+    if (all_tests_passed)
+    {
+        printf("🎉 All stack usage tests PASSED!\n");
+        return 0;
+    }
+    else
+    {
+        printf("💥 Some stack usage tests FAILED! Check the output above for details.\n");
+        return 1;
+    }
+}